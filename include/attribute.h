@@ -21,7 +21,10 @@
 
 #ifndef ATTRIBUTE_H
 #define ATTRIBUTE_H
+#include "attributeindex.h"
 #include "enumtype.h"
+#include <QAtomicInt>
+#include <QAtomicInteger>
 #include <QList>
 #include <QString>
 
@@ -30,10 +33,22 @@ class Attribute {
     QString m_name;
     short m_id;
     bool m_isOptional;
+    bool m_isStreamed;
     NS_AttDataType::T_AttDataType m_dataType;
     QList<Attribute *> m_subAttArray;
+    AttributeIndex m_subAttIndex;
+    AttributeIndex *m_pParentIndex;
     QString m_desc;
     void *pObj;
+    // Atomic so that threads reading the same tree can fill the cache concurrently
+    mutable QAtomicInteger<quint64> m_structHash;
+    mutable QAtomicInteger<quint64> m_shapeHash;
+    mutable QAtomicInt m_isStructHashValid;
+
+    bool hasSameParams(const Attribute &other) const;
+    void updateStructHash(void) const;
+
+    friend class AttributeIndex;
 
   public:
     typedef struct _attInfos {
@@ -47,16 +62,29 @@ class Attribute {
         QString attDesc;
     } T_attInfos;
 
+    // FNV-1a 64 bits offset basis
+    static const quint64 HASH_SEED = 14695981039346656037ULL;
+
     Attribute(void);
     Attribute(QString attName, short attId, bool attIsOptional, NS_AttDataType::T_AttDataType attDataType, QString attDesc);
     Attribute(QString attName, short attId, bool attIsOptional, NS_AttDataType::T_AttDataType attDataType,
         QList<Attribute *> attSubAttArray, QString attDesc);
+    ~Attribute();
     void setName(QString attName);
     QString getName(void);
     void setId(short attId);
     short getId(void);
     void setIsOptional(bool attIsOptional);
     bool getIsOptional(void);
+
+    /**
+     * @brief      Sets if a byte array attribute is streamed, its body is then encoded and decoded in chunks by the
+     *             generated code instead of being held in memory
+     *
+     * @param[in]  attIsStreamed  True if the attribute is streamed
+     */
+    void setIsStreamed(bool attIsStreamed);
+    bool getIsStreamed(void);
     void setDataType(NS_AttDataType::T_AttDataType attDataType);
     NS_AttDataType::T_AttDataType getDataType(void);
     void setDesc(QString attDesc);
@@ -81,9 +109,41 @@ class Attribute {
     void clearArray_rec(void);
     void removeAtt(QString attName);
     Attribute *getSubAttPointer(QString subAttName);
+    Attribute *getSubAttById(short subAttId);
+
+    /**
+     * @brief      Gets the structural hash of the attribute and its sub-attributes, computed lazily and invalidated
+     *             by any edit of the subtree. Equal trees have equal hashes.
+     *
+     * @return     The structural hash
+     */
+    quint64 getStructHash(void) const;
 
+    /**
+     * @brief      Gets the hash of what the descriptors hold of the attribute and its sub-attributes (ids, types and
+     *             optionality), cached with the structural hash
+     *
+     * @return     The shape hash
+     */
+    quint64 getShapeHash(void) const;
+    void invalidateStructHash(void);
+
+    static quint64 hashValue(quint64 hash, quint64 value);
+    static quint64 hashString(quint64 hash, QString str);
     static bool compareRefAttList(QList<Attribute *> a_list, QList<Attribute *> b_list, int &err_idx);
 
+    /**
+     * @brief      Lists the paths of the attributes that differ between two lists, subtrees with equal hashes are
+     *             skipped
+     *
+     * @param[in]  a_list      The reference list
+     * @param[in]  b_list      The compared list
+     * @param[in]  parentPath  The path of the lists parent
+     *
+     * @return     The paths of the modified, removed or added attributes
+     */
+    static QStringList diffAttList(QList<Attribute *> a_list, QList<Attribute *> b_list, QString parentPath);
+
     friend bool operator==(const Attribute &lhs, const Attribute &rhs) {
         if (lhs.m_name != rhs.m_name) {
             return false;
@@ -94,6 +154,9 @@ class Attribute {
         if (lhs.m_isOptional != rhs.m_isOptional) {
             return false;
         }
+        if (lhs.m_isStreamed != rhs.m_isStreamed) {
+            return false;
+        }
         if (lhs.m_dataType != rhs.m_dataType) {
             return false;
         }
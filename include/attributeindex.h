@@ -0,0 +1,62 @@
+/**
+ * \file attributeindex.h
+ * \brief Attribute lookup index module
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#ifndef ATTRIBUTEINDEX_H
+#define ATTRIBUTEINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+class Attribute;
+class Command;
+
+// Name and id index over one attribute level (command attributes or sub-attributes).
+// Indexed attributes point back to the index so renames and deletions keep it up to date,
+// and so edits can invalidate the structural hash of the owner.
+class AttributeIndex {
+  private:
+    QHash<QString, QList<Attribute *>> m_nameIdx;
+    QHash<short, QList<Attribute *>> m_idIdx;
+    Attribute *m_pOwnerAtt;
+    Command *m_pOwnerCmd;
+
+  public:
+    AttributeIndex(void);
+    ~AttributeIndex();
+    AttributeIndex(const AttributeIndex &) = delete;
+    AttributeIndex &operator=(const AttributeIndex &) = delete;
+
+    void setOwner(Attribute *pOwnerAtt);
+    void setOwner(Command *pOwnerCmd);
+    void invalidateOwnerHash(void);
+    // An attribute has a single parent, inserting one that is already indexed is rejected
+    bool insert(Attribute *pAtt);
+    void remove(Attribute *pAtt);
+    QList<Attribute *> rebuild(QList<Attribute *> attList);
+    void clear(void);
+    void rename(Attribute *pAtt, QString oldName, QString newName);
+    void changeId(Attribute *pAtt, short oldId, short newId);
+    Attribute *findByName(QString attName) const;
+    Attribute *findById(short attId) const;
+};
+
+#endif // ATTRIBUTEINDEX_H
@@ -22,10 +22,13 @@
 #ifndef CODEEXTRACTOR_H
 #define CODEEXTRACTOR_H
 
+#include "codescanner.h"
 #include "command.h"
 #include <QDebug>
+#include <QHash>
 #include <QList>
 #include <QString>
+#include <QStringRef>
 #include <QTextStream>
 
 class CodeExtractor {
@@ -48,12 +51,26 @@ class CodeExtractor {
     QString m_unknownPublicFunctionsHeaders;
     QString m_defaultCommandHandler;
 
-    void extractIncludes(QTextStream *pInStream);
-    void extractDefinitions(QTextStream *pInStream);
-    void extractPrivateFunctions(QString protocolName, QTextStream *pInStream, QList<Command *> cmdList);
+    // Single pass parsing state
+    QString m_executePrefix;
+    QString m_mainExecuteName;
+    QHash<QString, int> m_cmdNameToIdx;
+    QString m_functionBuffer;
+    CodeScanner m_scanner;
+    int m_cmdIdx;
+    bool m_inMainExecute;
+    bool m_inDefaultHandler;
+    int m_defaultHandlerDepth;
+
+    void extractIncludes(const QStringRef &line);
+    void extractDefinitions(const QStringRef &line);
+    void extractPrivateFunctions(const QStringRef &line);
+    void extractPublicFunctions(const QStringRef &line);
+    void extractMainExecute(const QStringRef &line);
     void extractPublicFunctionHeader(QString functionBuffer);
-    void extractDefaultCommandHandler(QTextStream *pInStream);
-    void extractPublicFunctions(QString protocolName, QTextStream *pInStream);
+    void flushFunctionBuffer();
+    void resetFunctionBuffer();
+    int findCommandIdx(const QStringRef &line);
     bool isHeader(QString text);
 
   public:
@@ -30,13 +30,45 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QHash>
+#include <QPair>
+#include <QSet>
 #include <QString>
 #include <QTextStream>
 #include <QUrl>
 
 class CodeGenerator {
   private:
+    // Field of a generated C struct, arrayNb is 0 for a scalar field
+    typedef struct _cField {
+        QString type;
+        QString name;
+        QString arrayLength;
+        int arrayNb;
+    } T_CField;
+
+    // Sections of the bridge files, each feature emitter writes its part of a section
+    typedef enum {
+        BRIDGE_H_CONSTANTS,
+        BRIDGE_H_TYPES,
+        BRIDGE_H_PROTOTYPES,
+        BRIDGE_C_TYPES,
+        BRIDGE_C_CONSTANTS,
+        BRIDGE_C_PROTOTYPES,
+        BRIDGE_C_PRIVATE_FCTS,
+        BRIDGE_C_PUBLIC_FCTS,
+    } T_BridgeSection;
+
     bool protocolHasSubAtt;
+    QHash<QString, QString> sharedDescNames;
+    int sharedDescArrayNb;
+    int sharedDescEntryNb;
+    bool reentrantMode;
+    bool deferredMode;
+    bool fastDecoderMode;
+    bool segmentEncodeMode;
+    bool instrumentMode;
+    bool shareDescMode;
 
     QString getAttDataRxPath(QString protocolName, QStringList parentNames, QString attName);
     QString getAttDataTxPath(QString protocolName, QStringList parentNames, QString attName);
@@ -46,6 +78,67 @@ class CodeGenerator {
     QString getTypeStringFromDataType(NS_AttDataType::T_AttDataType dataType);
     QString getInitStringFromDataType(NS_AttDataType::T_AttDataType dataType);
     QString getAttDescString(QString protocolName, QString parentName, Attribute *attribute);
+    QString getCtxParam(QString protocolName, bool isOnlyParam);
+    QString getCtxArg(bool isOnlyArg);
+    QString getBridgeCtxParam(QString protocolName, bool isOnlyParam);
+    QList<T_CField> getQueueFields(QString protocolName);
+    QList<T_CField> getQueueSlotFields(QString protocolName);
+    QList<QPair<QString, QString>> getFailReasons(QString protocolName);
+    QList<T_CField> getCmdStatsFields(void);
+    QList<T_CField> getStatsFields(QString protocolName, int cmdNb);
+    void writeCFields(QList<T_CField> fields, QTextStream *pOut);
+    void declareCmdStorage(QString protocolName, QTextStream *pOut);
+    void declareStatsStorage(QString protocolName, QTextStream *pOut);
+    QString getLifoPtr(QString protocolName);
+    QString getDecodeFctSignature(QString protocolName, QStringList parentNames);
+    void declareDecodeFct_Rec(QString protocolName, QStringList parentNames, QList<Attribute *> attList, QTextStream *pOut);
+    void writeDecodeFct_Rec(QString protocolName, QStringList parentNames, QList<Attribute *> attList, QTextStream *pOut);
+    QString getEncodeSegFctSignature(QString protocolName, QStringList parentNames, bool isStream);
+    void declareEncodeSegFct_Rec(
+        QString protocolName, QStringList parentNames, QList<Attribute *> attList, Attribute *pStreamAtt, QTextStream *pOut);
+    void writeEncodeSegFct_Rec(
+        QString protocolName, QStringList parentNames, QList<Attribute *> attList, Attribute *pStreamAtt, QTextStream *pOut);
+    void getSegmentBounds_Rec(QList<Attribute *> attList, int &fieldNb, int &dataSize, int &refNb);
+    void writeBenchAtt_Rec(QString protocolName, QString parentName, QList<Attribute *> attList, QTextStream *pOut);
+    void writeBenchPayload_Rec(
+        QString protocolName, QStringList parentNames, QList<Attribute *> attList, QTextStream *pOut, int indentNb);
+    void writeBenchBuilders(QString protocolName, QList<Command *> cmdList, QTextStream *pOut);
+    void writeLoopbackCompare_Rec(
+        QString protocolName, QStringList parentNames, QList<Attribute *> attList, QTextStream *pOut, int indentNb);
+    bool writeLoopbackHeader(QString protocolName, QList<Command *> cmdList, QString dirPath);
+    void writeLoopbackStore(QString protocolName, QList<Command *> cmdList, QTextStream *pOut);
+    void writeLoopbackStream(QString protocolName, QList<Command *> cmdList, QString side, QTextStream *pOut);
+    void writeLoopbackSide(QString protocolName, QList<Command *> cmdList, QString side, QTextStream *pOut);
+    void writeLoopbackChecks(QString protocolName, QList<Command *> cmdList, QTextStream *pOut);
+    void writeLoopbackStats(QString protocolName, QList<Command *> cmdList, QTextStream *pOut);
+    void writeLoopbackMain(QString protocolName, QTextStream *pOut);
+    quint64 getSubAttShapeHash(Attribute *attribute);
+    bool isSameSubAttShape_Rec(Attribute *aAtt, Attribute *bAtt);
+    Attribute *findSubAttShape(QHash<quint64, Attribute *> *pShapes, Attribute *attribute);
+    void findSharedDescArrays(QList<Attribute::T_attInfos> attInfosList);
+    void addStructField(int &structSize, int &structAlign, int fieldSize, int fieldAlign);
+    void addCFields(
+        QList<T_CField> fields, QHash<QString, QPair<int, int>> structLayouts, int &structSize, int &structAlign);
+    void getPayloadLayout_Rec(QList<Attribute *> attList, int &structSize, int &structAlign, int &flagsSize);
+    int getDescEntryNb_Rec(QList<Attribute *> attList, QHash<quint64, Attribute *> *pDescShapes);
+    int getNestingDepth_Rec(QList<Attribute *> attList);
+    Attribute *getStreamAtt(Command *command);
+    bool hasStreamAtt(QList<Command *> cmdList);
+    QList<Command *> getStreamCmds(QList<Command *> cmdList, bool isA);
+    void writeCmdFill(QString protocolName, QString decodeCall, QString cmdName, QString pCmdName, QString pCmdPayload,
+        QString payloadSize, QTextStream *pOut);
+    void writeFrameDispatch(QString protocolName, QString decodeCall, QTextStream *pOut);
+    void writeBridgeQueue(QString protocolName, T_BridgeSection section, QTextStream *pOut);
+    void writeBridgeDecoder(
+        QString protocolName, QList<Command *> cmdList, bool isA, T_BridgeSection section, QTextStream *pOut);
+    void writeBridgeSegWriter(
+        QString protocolName, QList<Command *> cmdList, bool isA, T_BridgeSection section, QTextStream *pOut);
+    void writeBridgeSegments(
+        QString protocolName, QList<Command *> cmdList, bool isA, T_BridgeSection section, QTextStream *pOut);
+    void writeBridgeStream(
+        QString protocolName, QList<Command *> cmdList, bool isA, T_BridgeSection section, QTextStream *pOut);
+    void writeBridgeStats(QString protocolName, QList<Command *> cmdList, T_BridgeSection section, QTextStream *pOut);
+    void writeHandlerCall(QString protocolName, QString pStats, QString cmdName, QTextStream *pOut);
     QList<Attribute::T_attInfos> getAttInfos_Rec(QString parentName, QList<Attribute *> attList);
     QList<Attribute::T_attInfos> getAttInfos(QList<Command *> cmdList);
     QList<Attribute::T_attInfos> insertSortAttInfosListByParentName(QList<Attribute::T_attInfos> attInfosList);
@@ -64,13 +157,165 @@ class CodeGenerator {
         QList<Attribute::T_attInfos> attInfosList, QList<Command *> cmdList);
 
   public:
+    // Sizes on a 32 bits target
+    static const int ATT_DESC_SIZE = 16; // lcsf_attribute_desc_t
+    static const int CMD_DESC_SIZE = 8; // lcsf_command_desc_t
+    static const int VALID_ATT_SIZE = 8; // lcsf_valid_att_t
+    static const int POINTER_SIZE = 4;
+    static const int ATOMIC_INDEX_SIZE = 4; // atomic_uint_fast16_t
+    // Default slot number of the deferred command queue
+    static const int DEFAULT_QUEUE_SIZE = 4;
+
+    typedef struct _cmdFootprint {
+        QString cmdName;
+        int payloadSize;
+        int flagsSize;
+        int descSize;
+        int attNb;
+        int nestingDepth;
+    } T_CmdFootprint;
+
+    typedef struct _footprint {
+        QList<T_CmdFootprint> cmdFootprints;
+        int payloadUnionSize;
+        int descTableSize;
+        int cmdTableSize;
+        int lifoSize;
+        int maxNestingDepth;
+        int flashSize;
+        int ramSize;
+    } T_Footprint;
+
     CodeGenerator();
+
+    /**
+     * @brief      Selects the reentrant C generation, where the main and bridge modules keep their state in per
+     *             channel context structs instead of static variables
+     *
+     * @param[in]  isReentrant  True to generate reentrant modules
+     */
+    void setReentrantMode(bool isReentrant);
+
+    /**
+     * @brief      Selects the deferred C dispatch, where the bridge queues received commands in a lock-free single
+     *             producer single consumer ring and the main module executes them when polled
+     *
+     * @param[in]  isDeferred  True to generate the deferred dispatch
+     */
+    void setDeferredMode(bool isDeferred);
+
+    /**
+     * @brief      Adds a specialised decoder to the C bridge, it validates and decodes raw frames straight into the
+     *             command payload without going through LCSF_Validator
+     *
+     * @param[in]  isFastDecoder  True to generate the specialised decoder
+     */
+    void setFastDecoderMode(bool isFastDecoder);
+
+    /**
+     * @brief      Adds a scatter/gather encoder to the C bridge, it outputs the message as a segment list where byte
+     *             arrays and strings are referenced in place instead of copied
+     *
+     * @param[in]  isSegmentEncode  True to generate the segment encoder
+     */
+    void setSegmentEncodeMode(bool isSegmentEncode);
+
+    /**
+     * @brief      Adds per command instrumentation hooks to the C bridge, counting commands, bytes, failures and
+     *             decode/handler/encode cycles in a stats struct, the hooks compile out with LCSF_BRIDGE_<P>_NO_STATS
+     *
+     * @param[in]  isInstrument  True to generate the instrumentation hooks
+     */
+    void setInstrumentMode(bool isInstrument);
+
+    /**
+     * @brief      Makes sub-attributes with isomorphic subtrees (same ids, types and optionality) point to a single
+     *             descriptor array in the description file, each array then costs ATT_DESC_SIZE bytes per entry once
+     *
+     * @param[in]  isShareDesc  True to share the descriptor arrays
+     */
+    void setShareDescMode(bool isShareDesc);
     void generateMainHeader(QString protocolName, QList<Command *> cmdList, CodeExtractor codeExtract, QString dirPath);
     void generateMain(QString protocolName, QList<Command *> cmdList, CodeExtractor codeExtract, bool isA, QString dirPath);
     void generateBridgeHeader(
         QString protocolName, QString protocolId, QString protocolVersion, QList<Command *> cmdList, QString dirPath);
     void generateBridge(QString protocolName, QList<Command *> cmdList, bool isA, QString dirPath);
     void generateDescription(QString protocolName, QList<Command *> cmdList, QString dirPath);
+
+    /**
+     * @brief      Generates a host benchmark comparing the specialised decoder with the LCSF_Validator path, only
+     *             available with the default dispatch
+     *
+     * @param[in]  protocolName  The protocol name
+     * @param[in]  cmdList       The command list
+     * @param[in]  isA           True for the A side
+     * @param[in]  dirPath       The output directory
+     *
+     * @return     true if the benchmark was written
+     */
+    bool generateDecoderBench(QString protocolName, QList<Command *> cmdList, bool isA, QString dirPath);
+
+    /**
+     * @brief      Generates a host benchmark of encode/decode round trips with random payloads for each command sent
+     *             by a side and decoded by the other side's bridge, reporting messages and bytes per second, only
+     *             available with the default dispatch, both sides link through the loopback side symbols header
+     *
+     * @param[in]  protocolName  The protocol name
+     * @param[in]  cmdList       The command list
+     * @param[in]  isA           True for the A side
+     * @param[in]  dirPath       The output directory
+     *
+     * @return     true if the benchmark was written
+     */
+    bool generateThroughputBench(QString protocolName, QList<Command *> cmdList, bool isA, QString dirPath);
+
+    /**
+     * @brief      Generates a host harness checking and timing every command between the A and B bridges
+     *
+     * @param[in]  protocolName  The protocol name
+     * @param[in]  cmdList       The command list
+     * @param[in]  dirPath       The output directory, the same as the A and B bridges
+     *
+     * @return     true if the harness was written
+     */
+    bool generateLoopback(QString protocolName, QList<Command *> cmdList, QString dirPath);
+
+    /**
+     * @brief      Gets the number of sub-attribute descriptor arrays merged into a shared array by the last
+     *             description generation
+     *
+     * @return     The merged array number
+     */
+    int getSharedDescArrayNb(void);
+
+    /**
+     * @brief      Gets the number of attribute descriptor entries saved by the shared arrays of the last description
+     *             generation
+     *
+     * @return     The saved entry number
+     */
+    int getSharedDescEntryNb(void);
+
+    /**
+     * @brief      Estimates the target footprint of the generated C code: payload structs, flags bitfields, descriptor
+     *             tables, bridge LIFO and attribute nesting depth
+     *
+     * @param[in]  cmdList  The command list
+     *
+     * @return     The footprint per command and in total
+     */
+    T_Footprint getFootprint(QList<Command *> cmdList);
+
+    /**
+     * @brief      Writes a footprint report, as JSON if the file name ends with .json and as markdown otherwise
+     *
+     * @param[in]  protocolName  The protocol name
+     * @param[in]  footprint     The footprint
+     * @param[in]  filePath      The report file path
+     *
+     * @return     true if the report was written
+     */
+    bool generateFootprintReport(QString protocolName, T_Footprint footprint, QString filePath);
 };
 
 #endif // CODEGENERATOR_H
@@ -0,0 +1,67 @@
+/**
+ * \file codescanner.h
+ * \brief Source code lexical scanner module
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#ifndef CODESCANNER_H
+#define CODESCANNER_H
+
+#include <QString>
+#include <QStringRef>
+
+class CodeScanner {
+  public:
+    typedef enum {
+        LANGUAGE_C,
+        LANGUAGE_RUST,
+    } T_ScannerLanguage;
+
+  private:
+    typedef enum {
+        SCAN_CODE,
+        SCAN_LINE_COMMENT,
+        SCAN_BLOCK_COMMENT,
+        SCAN_STRING,
+        SCAN_CHAR,
+        SCAN_RAW_STRING,
+    } T_ScannerStates;
+
+    T_ScannerLanguage m_language;
+    T_ScannerStates m_state;
+    int m_bracketCounter;
+    bool m_blockBegan;
+    int m_commentDepth;
+    int m_rawHashNb;
+    bool m_lineContinued;
+
+    int scanRawStringStart(const QStringRef &line, int idx);
+    bool isRawStringEnd(const QStringRef &line, int idx);
+    int scanRustQuote(const QStringRef &line, int idx);
+
+  public:
+    CodeScanner(T_ScannerLanguage language = LANGUAGE_C);
+    void reset();
+    int scanLine(const QStringRef &line);
+    int scanLine(const QString &line);
+    int getBracketCounter() const;
+    bool getBlockBegan() const;
+    bool isInCode() const;
+};
+
+#endif // CODESCANNER_H
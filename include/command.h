@@ -22,6 +22,10 @@
 #ifndef COMMAND_H
 #define COMMAND_H
 #include "attribute.h"
+#include <QAtomicInt>
+#include <QAtomicInteger>
+#include <QHash>
+#include <QSet>
 #include <QString>
 
 class Command {
@@ -31,7 +35,13 @@ class Command {
     bool m_hasAttributes;
     NS_DirectionType::T_DirectionType m_direction;
     QList<Attribute *> m_attArray;
+    AttributeIndex m_attIndex;
     QString m_desc;
+    // Atomic so that threads reading the same tree can fill the cache concurrently
+    mutable QAtomicInteger<quint64> m_structHash;
+    mutable QAtomicInt m_isStructHashValid;
+
+    bool hasSameParams(const Command &other) const;
 
   public:
     Command(void);
@@ -70,12 +80,46 @@ class Command {
     void clearAttArray(void);
     void removeAttByName(QString attName);
     Attribute *getAttByName(QString cmdAttName);
+    Attribute *getAttById(short cmdAttId);
+
+    /**
+     * @brief      Gets the structural hash of the command and its attributes, computed lazily and invalidated by any
+     *             edit of the command tree. Equal commands have equal hashes.
+     *
+     * @return     The structural hash
+     */
+    quint64 getStructHash(void) const;
+    void invalidateStructHash(void);
 
     static Command *findCmdAddr(QString cmdName, QList<Command *> cmdList);
     static QList<Command *> sortListById(QList<Command *> cmdList);
     static int findCmdIdx(QString cmdName, QList<Command *> cmdList);
     static QStringList getListCmdNames(QList<Command *> cmdList);
+    static QHash<QString, Command *> getNameIndex(QList<Command *> cmdList);
+    static QHash<short, Command *> getIdIndex(QList<Command *> cmdList);
+
+    /**
+     * @brief      Keeps the commands of a list that are part of a subset, in list order
+     *
+     * @param[in]  cmdList       The command list
+     * @param[in]  cmdNames      The names of the subset commands
+     * @param[out] unknownNames  The subset names not found in the list
+     *
+     * @return     The subset command list
+     */
+    static QList<Command *> filterListByNames(QList<Command *> cmdList, QStringList cmdNames, QStringList &unknownNames);
     static bool compareRefCmdList(QList<Command *> a_list, QList<Command *> b_list, int &err_idx);
+
+    /**
+     * @brief      Lists the paths (command/attribute/sub-attribute) of the nodes that differ between two command lists,
+     *             subtrees with equal hashes are skipped
+     *
+     * @param[in]  a_list  The reference list
+     * @param[in]  b_list  The compared list
+     *
+     * @return     The paths of the modified, removed or added nodes
+     */
+    static QStringList diffCmdList(QList<Command *> a_list, QList<Command *> b_list);
     static int getMaxAttNb(QList<Command *> cmdList);
 
     friend bool operator==(const Command &lhs, const Command &rhs) {
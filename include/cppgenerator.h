@@ -0,0 +1,64 @@
+/**
+ * \file cppgenerator.h
+ * \brief C++ code generator module
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#ifndef CPPGENERATOR_H
+#define CPPGENERATOR_H
+
+#include "attribute.h"
+#include "command.h"
+#include "enumtype.h"
+#include <QDir>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+
+class CppGenerator {
+  private:
+    QString capitalize(const QString &str);
+    QString getPayloadName(QStringList attPath);
+    QString getConstPrefix(QStringList attPath);
+    QString getMemberType(Attribute *attribute, QStringList attPath);
+    QString getDataTypeName(NS_AttDataType::T_AttDataType dataType);
+    void declareAttIds_Rec(QStringList parentPath, QList<Attribute *> attList, QTextStream *pOut);
+    void declareAttDesc_Rec(QStringList parentPath, QList<Attribute *> attList, QTextStream *pOut);
+    void declarePayload_Rec(QStringList parentPath, QList<Attribute *> attList, QTextStream *pOut);
+    void writeDecodeFct_Rec(QStringList parentPath, QList<Attribute *> attList, QTextStream *pOut);
+    void writeEncodeFct_Rec(QStringList parentPath, QList<Attribute *> attList, QTextStream *pOut);
+
+  public:
+    CppGenerator();
+
+    /**
+     * @brief      Generates a header-only C++20 binding of a protocol, with a constexpr descriptor, payloads holding
+     *             views over the frame buffer and compile time dispatch of the received commands to a handler
+     *
+     * @param[in]  protocolName     The protocol name
+     * @param[in]  protocolId       The protocol identifier
+     * @param[in]  protocolVersion  The protocol version
+     * @param[in]  cmdList          The command list
+     * @param[in]  dirPath          The output directory
+     */
+    void generateBinding(
+        QString protocolName, QString protocolId, QString protocolVersion, QList<Command *> cmdList, QString dirPath);
+};
+
+#endif // CPPGENERATOR_H
@@ -31,5 +31,6 @@ class DescHandler {
     static void load_desc(QFile &file, QList<Command *> &cmdArray, QString &protocolName, QString &protocolId,
         QString &protocolVersion, QString &protocolDesc);
     static bool save_desc(QString filename, QList<Command *> cmdArray, QString protocolName, QString protocolId,
-        QString protocolVersion, QString protocolDesc);
+        QString protocolVersion, QString protocolDesc, bool isCompact = false);
+    static void load_subset(QFile &file, QStringList &cmdNames);
 };
\ No newline at end of file
@@ -30,20 +30,94 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QMap>
 #include <QString>
 #include <QTextStream>
 #include <QUrl>
 
 class DocGenerator {
+  public:
+    // Documentation output formats
+    typedef enum _docFormat {
+        DOC_WIKI,
+        DOC_DOKUWIKI,
+        DOC_MKDOWN,
+        DOC_HTML,
+    } T_DocFormat;
+
+    // Format neutral table row, cells are formatted once for every output format
+    typedef struct _docRow {
+        QString name;
+        QString id;
+        QString isOptional;
+        QString dataType;
+        QString desc;
+        QList<_docRow> subRows;
+    } T_DocRow;
+
+    typedef struct _docCmd {
+        QString name;
+        QString id;
+        QString direction;
+        QString desc;
+        QList<T_DocRow> attRows;
+    } T_DocCmd;
+
+    typedef struct _docTable {
+        QString parentName;
+        QList<T_DocRow> rows;
+    } T_DocTable;
+
+    typedef struct _docModel {
+        QString protocolName;
+        QString protocolId;
+        QString protocolDesc;
+        QList<T_DocCmd> commands;
+        QList<T_DocTable> subAttTables;
+    } T_DocModel;
+
   private:
-    QList<Attribute::T_attInfos> getAttInfos_Rec(QString parentName, QList<Attribute *> attList);
-    QList<Attribute::T_attInfos> getAttInfos(QList<Command *> cmdList);
-    QList<Attribute::T_attInfos> insertSortAttInfosListByParentName(QList<Attribute::T_attInfos> attInfosList);
-    QList<Attribute::T_attInfos> removeCommandAttributes(
-        QList<Attribute::T_attInfos> attInfosList, QList<Command *> cmdList);
+    QString getDocId(short id);
+    T_DocRow getDocRow_Rec(Attribute *attribute);
+    void fillSubAttTables_Rec(QString parentName, const QList<T_DocRow> &rows, QMap<QString, QList<T_DocRow>> &tables);
+    void renderWikiTable(const T_DocModel &model, QTextStream *pOut);
+    void renderDokuWikiTable(const T_DocModel &model, QTextStream *pOut);
+    void renderMkdownTable(const T_DocModel &model, QTextStream *pOut);
+    void renderHtmlHead(QString title, bool hasSearch, QTextStream *pOut);
+    void renderHtmlTree_Rec(QString parentPath, const QList<T_DocRow> &rows, QTextStream *pOut);
+    void renderHtmlIndex(const T_DocModel &model, QTextStream *pOut);
+    void renderHtmlCommand(const T_DocModel &model, const T_DocCmd &docCmd, QTextStream *pOut);
+    void renderHtmlSearchIndex(const T_DocModel &model, QTextStream *pOut);
+    void renderHtmlScript(QTextStream *pOut);
+    void renderHtmlStyle(QTextStream *pOut);
+    void writeHtmlDoc(const T_DocModel &model, QString dirPath);
+    void writeDocFile(const T_DocModel &model, T_DocFormat format, QString dirPath);
 
   public:
     DocGenerator();
+
+    /**
+     * @brief      Builds the format neutral documentation tables of a protocol, in a single pass over its commands
+     *
+     * @param[in]  protocolName  The protocol name
+     * @param[in]  protocolId    The protocol identifier
+     * @param[in]  protocolDesc  The protocol description
+     * @param[in]  cmdList       The command list
+     *
+     * @return     The documentation model
+     */
+    T_DocModel buildDocModel(QString protocolName, QString protocolId, QString protocolDesc, QList<Command *> cmdList);
+
+    /**
+     * @brief      Generates the documentation in several formats from one model, the formats are rendered in
+     *             parallel
+     *
+     * @param[in]  model    The documentation model
+     * @param[in]  formats  The output formats
+     * @param[in]  dirPath  The output directory path
+     */
+    void generateDoc(const T_DocModel &model, QList<T_DocFormat> formats, QString dirPath);
+
     void generateWikiTable(
         QString protocolName, QString protocolId, QString protocolDesc, QList<Command *> cmdList, QString dirPath);
     void generateDokuWikiTable(
@@ -0,0 +1,189 @@
+/**
+ * \file dynamiccodec.h
+ * \brief Runtime LCSF frame codec module
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#ifndef DYNAMICCODEC_H
+#define DYNAMICCODEC_H
+
+#include "command.h"
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QVector>
+
+// Encodes and decodes the frames of any loaded protocol without generating code.
+// The command tree is compiled once into flat tables: each attribute level is a contiguous node range with a dense
+// id table giving the node slot, so decoding a frame is a table lookup per attribute.
+class DynamicCodec {
+  public:
+    typedef enum {
+        CODEC_OK,
+        CODEC_ERR_NOT_COMPILED,
+        CODEC_ERR_FRAME_SIZE,
+        CODEC_ERR_PROTOCOL_ID,
+        CODEC_ERR_UNKNOWN_CMD,
+        CODEC_ERR_UNKNOWN_ATT,
+        CODEC_ERR_DUPLICATE_ATT,
+        CODEC_ERR_ATT_TYPE,
+        CODEC_ERR_DATA_SIZE,
+        CODEC_ERR_MISSING_ATT,
+        CODEC_ERR_TRAILING_BYTES,
+        CODEC_ERR_VALUE,
+        CODEC_ERR_COUNT,
+    } T_CodecError;
+
+    // Compiled attribute, the nodes of a level are contiguous in descriptor order
+    typedef struct {
+        QString name;
+        short attId;
+        NS_AttDataType::T_AttDataType dataType;
+        bool isOptional;
+        int subLevelIdx;
+    } T_Node;
+
+    // Decoded attribute, sub-attribute values are in descriptor order.
+    // Strings are held without their terminator.
+    typedef struct _value {
+        int nodeIdx;
+        bool isPresent;
+        quint64 uintValue;
+        double realValue;
+        QByteArray data;
+        QVector<struct _value> subValues;
+    } T_Value;
+
+    // Decoded command, attribute values are in descriptor order
+    typedef struct {
+        short cmdId;
+        QVector<T_Value> attValues;
+    } T_Message;
+
+  private:
+    typedef struct {
+        int firstNodeIdx;
+        int nodeNb;
+        int mandatoryNb;
+        int minAttId;
+        int idTableIdx;
+        int idTableSize;
+    } T_Level;
+
+    typedef struct {
+        QString name;
+        short cmdId;
+        int levelIdx;
+    } T_CmdEntry;
+
+    bool m_isCompiled;
+    bool m_isSmall;
+    quint16 m_protocolId;
+    QVector<T_Node> m_nodes;
+    QVector<T_Level> m_levels;
+    QVector<int> m_idTable;
+    QVector<T_CmdEntry> m_cmds;
+    QVector<int> m_cmdTable;
+    int m_minCmdId;
+
+    int compileLevel_Rec(QList<Attribute *> attList);
+    void initValues_Rec(int levelIdx, QVector<T_Value> &values) const;
+    int getFieldSize(void) const;
+    int getFieldMax(void) const;
+    int getCmplxFlag(void) const;
+    bool readField(const uchar *pFrame, int frameSize, int &frameIdx, int &value) const;
+    void writeField(QByteArray &frame, int value) const;
+    T_CodecError decodeLevel_Rec(
+        int levelIdx, int attNb, const uchar *pFrame, int frameSize, int &frameIdx, QVector<T_Value> &values) const;
+    T_CodecError decodeData(const T_Node &node, const uchar *pData, int dataSize, T_Value &value) const;
+    int getPresentNb(const QVector<T_Value> &values) const;
+    T_CodecError encodeLevel_Rec(int levelIdx, const QVector<T_Value> &values, QByteArray &frame) const;
+    T_CodecError encodeData(const T_Node &node, const T_Value &value, QByteArray &frame) const;
+    void formatLevel_Rec(int levelIdx, const QVector<T_Value> &values, QString indent, QStringList &lines) const;
+
+  public:
+    DynamicCodec(void);
+
+    /**
+     * @brief      Sets the frame field size, one byte fields (LCSF_SMALL) instead of two, to set before compiling
+     *
+     * @param[in]  isSmall  True for one byte fields
+     */
+    void setSmallFields(bool isSmall);
+    bool getSmallFields(void) const;
+
+    /**
+     * @brief      Compiles a protocol into the decode tables, replaces any previous protocol
+     *
+     * @param[in]  protocolId  The protocol identifier
+     * @param[in]  cmdList     The command list
+     *
+     * @return     false if a command or attribute identifier is duplicated or out of the field range
+     */
+    bool compile(quint16 protocolId, QList<Command *> cmdList);
+    bool isCompiled(void) const;
+    quint16 getProtocolId(void) const;
+    const T_Node &getNode(int nodeIdx) const;
+    QString getCmdName(short cmdId) const;
+
+    /**
+     * @brief      Builds a message of a command with every attribute absent, to be filled before encoding
+     *
+     * @param[in]  cmdId  The command identifier
+     * @param[out] msg    The message
+     *
+     * @return     false if the command is unknown
+     */
+    bool initMessage(short cmdId, T_Message &msg) const;
+
+    /**
+     * @brief      Decodes a frame, checks it the way the LCSF validator does. The message storage is reused between
+     *             calls.
+     *
+     * @param[in]  pFrame     Pointer to the frame
+     * @param[in]  frameSize  The frame size
+     * @param[out] msg        The decoded message
+     *
+     * @return     CODEC_OK or the reason the frame was rejected
+     */
+    T_CodecError decode(const uchar *pFrame, int frameSize, T_Message &msg) const;
+    T_CodecError decode(const QByteArray &frame, T_Message &msg) const;
+
+    /**
+     * @brief      Encodes a message, present attributes are written in descriptor order
+     *
+     * @param[in]  msg    The message
+     * @param[out] frame  The frame
+     *
+     * @return     CODEC_OK or the reason the message can't be encoded
+     */
+    T_CodecError encode(const T_Message &msg, QByteArray &frame) const;
+
+    /**
+     * @brief      Formats a decoded message as an indented attribute tree
+     *
+     * @param[in]  msg   The message
+     *
+     * @return     The message text
+     */
+    QString formatMessage(const T_Message &msg) const;
+
+    static QString getErrorString(T_CodecError error);
+};
+
+#endif // DYNAMICCODEC_H
@@ -0,0 +1,70 @@
+/**
+ * \file framecapture.h
+ * \brief Frame capture file module
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QList>
+#include <QString>
+
+// Capture files hold recorded LCSF frames, all fields are little endian like the frames themselves:
+//   header: "LCAP" magic, u16 version, u16 reserved
+//   record: u64 timestamp (us), u16 protocol id, u32 frame size, frame bytes
+class FrameCapture {
+  public:
+    typedef struct {
+        quint64 timestampUs;
+        quint16 protocolId;
+        QByteArray frame;
+    } T_Record;
+
+    static const quint16 VERSION = 1;
+    static const int HEADER_SIZE = 8;
+    static const int RECORD_HEADER_SIZE = 14;
+
+    /**
+     * @brief      Writes a capture header and its records to a device
+     *
+     * @param      pDevice  The device, open for writing
+     * @param[in]  records  The records
+     *
+     * @return     false if the device couldn't be written
+     */
+    static bool write(QIODevice *pDevice, const QList<T_Record> &records);
+
+    /**
+     * @brief      Reads a whole capture from a device
+     *
+     * @param      pDevice  The device, open for reading
+     * @param[out] records  The records
+     * @param[out] error    The reason the capture was rejected
+     *
+     * @return     false if the header is invalid or a record is truncated
+     */
+    static bool read(QIODevice *pDevice, QList<T_Record> &records, QString &error);
+
+    static bool save(QString filename, const QList<T_Record> &records);
+    static bool load(QString filename, QList<T_Record> &records, QString &error);
+};
+
+#endif // FRAMECAPTURE_H
@@ -0,0 +1,86 @@
+/**
+ * \file framereplay.h
+ * \brief Capture replay benchmark module
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#ifndef FRAMEREPLAY_H
+#define FRAMEREPLAY_H
+
+#include "command.h"
+#include "framecapture.h"
+#include <QList>
+#include <QString>
+#include <functional>
+
+// Feeds captured frames through a decoder, times the passes for throughput and each decode for latencies
+class FrameReplay {
+  public:
+    // Decodes a frame, returns its command identifier or -1 if the decoder rejected it
+    typedef std::function<int(const uchar *pFrame, int frameSize)> T_DecodeFn;
+
+    typedef struct {
+        int cmdId;
+        int frameNb;
+        qint64 byteNb;
+        qint64 totalNs;
+        qint64 p50Ns;
+        qint64 p90Ns;
+        qint64 p99Ns;
+        qint64 maxNs;
+    } T_CmdStats;
+
+    typedef struct {
+        int passNb;
+        int recordNb;
+        int skippedNb;
+        int rejectedNb;
+        quint64 spanUs;
+        qint64 wallNs;
+        qint64 timerOverheadNs;
+        T_CmdStats total;
+        QList<T_CmdStats> cmdStats;
+    } T_Report;
+
+    /**
+     * @brief      Replays the records of a protocol, the other protocols are skipped
+     *
+     *             The passes run twice: timed as a whole for the throughput (wallNs), then timed per frame for the
+     *             latencies, minus the calibrated cost of timing a frame (timerOverheadNs).
+     *
+     * @param[in]  records     The capture records
+     * @param[in]  protocolId  The protocol identifier
+     * @param[in]  passNb      The number of passes over the capture
+     * @param[in]  decodeFn    The decoder
+     *
+     * @return     The report, commands sorted by identifier
+     */
+    static T_Report run(const QList<FrameCapture::T_Record> &records, quint16 protocolId, int passNb, T_DecodeFn decodeFn);
+
+    /**
+     * @brief      Formats a report as a per command latency table followed by the throughput
+     *
+     * @param[in]  report   The report
+     * @param[in]  cmdList  The command list, used to name the commands
+     *
+     * @return     The report text
+     */
+    static QString formatReport(const T_Report &report, const QList<Command *> &cmdList);
+};
+
+#endif // FRAMEREPLAY_H
@@ -0,0 +1,79 @@
+/**
+ * \file profiler.h
+ * \brief Generation profiler module
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <QList>
+#include <QMap>
+#include <QString>
+
+// Time the enclosing scope, does nothing while the profiler is disabled
+#define LCSF_PROFILE_SCOPE(name, category) ProfileScope profileScope(name, category)
+
+class Profiler {
+  public:
+    typedef struct {
+        QString name;
+        QString category;
+        qint64 startUs;
+        qint64 durationUs;
+        int threadId;
+        qint64 allocCount;
+        qint64 allocBytes;
+    } T_ProfileEvent;
+
+    static void setEnabled(bool isEnabled);
+    static bool isEnabled();
+    static void reset();
+
+    static qint64 getTimestampUs();
+    static int getThreadId();
+    static void recordEvent(T_ProfileEvent event);
+    static void addCounter(QString name, qint64 value);
+
+    // Allocation hooks, fed by the application allocator if it has one, allocations that bypass it
+    // (e.g. malloc calls inside Qt) aren't seen so the counts are partial
+    static void recordAllocation(size_t size);
+    static qint64 getThreadAllocCount();
+    static qint64 getThreadAllocBytes();
+
+    static QList<T_ProfileEvent> getEvents();
+    static QMap<QString, qint64> getCounters();
+    static QString getReportTable();
+    static bool writeChromeTrace(QString filename);
+};
+
+class ProfileScope {
+  private:
+    const char *m_name;
+    const char *m_category;
+    bool m_isActive;
+    qint64 m_startUs;
+    qint64 m_startAllocCount;
+    qint64 m_startAllocBytes;
+
+  public:
+    ProfileScope(const char *name, const char *category);
+    ~ProfileScope();
+};
+
+#endif // PROFILER_H
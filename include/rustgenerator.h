@@ -37,6 +37,10 @@
 class RustGenerator {
   private:
     bool protocolHasSubAtt;
+    bool segmentEncodeMode;
+    bool handlerTraitMode;
+    bool instrumentMode;
+    bool staticDescMode;
 
     bool is_CString_needed(QList<Attribute::T_attInfos> attInfosList);
     QString capitalize(const QString &str);
@@ -54,12 +58,62 @@ class RustGenerator {
     void fillSubAttData_Rec(QStringList parentNames, QList<Attribute *> attList, QTextStream *pOut, int indentNb);
     QString getAttDescString(bool isOptional, NS_AttDataType::T_AttDataType data_type);
     void printAttDesc_Rec(QString parentName, QList<Attribute *> attList, QTextStream *pOut, int indentNb);
+    QString getSegAttNbString(QStringList parentNames, QList<Attribute *> attList);
+    void fillSegments_Rec(
+        QString parentName, QStringList parentNames, QList<Attribute *> attList, QTextStream *pOut, int indentNb);
+    void printBenchStruct_Rec(QString parentName, QList<Attribute *> attList, QTextStream *pOut, int indentNb);
+    void printHandlerTrait(QString protSuffix, QList<Command *> cmdList, bool isA, QTextStream *pOut);
+    void printStats(int cmdNb, QTextStream *pOut);
 
   public:
     RustGenerator();
+
+    /**
+     * @brief      Adds a scatter/gather encoder to the Rust bridge, it outputs the message as a segment list where
+     *             byte arrays and strings are borrowed from the payload instead of copied
+     *
+     * @param[in]  isSegmentEncode  True to generate the segment encoder
+     */
+    void setSegmentEncodeMode(bool isSegmentEncode);
+
+    /**
+     * @brief      Replaces the execute functions of the Rust main file by a Handler trait with one method per received
+     *             command, a generic dispatch and an init_core registering a handler type to LcsfCore, user code
+     *             then lives in its own files and isn't extracted
+     *
+     * @param[in]  isHandlerTrait  True to generate the handler trait
+     */
+    void setHandlerTraitMode(bool isHandlerTrait);
+
+    /**
+     * @brief      Adds per command instrumentation to the Rust bridge behind the lcsf_stats cargo feature, counting
+     *             commands, bytes, failures and decode/handler/encode times in a stats module
+     *
+     * @param[in]  isInstrument  True to generate the instrumentation
+     */
+    void setInstrumentMode(bool isInstrument);
+
+    /**
+     * @brief      Emits the Rust protocol descriptor as a plain static of &'static slices instead of vectors built by
+     *             lazy_static, it needs the LCSF Rust stack descriptor arrays to be slices
+     *
+     * @param[in]  isStaticDesc  True to generate the static descriptor
+     */
+    void setStaticDescMode(bool isStaticDesc);
     void generateMain(QString protocolName, QList<Command *> cmdList, bool isA, QString dirPath, RustExtractor rustExtract = RustExtractor());
     void generateBridge(QString protocolName, QString protocolId, QString protocolVersion, QList<Command *> cmdList,
         bool isA, QString dirPath);
+
+    /**
+     * @brief      Generates a benchmark of round trips through lcsf_core with random payloads for each command sent
+     *             by a side, decoded with the other side's protocol, reporting messages and bytes per second
+     *
+     * @param[in]  protocolName  The protocol name
+     * @param[in]  cmdList       The command list
+     * @param[in]  isA           True for the A side
+     * @param[in]  dirPath       The output directory
+     */
+    void generateBench(QString protocolName, QList<Command *> cmdList, bool isA, QString dirPath);
 };
 
 #endif // RUSTGENERATOR_H
@@ -22,19 +22,30 @@
 // Qt include
 #include <QCommandLineParser>
 #include <QCoreApplication>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QFileInfo>
+#include <QFuture>
 #include <QList>
 #include <QSet>
 #include <QTextStream>
+#include <QtConcurrent>
+#include <cstdlib>
+#include <new>
 
 // Custom include
 #include "attribute.h"
 #include "codeextractor.h"
 #include "codegenerator.h"
 #include "command.h"
+#include "cppgenerator.h"
 #include "deschandler.h"
 #include "docgenerator.h"
+#include "dynamiccodec.h"
 #include "enumtype.h"
+#include "framecapture.h"
+#include "framereplay.h"
+#include "profiler.h"
 #include "rustextractor.h"
 #include "rustgenerator.h"
 
@@ -44,6 +55,7 @@ static QString protocolId;
 static QString protocolVersion;
 static QString protocolDesc;
 static QList<Command *> cmdArray;
+static QList<Command *> codeCmdArray;
 static const QString defCOutPath = "./COutput";
 static QString cOutPathA = defCOutPath;
 static QString cOutPathB = defCOutPath;
@@ -55,11 +67,50 @@ static QString docPath = "./Export";
 static DocGenerator docgen;
 static CodeGenerator codegen;
 static RustGenerator rustgen;
+static CppGenerator cppgen;
 static CodeExtractor codeextractA;
 static CodeExtractor codeextractB;
 static RustExtractor rustextractA;
 static RustExtractor rustextractB;
 
+// Import files
+typedef enum {
+    IMPORT_C_A,
+    IMPORT_C_B,
+    IMPORT_RUST_A,
+    IMPORT_RUST_B,
+    IMPORT_NB,
+} T_ImportIdx;
+
+typedef struct {
+    QString optionName;
+    QString label;
+    QString filePath;
+    QString content;
+    QString error;
+    qint64 readTime;
+    qint64 extractTime;
+    bool isExtracted;
+} T_ImportJob;
+
+// Count allocations for the profiler
+void *operator new(std::size_t size) {
+    Profiler::recordAllocation(size);
+    void *ptr = std::malloc((size > 0) ? size : 1);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
 // Private functions
 static QString checkAttNameDuplicate_Rec(QSet<QString> *pSet, QList<Attribute *> attArray) {
     // Parse the attribute table
@@ -86,6 +137,7 @@ static QString checkAttNameDuplicate_Rec(QSet<QString> *pSet, QList<Attribute *>
 }
 
 static QString checkAttNameDuplicate(QList<Command *> cmdList) {
+    LCSF_PROFILE_SCOPE("checkAttNameDuplicate", "validate");
     QSet<QString> set;
     // Parse the command table for attributes
     for (Command *pCmd : cmdList) {
@@ -99,6 +151,63 @@ static QString checkAttNameDuplicate(QList<Command *> cmdList) {
     return "";
 }
 
+static bool readImportFile(T_ImportJob *pJob) {
+    LCSF_PROFILE_SCOPE("readImportFile", "io");
+    QElapsedTimer timer;
+    timer.start();
+    QFile importFile(pJob->filePath);
+
+    if (!importFile.open(QIODevice::ReadOnly)) {
+        pJob->error = importFile.errorString();
+        return false;
+    }
+    QTextStream importStream(&importFile);
+    pJob->content = importStream.readAll();
+    importFile.close();
+    pJob->readTime = timer.elapsed();
+    return true;
+}
+
+// The import jobs live on the main stack, wait for the workers before leaving main
+static void waitImports(QList<QFuture<bool>> &futures) {
+    for (QFuture<bool> &future : futures) {
+        future.waitForFinished();
+    }
+}
+
+template <typename T_Extractor> static bool extractImport(T_ImportJob *pJob, T_Extractor *pExtractor) {
+    QElapsedTimer timer;
+    timer.start();
+    QTextStream importStream(&pJob->content);
+
+    pJob->isExtracted = pExtractor->extractFromSourceFile(protocolName, &importStream, codeCmdArray);
+    pJob->extractTime = timer.elapsed();
+    return pJob->isExtracted;
+}
+
+static int runReplay(QTextStream &out, QString capturePath, int passNb, bool isSmall) {
+    QList<FrameCapture::T_Record> records;
+    DynamicCodec codec;
+    DynamicCodec::T_Message msg;
+    QString error;
+
+    if (!FrameCapture::load(capturePath, records, error)) {
+        out << "Couldn't load capture: " << capturePath << ", reason: " << error << Qt::endl;
+        return EXIT_FAILURE;
+    }
+    codec.setSmallFields(isSmall);
+    if (!codec.compile(protocolId.toUShort(nullptr, 16), cmdArray)) {
+        out << "Error, couldn't compile the protocol decode tables." << Qt::endl;
+        return EXIT_FAILURE;
+    }
+    auto decodeFn = [&codec, &msg](const uchar *pFrame, int frameSize) {
+        return (codec.decode(pFrame, frameSize, msg) == DynamicCodec::CODEC_OK) ? msg.cmdId : -1;
+    };
+    FrameReplay::T_Report report = FrameReplay::run(records, codec.getProtocolId(), passNb, decodeFn);
+    out << FrameReplay::formatReport(report, cmdArray);
+    return (report.total.frameNb > 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 // Main function
 int main(int argc, char *argv[]) {
     QCoreApplication a(argc, argv);
@@ -110,6 +219,9 @@ int main(int argc, char *argv[]) {
     parser.setApplicationDescription("CLI variant of LCSF_Generator");
     parser.addHelpOption();
     parser.addVersionOption();
+    parser.addPositionalArgument("mode",
+        QCoreApplication::translate("main", "generate (default), or replay a capture through the dynamic decoder"),
+        "[generate|replay]");
 
     // Add specific options
 
@@ -122,6 +234,10 @@ int main(int argc, char *argv[]) {
         QStringList() << "d" << "doc", QCoreApplication::translate("main", "Activate doc generation"));
     parser.addOption(docGenOption);
 
+    QCommandLineOption docHtmlOption(QStringList() << "doc-html",
+        QCoreApplication::translate("main", "Add the searchable html page to the generated doc"));
+    parser.addOption(docHtmlOption);
+
     QCommandLineOption importAOption(QStringList() << "a" << "import-a",
         QCoreApplication::translate("main", "Import specific protocol C code, A point of view"),
         QCoreApplication::translate("main", "path/to/file"));
@@ -142,6 +258,85 @@ int main(int argc, char *argv[]) {
         QCoreApplication::translate("main", "path/to/file"));
     parser.addOption(importRustBOption);
 
+    QCommandLineOption profileOption(QStringList() << "p" << "profile",
+        QCoreApplication::translate("main", "Print a generation profile and save it as a Chrome trace file"),
+        QCoreApplication::translate("main", "path/to/trace.json"));
+    parser.addOption(profileOption);
+
+    QCommandLineOption subsetOption(QStringList() << "s" << "subset",
+        QCoreApplication::translate("main", "Only generate code for the commands listed in a subset profile file"),
+        QCoreApplication::translate("main", "path/to/file"));
+    parser.addOption(subsetOption);
+
+    QCommandLineOption footprintOption(QStringList() << "f" << "footprint",
+        QCoreApplication::translate("main", "Save a C footprint report, as JSON for a .json file or as markdown"),
+        QCoreApplication::translate("main", "path/to/report"));
+    parser.addOption(footprintOption);
+
+    QCommandLineOption budgetOption(QStringList() << "budget",
+        QCoreApplication::translate("main", "Fail if the C footprint exceeds a flash and optional RAM budget in bytes"),
+        QCoreApplication::translate("main", "flash[:ram]"));
+    parser.addOption(budgetOption);
+
+    QCommandLineOption reentrantOption(QStringList() << "r" << "reentrant",
+        QCoreApplication::translate("main", "Generate reentrant C modules with one context struct per channel"));
+    parser.addOption(reentrantOption);
+
+    QCommandLineOption deferredOption(QStringList() << "deferred",
+        QCoreApplication::translate("main", "Queue received C commands and execute them from <Prot>_MainPoll"));
+    parser.addOption(deferredOption);
+
+    QCommandLineOption fastDecoderOption(QStringList() << "fast-decoder",
+        QCoreApplication::translate("main", "Add a specialised C frame decoder, --emit-bench benchmarks it"));
+    parser.addOption(fastDecoderOption);
+
+    QCommandLineOption segmentEncodeOption(QStringList() << "segment-encode",
+        QCoreApplication::translate("main", "Add a scatter/gather encoder that sends byte arrays and strings in place"));
+    parser.addOption(segmentEncodeOption);
+
+    QCommandLineOption handlerTraitOption(QStringList() << "handler-trait",
+        QCoreApplication::translate("main", "Generate a Rust Handler trait with static dispatch instead of execute functions"));
+    parser.addOption(handlerTraitOption);
+
+    QCommandLineOption instrumentOption(QStringList() << "instrument",
+        QCoreApplication::translate("main", "Add per command counters and timings to the C and Rust bridges"));
+    parser.addOption(instrumentOption);
+
+    QCommandLineOption staticDescOption(QStringList() << "static-desc",
+        QCoreApplication::translate("main", "Emit the Rust protocol descriptor as static slices instead of vectors"));
+    parser.addOption(staticDescOption);
+
+    QCommandLineOption shareDescOption(QStringList() << "share-desc",
+        QCoreApplication::translate("main", "Share the C descriptor arrays of isomorphic sub-attribute subtrees"));
+    parser.addOption(shareDescOption);
+
+    QCommandLineOption emitBenchOption(QStringList() << "emit-bench",
+        QCoreApplication::translate("main", "Generate encode/decode throughput benchmarks for the C and Rust code"));
+    parser.addOption(emitBenchOption);
+
+    QCommandLineOption emitLoopbackOption(QStringList() << "emit-loopback",
+        QCoreApplication::translate("main", "Generate a C harness checking the A and B bridges against each other"));
+    parser.addOption(emitLoopbackOption);
+
+    QCommandLineOption cppOption(QStringList() << "cpp",
+        QCoreApplication::translate("main", "Generate a header-only C++ binding in a directory"),
+        QCoreApplication::translate("main", "path/to/dir"));
+    parser.addOption(cppOption);
+
+    QCommandLineOption captureOption(QStringList() << "capture",
+        QCoreApplication::translate("main", "Capture file to replay, in replay mode"),
+        QCoreApplication::translate("main", "path/to/capture"));
+    parser.addOption(captureOption);
+
+    QCommandLineOption passesOption(QStringList() << "passes",
+        QCoreApplication::translate("main", "Number of passes over the capture, in replay mode"),
+        QCoreApplication::translate("main", "number"), "1");
+    parser.addOption(passesOption);
+
+    QCommandLineOption smallFieldsOption(QStringList() << "small-fields",
+        QCoreApplication::translate("main", "Replay frames with one byte fields (LCSF_SMALL)"));
+    parser.addOption(smallFieldsOption);
+
     // Parse arguments
     parser.process(a);
 
@@ -151,6 +346,13 @@ int main(int argc, char *argv[]) {
     QString importBFilePath = parser.value(importBOption);
     QString importRustAFilePath = parser.value(importRustAOption);
     QString importRustBFilePath = parser.value(importRustBOption);
+    QString profileFilePath = parser.value(profileOption);
+    QString subsetFilePath = parser.value(subsetOption);
+    QString footprintFilePath = parser.value(footprintOption);
+    QStringList budgetValues = parser.value(budgetOption).split(":");
+    QString cppOutPath = parser.value(cppOption);
+    QStringList positionalArgs = parser.positionalArguments();
+    bool isReplayMode = !positionalArgs.isEmpty() && (positionalArgs.at(0) == "replay");
 
     // Process args
     QTextStream out(stdout);
@@ -160,136 +362,277 @@ int main(int argc, char *argv[]) {
         out << "Error, missing protocol description file. Use -h for help." << Qt::endl;
         exit(EXIT_FAILURE);
     }
+    if ((positionalArgs.size() > 1) ||
+        (!positionalArgs.isEmpty() && !isReplayMode && (positionalArgs.at(0) != "generate"))) {
+        out << "Error, unknown mode: " << positionalArgs.join(" ") << ". Use -h for help." << Qt::endl;
+        exit(EXIT_FAILURE);
+    }
+    int passNb = parser.value(passesOption).toInt();
+    if (isReplayMode && (!parser.isSet("capture") || (passNb <= 0))) {
+        out << "Error, replay needs a capture file and a positive number of passes. Use -h for help." << Qt::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (parser.isSet("p")) {
+        Profiler::setEnabled(true);
+    }
+    int flashBudget = -1;
+    int ramBudget = -1;
+    if (parser.isSet("budget")) {
+        bool isFlashOk = false;
+        bool isRamOk = true;
+        flashBudget = budgetValues.at(0).toInt(&isFlashOk);
+        if (budgetValues.size() > 1) {
+            ramBudget = budgetValues.at(1).toInt(&isRamOk);
+        }
+        if (!isFlashOk || !isRamOk || (budgetValues.size() > 2)) {
+            out << "Error, invalid budget: " << parser.value(budgetOption) << ". Use -h for help." << Qt::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+    // Read import files in the background while the description is loaded
+    T_ImportJob importJobs[IMPORT_NB] = {
+        {"a", "Import A", importAFilePath, QString(), QString(), 0, 0, false},
+        {"b", "Import B", importBFilePath, QString(), QString(), 0, 0, false},
+        {"ra", "Rust import A", importRustAFilePath, QString(), QString(), 0, 0, false},
+        {"rb", "Rust import B", importRustBFilePath, QString(), QString(), 0, 0, false},
+    };
+    QList<QFuture<bool>> importFutures;
+
+    for (T_ImportJob &job : importJobs) {
+        if (parser.isSet(job.optionName)) {
+            T_ImportJob *pJob = &job;
+            importFutures.append(QtConcurrent::run([pJob]() { return readImportFile(pJob); }));
+        }
+    }
     // Get description file
+    QElapsedTimer loadTimer;
+    loadTimer.start();
     QFile descFile(descFilePath);
 
     if (!descFile.open(QIODevice::ReadOnly)) {
         out << "Couldn't open file: " << descFilePath << ", reason: " << descFile.errorString() << Qt::endl;
+        waitImports(importFutures);
         exit(EXIT_FAILURE);
     }
     // Process description file
     DescHandler::load_desc(descFile, cmdArray, protocolName, protocolId, protocolVersion, protocolDesc);
     descFile.close();
-
-    // Check import
-    if (parser.isSet("a")) {
-        // Get import A data
-        QFile importAFile(importAFilePath);
-
-        if (!importAFile.open(QIODevice::ReadOnly)) {
-            out << "Error, couldn't open file: " << importAFilePath << ", reason: " << importAFile.errorString() << Qt::endl;
+    out << "Description loaded (" << loadTimer.elapsed() << " ms)." << Qt::endl;
+
+    // Restrict generated code to a command subset (if needed)
+    codeCmdArray = cmdArray;
+    if (parser.isSet("s")) {
+        QFile subsetFile(subsetFilePath);
+        QStringList subsetNames;
+        QStringList unknownNames;
+
+        if (!subsetFile.open(QIODevice::ReadOnly)) {
+            out << "Couldn't open file: " << subsetFilePath << ", reason: " << subsetFile.errorString() << Qt::endl;
+            waitImports(importFutures);
             exit(EXIT_FAILURE);
         }
-        QTextStream importAStream(&importAFile);
-        if (!codeextractA.extractFromSourceFile(protocolName, &importAStream, cmdArray)) {
-            out << "Error while extracting import A info." << Qt::endl;
+        DescHandler::load_subset(subsetFile, subsetNames);
+        subsetFile.close();
+        codeCmdArray = Command::filterListByNames(cmdArray, subsetNames, unknownNames);
+        if (!unknownNames.isEmpty()) {
+            out << "Error, unknown subset commands: " << unknownNames.join(", ") << Qt::endl;
+            waitImports(importFutures);
             exit(EXIT_FAILURE);
         }
-        QFileInfo importAInfo(importAFile);
-        cOutPathA = importAInfo.absoluteDir().absolutePath();
-        if (cOutPathB == defCOutPath) {
-            cOutPathB = cOutPathA;
-        }
-        out << "Import A extraction successful." << Qt::endl;
+        out << "Subset profile loaded: " << codeCmdArray.size() << "/" << cmdArray.size() << " commands." << Qt::endl;
     }
-    if (parser.isSet("b")) {
-        // Get import A data
-        QFile importBFile(importBFilePath);
 
-        if (!importBFile.open(QIODevice::ReadOnly)) {
-            out << "Couldn't open file: " << importBFilePath << ", reason: " << importBFile.errorString() << Qt::endl;
+    // Wait for import files
+    QElapsedTimer importTimer;
+    importTimer.start();
+    waitImports(importFutures);
+    for (T_ImportJob &job : importJobs) {
+        if (parser.isSet(job.optionName) && !job.error.isEmpty()) {
+            out << "Error, couldn't open file: " << job.filePath << ", reason: " << job.error << Qt::endl;
             exit(EXIT_FAILURE);
         }
-        QTextStream importBStream(&importBFile);
-        if (!codeextractB.extractFromSourceFile(protocolName, &importBStream, cmdArray)) {
-            out << "Error while extracting import B info." << Qt::endl;
-            exit(EXIT_FAILURE);
+    }
+    // Extractions are independent, run them concurrently
+    QList<QFuture<bool>> extractFutures;
+    for (int idx = 0; idx < IMPORT_NB; idx++) {
+        T_ImportJob *pJob = &importJobs[idx];
+
+        if (!parser.isSet(pJob->optionName)) {
+            continue;
         }
-        QFileInfo importBInfo(importBFile);
-        cOutPathB = importBInfo.absoluteDir().absolutePath();
-        if (cOutPathA == defCOutPath) {
-            cOutPathA = cOutPathB;
+        switch (idx) {
+            case IMPORT_C_A:
+                extractFutures.append(QtConcurrent::run([pJob]() { return extractImport(pJob, &codeextractA); }));
+                break;
+
+            case IMPORT_C_B:
+                extractFutures.append(QtConcurrent::run([pJob]() { return extractImport(pJob, &codeextractB); }));
+                break;
+
+            case IMPORT_RUST_A:
+                extractFutures.append(QtConcurrent::run([pJob]() { return extractImport(pJob, &rustextractA); }));
+                break;
+
+            case IMPORT_RUST_B:
+                extractFutures.append(QtConcurrent::run([pJob]() { return extractImport(pJob, &rustextractB); }));
+                break;
         }
-        out << "Import B extraction successful." << Qt::endl;
     }
-    if (parser.isSet("ra")) {
-        QFile importRustAFile(importRustAFilePath);
-
-        if (!importRustAFile.open(QIODevice::ReadOnly)) {
-            out << "Error, couldn't open file: " << importRustAFilePath << ", reason: " << importRustAFile.errorString()
-                << Qt::endl;
-            exit(EXIT_FAILURE);
+    waitImports(extractFutures);
+    // Report in a fixed order
+    for (T_ImportJob &job : importJobs) {
+        if (!parser.isSet(job.optionName)) {
+            continue;
         }
-        QTextStream importRustAStream(&importRustAFile);
-        if (!rustextractA.extractFromSourceFile(protocolName, &importRustAStream, cmdArray)) {
-            out << "Error while extracting Rust import A info." << Qt::endl;
+        if (!job.isExtracted) {
+            out << "Error while extracting " << job.label << " info." << Qt::endl;
             exit(EXIT_FAILURE);
         }
-        QFileInfo importRustAInfo(importRustAFile);
-        rustOutPathA = importRustAInfo.absoluteDir().absolutePath();
-        if (rustOutPathB == defRustOutPath) {
-            rustOutPathB = rustOutPathA;
+        out << job.label << " extraction successful (read " << job.readTime << " ms, extract " << job.extractTime
+            << " ms)." << Qt::endl;
+    }
+    if (!importFutures.isEmpty()) {
+        out << "Imports extracted in " << importTimer.elapsed() << " ms." << Qt::endl;
+    }
+    // Output paths follow the imported files
+    if (parser.isSet("a")) {
+        cOutPathA = QFileInfo(importAFilePath).absoluteDir().absolutePath();
+        if (!parser.isSet("b")) {
+            cOutPathB = cOutPathA;
         }
-        out << "Rust import A extraction successful." << Qt::endl;
     }
-    if (parser.isSet("rb")) {
-        QFile importRustBFile(importRustBFilePath);
-
-        if (!importRustBFile.open(QIODevice::ReadOnly)) {
-            out << "Error, couldn't open file: " << importRustBFilePath << ", reason: " << importRustBFile.errorString()
-                << Qt::endl;
-            exit(EXIT_FAILURE);
+    if (parser.isSet("b")) {
+        cOutPathB = QFileInfo(importBFilePath).absoluteDir().absolutePath();
+        if (!parser.isSet("a")) {
+            cOutPathA = cOutPathB;
         }
-        QTextStream importRustBStream(&importRustBFile);
-        if (!rustextractB.extractFromSourceFile(protocolName, &importRustBStream, cmdArray)) {
-            out << "Error while extracting Rust import B info." << Qt::endl;
-            exit(EXIT_FAILURE);
+    }
+    if (parser.isSet("ra")) {
+        rustOutPathA = QFileInfo(importRustAFilePath).absoluteDir().absolutePath();
+        if (!parser.isSet("rb")) {
+            rustOutPathB = rustOutPathA;
         }
-        QFileInfo importRustBInfo(importRustBFile);
-        rustOutPathB = importRustBInfo.absoluteDir().absolutePath();
-        if (rustOutPathA == defRustOutPath) {
+    }
+    if (parser.isSet("rb")) {
+        rustOutPathB = QFileInfo(importRustBFilePath).absoluteDir().absolutePath();
+        if (!parser.isSet("ra")) {
             rustOutPathA = rustOutPathB;
         }
-        out << "Rust import B extraction successful." << Qt::endl;
     }
     // Check data
     if (cmdArray.size() <= 0) {
         out << "Error, protocol has no command!" << Qt::endl;
         exit(EXIT_FAILURE);
     }
+    if (codeCmdArray.size() <= 0) {
+        out << "Error, subset profile has no command!" << Qt::endl;
+        exit(EXIT_FAILURE);
+    }
     QString dupName = checkAttNameDuplicate(cmdArray);
     if (dupName.size() > 0) {
         out << "Error, duplicate complex attribute name: '" + dupName + "'." << Qt::endl;
         exit(EXIT_FAILURE);
     }
+    // Replay a capture instead of generating (if needed)
+    if (isReplayMode) {
+        exit(runReplay(out, parser.value(captureOption), passNb, parser.isSet("small-fields")));
+    }
+    if (parser.isSet("r")) {
+        codegen.setReentrantMode(true);
+    }
+    if (parser.isSet("deferred")) {
+        codegen.setDeferredMode(true);
+    }
+    if (parser.isSet("fast-decoder")) {
+        codegen.setFastDecoderMode(true);
+    }
+    if (parser.isSet("segment-encode")) {
+        codegen.setSegmentEncodeMode(true);
+        rustgen.setSegmentEncodeMode(true);
+    }
+    if (parser.isSet("handler-trait")) {
+        rustgen.setHandlerTraitMode(true);
+    }
+    if (parser.isSet("instrument")) {
+        codegen.setInstrumentMode(true);
+        rustgen.setInstrumentMode(true);
+    }
+    if (parser.isSet("static-desc")) {
+        rustgen.setStaticDescMode(true);
+    }
+    if (parser.isSet("share-desc")) {
+        codegen.setShareDescMode(true);
+    }
+    // Footprint report and budget check (if needed), before any file is written
+    if (parser.isSet("f") || parser.isSet("budget")) {
+        CodeGenerator::T_Footprint footprint = codegen.getFootprint(codeCmdArray);
+        out << "Estimated C footprint: " << footprint.flashSize << " bytes of flash tables, " << footprint.ramSize
+            << " bytes of RAM, nesting depth " << footprint.maxNestingDepth << "." << Qt::endl;
+        if (parser.isSet("f")) {
+            if (!codegen.generateFootprintReport(protocolName, footprint, footprintFilePath)) {
+                out << "Error, couldn't save footprint report: " << footprintFilePath << Qt::endl;
+                exit(EXIT_FAILURE);
+            }
+            out << "Footprint report saved in: " << footprintFilePath << Qt::endl;
+        }
+        if ((flashBudget >= 0) && (footprint.flashSize > flashBudget)) {
+            out << "Error, flash budget exceeded: " << footprint.flashSize << " > " << flashBudget << " bytes." << Qt::endl;
+            exit(EXIT_FAILURE);
+        }
+        if ((ramBudget >= 0) && (footprint.ramSize > ramBudget)) {
+            out << "Error, RAM budget exceeded: " << footprint.ramSize << " > " << ramBudget << " bytes." << Qt::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
     // Generate "A" C files
-    codegen.generateMainHeader(protocolName, cmdArray, codeextractA, cOutPathA);
-    codegen.generateMain(protocolName, cmdArray, codeextractA, true, cOutPathA);
-    codegen.generateBridgeHeader(protocolName, protocolId, protocolVersion, cmdArray, cOutPathA);
-    codegen.generateBridge(protocolName, cmdArray, true, cOutPathA);
-    codegen.generateDescription(protocolName, cmdArray, cOutPathA);
+    codegen.generateMainHeader(protocolName, codeCmdArray, codeextractA, cOutPathA);
+    codegen.generateMain(protocolName, codeCmdArray, codeextractA, true, cOutPathA);
+    codegen.generateBridgeHeader(protocolName, protocolId, protocolVersion, codeCmdArray, cOutPathA);
+    codegen.generateBridge(protocolName, codeCmdArray, true, cOutPathA);
+    codegen.generateDescription(protocolName, codeCmdArray, cOutPathA);
 
-    rustgen.generateMain(protocolName, cmdArray, true, rustOutPathA, rustextractA);
-    rustgen.generateBridge(protocolName, protocolId, protocolVersion, cmdArray, true, rustOutPathA);
+    rustgen.generateMain(protocolName, codeCmdArray, true, rustOutPathA, rustextractA);
+    rustgen.generateBridge(protocolName, protocolId, protocolVersion, codeCmdArray, true, rustOutPathA);
 
     // Generate "B" C files
     if (codeextractB.getExtractionComplete() || !codeextractA.getExtractionComplete()) {
         // Avoid a non imported side to clobber the commonly generated Main header
-        codegen.generateMainHeader(protocolName, cmdArray, codeextractB, cOutPathB);
+        codegen.generateMainHeader(protocolName, codeCmdArray, codeextractB, cOutPathB);
+    }
+    codegen.generateMain(protocolName, codeCmdArray, codeextractB, false, cOutPathB);
+    codegen.generateBridgeHeader(protocolName, protocolId, protocolVersion, codeCmdArray, cOutPathB);
+    codegen.generateBridge(protocolName, codeCmdArray, false, cOutPathB);
+    codegen.generateDescription(protocolName, codeCmdArray, cOutPathB);
+
+    rustgen.generateMain(protocolName, codeCmdArray, false, rustOutPathB, rustextractB);
+    rustgen.generateBridge(protocolName, protocolId, protocolVersion, codeCmdArray, false, rustOutPathB);
+
+    // Generate throughput and fast decoder benchmarks (if needed)
+    if (parser.isSet("emit-bench")) {
+        codegen.generateThroughputBench(protocolName, codeCmdArray, true, cOutPathA);
+        codegen.generateThroughputBench(protocolName, codeCmdArray, false, cOutPathB);
+        codegen.generateDecoderBench(protocolName, codeCmdArray, true, cOutPathA);
+        codegen.generateDecoderBench(protocolName, codeCmdArray, false, cOutPathB);
+        rustgen.generateBench(protocolName, codeCmdArray, true, rustOutPathA);
+        rustgen.generateBench(protocolName, codeCmdArray, false, rustOutPathB);
+    }
+    // Generate loopback harness (if needed)
+    if (parser.isSet("emit-loopback")) {
+        codegen.generateLoopback(protocolName, codeCmdArray, cOutPathA);
+    }
+    // Generate C++ binding (if needed)
+    if (parser.isSet("cpp")) {
+        cppgen.generateBinding(protocolName, protocolId, protocolVersion, codeCmdArray, cppOutPath);
     }
-    codegen.generateMain(protocolName, cmdArray, codeextractB, false, cOutPathB);
-    codegen.generateBridgeHeader(protocolName, protocolId, protocolVersion, cmdArray, cOutPathB);
-    codegen.generateBridge(protocolName, cmdArray, false, cOutPathB);
-    codegen.generateDescription(protocolName, cmdArray, cOutPathB);
-
-    rustgen.generateMain(protocolName, cmdArray, false, rustOutPathB, rustextractB);
-    rustgen.generateBridge(protocolName, protocolId, protocolVersion, cmdArray, false, rustOutPathB);
-
     // Generate doc (if needed)
     if (parser.isSet("d")) {
-        docgen.generateWikiTable(protocolName, protocolId, protocolDesc, cmdArray, docPath);
-        docgen.generateDokuWikiTable(protocolName, protocolId, protocolDesc, cmdArray, docPath);
-        docgen.generateMkdownTable(protocolName, protocolId, protocolDesc, cmdArray, docPath);
+        DocGenerator::T_DocModel docModel = docgen.buildDocModel(protocolName, protocolId, protocolDesc, cmdArray);
+        QList<DocGenerator::T_DocFormat> docFormats = {
+            DocGenerator::DOC_WIKI, DocGenerator::DOC_DOKUWIKI, DocGenerator::DOC_MKDOWN};
+        if (parser.isSet("doc-html")) {
+            docFormats.append(DocGenerator::DOC_HTML);
+        }
+        docgen.generateDoc(docModel, docFormats, docPath);
     }
     // End output
     out << "Generation complete." << Qt::endl;
@@ -305,7 +648,25 @@ int main(int argc, char *argv[]) {
         out << "Rust code A generated in: " << rustOutPathA << Qt::endl;
         out << "Rust code B generated in: " << rustOutPathB << Qt::endl;
     }
+    if (parser.isSet("cpp")) {
+        out << "C++ binding generated in: " << cppOutPath << Qt::endl;
+    }
     if (parser.isSet("d")) {
         out << "Documentation generated in: " << docPath << Qt::endl;
     }
+    if (codegen.getSharedDescArrayNb() > 0) {
+        int savedSize = codegen.getSharedDescEntryNb() * CodeGenerator::ATT_DESC_SIZE;
+        out << "Shared C descriptors: " << codegen.getSharedDescArrayNb() << " arrays merged, "
+            << codegen.getSharedDescEntryNb() << " entries saved (~" << savedSize << " bytes of flash)" << Qt::endl;
+    }
+    // Profile report
+    if (parser.isSet("p")) {
+        Profiler::setEnabled(false);
+        out << Qt::endl << Profiler::getReportTable();
+        if (!Profiler::writeChromeTrace(profileFilePath)) {
+            out << "Error, couldn't save profile trace: " << profileFilePath << Qt::endl;
+            exit(EXIT_FAILURE);
+        }
+        out << "Profile trace saved in: " << profileFilePath << Qt::endl;
+    }
 }
@@ -19,15 +19,26 @@
     along with this project. If not, see <https://www.gnu.org/licenses/>
  */
 
+#include <QHash>
+
 #include "attribute.h"
 
+// FNV-1a 64 bits prime
+static const quint64 HASH_PRIME = 1099511628211ULL;
+
 Attribute::Attribute(void) {
     this->m_name = "default";
     this->m_id = 0;
     this->m_isOptional = true;
+    this->m_isStreamed = false;
     this->m_dataType = NS_AttDataType::UNKNOWN;
     this->m_subAttArray = QList<Attribute *>();
+    this->m_subAttIndex.setOwner(this);
+    this->m_pParentIndex = nullptr;
     this->m_desc = QString();
+    this->m_structHash.storeRelaxed(0);
+    this->m_shapeHash.storeRelaxed(0);
+    this->m_isStructHashValid.storeRelaxed(0);
 }
 
 Attribute::Attribute(
@@ -35,9 +46,15 @@ Attribute::Attribute(
     this->m_name = attName;
     this->m_id = attId;
     this->m_isOptional = attIsOptional;
+    this->m_isStreamed = false;
     this->m_dataType = attDataType;
     this->m_subAttArray = QList<Attribute *>();
+    this->m_subAttIndex.setOwner(this);
+    this->m_pParentIndex = nullptr;
     this->m_desc = attDesc;
+    this->m_structHash.storeRelaxed(0);
+    this->m_shapeHash.storeRelaxed(0);
+    this->m_isStructHashValid.storeRelaxed(0);
 }
 
 Attribute::Attribute(QString attName, short attId, bool attIsOptional, NS_AttDataType::T_AttDataType attDataType,
@@ -45,13 +62,30 @@ Attribute::Attribute(QString attName, short attId, bool attIsOptional, NS_AttDat
     this->m_name = attName;
     this->m_id = attId;
     this->m_isOptional = attIsOptional;
+    this->m_isStreamed = false;
     this->m_dataType = attDataType;
-    this->m_subAttArray = attSubAttArray;
+    this->m_subAttIndex.setOwner(this);
+    this->m_subAttArray = this->m_subAttIndex.rebuild(attSubAttArray);
+    this->m_pParentIndex = nullptr;
     this->m_desc = attDesc;
+    this->m_structHash.storeRelaxed(0);
+    this->m_shapeHash.storeRelaxed(0);
+    this->m_isStructHashValid.storeRelaxed(0);
+}
+
+Attribute::~Attribute() {
+    // Keep the parent index free of dangling pointers
+    if (this->m_pParentIndex != nullptr) {
+        this->m_pParentIndex->remove(this);
+    }
 }
 
 void Attribute::setName(QString attName) {
+    if ((this->m_pParentIndex != nullptr) && (attName != this->m_name)) {
+        this->m_pParentIndex->rename(this, this->m_name, attName);
+    }
     this->m_name = attName;
+    this->invalidateStructHash();
 }
 
 QString Attribute::getName(void) {
@@ -59,7 +93,11 @@ QString Attribute::getName(void) {
 }
 
 void Attribute::setId(short attId) {
+    if ((this->m_pParentIndex != nullptr) && (attId != this->m_id)) {
+        this->m_pParentIndex->changeId(this, this->m_id, attId);
+    }
     this->m_id = attId;
+    this->invalidateStructHash();
 }
 
 short Attribute::getId(void) {
@@ -68,14 +106,25 @@ short Attribute::getId(void) {
 
 void Attribute::setIsOptional(bool attIsOptional) {
     this->m_isOptional = attIsOptional;
+    this->invalidateStructHash();
 }
 
 bool Attribute::getIsOptional(void) {
     return this->m_isOptional;
 }
 
+void Attribute::setIsStreamed(bool attIsStreamed) {
+    this->m_isStreamed = attIsStreamed;
+    this->invalidateStructHash();
+}
+
+bool Attribute::getIsStreamed(void) {
+    return this->m_isStreamed;
+}
+
 void Attribute::setDataType(NS_AttDataType::T_AttDataType attDataType) {
     this->m_dataType = attDataType;
+    this->invalidateStructHash();
 }
 
 NS_AttDataType::T_AttDataType Attribute::getDataType(void) {
@@ -84,6 +133,7 @@ NS_AttDataType::T_AttDataType Attribute::getDataType(void) {
 
 void Attribute::setDesc(QString attDesc) {
     this->m_desc = attDesc;
+    this->invalidateStructHash();
 }
 
 QString Attribute::getDesc(void) {
@@ -99,11 +149,16 @@ void *Attribute::getObjPtr(void) {
 }
 
 void Attribute::setSubAttArray(QList<Attribute *> attSubAttArray) {
-    this->m_subAttArray = attSubAttArray;
+    this->m_subAttArray = this->m_subAttIndex.rebuild(attSubAttArray);
+    this->invalidateStructHash();
 }
 
 void Attribute::addSubAtt(Attribute *newAtt) {
+    if (!this->m_subAttIndex.insert(newAtt)) {
+        return;
+    }
     this->m_subAttArray.append(newAtt);
+    this->invalidateStructHash();
 }
 
 QList<Attribute *> Attribute::getSubAttArray(void) {
@@ -144,16 +199,18 @@ void Attribute::sortArrayById(void) {
             j = j - 1;
         }
     }
-    this->m_subAttArray = sortedAttArray;
+    this->m_subAttArray = this->m_subAttIndex.rebuild(sortedAttArray);
+    this->invalidateStructHash();
 }
 
 void Attribute::editParams(
     QString attName, short attCode, bool attIsOptional, NS_AttDataType::T_AttDataType attDataType, QString attDesc) {
-    this->m_name = attName;
-    this->m_id = attCode;
+    this->setName(attName);
+    this->setId(attCode);
     this->m_isOptional = attIsOptional;
     this->m_dataType = attDataType;
     this->m_desc = attDesc;
+    this->invalidateStructHash();
 }
 
 void Attribute::removeAtt(QString attName) {
@@ -161,7 +218,9 @@ void Attribute::removeAtt(QString attName) {
     if (attStorage != nullptr) {
         attStorage->clearArray_rec();
         this->m_subAttArray.removeAll(attStorage);
+        this->m_subAttIndex.remove(attStorage);
         delete attStorage;
+        this->invalidateStructHash();
     }
 }
 
@@ -171,21 +230,133 @@ void Attribute::clearArray_rec(void) {
             attribute->clearArray_rec();
         }
     }
+    this->m_subAttIndex.clear();
     while (!this->m_subAttArray.isEmpty()) {
         delete this->m_subAttArray.takeFirst();
     }
+    this->invalidateStructHash();
 }
 
 Attribute *Attribute::getSubAttPointer(QString subAttName) {
-    Attribute *subAttPointer = nullptr;
+    return this->m_subAttIndex.findByName(subAttName);
+}
 
-    for (Attribute *attribute : this->m_subAttArray) {
-        if ((attribute != nullptr) && (attribute->getName().compare(subAttName) == 0)) {
-            subAttPointer = attribute;
-            break;
+Attribute *Attribute::getSubAttById(short subAttId) {
+    return this->m_subAttIndex.findById(subAttId);
+}
+
+void Attribute::updateStructHash(void) const {
+    quint64 hash = Attribute::hashString(Attribute::HASH_SEED, this->m_name);
+    hash = Attribute::hashValue(hash, static_cast<quint64>(this->m_id));
+    hash = Attribute::hashValue(hash, this->m_isOptional ? 1 : 0);
+    hash = Attribute::hashValue(hash, this->m_isStreamed ? 1 : 0);
+    hash = Attribute::hashValue(hash, static_cast<quint64>(this->m_dataType));
+    hash = Attribute::hashString(hash, this->m_desc);
+    hash = Attribute::hashValue(hash, static_cast<quint64>(this->m_subAttArray.size()));
+    // Names, descriptions and streaming aren't in the descriptors
+    quint64 shapeHash = Attribute::hashValue(Attribute::HASH_SEED, static_cast<quint64>(this->m_id));
+    shapeHash = Attribute::hashValue(shapeHash, this->m_isOptional ? 1 : 0);
+    shapeHash = Attribute::hashValue(shapeHash, static_cast<quint64>(this->m_dataType));
+    shapeHash = Attribute::hashValue(shapeHash, static_cast<quint64>(this->m_subAttArray.size()));
+    for (Attribute *subAtt : this->m_subAttArray) {
+        hash = Attribute::hashValue(hash, subAtt->getStructHash());
+        shapeHash = Attribute::hashValue(shapeHash, subAtt->getShapeHash());
+    }
+    // Concurrent readers compute the same values, publishing them twice is harmless
+    this->m_structHash.storeRelaxed(hash);
+    this->m_shapeHash.storeRelaxed(shapeHash);
+    this->m_isStructHashValid.storeRelease(1);
+}
+
+quint64 Attribute::getStructHash(void) const {
+    if (this->m_isStructHashValid.loadAcquire() == 0) {
+        this->updateStructHash();
+    }
+    return this->m_structHash.loadRelaxed();
+}
+
+quint64 Attribute::getShapeHash(void) const {
+    if (this->m_isStructHashValid.loadAcquire() == 0) {
+        this->updateStructHash();
+    }
+    return this->m_shapeHash.loadRelaxed();
+}
+
+void Attribute::invalidateStructHash(void) {
+    // A valid hash implies valid sub-attribute hashes, so ancestors of an invalid hash are already invalid
+    if (this->m_isStructHashValid.loadAcquire() == 0) {
+        return;
+    }
+    this->m_isStructHashValid.storeRelease(0);
+    if (this->m_pParentIndex != nullptr) {
+        this->m_pParentIndex->invalidateOwnerHash();
+    }
+}
+
+quint64 Attribute::hashValue(quint64 hash, quint64 value) {
+    for (int idx = 0; idx < 8; idx++) {
+        hash = (hash ^ ((value >> (idx * 8)) & 0xFF)) * HASH_PRIME;
+    }
+    return hash;
+}
+
+quint64 Attribute::hashString(quint64 hash, QString str) {
+    QByteArray bytes = str.toUtf8();
+
+    hash = Attribute::hashValue(hash, static_cast<quint64>(bytes.size()));
+    for (const char byte : bytes) {
+        hash = (hash ^ static_cast<uchar>(byte)) * HASH_PRIME;
+    }
+    return hash;
+}
+
+bool Attribute::hasSameParams(const Attribute &other) const {
+    return (this->m_name == other.m_name) && (this->m_id == other.m_id) && (this->m_isOptional == other.m_isOptional)
+           && (this->m_isStreamed == other.m_isStreamed) && (this->m_dataType == other.m_dataType)
+           && (this->m_desc == other.m_desc);
+}
+
+QStringList Attribute::diffAttList(QList<Attribute *> a_list, QList<Attribute *> b_list, QString parentPath) {
+    QStringList diffPaths;
+    QHash<QString, Attribute *> aNameIndex;
+    QHash<QString, Attribute *> bNameIndex;
+
+    for (Attribute *attribute : a_list) {
+        if (!aNameIndex.contains(attribute->getName())) {
+            aNameIndex.insert(attribute->getName(), attribute);
+        }
+    }
+    for (Attribute *attribute : b_list) {
+        if (!bNameIndex.contains(attribute->getName())) {
+            bNameIndex.insert(attribute->getName(), attribute);
+        }
+    }
+    // Modified and removed attributes
+    for (Attribute *aAtt : a_list) {
+        Attribute *bAtt = bNameIndex.value(aAtt->getName(), nullptr);
+        QString attPath = parentPath + "/" + aAtt->getName();
+
+        if (bAtt == nullptr) {
+            diffPaths.append(attPath);
+            continue;
+        }
+        if (aAtt->getStructHash() == bAtt->getStructHash()) {
+            continue;
+        }
+        // Sub-attributes only reordered are reported on their parent
+        QStringList subDiffPaths = Attribute::diffAttList(aAtt->m_subAttArray, bAtt->m_subAttArray, attPath);
+        if (!aAtt->hasSameParams(*bAtt) || subDiffPaths.isEmpty()) {
+            diffPaths.append(attPath);
+        }
+        diffPaths.append(subDiffPaths);
+    }
+    // Added attributes
+    for (Attribute *bAtt : b_list) {
+        if (!aNameIndex.contains(bAtt->getName())) {
+            diffPaths.append(parentPath + "/" + bAtt->getName());
         }
     }
-    return subAttPointer;
+    return diffPaths;
 }
 
 bool Attribute::compareRefAttList(QList<Attribute *> a_list, QList<Attribute *> b_list, int &err_idx) {
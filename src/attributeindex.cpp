@@ -0,0 +1,130 @@
+/**
+ * \file attributeindex.cpp
+ * \brief Attribute lookup index module
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#include "attributeindex.h"
+#include "attribute.h"
+#include "command.h"
+
+// Buckets keep insertion order, so duplicated keys resolve to the first attribute like a list scan would
+template <typename T_Key> static void removeFromBucket(QHash<T_Key, QList<Attribute *>> &index, T_Key key, Attribute *pAtt) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        return;
+    }
+    it->removeOne(pAtt);
+    if (it->isEmpty()) {
+        index.erase(it);
+    }
+}
+
+AttributeIndex::AttributeIndex(void) {
+    this->m_pOwnerAtt = nullptr;
+    this->m_pOwnerCmd = nullptr;
+}
+
+AttributeIndex::~AttributeIndex() {
+    this->clear();
+}
+
+void AttributeIndex::setOwner(Attribute *pOwnerAtt) {
+    this->m_pOwnerAtt = pOwnerAtt;
+    this->m_pOwnerCmd = nullptr;
+}
+
+void AttributeIndex::setOwner(Command *pOwnerCmd) {
+    this->m_pOwnerAtt = nullptr;
+    this->m_pOwnerCmd = pOwnerCmd;
+}
+
+void AttributeIndex::invalidateOwnerHash(void) {
+    if (this->m_pOwnerAtt != nullptr) {
+        this->m_pOwnerAtt->invalidateStructHash();
+    } else if (this->m_pOwnerCmd != nullptr) {
+        this->m_pOwnerCmd->invalidateStructHash();
+    }
+}
+
+bool AttributeIndex::insert(Attribute *pAtt) {
+    // Moving an attribute would leave it in the attribute list of its previous parent
+    if ((pAtt == nullptr) || (pAtt->m_pParentIndex != nullptr)) {
+        return false;
+    }
+    this->m_nameIdx[pAtt->getName()].append(pAtt);
+    this->m_idIdx[pAtt->getId()].append(pAtt);
+    pAtt->m_pParentIndex = this;
+    return true;
+}
+
+void AttributeIndex::remove(Attribute *pAtt) {
+    if ((pAtt == nullptr) || (pAtt->m_pParentIndex != this)) {
+        return;
+    }
+    removeFromBucket(this->m_nameIdx, pAtt->getName(), pAtt);
+    removeFromBucket(this->m_idIdx, pAtt->getId(), pAtt);
+    pAtt->m_pParentIndex = nullptr;
+    this->invalidateOwnerHash();
+}
+
+// Returns the indexed attributes, without the ones owned by another parent
+QList<Attribute *> AttributeIndex::rebuild(QList<Attribute *> attList) {
+    QList<Attribute *> indexedList;
+
+    this->clear();
+    for (Attribute *pAtt : attList) {
+        if (this->insert(pAtt)) {
+            indexedList.append(pAtt);
+        }
+    }
+    return indexedList;
+}
+
+void AttributeIndex::clear(void) {
+    // Detach the attributes still pointing to this index
+    for (const QList<Attribute *> &bucket : this->m_idIdx) {
+        for (Attribute *pAtt : bucket) {
+            if (pAtt->m_pParentIndex == this) {
+                pAtt->m_pParentIndex = nullptr;
+            }
+        }
+    }
+    this->m_nameIdx.clear();
+    this->m_idIdx.clear();
+}
+
+void AttributeIndex::rename(Attribute *pAtt, QString oldName, QString newName) {
+    removeFromBucket(this->m_nameIdx, oldName, pAtt);
+    this->m_nameIdx[newName].append(pAtt);
+}
+
+void AttributeIndex::changeId(Attribute *pAtt, short oldId, short newId) {
+    removeFromBucket(this->m_idIdx, oldId, pAtt);
+    this->m_idIdx[newId].append(pAtt);
+}
+
+Attribute *AttributeIndex::findByName(QString attName) const {
+    auto it = this->m_nameIdx.constFind(attName);
+    return (it != this->m_nameIdx.constEnd()) ? it->first() : nullptr;
+}
+
+Attribute *AttributeIndex::findById(short attId) const {
+    auto it = this->m_idIdx.constFind(attId);
+    return (it != this->m_idIdx.constEnd()) ? it->first() : nullptr;
+}
@@ -20,6 +20,7 @@
  */
 
 #include "codeextractor.h"
+#include "profiler.h"
 
 CodeExtractor::CodeExtractor() {
     this->m_extractionComplete = false;
@@ -30,179 +31,148 @@ CodeExtractor::CodeExtractor() {
     this->m_unknownPublicFunctions = QString();
     this->m_unknownPublicFunctionsHeaders = QString();
     this->m_commandFunctions = QStringList();
+    this->m_scanner = CodeScanner(CodeScanner::LANGUAGE_C);
+    this->m_cmdIdx = -1;
+    this->m_inMainExecute = false;
+    this->m_inDefaultHandler = false;
+    this->m_defaultHandlerDepth = 0;
 }
 
-void CodeExtractor::extractIncludes(QTextStream *pInStream) {
-    while (!pInStream->atEnd()) {
-        QString currentLine = pInStream->readLine();
-        this->m_unknownIncludes.append(currentLine + "\n");
+void CodeExtractor::extractIncludes(const QStringRef &line) {
+    this->m_unknownIncludes.append(line);
+    this->m_unknownIncludes.append('\n');
 
-        if (currentLine.contains("Definitions")) {
-            this->m_state = EXTRACT_DEFINITIONS;
-            break;
-        }
+    if (line.contains(QLatin1String("Definitions"))) {
+        this->m_state = EXTRACT_DEFINITIONS;
     }
 }
 
-void CodeExtractor::extractDefinitions(QTextStream *pInStream) {
-    while (!pInStream->atEnd()) {
-        QString currentLine = pInStream->readLine();
-        this->m_unknownDefinitions.append(currentLine + "\n");
+void CodeExtractor::extractDefinitions(const QStringRef &line) {
+    this->m_unknownDefinitions.append(line);
+    this->m_unknownDefinitions.append('\n');
 
-        if (currentLine.contains("Private Functions")) {
-            this->m_state = EXTRACT_PRIVATE_FUNCTIONS;
-            break;
-        }
+    if (line.contains(QLatin1String("Private Functions"))) {
+        this->m_state = EXTRACT_PRIVATE_FUNCTIONS;
     }
 }
 
-void CodeExtractor::extractPrivateFunctions(QString protocolName, QTextStream *pInStream, QList<Command *> cmdList) {
-    for (int idx = 0; idx < cmdList.size(); idx++) {
-        this->m_commandFunctions.append("");
-    }
-    while (!pInStream->atEnd()) {
-        QString currentLine = pInStream->readLine();
-        bool functionFinished = false;
-        bool functionBegan = false;
-        bool isCommandFunction = false;
-        QString functionBuffer = "";
-        int bracketCounter = 0;
-        int cmdIdx = -1;
-
-        if (currentLine.trimmed().compare("") == 0) {
-            continue;
-        }
-        while (!pInStream->atEnd() && !functionFinished) {
-            functionBuffer.append(currentLine + "\n");
+int CodeExtractor::findCommandIdx(const QStringRef &line) {
+    int pos = line.indexOf(this->m_executePrefix);
 
-            if (currentLine.contains("Public Functions")) {
-                functionBuffer = "";
-                isCommandFunction = false;
-                this->m_state = EXTRACT_PUBLIC_FUNCTIONS;
-                break;
-            }
-            if ((currentLine.contains(protocolName + "Execute")) && !currentLine.contains("\\fn")) {
-                for (int idx = 0; idx < cmdList.size(); idx++) {
-                    QString commandName = cmdList.at(idx)->getName();
-
-                    if (currentLine.contains(protocolName + "Execute" + commandName)) {
-                        cmdIdx = idx;
-                        isCommandFunction = true;
-                        break;
-                    }
-                }
-            }
-            for (QChar ch : currentLine) {
-                if (ch == '{') {
-                    if (bracketCounter == 0) {
-                        functionBegan = true;
-                    }
-                    bracketCounter++;
-                } else if (ch == '}') {
-                    bracketCounter--;
-                }
-            }
-            if ((bracketCounter == 0) && functionBegan) {
-                functionFinished = true;
-                break;
-            } else if (bracketCounter < 0) {
-                qDebug() << "Error: Negative bracket number!";
-                functionBuffer = "";
-                return;
+    while (pos >= 0) {
+        int nameStart = pos + this->m_executePrefix.size();
+        int nameEnd = nameStart;
+
+        while ((nameEnd < line.size()) && (line.at(nameEnd).isLetterOrNumber() || (line.at(nameEnd) == '_'))) {
+            nameEnd++;
+        }
+        // Prefix must start an identifier and the remainder must be an exact command name
+        if ((pos == 0) || !(line.at(pos - 1).isLetterOrNumber() || (line.at(pos - 1) == '_'))) {
+            int cmdIdx = this->m_cmdNameToIdx.value(line.mid(nameStart, nameEnd - nameStart).toString(), -1);
+            if (cmdIdx >= 0) {
+                return cmdIdx;
             }
-            currentLine = pInStream->readLine();
         }
-        if (isCommandFunction && (cmdIdx >= 0)) {
-            this->m_commandFunctions.replace(cmdIdx, functionBuffer + "\n");
-        } else if (functionBuffer.compare("") != 0) {
-            this->m_unknownPrivateFunctions.append(functionBuffer + "\n");
+        pos = line.indexOf(this->m_executePrefix, nameEnd);
+    }
+    return -1;
+}
+
+void CodeExtractor::resetFunctionBuffer() {
+    // Keep the buffer capacity for the next function
+    this->m_functionBuffer.truncate(0);
+    this->m_scanner.reset();
+    this->m_cmdIdx = -1;
+}
+
+void CodeExtractor::flushFunctionBuffer() {
+    if (this->m_state == EXTRACT_PRIVATE_FUNCTIONS) {
+        if (this->m_cmdIdx >= 0) {
+            this->m_commandFunctions.replace(this->m_cmdIdx, this->m_functionBuffer + "\n");
         } else {
-            break;
+            this->m_unknownPrivateFunctions.append(this->m_functionBuffer + "\n");
         }
+    } else if (this->m_state == EXTRACT_PUBLIC_FUNCTIONS) {
+        this->extractPublicFunctionHeader(this->m_functionBuffer);
+        this->m_unknownPublicFunctions.append(this->m_functionBuffer + "\n");
     }
+    this->resetFunctionBuffer();
 }
 
-void CodeExtractor::extractDefaultCommandHandler(QTextStream *pInStream) {
-    this->m_defaultCommandHandler = "";
-    int bracketCounter = 1;
-    bool functionBegan = false;
+void CodeExtractor::extractPrivateFunctions(const QStringRef &line) {
+    // Skip blank lines between functions
+    if (this->m_functionBuffer.isEmpty() && line.trimmed().isEmpty()) {
+        return;
+    }
+    if (line.contains(QLatin1String("Public Functions"))) {
+        this->resetFunctionBuffer();
+        this->m_state = EXTRACT_PUBLIC_FUNCTIONS;
+        return;
+    }
+    this->m_functionBuffer.append(line);
+    this->m_functionBuffer.append('\n');
 
-    while (!pInStream->atEnd()) {
-        QString currentLine = pInStream->readLine();
+    if ((this->m_cmdIdx < 0) && !line.contains(QLatin1String("\\fn"))) {
+        this->m_cmdIdx = this->findCommandIdx(line);
+    }
+    int bracketCounter = this->m_scanner.scanLine(line);
+    if ((bracketCounter == 0) && this->m_scanner.getBlockBegan()) {
+        this->flushFunctionBuffer();
+    } else if (bracketCounter < 0) {
+        qDebug() << "Error: Negative bracket number!";
+        this->resetFunctionBuffer();
+    }
+}
 
-        for (QChar ch : currentLine) {
-            if (ch == '{') {
-                if (bracketCounter == 0) {
-                    functionBegan = true;
-                }
-                bracketCounter++;
-            } else if (ch == '}') {
-                bracketCounter--;
-            }
-        }
-        if ((bracketCounter <= 0) && functionBegan) {
-            return;
-        }
-        if (currentLine.contains("default:")) {
-            while (!pInStream->atEnd()) {
-                currentLine = pInStream->readLine();
+void CodeExtractor::extractMainExecute(const QStringRef &line) {
+    int bracketCounter = this->m_scanner.scanLine(line);
 
-                if (currentLine.contains("}")) {
-                    break;
-                } else {
-                    this->m_defaultCommandHandler.append(currentLine + "\n");
-                }
-            }
+    if (this->m_inDefaultHandler) {
+        // Handler ends when its enclosing switch is closed
+        if (bracketCounter < this->m_defaultHandlerDepth) {
+            this->m_inDefaultHandler = false;
+        } else {
+            this->m_defaultCommandHandler.append(line);
+            this->m_defaultCommandHandler.append('\n');
         }
+    } else if (line.contains(QLatin1String("default:"))) {
+        this->m_inDefaultHandler = true;
+        this->m_defaultHandlerDepth = bracketCounter;
+    }
+    if ((bracketCounter <= 0) && this->m_scanner.getBlockBegan()) {
+        this->m_inMainExecute = false;
+        this->m_inDefaultHandler = false;
+        this->resetFunctionBuffer();
     }
 }
 
-void CodeExtractor::extractPublicFunctions(QString protocolName, QTextStream *pInStream) {
-    while (!pInStream->atEnd()) {
-        QString currentLine = pInStream->readLine();
-        bool functionFinished = false;
-        bool functionBegan = false;
-        QString functionBuffer = "";
-        int bracketCounter = 0;
+void CodeExtractor::extractPublicFunctions(const QStringRef &line) {
+    if (this->m_inMainExecute) {
+        this->extractMainExecute(line);
+        return;
+    }
+    // Skip blank lines between functions
+    if (this->m_functionBuffer.isEmpty() && line.trimmed().isEmpty()) {
+        return;
+    }
+    if (line.contains(this->m_mainExecuteName) && !line.contains(QLatin1String("\\fn"))) {
+        // Generated function, only its default handler is kept
+        this->resetFunctionBuffer();
+        this->m_defaultCommandHandler = "";
+        this->m_inMainExecute = true;
+        this->extractMainExecute(line);
+        return;
+    }
+    this->m_functionBuffer.append(line);
+    this->m_functionBuffer.append('\n');
 
-        if (currentLine.trimmed().compare("") == 0) {
-            continue;
-        }
-        while (!pInStream->atEnd() && !functionFinished) {
-            if (currentLine.contains(protocolName + "_MainExecute") && !currentLine.contains("\\fn")) {
-                this->extractDefaultCommandHandler(pInStream);
-                functionBuffer = "";
-                break;
-            } else {
-                functionBuffer.append(currentLine + "\n");
-
-                for (QChar ch : currentLine) {
-                    if (ch == '{') {
-                        if (bracketCounter == 0) {
-                            functionBegan = true;
-                        }
-                        bracketCounter++;
-                    } else if (ch == '}') {
-                        bracketCounter--;
-                    }
-                }
-            }
-            if ((bracketCounter == 0) && functionBegan) {
-                functionFinished = true;
-                break;
-            } else if (bracketCounter < 0) {
-                qDebug() << "Error: Negative bracket number!";
-                functionBuffer = "";
-                return;
-            }
-            currentLine = pInStream->readLine();
-        }
-        if (functionBuffer.compare("") != 0) {
-            this->extractPublicFunctionHeader(functionBuffer);
-            this->m_unknownPublicFunctions.append(functionBuffer + "\n");
-        }
+    int bracketCounter = this->m_scanner.scanLine(line);
+    if ((bracketCounter == 0) && this->m_scanner.getBlockBegan()) {
+        this->flushFunctionBuffer();
+    } else if (bracketCounter < 0) {
+        qDebug() << "Error: Negative bracket number!";
+        this->resetFunctionBuffer();
     }
-    this->m_state = EXTRACT_END;
 }
 
 bool CodeExtractor::isHeader(QString text) {
@@ -258,30 +228,71 @@ void CodeExtractor::extractPublicFunctionHeader(QString functionBuffer) {
 }
 
 bool CodeExtractor::extractFromSourceFile(QString protocolName, QTextStream *pInStream, QList<Command *> cmdList) {
+    LCSF_PROFILE_SCOPE("CodeExtractor::extractFromSourceFile", "extract");
     if (pInStream == nullptr) {
         return false;
     }
-    while ((!pInStream->atEnd()) && (this->m_state != EXTRACT_END)) {
+    // Decode the source once, lines are then referenced in place
+    const QString source = pInStream->readAll();
+    const int sourceSize = source.size();
+    int lineStart = 0;
+
+    // Command function name lookup
+    this->m_executePrefix = protocolName + "Execute";
+    this->m_mainExecuteName = protocolName + "_MainExecute";
+    this->m_cmdNameToIdx.clear();
+    this->m_cmdNameToIdx.reserve(cmdList.size());
+    this->m_commandFunctions.clear();
+    for (int idx = 0; idx < cmdList.size(); idx++) {
+        QString cmdName = cmdList.at(idx)->getName();
+
+        if (!this->m_cmdNameToIdx.contains(cmdName)) {
+            this->m_cmdNameToIdx.insert(cmdName, idx);
+        }
+        this->m_commandFunctions.append("");
+    }
+    this->resetFunctionBuffer();
+
+    while ((lineStart < sourceSize) && (this->m_state != EXTRACT_END)) {
+        int lineEnd = source.indexOf('\n', lineStart);
+        if (lineEnd < 0) {
+            lineEnd = sourceSize;
+        }
+        int nextLineStart = lineEnd + 1;
+        // Strip line ending like QTextStream::readLine
+        if ((lineEnd > lineStart) && (source.at(lineEnd - 1) == '\r')) {
+            lineEnd--;
+        }
+        const QStringRef line = source.midRef(lineStart, lineEnd - lineStart);
+
         switch (this->m_state) {
             case EXTRACT_INCLUDES:
-                this->extractIncludes(pInStream);
+                this->extractIncludes(line);
                 break;
 
             case EXTRACT_DEFINITIONS:
-                this->extractDefinitions(pInStream);
+                this->extractDefinitions(line);
                 break;
 
             case EXTRACT_PRIVATE_FUNCTIONS:
-                this->extractPrivateFunctions(protocolName, pInStream, cmdList);
+                this->extractPrivateFunctions(line);
                 break;
 
             case EXTRACT_PUBLIC_FUNCTIONS:
-                this->extractPublicFunctions(protocolName, pInStream);
+                this->extractPublicFunctions(line);
                 break;
 
             case EXTRACT_END:
                 break;
         }
+        lineStart = nextLineStart;
+    }
+    // Keep an unterminated trailing function
+    if (!this->m_functionBuffer.isEmpty()) {
+        this->flushFunctionBuffer();
+    }
+    if (this->m_state == EXTRACT_PUBLIC_FUNCTIONS) {
+        this->m_state = EXTRACT_END;
     }
     this->m_extractionComplete = true;
     return true;
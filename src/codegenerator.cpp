@@ -19,11 +19,48 @@
     along with this project. If not, see <https://www.gnu.org/licenses/>
  */
 
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QStringBuilder>
 
 #include "codegenerator.h"
+#include "profiler.h"
 
 CodeGenerator::CodeGenerator() {
+    this->protocolHasSubAtt = false;
+    this->sharedDescArrayNb = 0;
+    this->sharedDescEntryNb = 0;
+    this->reentrantMode = false;
+    this->deferredMode = false;
+    this->fastDecoderMode = false;
+    this->segmentEncodeMode = false;
+    this->instrumentMode = false;
+    this->shareDescMode = false;
+}
+
+void CodeGenerator::setReentrantMode(bool isReentrant) {
+    this->reentrantMode = isReentrant;
+}
+
+void CodeGenerator::setDeferredMode(bool isDeferred) {
+    this->deferredMode = isDeferred;
+}
+
+void CodeGenerator::setFastDecoderMode(bool isFastDecoder) {
+    this->fastDecoderMode = isFastDecoder;
+}
+
+void CodeGenerator::setSegmentEncodeMode(bool isSegmentEncode) {
+    this->segmentEncodeMode = isSegmentEncode;
+}
+
+void CodeGenerator::setInstrumentMode(bool isInstrument) {
+    this->instrumentMode = isInstrument;
+}
+
+void CodeGenerator::setShareDescMode(bool isShareDesc) {
+    this->shareDescMode = isShareDesc;
 }
 
 QString CodeGenerator::getAttDataRxPath(QString protocolName, QStringList parentNames, QString attName) {
@@ -71,118 +108,2461 @@ QString CodeGenerator::getIndent(int indentNb) {
             indentString.append("    ");
         }
     }
-    return indentString;
+    return indentString;
+}
+
+QString CodeGenerator::getFlagTypeStringFromAttNb(int attNb, QString varName) {
+    QString typeString = QString();
+
+    if (attNb > 0) {
+        if (attNb <= 8) {
+            typeString = "uint8_t " + varName;
+        } else if (attNb <= 16) {
+            typeString = "uint16_t " + varName;
+        } else if (attNb <= 32) {
+            typeString = "uint32_t " + varName;
+        } else {
+            int ByteNb = attNb / 8;
+            if (attNb % 8 != 0)
+                ByteNb++;
+            typeString = "uint8_t ";
+            typeString.append(varName + "[");
+            typeString.append(QString::number(ByteNb));
+            typeString.append("] ");
+        }
+    }
+    return typeString;
+}
+
+QString CodeGenerator::getTypeStringFromDataType(NS_AttDataType::T_AttDataType dataType) {
+    QString typeString;
+    switch (dataType) {
+        case NS_AttDataType::UINT8:
+            typeString = "uint8_t ";
+            break;
+
+        case NS_AttDataType::UINT16:
+            typeString = "uint16_t ";
+            break;
+
+        case NS_AttDataType::UINT32:
+            typeString = "uint32_t ";
+            break;
+
+        case NS_AttDataType::UINT64:
+            typeString = "uint64_t ";
+            break;
+
+        case NS_AttDataType::FLOAT32:
+            typeString = "float ";
+            break;
+
+        case NS_AttDataType::FLOAT64:
+            typeString = "double ";
+            break;
+
+        case NS_AttDataType::BYTE_ARRAY:
+            typeString = "uint8_t *";
+            break;
+
+        case NS_AttDataType::STRING:
+            typeString = "char *";
+            break;
+
+        default:
+            typeString = "void *";
+            break;
+    }
+    return typeString;
+}
+
+QString CodeGenerator::getInitStringFromDataType(NS_AttDataType::T_AttDataType dataType) {
+    QString initString;
+    switch (dataType) {
+        case NS_AttDataType::UINT8:
+        case NS_AttDataType::UINT16:
+        case NS_AttDataType::UINT32:
+        case NS_AttDataType::UINT64:
+        case NS_AttDataType::FLOAT32:
+        case NS_AttDataType::FLOAT64:
+        default:
+            initString = " = 0";
+            break;
+
+        case NS_AttDataType::BYTE_ARRAY:
+        case NS_AttDataType::STRING:
+            initString = " = NULL";
+            break;
+    }
+    return initString;
+}
+
+QString CodeGenerator::getAttDescString(QString protocolName, QString parentName, Attribute *attribute) {
+    QString descString = "";
+    if (attribute != nullptr) {
+        // Optionality
+        if (attribute->getIsOptional()) {
+            descString.append("true, ");
+        } else {
+            descString.append("false, ");
+        }
+        // Type
+        descString.append(NS_AttDataType::SL_AttDataType.at(attribute->getDataType()) + ", ");
+        // Id
+        descString.append("LCSF_" + protocolName.toUpper() + "_" + parentName.toUpper() + "_ATT_ID_" +
+            attribute->getName().toUpper() + ", ");
+        // Sub-attributes descriptor, isomorphic subtrees point to their shared array
+        if (attribute->getSubAttArray().size() > 0) {
+            QString descArrayName = this->sharedDescNames.value(attribute->getName(), attribute->getName());
+            descString.append("LCSF_" + protocolName.toUpper() + "_ATT_" + attribute->getName().toUpper() + "_SUBATT_NB, ");
+            descString.append("LCSF_" + protocolName + "_" + descArrayName + "_AttDescArray");
+        } else {
+            descString.append("0, NULL");
+        }
+    }
+    return descString;
+}
+
+QString CodeGenerator::getCtxParam(QString protocolName, bool isOnlyParam) {
+    if (!this->reentrantMode) {
+        return (isOnlyParam) ? "void" : "";
+    }
+    QString ctxParam = protocolName.toLower() + "_ctx_t *pCtx";
+    return (isOnlyParam) ? ctxParam : ctxParam + ", ";
+}
+
+QString CodeGenerator::getCtxArg(bool isOnlyArg) {
+    if (!this->reentrantMode) {
+        return "";
+    }
+    return (isOnlyArg) ? "pCtx" : "pCtx, ";
+}
+
+QString CodeGenerator::getBridgeCtxParam(QString protocolName, bool isOnlyParam) {
+    if (!this->reentrantMode) {
+        return (isOnlyParam) ? "void" : "";
+    }
+    QString ctxParam = "lcsf_bridge_" + protocolName.toLower() + "_ctx_t *pCtx";
+    return (isOnlyParam) ? ctxParam : ctxParam + ", ";
+}
+
+QList<CodeGenerator::T_CField> CodeGenerator::getQueueFields(QString protocolName) {
+    return {
+        {"lcsf_bridge_" + protocolName.toLower() + "_queue_slot_t", "Queue",
+            "LCSF_BRIDGE_" + protocolName.toUpper() + "_QUEUE_SIZE", DEFAULT_QUEUE_SIZE},
+        {"atomic_uint_fast16_t", "QueueHead", "", 0},
+        {"atomic_uint_fast16_t", "QueueTail", "", 0},
+    };
+}
+
+QList<CodeGenerator::T_CField> CodeGenerator::getQueueSlotFields(QString protocolName) {
+    return {
+        {"uint16_t", "CmdName", "", 0},
+        {protocolName.toLower() + "_cmd_payload_t", "CmdPayload", "", 0},
+    };
+}
+
+QList<QPair<QString, QString>> CodeGenerator::getFailReasons(QString protocolName) {
+    return {
+        {"DECODE", "Frame rejected by the bridge decoder"},
+        {"QUEUE_FULL", "Command dropped, deferred queue full"},
+        {"HANDLER", protocolName + "_MainExecute returned false"},
+        {"ENCODE", "Payload couldn't be encoded"},
+    };
+}
+
+QList<CodeGenerator::T_CField> CodeGenerator::getCmdStatsFields(void) {
+    return {
+        {"uint32_t", "RxCount", "", 0},
+        {"uint32_t", "TxCount", "", 0},
+        {"uint32_t", "RxFailCount", "", 0},
+        {"uint32_t", "FailCount", "", 0},
+        {"uint64_t", "RxBytes", "", 0},
+        {"uint64_t", "TxBytes", "", 0},
+        {"uint64_t", "DecodeCycles", "", 0},
+        {"uint64_t", "HandlerCycles", "", 0},
+        {"uint64_t", "EncodeCycles", "", 0},
+    };
+}
+
+QList<CodeGenerator::T_CField> CodeGenerator::getStatsFields(QString protocolName, int cmdNb) {
+    return {
+        {"lcsf_bridge_" + protocolName.toLower() + "_cmd_stats_t", "Cmd", "LCSF_" + protocolName.toUpper() + "_CMD_NB",
+            cmdNb},
+        {"uint32_t", "FailCount", "LCSF_BRIDGE_" + protocolName.toUpper() + "_FAIL_NB",
+            this->getFailReasons(protocolName).size()},
+        {"uint16_t", "RxLastFailCmdName", "", 0},
+        {"uint8_t", "RxLastFail", "", 0},
+        {"uint16_t", "LastFailCmdName", "", 0},
+        {"uint8_t", "LastFail", "", 0},
+    };
+}
+
+void CodeGenerator::writeCFields(QList<T_CField> fields, QTextStream *pOut) {
+    for (T_CField field : fields) {
+        *pOut << "    " << field.type << " " << field.name;
+        if (field.arrayNb > 0) {
+            *pOut << "[" << field.arrayLength << "]";
+        }
+        *pOut << ";" << Qt::endl;
+    }
+}
+
+void CodeGenerator::declareCmdStorage(QString protocolName, QTextStream *pOut) {
+    // Deferred commands are decoded straight into their queue slot
+    if (this->deferredMode) {
+        this->writeCFields(this->getQueueFields(protocolName), pOut);
+    } else {
+        *pOut << "    " << protocolName.toLower() << "_cmd_payload_t CmdPayload;" << Qt::endl;
+    }
+}
+
+void CodeGenerator::declareStatsStorage(QString protocolName, QTextStream *pOut) {
+    if (this->instrumentMode) {
+        *pOut << "#ifdef LCSF_BRIDGE_" << protocolName.toUpper() << "_STATS" << Qt::endl;
+        *pOut << "    lcsf_bridge_" << protocolName.toLower() << "_stats_t Stats;" << Qt::endl;
+        *pOut << "#endif" << Qt::endl;
+    }
+}
+
+QString CodeGenerator::getLifoPtr(QString protocolName) {
+    // Reentrant fill functions get the lifo of their channel as parameter
+    if (this->reentrantMode) {
+        return "pLifo";
+    }
+    return "&LcsfBridge" + protocolName + "Info.Lifo";
+}
+
+QString CodeGenerator::getDecodeFctSignature(QString protocolName, QStringList parentNames) {
+    return "static bool LCSF_Bridge_" + protocolName + parentNames.join("") +
+        "Decode(const uint8_t *pBuffer, size_t buffSize, size_t *pIdx, uint_fast16_t attNb, " + protocolName.toLower() +
+        "_cmd_payload_t *pCmdPayload)";
+}
+
+void CodeGenerator::declareDecodeFct_Rec(
+    QString protocolName, QStringList parentNames, QList<Attribute *> attList, QTextStream *pOut) {
+    *pOut << this->getDecodeFctSignature(protocolName, parentNames) << ";" << Qt::endl;
+    for (Attribute *attribute : attList) {
+        if (attribute->getDataType() == NS_AttDataType::SUB_ATTRIBUTES) {
+            QStringList nextParentNames = parentNames;
+            nextParentNames.append(attribute->getName());
+            this->declareDecodeFct_Rec(protocolName, nextParentNames, attribute->getSubAttArray(), pOut);
+        }
+    }
+}
+
+void CodeGenerator::writeDecodeFct_Rec(
+    QString protocolName, QStringList parentNames, QList<Attribute *> attList, QTextStream *pOut) {
+    QString payloadPath = "pCmdPayload->" + this->getPayloadPath(parentNames);
+    QString namePrefix = protocolName.toUpper() + "_" + parentNames.last().toUpper() + "_ATT_";
+    QString readFieldFct = "LCSF_Bridge_" + protocolName + "ReadField";
+    QString attNbMacro;
+    QStringList mandatoryChecks;
+    bool hasDataAtt = false;
+
+    if (parentNames.size() > 1) {
+        attNbMacro = "LCSF_" + protocolName.toUpper() + "_ATT_" + parentNames.last().toUpper() + "_SUBATT_NB";
+    } else {
+        attNbMacro = "LCSF_" + protocolName.toUpper() + "_CMD_" + parentNames.last().toUpper() + "_ATT_NB";
+    }
+    for (Attribute *attribute : attList) {
+        if (attribute->getDataType() != NS_AttDataType::SUB_ATTRIBUTES) {
+            hasDataAtt = true;
+        }
+    }
+    *pOut << this->getDecodeFctSignature(protocolName, parentNames) << " {" << Qt::endl;
+    *pOut << "    bool isAttHere[" << attNbMacro << "] = {false};" << Qt::endl;
+    *pOut << "    uint_fast16_t attId;" << Qt::endl;
+    *pOut << "    uint_fast16_t dataSize;" << Qt::endl;
+    if (hasDataAtt) {
+        *pOut << "    const uint8_t *pData;" << Qt::endl;
+    }
+    *pOut << Qt::endl;
+    *pOut << "    for (uint_fast16_t attIdx = 0; attIdx < attNb; attIdx++) {" << Qt::endl;
+    *pOut << "        if (!" << readFieldFct << "(pBuffer, buffSize, pIdx, &attId)) {" << Qt::endl;
+    *pOut << "            return false;" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "        switch (attId) {" << Qt::endl;
+    for (Attribute *attribute : attList) {
+        QString attIdx = namePrefix + attribute->getName().toUpper();
+        QString attId = "LCSF_" + protocolName.toUpper() + "_" + parentNames.last().toUpper() + "_ATT_ID_" +
+            attribute->getName().toUpper();
+        QString attField = payloadPath + attribute->getName().toLower();
+
+        if (attribute->getDataType() == NS_AttDataType::SUB_ATTRIBUTES) {
+            *pOut << "            case (" << attId << " | LCSF_BRIDGE_" << protocolName.toUpper() << "_CMPLX_FLAG):"
+                  << Qt::endl;
+        } else {
+            *pOut << "            case " << attId << ":" << Qt::endl;
+        }
+        *pOut << "                // Reject duplicated attribute" << Qt::endl;
+        *pOut << "                if (isAttHere[" << attIdx << "]) {" << Qt::endl;
+        *pOut << "                    return false;" << Qt::endl;
+        *pOut << "                }" << Qt::endl;
+        *pOut << "                isAttHere[" << attIdx << "] = true;" << Qt::endl;
+        switch (attribute->getDataType()) {
+            case NS_AttDataType::SUB_ATTRIBUTES:
+                {
+                    QStringList nextParentNames = parentNames;
+                    nextParentNames.append(attribute->getName());
+                    *pOut << "                // Complex attribute size field holds its sub-attribute number" << Qt::endl;
+                    *pOut << "                if (!" << readFieldFct << "(pBuffer, buffSize, pIdx, &dataSize)) {"
+                          << Qt::endl;
+                    *pOut << "                    return false;" << Qt::endl;
+                    *pOut << "                }" << Qt::endl;
+                    *pOut << "                if (!LCSF_Bridge_" << protocolName << nextParentNames.join("")
+                          << "Decode(pBuffer, buffSize, pIdx, dataSize, pCmdPayload)) {" << Qt::endl;
+                    *pOut << "                    return false;" << Qt::endl;
+                    *pOut << "                }" << Qt::endl;
+                }
+                break;
+            case NS_AttDataType::BYTE_ARRAY: // fall through
+            case NS_AttDataType::STRING:
+                *pOut << "                pData = LCSF_Bridge_" << protocolName
+                      << "ReadData(pBuffer, buffSize, pIdx, &dataSize);" << Qt::endl;
+                *pOut << "                if (pData == NULL) {" << Qt::endl;
+                *pOut << "                    return false;" << Qt::endl;
+                *pOut << "                }" << Qt::endl;
+                *pOut << "                " << payloadPath << "p_" << attribute->getName().toLower() << " = ("
+                      << this->getTypeStringFromDataType(attribute->getDataType()) << ")pData;" << Qt::endl;
+                *pOut << "                " << attField << "Size = dataSize;" << Qt::endl;
+                break;
+            case NS_AttDataType::FLOAT32: // fall through
+            case NS_AttDataType::FLOAT64:
+                *pOut << "                pData = LCSF_Bridge_" << protocolName
+                      << "ReadData(pBuffer, buffSize, pIdx, &dataSize);" << Qt::endl;
+                *pOut << "                if ((pData == NULL) || (dataSize != sizeof(" << attField << "))) {" << Qt::endl;
+                *pOut << "                    return false;" << Qt::endl;
+                *pOut << "                }" << Qt::endl;
+                *pOut << "                memcpy(&(" << attField << "), pData, dataSize);" << Qt::endl;
+                break;
+            default:
+                // Numbers are variable length encoded, the payload was cleared beforehand
+                *pOut << "                pData = LCSF_Bridge_" << protocolName
+                      << "ReadData(pBuffer, buffSize, pIdx, &dataSize);" << Qt::endl;
+                *pOut << "                if ((pData == NULL) || (dataSize == 0) || (dataSize > sizeof(" << attField
+                      << "))) {" << Qt::endl;
+                *pOut << "                    return false;" << Qt::endl;
+                *pOut << "                }" << Qt::endl;
+                *pOut << "                memcpy(&(" << attField << "), pData, dataSize);" << Qt::endl;
+                break;
+        }
+        if (attribute->getIsOptional()) {
+            *pOut << "                " << payloadPath << "optAttFlagsBitfield |= " << attIdx << "_FLAG;" << Qt::endl;
+        } else {
+            mandatoryChecks.append("isAttHere[" + attIdx + "]");
+        }
+        *pOut << "                break;" << Qt::endl;
+        *pOut << Qt::endl;
+    }
+    *pOut << "            default: // Unknown attribute" << Qt::endl;
+    *pOut << "                return false;" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    if (mandatoryChecks.isEmpty()) {
+        *pOut << "    return true;" << Qt::endl;
+    } else {
+        *pOut << "    // Check mandatory attributes presence" << Qt::endl;
+        *pOut << "    return " << mandatoryChecks.join(" &&\n        ") << ";" << Qt::endl;
+    }
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+
+    for (Attribute *attribute : attList) {
+        if (attribute->getDataType() == NS_AttDataType::SUB_ATTRIBUTES) {
+            QStringList nextParentNames = parentNames;
+            nextParentNames.append(attribute->getName());
+            this->writeDecodeFct_Rec(protocolName, nextParentNames, attribute->getSubAttArray(), pOut);
+        }
+    }
+}
+
+QString CodeGenerator::getEncodeSegFctSignature(QString protocolName, QStringList parentNames, bool isStream) {
+    return "static bool LCSF_Bridge_" + protocolName + parentNames.join("") + ((isStream) ? "EncodeStream" : "EncodeSeg") +
+        "(lcsf_bridge_" +
+        protocolName.toLower() + "_seg_writer_t *pWriter, const " + protocolName.toLower() +
+        "_cmd_payload_t *pCmdPayload)";
+}
+
+void CodeGenerator::declareEncodeSegFct_Rec(
+    QString protocolName, QStringList parentNames, QList<Attribute *> attList, Attribute *pStreamAtt, QTextStream *pOut) {
+    *pOut << this->getEncodeSegFctSignature(protocolName, parentNames, (pStreamAtt != nullptr)) << ";" << Qt::endl;
+    // Segment mode already declares the sub-levels of the stream encoder
+    if ((pStreamAtt != nullptr) && this->segmentEncodeMode) {
+        return;
+    }
+    for (Attribute *attribute : attList) {
+        if (attribute->getDataType() == NS_AttDataType::SUB_ATTRIBUTES) {
+            QStringList nextParentNames = parentNames;
+            nextParentNames.append(attribute->getName());
+            this->declareEncodeSegFct_Rec(protocolName, nextParentNames, attribute->getSubAttArray(), nullptr, pOut);
+        }
+    }
+}
+
+void CodeGenerator::writeEncodeSegFct_Rec(
+    QString protocolName, QStringList parentNames, QList<Attribute *> attList, Attribute *pStreamAtt, QTextStream *pOut) {
+    QString payloadPath = "pCmdPayload->" + this->getPayloadPath(parentNames);
+    QString fctPrefix = "LCSF_Bridge_" + protocolName;
+    int mandatoryNb = 0;
+
+    for (Attribute *attribute : attList) {
+        if (!attribute->getIsOptional()) {
+            mandatoryNb++;
+        }
+    }
+    *pOut << this->getEncodeSegFctSignature(protocolName, parentNames, (pStreamAtt != nullptr)) << " {" << Qt::endl;
+    *pOut << "    uint_fast16_t attNb = " << mandatoryNb << ";" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    // Count present attributes" << Qt::endl;
+    for (Attribute *attribute : attList) {
+        if (attribute->getIsOptional()) {
+            *pOut << "    if ((" << payloadPath << "optAttFlagsBitfield & " << protocolName.toUpper() << "_"
+                  << parentNames.last().toUpper() << "_ATT_" << attribute->getName().toUpper() << "_FLAG) != 0) {"
+                  << Qt::endl;
+            *pOut << "        attNb++;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+        }
+    }
+    *pOut << "    if (!" << fctPrefix << "WriteField(pWriter, attNb)) {" << Qt::endl;
+    *pOut << "        return false;" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    // Streamed attribute goes last so its body ends the frame
+    QList<Attribute *> writeList = attList;
+    if (pStreamAtt != nullptr) {
+        writeList.removeOne(pStreamAtt);
+        writeList.append(pStreamAtt);
+    }
+    for (Attribute *attribute : writeList) {
+        QString attId = "LCSF_" + protocolName.toUpper() + "_" + parentNames.last().toUpper() + "_ATT_ID_" +
+            attribute->getName().toUpper();
+        QString attField = payloadPath + attribute->getName().toLower();
+        QString indent = this->getIndent(1);
+        QStringList writeCalls;
+
+        switch (attribute->getDataType()) {
+            case NS_AttDataType::SUB_ATTRIBUTES:
+                {
+                    QStringList nextParentNames = parentNames;
+                    nextParentNames.append(attribute->getName());
+                    writeCalls.append(fctPrefix + "WriteField(pWriter, " + attId + " | LCSF_BRIDGE_" +
+                        protocolName.toUpper() + "_CMPLX_FLAG)");
+                    writeCalls.append(fctPrefix + nextParentNames.join("") + "EncodeSeg(pWriter, pCmdPayload)");
+                }
+                break;
+            case NS_AttDataType::BYTE_ARRAY: // fall through
+            case NS_AttDataType::STRING:
+                writeCalls.append(fctPrefix + "WriteField(pWriter, " + attId + ")");
+                if (attribute == pStreamAtt) {
+                    // Only the body size is written, the body follows the header
+                    writeCalls.append(fctPrefix + "WriteField(pWriter, " + attField + "Size)");
+                } else {
+                    writeCalls.append(fctPrefix + "WriteRef(pWriter, " + payloadPath + "p_" +
+                        attribute->getName().toLower() + ", " + attField + "Size)");
+                }
+                break;
+            case NS_AttDataType::FLOAT32: // fall through
+            case NS_AttDataType::FLOAT64:
+                writeCalls.append(fctPrefix + "WriteField(pWriter, " + attId + ")");
+                writeCalls.append(fctPrefix + "WriteData(pWriter, &(" + attField + "), sizeof(" + attField + "))");
+                break;
+            default:
+                writeCalls.append(fctPrefix + "WriteField(pWriter, " + attId + ")");
+                writeCalls.append(fctPrefix + "WriteVle(pWriter, " + attField + ")");
+                break;
+        }
+        *pOut << "    // Write attribute " << attribute->getName() << Qt::endl;
+        if (attribute->getIsOptional()) {
+            *pOut << "    if ((" << payloadPath << "optAttFlagsBitfield & " << protocolName.toUpper() << "_"
+                  << parentNames.last().toUpper() << "_ATT_" << attribute->getName().toUpper() << "_FLAG) != 0) {"
+                  << Qt::endl;
+            indent = this->getIndent(2);
+        }
+        *pOut << indent << "if (!" << writeCalls.join(" || !") << ") {" << Qt::endl;
+        *pOut << indent << "    return false;" << Qt::endl;
+        *pOut << indent << "}" << Qt::endl;
+        if (attribute->getIsOptional()) {
+            *pOut << "    }" << Qt::endl;
+        }
+    }
+    *pOut << "    return true;" << Qt::endl;
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+
+    // Segment mode already writes the sub-levels of the stream encoder
+    if ((pStreamAtt != nullptr) && this->segmentEncodeMode) {
+        return;
+    }
+    for (Attribute *attribute : attList) {
+        if (attribute->getDataType() == NS_AttDataType::SUB_ATTRIBUTES) {
+            QStringList nextParentNames = parentNames;
+            nextParentNames.append(attribute->getName());
+            this->writeEncodeSegFct_Rec(protocolName, nextParentNames, attribute->getSubAttArray(), nullptr, pOut);
+        }
+    }
+}
+
+void CodeGenerator::getSegmentBounds_Rec(QList<Attribute *> attList, int &fieldNb, int &dataSize, int &refNb) {
+    // Count field of the level, then id and size fields of each attribute
+    fieldNb++;
+    for (Attribute *attribute : attList) {
+        fieldNb++;
+        switch (attribute->getDataType()) {
+            case NS_AttDataType::SUB_ATTRIBUTES:
+                this->getSegmentBounds_Rec(attribute->getSubAttArray(), fieldNb, dataSize, refNb);
+                break;
+            case NS_AttDataType::BYTE_ARRAY: // fall through
+            case NS_AttDataType::STRING:
+                fieldNb++;
+                refNb++;
+                break;
+            case NS_AttDataType::UINT8:
+                fieldNb++;
+                dataSize += 1;
+                break;
+            case NS_AttDataType::UINT16:
+                fieldNb++;
+                dataSize += 2;
+                break;
+            case NS_AttDataType::UINT32: // fall through
+            case NS_AttDataType::FLOAT32:
+                fieldNb++;
+                dataSize += 4;
+                break;
+            default:
+                fieldNb++;
+                dataSize += 8;
+                break;
+        }
+    }
+}
+
+void CodeGenerator::writeBenchAtt_Rec(
+    QString protocolName, QString parentName, QList<Attribute *> attList, QTextStream *pOut) {
+    for (Attribute *attribute : attList) {
+        QString attId = "LCSF_" + protocolName.toUpper() + "_" + parentName.toUpper() + "_ATT_ID_" +
+            attribute->getName().toUpper();
+
+        switch (attribute->getDataType()) {
+            case NS_AttDataType::SUB_ATTRIBUTES:
+                *pOut << "    LCSF_BENCH_FIELD(" << attId << " | LCSF_BENCH_CMPLX_FLAG), LCSF_BENCH_FIELD("
+                      << attribute->getSubAttArray().size() << ")," << Qt::endl;
+                this->writeBenchAtt_Rec(protocolName, attribute->getName(), attribute->getSubAttArray(), pOut);
+                break;
+            case NS_AttDataType::UINT8:
+                *pOut << "    LCSF_BENCH_FIELD(" << attId << "), LCSF_BENCH_FIELD(1), 0x2a," << Qt::endl;
+                break;
+            case NS_AttDataType::UINT16:
+                *pOut << "    LCSF_BENCH_FIELD(" << attId << "), LCSF_BENCH_FIELD(2), 0x2a, 0x01," << Qt::endl;
+                break;
+            case NS_AttDataType::UINT32:
+                *pOut << "    LCSF_BENCH_FIELD(" << attId << "), LCSF_BENCH_FIELD(4), 0x2a, 0x01, 0x02, 0x03," << Qt::endl;
+                break;
+            case NS_AttDataType::UINT64:
+                *pOut << "    LCSF_BENCH_FIELD(" << attId
+                      << "), LCSF_BENCH_FIELD(8), 0x2a, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07," << Qt::endl;
+                break;
+            case NS_AttDataType::FLOAT32:
+                *pOut << "    LCSF_BENCH_FIELD(" << attId << "), LCSF_BENCH_FIELD(4), 0x00, 0x00, 0x80, 0x3f," << Qt::endl;
+                break;
+            case NS_AttDataType::FLOAT64:
+                *pOut << "    LCSF_BENCH_FIELD(" << attId
+                      << "), LCSF_BENCH_FIELD(8), 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x3f," << Qt::endl;
+                break;
+            case NS_AttDataType::STRING:
+                *pOut << "    LCSF_BENCH_FIELD(" << attId << "), LCSF_BENCH_FIELD(5), 'l', 'c', 's', 'f', '\\0',"
+                      << Qt::endl;
+                break;
+            default:
+                *pOut << "    LCSF_BENCH_FIELD(" << attId
+                      << "), LCSF_BENCH_FIELD(8), 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07," << Qt::endl;
+                break;
+        }
+    }
+}
+
+void CodeGenerator::writeBenchPayload_Rec(
+    QString protocolName, QStringList parentNames, QList<Attribute *> attList, QTextStream *pOut, int indentNb) {
+    QString payloadPath = "pCmdPayload->" + this->getPayloadPath(parentNames);
+
+    for (Attribute *attribute : attList) {
+        QString attPath = payloadPath + attribute->getName().toLower();
+        QString indent = this->getIndent(indentNb);
+
+        if (attribute->getIsOptional()) {
+            *pOut << indent << "if (LCSF_Bench_RandBool()) {" << Qt::endl;
+            indent = this->getIndent(indentNb + 1);
+            *pOut << indent << payloadPath << "optAttFlagsBitfield |= " << protocolName.toUpper() << "_"
+                  << parentNames.last().toUpper() << "_ATT_" << attribute->getName().toUpper() << "_FLAG;" << Qt::endl;
+        }
+        switch (attribute->getDataType()) {
+            case NS_AttDataType::SUB_ATTRIBUTES:
+                this->writeBenchPayload_Rec(protocolName, parentNames + QStringList(attribute->getName()),
+                    attribute->getSubAttArray(), pOut, (attribute->getIsOptional()) ? indentNb + 1 : indentNb);
+                break;
+            case NS_AttDataType::UINT8:
+                *pOut << indent << attPath << " = (uint8_t)LCSF_Bench_Rand();" << Qt::endl;
+                break;
+            case NS_AttDataType::UINT16:
+                *pOut << indent << attPath << " = (uint16_t)LCSF_Bench_Rand();" << Qt::endl;
+                break;
+            case NS_AttDataType::UINT32:
+                *pOut << indent << attPath << " = LCSF_Bench_Rand();" << Qt::endl;
+                break;
+            case NS_AttDataType::UINT64:
+                *pOut << indent << attPath << " = ((uint64_t)LCSF_Bench_Rand() << 32) | LCSF_Bench_Rand();" << Qt::endl;
+                break;
+            case NS_AttDataType::FLOAT32:
+                *pOut << indent << attPath << " = (float)LCSF_Bench_RandReal();" << Qt::endl;
+                break;
+            case NS_AttDataType::FLOAT64:
+                *pOut << indent << attPath << " = LCSF_Bench_RandReal();" << Qt::endl;
+                break;
+            case NS_AttDataType::BYTE_ARRAY:
+                *pOut << indent << payloadPath << attribute->getName().toLower() << "Size = LCSF_Bench_RandSize();"
+                      << Qt::endl;
+                *pOut << indent << payloadPath << "p_" << attribute->getName().toLower() << " = LcsfBenchBytes;"
+                      << Qt::endl;
+                break;
+            case NS_AttDataType::STRING:
+                *pOut << indent << payloadPath << "p_" << attribute->getName().toLower() << " = LCSF_Bench_RandString(&("
+                      << payloadPath << attribute->getName().toLower() << "Size));" << Qt::endl;
+                break;
+            default:
+                break;
+        }
+        if (attribute->getIsOptional()) {
+            *pOut << this->getIndent(indentNb) << "}" << Qt::endl;
+        }
+    }
+}
+
+void CodeGenerator::writeBenchBuilders(QString protocolName, QList<Command *> cmdList, QTextStream *pOut) {
+    // Builders are written first so that only the random helpers they call are emitted
+    QString builders;
+    QTextStream buildOut(&builders);
+
+    for (Command *command : cmdList) {
+        if (command->getAttArray().size() == 0) {
+            continue;
+        }
+        buildOut << "static void LCSF_Bench_Build" << command->getName() << "(" << protocolName.toLower()
+                 << "_cmd_payload_t *pCmdPayload) {" << Qt::endl;
+        buildOut << "    memset(pCmdPayload, 0, sizeof(*pCmdPayload));" << Qt::endl;
+        this->writeBenchPayload_Rec(protocolName, QStringList(command->getName()), command->getAttArray(), &buildOut, 1);
+        buildOut << "}" << Qt::endl;
+        buildOut << Qt::endl;
+    }
+    *pOut << "// Xorshift generator, the payloads are the same on every run" << Qt::endl;
+    *pOut << "static uint32_t LCSF_Bench_Rand(void) {" << Qt::endl;
+    *pOut << "    LcsfBenchRandState ^= LcsfBenchRandState << 13;" << Qt::endl;
+    *pOut << "    LcsfBenchRandState ^= LcsfBenchRandState >> 17;" << Qt::endl;
+    *pOut << "    LcsfBenchRandState ^= LcsfBenchRandState << 5;" << Qt::endl;
+    *pOut << "    return LcsfBenchRandState;" << Qt::endl;
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+    if (builders.contains("LCSF_Bench_RandBool(")) {
+        *pOut << "static bool LCSF_Bench_RandBool(void) {" << Qt::endl;
+        *pOut << "    return (LCSF_Bench_Rand() & 1) != 0;" << Qt::endl;
+        *pOut << "}" << Qt::endl;
+        *pOut << Qt::endl;
+    }
+    if (builders.contains("LCSF_Bench_RandReal(")) {
+        *pOut << "static double LCSF_Bench_RandReal(void) {" << Qt::endl;
+        *pOut << "    return (double)LCSF_Bench_Rand() / 4294967296.0;" << Qt::endl;
+        *pOut << "}" << Qt::endl;
+        *pOut << Qt::endl;
+    }
+    if (builders.contains("LCSF_Bench_RandSize(")) {
+        *pOut << "static uint32_t LCSF_Bench_RandSize(void) {" << Qt::endl;
+        *pOut << "    return 1 + (LCSF_Bench_Rand() % LCSF_BENCH_MAX_DATA_SIZE);" << Qt::endl;
+        *pOut << "}" << Qt::endl;
+        *pOut << Qt::endl;
+    }
+    if (builders.contains("LCSF_Bench_RandString(")) {
+        *pOut << "// Strings are suffixes of LcsfBenchChars, their size includes the terminator" << Qt::endl;
+        *pOut << "static char *LCSF_Bench_RandString(uint32_t *pSize) {" << Qt::endl;
+        *pOut << "    uint32_t strLen = LCSF_Bench_Rand() % LCSF_BENCH_MAX_DATA_SIZE;" << Qt::endl;
+        *pOut << Qt::endl;
+        *pOut << "    *pSize = strLen + 1;" << Qt::endl;
+        *pOut << "    return &(LcsfBenchChars[LCSF_BENCH_MAX_DATA_SIZE - strLen]);" << Qt::endl;
+        *pOut << "}" << Qt::endl;
+        *pOut << Qt::endl;
+    }
+    buildOut.flush();
+    *pOut << builders;
+}
+
+void CodeGenerator::writeLoopbackCompare_Rec(
+    QString protocolName, QStringList parentNames, QList<Attribute *> attList, QTextStream *pOut, int indentNb) {
+    QString sentPath = "pSent->" + this->getPayloadPath(parentNames);
+    QString recvPath = "pRecv->" + this->getPayloadPath(parentNames);
+    QString indent = this->getIndent(indentNb);
+
+    for (Attribute *attribute : attList) {
+        if (attribute->getIsOptional()) {
+            *pOut << indent << "if (" << sentPath << "optAttFlagsBitfield != " << recvPath << "optAttFlagsBitfield) {"
+                  << Qt::endl;
+            *pOut << indent << "    return false;" << Qt::endl;
+            *pOut << indent << "}" << Qt::endl;
+            break;
+        }
+    }
+    for (Attribute *attribute : attList) {
+        QString attName = attribute->getName().toLower();
+        int attIndentNb = indentNb;
+
+        if (attribute->getIsOptional()) {
+            *pOut << indent << "if ((" << sentPath << "optAttFlagsBitfield & " << protocolName.toUpper() << "_"
+                  << parentNames.last().toUpper() << "_ATT_" << attribute->getName().toUpper() << "_FLAG) != 0) {"
+                  << Qt::endl;
+            attIndentNb++;
+        }
+        QString attIndent = this->getIndent(attIndentNb);
+        switch (attribute->getDataType()) {
+            case NS_AttDataType::SUB_ATTRIBUTES:
+                this->writeLoopbackCompare_Rec(protocolName, parentNames + QStringList(attribute->getName()),
+                    attribute->getSubAttArray(), pOut, attIndentNb);
+                break;
+            case NS_AttDataType::BYTE_ARRAY:
+            case NS_AttDataType::STRING:
+                *pOut << attIndent << "if ((" << sentPath << attName << "Size != " << recvPath << attName
+                      << "Size) ||" << Qt::endl;
+                *pOut << attIndent << "    (memcmp(" << sentPath << "p_" << attName << ", " << recvPath << "p_"
+                      << attName << ", " << sentPath << attName << "Size) != 0)) {" << Qt::endl;
+                *pOut << attIndent << "    return false;" << Qt::endl;
+                *pOut << attIndent << "}" << Qt::endl;
+                break;
+            default:
+                *pOut << attIndent << "if (" << sentPath << attName << " != " << recvPath << attName << ") {"
+                      << Qt::endl;
+                *pOut << attIndent << "    return false;" << Qt::endl;
+                *pOut << attIndent << "}" << Qt::endl;
+                break;
+        }
+        if (attribute->getIsOptional()) {
+            *pOut << indent << "}" << Qt::endl;
+        }
+    }
+}
+
+quint64 CodeGenerator::getSubAttShapeHash(Attribute *attribute) {
+    // Names are left out as descriptors only hold ids, types and optionality
+    quint64 shapeHash = Attribute::hashValue(Attribute::HASH_SEED, static_cast<quint64>(attribute->getSubAttArray().size()));
+    for (Attribute *subAtt : attribute->getSubAttArray()) {
+        shapeHash = Attribute::hashValue(shapeHash, subAtt->getShapeHash());
+    }
+    return shapeHash;
+}
+
+bool CodeGenerator::isSameSubAttShape_Rec(Attribute *aAtt, Attribute *bAtt) {
+    QList<Attribute *> aSubAtts = aAtt->getSubAttArray();
+    QList<Attribute *> bSubAtts = bAtt->getSubAttArray();
+
+    if (aSubAtts.size() != bSubAtts.size()) {
+        return false;
+    }
+    for (int idx = 0; idx < aSubAtts.size(); idx++) {
+        Attribute *aSubAtt = aSubAtts.at(idx);
+        Attribute *bSubAtt = bSubAtts.at(idx);
+        if ((aSubAtt->getId() != bSubAtt->getId()) || (aSubAtt->getIsOptional() != bSubAtt->getIsOptional()) ||
+            (aSubAtt->getDataType() != bSubAtt->getDataType()) || !this->isSameSubAttShape_Rec(aSubAtt, bSubAtt)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Attribute *CodeGenerator::findSubAttShape(QHash<quint64, Attribute *> *pShapes, Attribute *attribute) {
+    quint64 shapeHash = this->getSubAttShapeHash(attribute);
+    Attribute *pOwner = pShapes->value(shapeHash, nullptr);
+
+    if (pOwner == nullptr) {
+        pShapes->insert(shapeHash, attribute);
+        return nullptr;
+    }
+    // Hashes only pick the candidate, a colliding shape is left unshared
+    return this->isSameSubAttShape_Rec(pOwner, attribute) ? pOwner : nullptr;
+}
+
+void CodeGenerator::findSharedDescArrays(QList<Attribute::T_attInfos> attInfosList) {
+    QHash<quint64, Attribute *> shapeOwners;
+    QHash<Attribute *, QString> ownerNames;
+    this->sharedDescNames.clear();
+    this->sharedDescArrayNb = 0;
+    this->sharedDescEntryNb = 0;
+    if (!this->shareDescMode) {
+        return;
+    }
+    // Arrays are declared in reverse order, so the last attribute of a class owns the array and is declared before
+    // any of its users
+    for (int idx = attInfosList.size() - 1; idx >= 0; idx--) {
+        Attribute::T_attInfos attInfo = attInfosList.at(idx);
+        if (attInfo.subAttNb <= 0) {
+            continue;
+        }
+        Attribute *pOwner = this->findSubAttShape(&shapeOwners, attInfo.attPointer);
+        if (pOwner != nullptr) {
+            this->sharedDescNames.insert(attInfo.attName, ownerNames.value(pOwner));
+            this->sharedDescArrayNb++;
+            this->sharedDescEntryNb += attInfo.subAttNb;
+        } else {
+            ownerNames.insert(attInfo.attPointer, attInfo.attName);
+        }
+    }
+}
+
+void CodeGenerator::addStructField(int &structSize, int &structAlign, int fieldSize, int fieldAlign) {
+    // Pad the field to its alignment like a C compiler would
+    if ((structSize % fieldAlign) != 0) {
+        structSize += fieldAlign - (structSize % fieldAlign);
+    }
+    structSize += fieldSize;
+    if (fieldAlign > structAlign) {
+        structAlign = fieldAlign;
+    }
+}
+
+void CodeGenerator::addCFields(
+    QList<T_CField> fields, QHash<QString, QPair<int, int>> structLayouts, int &structSize, int &structAlign) {
+    // Size and alignment of the fixed width types, struct fields are given by name
+    QHash<QString, QPair<int, int>> typeLayouts;
+    int atomicSize = ATOMIC_INDEX_SIZE;
+    typeLayouts.insert("uint8_t", {1, 1});
+    typeLayouts.insert("uint16_t", {2, 2});
+    typeLayouts.insert("uint32_t", {4, 4});
+    typeLayouts.insert("uint64_t", {8, 8});
+    typeLayouts.insert("atomic_uint_fast16_t", {atomicSize, atomicSize});
+
+    for (T_CField field : fields) {
+        QPair<int, int> layout = typeLayouts.value(field.type, structLayouts.value(field.name, {0, 1}));
+        int fieldNb = (field.arrayNb > 0) ? field.arrayNb : 1;
+        this->addStructField(structSize, structAlign, fieldNb * layout.first, layout.second);
+    }
+}
+
+void CodeGenerator::getPayloadLayout_Rec(QList<Attribute *> attList, int &structSize, int &structAlign, int &flagsSize) {
+    int optAttNb = 0;
+
+    structSize = 0;
+    structAlign = 1;
+    // Flags bitfield, see getFlagTypeStringFromAttNb
+    for (Attribute *attribute : attList) {
+        if (attribute->getIsOptional()) {
+            optAttNb++;
+        }
+    }
+    if (optAttNb > 0) {
+        int bitfieldSize = (optAttNb <= 8) ? 1 : (optAttNb <= 16) ? 2 : (optAttNb <= 32) ? 4 : (optAttNb + 7) / 8;
+        int bitfieldAlign = (optAttNb <= 32) ? bitfieldSize : 1;
+        this->addStructField(structSize, structAlign, bitfieldSize, bitfieldAlign);
+        flagsSize += bitfieldSize;
+    }
+    // Payload fields
+    for (Attribute *attribute : attList) {
+        switch (attribute->getDataType()) {
+            case NS_AttDataType::UINT8:
+                this->addStructField(structSize, structAlign, 1, 1);
+                break;
+
+            case NS_AttDataType::UINT16:
+                this->addStructField(structSize, structAlign, 2, 2);
+                break;
+
+            case NS_AttDataType::UINT32:
+            case NS_AttDataType::FLOAT32:
+                this->addStructField(structSize, structAlign, 4, 4);
+                break;
+
+            case NS_AttDataType::UINT64:
+            case NS_AttDataType::FLOAT64:
+                this->addStructField(structSize, structAlign, 8, 8);
+                break;
+
+            case NS_AttDataType::BYTE_ARRAY:
+            case NS_AttDataType::STRING:
+                // Size and data pointer
+                this->addStructField(structSize, structAlign, 4, 4);
+                this->addStructField(structSize, structAlign, POINTER_SIZE, POINTER_SIZE);
+                break;
+
+            case NS_AttDataType::SUB_ATTRIBUTES: {
+                int subStructSize = 0;
+                int subStructAlign = 1;
+                this->getPayloadLayout_Rec(attribute->getSubAttArray(), subStructSize, subStructAlign, flagsSize);
+                this->addStructField(structSize, structAlign, subStructSize, subStructAlign);
+            } break;
+
+            default:
+                this->addStructField(structSize, structAlign, POINTER_SIZE, POINTER_SIZE);
+                break;
+        }
+    }
+    // Tail padding
+    this->addStructField(structSize, structAlign, 0, structAlign);
+}
+
+int CodeGenerator::getDescEntryNb_Rec(QList<Attribute *> attList, QHash<quint64, Attribute *> *pDescShapes) {
+    int entryNb = 0;
+
+    for (Attribute *attribute : attList) {
+        if (attribute->getSubAttArray().size() <= 0) {
+            continue;
+        }
+        // Shared sub-attribute arrays are only counted once
+        if (this->shareDescMode) {
+            if (this->findSubAttShape(pDescShapes, attribute) != nullptr) {
+                continue;
+            }
+        }
+        entryNb += attribute->getSubAttArray().size();
+        entryNb += this->getDescEntryNb_Rec(attribute->getSubAttArray(), pDescShapes);
+    }
+    return entryNb;
+}
+
+Attribute *CodeGenerator::getStreamAtt(Command *command) {
+    // Only a top level byte array can be streamed, the first flagged one is used
+    for (Attribute *attribute : command->getAttArray()) {
+        if ((attribute->getDataType() == NS_AttDataType::BYTE_ARRAY) && attribute->getIsStreamed()) {
+            return attribute;
+        }
+    }
+    return nullptr;
+}
+
+bool CodeGenerator::hasStreamAtt(QList<Command *> cmdList) {
+    for (Command *command : cmdList) {
+        if (this->getStreamAtt(command) != nullptr) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QList<Command *> CodeGenerator::getStreamCmds(QList<Command *> cmdList, bool isA) {
+    QList<Command *> streamCmds;
+
+    for (Command *command : cmdList) {
+        if (command->isTransmittable(isA) && (this->getStreamAtt(command) != nullptr)) {
+            streamCmds.append(command);
+        }
+    }
+    return streamCmds;
+}
+
+void CodeGenerator::writeCmdFill(QString protocolName, QString decodeCall, QString cmdName, QString pCmdName,
+    QString pCmdPayload, QString payloadSize, QTextStream *pOut) {
+    QString statePrefix = (this->reentrantMode) ? QString("pCtx->") : "LcsfBridge" + protocolName + "Info.";
+    QString hookPrefix = "LCSF_BRIDGE_" + protocolName.toUpper() + "_HOOK_";
+    QString pStats = "&(" + statePrefix + "Stats)";
+
+    // Without a decode call, the command comes from LCSF_Validator and its name is already set
+    if (decodeCall.isEmpty()) {
+        *pOut << "    // Clear payload to remove stale VLE bytes" << Qt::endl;
+        *pOut << "    memset(" << pCmdPayload << ", 0, " << payloadSize << ");" << Qt::endl;
+        *pOut << "    LCSF_Bridge_" << protocolName << "GetCmdData(" << cmdName << ", pValidCmd->pAttArray, " << pCmdPayload
+              << ");" << Qt::endl;
+        if (this->instrumentMode) {
+            *pOut << "    // The frame size isn't known past LCSF_Validator" << Qt::endl;
+            *pOut << "    " << hookPrefix << "RX(" << pStats << ", " << cmdName << ", 0, start);" << Qt::endl;
+        }
+    } else if (this->instrumentMode) {
+        *pOut << "    int frameSize = " << decodeCall << ", " << pCmdName << ", " << pCmdPayload << ");" << Qt::endl;
+        *pOut << "    if (frameSize < 0) {" << Qt::endl;
+        // Frames the decoder rejects have no command name
+        *pOut << "        " << hookPrefix << "FAIL(" << pStats << ", LCSF_" << protocolName.toUpper()
+              << "_CMD_NB, LCSF_BRIDGE_" << protocolName.toUpper() << "_FAIL_DECODE);" << Qt::endl;
+        *pOut << "        return false;" << Qt::endl;
+        *pOut << "    }" << Qt::endl;
+        *pOut << "    " << hookPrefix << "RX(" << pStats << ", " << cmdName << ", frameSize, start);" << Qt::endl;
+    } else {
+        *pOut << "    if (" << decodeCall << ", " << pCmdName << ", " << pCmdPayload << ") < 0) {" << Qt::endl;
+        *pOut << "        return false;" << Qt::endl;
+        *pOut << "    }" << Qt::endl;
+    }
+}
+
+void CodeGenerator::writeFrameDispatch(QString protocolName, QString decodeCall, QTextStream *pOut) {
+    QString statePrefix = (this->reentrantMode) ? QString("pCtx->") : "LcsfBridge" + protocolName + "Info.";
+    QString hookPrefix = "LCSF_BRIDGE_" + protocolName.toUpper() + "_HOOK_";
+    QString pStats = "&(" + statePrefix + "Stats)";
+    // Validated commands know their name before being decoded, rejected frames have none
+    bool isValidCmd = decodeCall.isEmpty();
+    QString rxCmdName = (isValidCmd) ? "LCSF_Bridge_" + protocolName + "_CMDID2CMDNAME(pValidCmd->CmdId)"
+                                     : "LCSF_" + protocolName.toUpper() + "_CMD_NB";
+
+    if (this->instrumentMode) {
+        *pOut << "    " << hookPrefix << "START(start);" << Qt::endl;
+    }
+    if (this->deferredMode) {
+        // Single producer side of the queue, the slot is only published once filled
+        *pOut << "    uint_fast16_t head = atomic_load_explicit(&(" << statePrefix << "QueueHead), memory_order_relaxed);"
+              << Qt::endl;
+        *pOut << "    uint_fast16_t tail = atomic_load_explicit(&(" << statePrefix << "QueueTail), memory_order_acquire);"
+              << Qt::endl;
+        *pOut << Qt::endl;
+        *pOut << "    // Drop the command if the queue is full" << Qt::endl;
+        *pOut << "    if ((uint_fast16_t)(head - tail) >= LCSF_BRIDGE_" << protocolName.toUpper() << "_QUEUE_SIZE) {"
+              << Qt::endl;
+        if (this->instrumentMode) {
+            *pOut << "        " << hookPrefix << "FAIL(" << pStats << ", " << rxCmdName << ", LCSF_BRIDGE_"
+                  << protocolName.toUpper() << "_FAIL_QUEUE_FULL);" << Qt::endl;
+        }
+        *pOut << "        return false;" << Qt::endl;
+        *pOut << "    }" << Qt::endl;
+        *pOut << "    lcsf_bridge_" << protocolName.toLower() << "_queue_slot_t *pSlot = &(" << statePrefix
+              << "Queue[head & (LCSF_BRIDGE_" << protocolName.toUpper() << "_QUEUE_SIZE - 1)]);" << Qt::endl;
+        if (isValidCmd) {
+            *pOut << "    pSlot->CmdName = " << rxCmdName << ";" << Qt::endl;
+        }
+        this->writeCmdFill(protocolName, decodeCall, "pSlot->CmdName", "&(pSlot->CmdName)", "&(pSlot->CmdPayload)",
+            "sizeof(pSlot->CmdPayload)", pOut);
+        *pOut << "    // Publish the slot" << Qt::endl;
+        *pOut << "    atomic_store_explicit(&(" << statePrefix << "QueueHead), head + 1, memory_order_release);"
+              << Qt::endl;
+        *pOut << "    return true;" << Qt::endl;
+    } else {
+        if (isValidCmd) {
+            *pOut << "    uint16_t cmdName = " << rxCmdName << ";" << Qt::endl;
+        } else {
+            *pOut << "    uint16_t cmdName;" << Qt::endl;
+        }
+        if (this->reentrantMode) {
+            *pOut << "    " << protocolName.toLower() << "_cmd_payload_t *pCmdPayload = &(pCtx->CmdPayload);" << Qt::endl;
+        } else {
+            *pOut << "    " << protocolName.toLower() << "_cmd_payload_t *pCmdPayload = &LcsfBridge" << protocolName
+                  << "Info.CmdPayload;" << Qt::endl;
+        }
+        *pOut << Qt::endl;
+        this->writeCmdFill(protocolName, decodeCall, "cmdName", "&cmdName", "pCmdPayload", "sizeof(*pCmdPayload)", pOut);
+        if (this->instrumentMode) {
+            this->writeHandlerCall(protocolName, pStats, "cmdName", pOut);
+        } else {
+            *pOut << "    return " << protocolName << "_MainExecute(" << ((this->reentrantMode) ? "pCtx->pMainCtx, " : "")
+                  << "cmdName, pCmdPayload);" << Qt::endl;
+        }
+    }
+}
+
+void CodeGenerator::writeBridgeQueue(QString protocolName, T_BridgeSection section, QTextStream *pOut) {
+    QString statePrefix = (this->reentrantMode) ? QString("pCtx->") : "LcsfBridge" + protocolName + "Info.";
+    QString bridgeCtxParam = this->getBridgeCtxParam(protocolName, false);
+
+    if (!this->deferredMode) {
+        return;
+    }
+    switch (section) {
+        case BRIDGE_H_CONSTANTS:
+            *pOut << "// Deferred command queue size, must be a power of two" << Qt::endl;
+            *pOut << "#ifndef LCSF_BRIDGE_" << protocolName.toUpper() << "_QUEUE_SIZE" << Qt::endl;
+            *pOut << "#define LCSF_BRIDGE_" << protocolName.toUpper() << "_QUEUE_SIZE " << DEFAULT_QUEUE_SIZE << Qt::endl;
+            *pOut << "#endif" << Qt::endl;
+            break;
+
+        case BRIDGE_H_TYPES:
+            *pOut << "// Deferred command queue slot" << Qt::endl;
+            *pOut << "typedef struct _lcsf_bridge_" << protocolName.toLower() << "_queue_slot {" << Qt::endl;
+            this->writeCFields(this->getQueueSlotFields(protocolName), pOut);
+            *pOut << "} lcsf_bridge_" << protocolName.toLower() << "_queue_slot_t;" << Qt::endl;
+            *pOut << Qt::endl;
+            break;
+
+        case BRIDGE_H_PROTOTYPES:
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn " << protocolName.toLower() << "_cmd_payload_t *LCSF_Bridge_" << protocolName << "Peek("
+                  << bridgeCtxParam << "uint16_t *pCmdName)" << Qt::endl;
+            *pOut << " * \\brief Get the oldest queued command, its slot stays in use until released" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            if (this->reentrantMode) {
+                *pOut << " * \\param pCtx pointer to the bridge context" << Qt::endl;
+            }
+            *pOut << " * \\param pCmdName pointer to contain the command name" << Qt::endl;
+            *pOut << " * \\return " << protocolName.toLower()
+                  << "_cmd_payload_t *: pointer to the command payload, NULL if the queue is empty" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << protocolName.toLower() << "_cmd_payload_t *LCSF_Bridge_" << protocolName << "Peek(" << bridgeCtxParam
+                  << "uint16_t *pCmdName);" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn void LCSF_Bridge_" << protocolName << "Release(" << this->getBridgeCtxParam(protocolName, true)
+                  << ")" << Qt::endl;
+            *pOut << " * \\brief Give the oldest queued command slot back to the receive side" << Qt::endl;
+            if (this->reentrantMode) {
+                *pOut << " *" << Qt::endl;
+                *pOut << " * \\param pCtx pointer to the bridge context" << Qt::endl;
+            }
+            *pOut << " */" << Qt::endl;
+            *pOut << "void LCSF_Bridge_" << protocolName << "Release(" << this->getBridgeCtxParam(protocolName, true) << ");"
+                  << Qt::endl;
+            *pOut << Qt::endl;
+            break;
+
+        case BRIDGE_C_CONSTANTS:
+            *pOut << "_Static_assert((LCSF_BRIDGE_" << protocolName.toUpper() << "_QUEUE_SIZE & (LCSF_BRIDGE_"
+                  << protocolName.toUpper() << "_QUEUE_SIZE - 1)) == 0, \"Queue size must be a power of two\");" << Qt::endl;
+            break;
+
+        case BRIDGE_C_PUBLIC_FCTS:
+            *pOut << protocolName.toLower() << "_cmd_payload_t *LCSF_Bridge_" << protocolName << "Peek("
+                  << this->getBridgeCtxParam(protocolName, false) << "uint16_t *pCmdName) {" << Qt::endl;
+            *pOut << "    uint_fast16_t tail = atomic_load_explicit(&(" << statePrefix
+                  << "QueueTail), memory_order_relaxed);" << Qt::endl;
+            *pOut << "    uint_fast16_t head = atomic_load_explicit(&(" << statePrefix
+                  << "QueueHead), memory_order_acquire);" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "    if (head == tail) {" << Qt::endl;
+            *pOut << "        return NULL;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    lcsf_bridge_" << protocolName.toLower() << "_queue_slot_t *pSlot = &(" << statePrefix
+                  << "Queue[tail & (LCSF_BRIDGE_" << protocolName.toUpper() << "_QUEUE_SIZE - 1)]);" << Qt::endl;
+            *pOut << "    *pCmdName = pSlot->CmdName;" << Qt::endl;
+            *pOut << "    return &(pSlot->CmdPayload);" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "void LCSF_Bridge_" << protocolName << "Release(" << this->getBridgeCtxParam(protocolName, true)
+                  << ") {" << Qt::endl;
+            *pOut << "    uint_fast16_t tail = atomic_load_explicit(&(" << statePrefix
+                  << "QueueTail), memory_order_relaxed);" << Qt::endl;
+            *pOut << "    atomic_store_explicit(&(" << statePrefix << "QueueTail), tail + 1, memory_order_release);"
+                  << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+            break;
+
+        default:
+            break;
+    }
+}
+
+void CodeGenerator::writeBridgeDecoder(
+    QString protocolName, QList<Command *> cmdList, bool isA, T_BridgeSection section, QTextStream *pOut) {
+    QString bridgeCtxParam = this->getBridgeCtxParam(protocolName, false);
+
+    // Reentrant channels and streaming receive through the decoder
+    if (!this->fastDecoderMode && !this->reentrantMode && !this->hasStreamAtt(cmdList)) {
+        return;
+    }
+    switch (section) {
+        case BRIDGE_H_PROTOTYPES:
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn int LCSF_Bridge_" << protocolName << "Decode(const uint8_t *pBuffer, size_t buffSize, "
+                  << "uint16_t *pCmdName, " << protocolName.toLower() << "_cmd_payload_t *pCmdPayload)" << Qt::endl;
+            *pOut << " * \\brief Validate a raw frame and decode it into a command payload without LCSF_Validator"
+                  << Qt::endl;
+            *pOut << " * Byte array and string payloads point to the frame buffer" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pBuffer pointer to the frame" << Qt::endl;
+            *pOut << " * \\param buffSize frame size" << Qt::endl;
+            *pOut << " * \\param pCmdName pointer to contain the command name" << Qt::endl;
+            *pOut << " * \\param pCmdPayload pointer to the payload to contain the command data" << Qt::endl;
+            *pOut << " * \\return int: -1 if the frame is invalid, decoded frame size if success" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "int LCSF_Bridge_" << protocolName
+                  << "Decode(const uint8_t *pBuffer, size_t buffSize, uint16_t *pCmdName, " << protocolName.toLower()
+                  << "_cmd_payload_t *pCmdPayload);" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn bool LCSF_Bridge_" << protocolName << "ReceiveFrame(" << bridgeCtxParam
+                  << "const uint8_t *pBuffer, size_t buffSize)" << Qt::endl;
+            if (this->deferredMode) {
+                *pOut << " * \\brief Decode a raw frame and queue it for " << protocolName << "_MainPoll" << Qt::endl;
+            } else {
+                *pOut << " * \\brief Decode a raw frame and transmit it to " << protocolName << "_Main" << Qt::endl;
+            }
+            *pOut << " *" << Qt::endl;
+            if (this->reentrantMode) {
+                *pOut << " * \\param pCtx pointer to the bridge context" << Qt::endl;
+            }
+            *pOut << " * \\param pBuffer pointer to the frame" << Qt::endl;
+            *pOut << " * \\param buffSize frame size" << Qt::endl;
+            *pOut << " * \\return bool: true if operation was a success" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "bool LCSF_Bridge_" << protocolName << "ReceiveFrame(" << bridgeCtxParam
+                  << "const uint8_t *pBuffer, size_t buffSize);" << Qt::endl;
+            *pOut << Qt::endl;
+            break;
+
+        case BRIDGE_C_PROTOTYPES:
+            *pOut << "static bool LCSF_Bridge_" << protocolName
+                  << "ReadField(const uint8_t *pBuffer, size_t buffSize, size_t *pIdx, uint_fast16_t *pValue);" << Qt::endl;
+            *pOut << "static const uint8_t *LCSF_Bridge_" << protocolName
+                  << "ReadData(const uint8_t *pBuffer, size_t buffSize, size_t *pIdx, uint_fast16_t *pDataSize);"
+                  << Qt::endl;
+            for (Command *command : cmdList) {
+                if ((command->getAttArray().size() > 0) && (command->isReceivable(isA))) {
+                    this->declareDecodeFct_Rec(protocolName, {command->getName()}, command->getAttArray(), pOut);
+                }
+            }
+            break;
+
+        case BRIDGE_C_PRIVATE_FCTS:
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn static bool LCSF_Bridge_" << protocolName
+                  << "ReadField(const uint8_t *pBuffer, size_t buffSize, size_t *pIdx, uint_fast16_t *pValue)" << Qt::endl;
+            *pOut << " * \\brief Read a little endian frame field and move the frame index past it" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pBuffer pointer to the frame" << Qt::endl;
+            *pOut << " * \\param buffSize frame size" << Qt::endl;
+            *pOut << " * \\param pIdx pointer to the frame index" << Qt::endl;
+            *pOut << " * \\param pValue pointer to contain the field value" << Qt::endl;
+            *pOut << " * \\return bool: true if operation was a success" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "static bool LCSF_Bridge_" << protocolName
+                  << "ReadField(const uint8_t *pBuffer, size_t buffSize, size_t *pIdx, uint_fast16_t *pValue) {" << Qt::endl;
+            *pOut << "    if ((buffSize - *pIdx) < LCSF_BRIDGE_" << protocolName.toUpper() << "_FIELD_SIZE) {" << Qt::endl;
+            *pOut << "        return false;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "#ifdef LCSF_SMALL" << Qt::endl;
+            *pOut << "    *pValue = pBuffer[*pIdx];" << Qt::endl;
+            *pOut << "#else" << Qt::endl;
+            *pOut << "    *pValue = (uint_fast16_t)(pBuffer[*pIdx] | (pBuffer[*pIdx + 1] << 8));" << Qt::endl;
+            *pOut << "#endif" << Qt::endl;
+            *pOut << "    *pIdx += LCSF_BRIDGE_" << protocolName.toUpper() << "_FIELD_SIZE;" << Qt::endl;
+            *pOut << "    return true;" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn static const uint8_t *LCSF_Bridge_" << protocolName
+                  << "ReadData(const uint8_t *pBuffer, size_t buffSize, size_t *pIdx, uint_fast16_t *pDataSize)" << Qt::endl;
+            *pOut << " * \\brief Read an attribute data size and data, and move the frame index past them" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pBuffer pointer to the frame" << Qt::endl;
+            *pOut << " * \\param buffSize frame size" << Qt::endl;
+            *pOut << " * \\param pIdx pointer to the frame index" << Qt::endl;
+            *pOut << " * \\param pDataSize pointer to contain the data size" << Qt::endl;
+            *pOut << " * \\return const uint8_t *: pointer to the data in the frame, NULL if the frame is too short"
+                  << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "static const uint8_t *LCSF_Bridge_" << protocolName
+                  << "ReadData(const uint8_t *pBuffer, size_t buffSize, size_t *pIdx, uint_fast16_t *pDataSize) {"
+                  << Qt::endl;
+            *pOut << "    if (!LCSF_Bridge_" << protocolName << "ReadField(pBuffer, buffSize, pIdx, pDataSize)) {"
+                  << Qt::endl;
+            *pOut << "        return NULL;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    if ((buffSize - *pIdx) < *pDataSize) {" << Qt::endl;
+            *pOut << "        return NULL;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    const uint8_t *pData = &(pBuffer[*pIdx]);" << Qt::endl;
+            *pOut << "    *pIdx += *pDataSize;" << Qt::endl;
+            *pOut << "    return pData;" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn static bool LCSF_Bridge_" << protocolName
+                  << "XDecode(const uint8_t *pBuffer, size_t buffSize, size_t *pIdx, uint_fast16_t attNb, "
+                  << protocolName.toLower() << "_cmd_payload_t *pCmdPayload)" << Qt::endl;
+            *pOut << " * \\brief Validate and decode the attributes of command or complex attribute X, in one pass"
+                  << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pBuffer pointer to the frame" << Qt::endl;
+            *pOut << " * \\param buffSize frame size" << Qt::endl;
+            *pOut << " * \\param pIdx pointer to the frame index" << Qt::endl;
+            *pOut << " * \\param attNb number of attributes in the frame" << Qt::endl;
+            *pOut << " * \\param pCmdPayload pointer to the payload to contain the command data" << Qt::endl;
+            *pOut << " * \\return bool: true if the attributes are valid" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            for (Command *command : cmdList) {
+                if ((command->getAttArray().size() > 0) && (command->isReceivable(isA))) {
+                    this->writeDecodeFct_Rec(protocolName, {command->getName()}, command->getAttArray(), pOut);
+                }
+            }
+            break;
+
+        case BRIDGE_C_PUBLIC_FCTS:
+            *pOut << "int LCSF_Bridge_" << protocolName
+                  << "Decode(const uint8_t *pBuffer, size_t buffSize, uint16_t *pCmdName, " << protocolName.toLower()
+                  << "_cmd_payload_t *pCmdPayload) {" << Qt::endl;
+            *pOut << "    size_t idx = 0;" << Qt::endl;
+            *pOut << "    uint_fast16_t protId;" << Qt::endl;
+            *pOut << "    uint_fast16_t cmdId;" << Qt::endl;
+            *pOut << "    uint_fast16_t attNb;" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "    if (!LCSF_Bridge_" << protocolName
+                  << "ReadField(pBuffer, buffSize, &idx, &protId) || (protId != LCSF_" << protocolName.toUpper()
+                  << "_PROTOCOL_ID)) {" << Qt::endl;
+            *pOut << "        return -1;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    if (!LCSF_Bridge_" << protocolName << "ReadField(pBuffer, buffSize, &idx, &cmdId) || !LCSF_Bridge_"
+                  << protocolName << "ReadField(pBuffer, buffSize, &idx, &attNb)) {" << Qt::endl;
+            *pOut << "        return -1;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    // Clear payload to remove stale VLE bytes" << Qt::endl;
+            *pOut << "    memset(pCmdPayload, 0, sizeof(*pCmdPayload));" << Qt::endl;
+            *pOut << "    switch (cmdId) {" << Qt::endl;
+            for (Command *command : cmdList) {
+                if (!command->isReceivable(isA)) {
+                    continue;
+                }
+                *pOut << "        case LCSF_" << protocolName.toUpper() << "_CMD_ID_" << command->getName().toUpper() << ":"
+                      << Qt::endl;
+                if (command->getAttArray().size() > 0) {
+                    *pOut << "            if (!LCSF_Bridge_" << protocolName << command->getName()
+                          << "Decode(pBuffer, buffSize, &idx, attNb, pCmdPayload)) {" << Qt::endl;
+                } else {
+                    *pOut << "            if (attNb != 0) {" << Qt::endl;
+                }
+                *pOut << "                return -1;" << Qt::endl;
+                *pOut << "            }" << Qt::endl;
+                *pOut << "            break;" << Qt::endl;
+                *pOut << Qt::endl;
+            }
+            *pOut << "        default: // Unknown or non receivable command" << Qt::endl;
+            *pOut << "            return -1;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    *pCmdName = LCSF_Bridge_" << protocolName << "_CMDID2CMDNAME(cmdId);" << Qt::endl;
+            *pOut << "    return (int)idx;" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+
+            *pOut << "bool LCSF_Bridge_" << protocolName << "ReceiveFrame(" << bridgeCtxParam
+                  << "const uint8_t *pBuffer, size_t buffSize) {" << Qt::endl;
+            this->writeFrameDispatch(protocolName, "LCSF_Bridge_" + protocolName + "Decode(pBuffer, buffSize", pOut);
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+            break;
+
+        default:
+            break;
+    }
+}
+
+void CodeGenerator::writeBridgeSegWriter(
+    QString protocolName, QList<Command *> cmdList, bool isA, T_BridgeSection section, QTextStream *pOut) {
+    QString writerParam = "lcsf_bridge_" + protocolName.toLower() + "_seg_writer_t *pWriter";
+    QString fieldSizeMacro = "LCSF_BRIDGE_" + protocolName.toUpper() + "_FIELD_SIZE";
+    bool isStream = this->hasStreamAtt(cmdList);
+
+    // Streaming reuses the segment writer
+    if (!this->segmentEncodeMode && !isStream) {
+        return;
+    }
+    switch (section) {
+        case BRIDGE_H_TYPES:
+            *pOut << "// Encoded message segment, same layout as struct iovec" << Qt::endl;
+            *pOut << "typedef struct _lcsf_bridge_" << protocolName.toLower() << "_segment {" << Qt::endl;
+            *pOut << "    const void *pData;" << Qt::endl;
+            *pOut << "    size_t Size;" << Qt::endl;
+            *pOut << "} lcsf_bridge_" << protocolName.toLower() << "_segment_t;" << Qt::endl;
+            *pOut << Qt::endl;
+            break;
+
+        case BRIDGE_C_TYPES:
+            if (this->reentrantMode) {
+                *pOut << "// --- Private Types ---" << Qt::endl;
+                *pOut << Qt::endl;
+            }
+            *pOut << "// Segment encoder state, the open header segment starts at HeaderStart" << Qt::endl;
+            *pOut << "typedef struct _lcsf_bridge_" << protocolName.toLower() << "_seg_writer {" << Qt::endl;
+            *pOut << "    uint8_t *pHeader;" << Qt::endl;
+            *pOut << "    size_t HeaderSize;" << Qt::endl;
+            *pOut << "    size_t HeaderIdx;" << Qt::endl;
+            *pOut << "    size_t HeaderStart;" << Qt::endl;
+            *pOut << "    lcsf_bridge_" << protocolName.toLower() << "_segment_t *pSegArray;" << Qt::endl;
+            *pOut << "    size_t SegNb;" << Qt::endl;
+            *pOut << "    size_t SegIdx;" << Qt::endl;
+            *pOut << "} lcsf_bridge_" << protocolName.toLower() << "_seg_writer_t;" << Qt::endl;
+            *pOut << Qt::endl;
+            break;
+
+        case BRIDGE_C_PROTOTYPES:
+            *pOut << "static bool LCSF_Bridge_" << protocolName << "WriteField(" << writerParam << ", size_t value);"
+                  << Qt::endl;
+            *pOut << "static bool LCSF_Bridge_" << protocolName << "WriteData(" << writerParam
+                  << ", const void *pData, size_t dataSize);" << Qt::endl;
+            *pOut << "static bool LCSF_Bridge_" << protocolName << "WriteVle(" << writerParam << ", uint64_t value);"
+                  << Qt::endl;
+            *pOut << "static bool LCSF_Bridge_" << protocolName << "CloseHeader(" << writerParam << ");" << Qt::endl;
+            *pOut << "static bool LCSF_Bridge_" << protocolName << "WriteRef(" << writerParam
+                  << ", const void *pData, size_t dataSize);" << Qt::endl;
+            for (Command *command : cmdList) {
+                if (!command->isTransmittable(isA) || (command->getAttArray().size() == 0)) {
+                    continue;
+                }
+                if (this->segmentEncodeMode) {
+                    this->declareEncodeSegFct_Rec(protocolName, {command->getName()}, command->getAttArray(), nullptr, pOut);
+                }
+                Attribute *pStreamAtt = this->getStreamAtt(command);
+                if (pStreamAtt != nullptr) {
+                    this->declareEncodeSegFct_Rec(
+                        protocolName, {command->getName()}, command->getAttArray(), pStreamAtt, pOut);
+                }
+            }
+            break;
+
+        case BRIDGE_C_PRIVATE_FCTS:
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn static bool LCSF_Bridge_" << protocolName << "WriteField(" << writerParam << ", size_t value)"
+                  << Qt::endl;
+            *pOut << " * \\brief Write a little endian frame field in the header buffer" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pWriter pointer to the segment encoder state" << Qt::endl;
+            *pOut << " * \\param value field value" << Qt::endl;
+            *pOut << " * \\return bool: true if operation was a success" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "static bool LCSF_Bridge_" << protocolName << "WriteField(" << writerParam << ", size_t value) {"
+                  << Qt::endl;
+            *pOut << "    if ((value >= ((size_t)1 << (8 * " << fieldSizeMacro << "))) ||" << Qt::endl;
+            *pOut << "        ((pWriter->HeaderSize - pWriter->HeaderIdx) < " << fieldSizeMacro << ")) {" << Qt::endl;
+            *pOut << "        return false;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    pWriter->pHeader[pWriter->HeaderIdx++] = (uint8_t)value;" << Qt::endl;
+            *pOut << "#ifndef LCSF_SMALL" << Qt::endl;
+            *pOut << "    pWriter->pHeader[pWriter->HeaderIdx++] = (uint8_t)(value >> 8);" << Qt::endl;
+            *pOut << "#endif" << Qt::endl;
+            *pOut << "    return true;" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn static bool LCSF_Bridge_" << protocolName << "WriteData(" << writerParam
+                  << ", const void *pData, size_t dataSize)" << Qt::endl;
+            *pOut << " * \\brief Write an attribute data size and copy its data in the header buffer" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pWriter pointer to the segment encoder state" << Qt::endl;
+            *pOut << " * \\param pData pointer to the data" << Qt::endl;
+            *pOut << " * \\param dataSize data size" << Qt::endl;
+            *pOut << " * \\return bool: true if operation was a success" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "static bool LCSF_Bridge_" << protocolName << "WriteData(" << writerParam
+                  << ", const void *pData, size_t dataSize) {" << Qt::endl;
+            *pOut << "    if (!LCSF_Bridge_" << protocolName << "WriteField(pWriter, dataSize) ||" << Qt::endl;
+            *pOut << "        ((pWriter->HeaderSize - pWriter->HeaderIdx) < dataSize)) {" << Qt::endl;
+            *pOut << "        return false;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    memcpy(&(pWriter->pHeader[pWriter->HeaderIdx]), pData, dataSize);" << Qt::endl;
+            *pOut << "    pWriter->HeaderIdx += dataSize;" << Qt::endl;
+            *pOut << "    return true;" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn static bool LCSF_Bridge_" << protocolName << "WriteVle(" << writerParam << ", uint64_t value)"
+                  << Qt::endl;
+            *pOut << " * \\brief Write a number with its variable length encoding in the header buffer" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pWriter pointer to the segment encoder state" << Qt::endl;
+            *pOut << " * \\param value number value" << Qt::endl;
+            *pOut << " * \\return bool: true if operation was a success" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "static bool LCSF_Bridge_" << protocolName << "WriteVle(" << writerParam << ", uint64_t value) {"
+                  << Qt::endl;
+            *pOut << "    uint8_t vleData[sizeof(uint64_t)];" << Qt::endl;
+            *pOut << "    size_t vleSize = 0;" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "    // Little endian, without the upper zero bytes but at least one byte" << Qt::endl;
+            *pOut << "    do {" << Qt::endl;
+            *pOut << "        vleData[vleSize++] = (uint8_t)value;" << Qt::endl;
+            *pOut << "        value >>= 8;" << Qt::endl;
+            *pOut << "    } while (value != 0);" << Qt::endl;
+            *pOut << "    return LCSF_Bridge_" << protocolName << "WriteData(pWriter, vleData, vleSize);" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn static bool LCSF_Bridge_" << protocolName << "CloseHeader(" << writerParam << ")" << Qt::endl;
+            *pOut << " * \\brief Turn the header bytes written since the last segment into a segment" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pWriter pointer to the segment encoder state" << Qt::endl;
+            *pOut << " * \\return bool: true if operation was a success" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "static bool LCSF_Bridge_" << protocolName << "CloseHeader(" << writerParam << ") {" << Qt::endl;
+            *pOut << "    if (pWriter->HeaderIdx == pWriter->HeaderStart) {" << Qt::endl;
+            *pOut << "        return true;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    if (pWriter->SegIdx >= pWriter->SegNb) {" << Qt::endl;
+            *pOut << "        return false;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    pWriter->pSegArray[pWriter->SegIdx].pData = &(pWriter->pHeader[pWriter->HeaderStart]);"
+                  << Qt::endl;
+            *pOut << "    pWriter->pSegArray[pWriter->SegIdx].Size = pWriter->HeaderIdx - pWriter->HeaderStart;" << Qt::endl;
+            *pOut << "    pWriter->SegIdx++;" << Qt::endl;
+            *pOut << "    pWriter->HeaderStart = pWriter->HeaderIdx;" << Qt::endl;
+            *pOut << "    return true;" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn static bool LCSF_Bridge_" << protocolName << "WriteRef(" << writerParam
+                  << ", const void *pData, size_t dataSize)" << Qt::endl;
+            *pOut << " * \\brief Write an attribute data size and reference its data in a segment of its own, or copy"
+                  << Qt::endl;
+            *pOut << " * it in the header buffer when there is no segment array" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pWriter pointer to the segment encoder state" << Qt::endl;
+            *pOut << " * \\param pData pointer to the data" << Qt::endl;
+            *pOut << " * \\param dataSize data size" << Qt::endl;
+            *pOut << " * \\return bool: true if operation was a success" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "static bool LCSF_Bridge_" << protocolName << "WriteRef(" << writerParam
+                  << ", const void *pData, size_t dataSize) {" << Qt::endl;
+            *pOut << "    if (pWriter->pSegArray == NULL) {" << Qt::endl;
+            *pOut << "        return LCSF_Bridge_" << protocolName << "WriteData(pWriter, pData, dataSize);" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    if (!LCSF_Bridge_" << protocolName << "WriteField(pWriter, dataSize) || "
+                  << "!LCSF_Bridge_" << protocolName << "CloseHeader(pWriter)) {" << Qt::endl;
+            *pOut << "        return false;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    if (dataSize == 0) {" << Qt::endl;
+            *pOut << "        return true;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    if ((pData == NULL) || (pWriter->SegIdx >= pWriter->SegNb)) {" << Qt::endl;
+            *pOut << "        return false;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    pWriter->pSegArray[pWriter->SegIdx].pData = pData;" << Qt::endl;
+            *pOut << "    pWriter->pSegArray[pWriter->SegIdx].Size = dataSize;" << Qt::endl;
+            *pOut << "    pWriter->SegIdx++;" << Qt::endl;
+            *pOut << "    return true;" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn " << this->getEncodeSegFctSignature(protocolName, {"X"}, false) << Qt::endl;
+            *pOut << " * \\brief Write the attributes of command or complex attribute X, preceded by their number"
+                  << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pWriter pointer to the segment encoder state" << Qt::endl;
+            *pOut << " * \\param pCmdPayload pointer to the command payload" << Qt::endl;
+            *pOut << " * \\return bool: true if operation was a success" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            for (Command *command : cmdList) {
+                if ((command->getAttArray().size() > 0) && (command->isTransmittable(isA)) && this->segmentEncodeMode) {
+                    this->writeEncodeSegFct_Rec(protocolName, {command->getName()}, command->getAttArray(), nullptr, pOut);
+                }
+            }
+            if (isStream) {
+                *pOut << "/**" << Qt::endl;
+                *pOut << " * \\fn " << this->getEncodeSegFctSignature(protocolName, {"X"}, true) << Qt::endl;
+                *pOut << " * \\brief Write the attributes of command X, its streamed attribute last and without data"
+                      << Qt::endl;
+                *pOut << " *" << Qt::endl;
+                *pOut << " * \\param pWriter pointer to the segment encoder state" << Qt::endl;
+                *pOut << " * \\param pCmdPayload pointer to the command payload" << Qt::endl;
+                *pOut << " * \\return bool: true if operation was a success" << Qt::endl;
+                *pOut << " */" << Qt::endl;
+                for (Command *command : cmdList) {
+                    Attribute *pStreamAtt = this->getStreamAtt(command);
+                    if ((pStreamAtt != nullptr) && (command->isTransmittable(isA))) {
+                        this->writeEncodeSegFct_Rec(
+                            protocolName, {command->getName()}, command->getAttArray(), pStreamAtt, pOut);
+                    }
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void CodeGenerator::writeBridgeSegments(
+    QString protocolName, QList<Command *> cmdList, bool isA, T_BridgeSection section, QTextStream *pOut) {
+    if (!this->segmentEncodeMode) {
+        return;
+    }
+    switch (section) {
+        case BRIDGE_H_CONSTANTS:
+            {
+                int maxFieldNb = 3;
+                int maxDataSize = 0;
+                int maxRefNb = 0;
+                for (Command *command : cmdList) {
+                    int fieldNb = 2;
+                    int dataSize = 0;
+                    int refNb = 0;
+                    this->getSegmentBounds_Rec(command->getAttArray(), fieldNb, dataSize, refNb);
+                    maxFieldNb = qMax(maxFieldNb, fieldNb);
+                    maxDataSize = qMax(maxDataSize, dataSize);
+                    maxRefNb = qMax(maxRefNb, refNb);
+                }
+                *pOut << "// Segment encoder buffer sizes, upper bounds over all commands" << Qt::endl;
+                *pOut << "#define LCSF_BRIDGE_" << protocolName.toUpper() << "_SEG_HEADER_SIZE ((" << maxFieldNb
+                      << " * LCSF_BRIDGE_" << protocolName.toUpper() << "_FIELD_SIZE) + " << maxDataSize << ")" << Qt::endl;
+                *pOut << "#define LCSF_BRIDGE_" << protocolName.toUpper() << "_SEG_NB " << (2 * maxRefNb) + 1 << Qt::endl;
+            }
+            break;
+
+        case BRIDGE_H_PROTOTYPES:
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn int LCSF_Bridge_" << protocolName << "EncodeSegments(uint_fast16_t cmdName, const "
+                  << protocolName.toLower()
+                  << "_cmd_payload_t *pCmdPayload, uint8_t *pHeader, size_t headerSize, lcsf_bridge_"
+                  << protocolName.toLower() << "_segment_t *pSegArray, size_t segNb)" << Qt::endl;
+            *pOut << " * \\brief Encode a command as a segment list for vectored or DMA transmission, fields and numbers"
+                  << Qt::endl;
+            *pOut << " * are written in the header buffer while byte arrays and strings are referenced in place, so the"
+                  << Qt::endl;
+            *pOut << " * payload must stay valid until the segments are sent" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param cmdName name of the command" << Qt::endl;
+            *pOut << " * \\param pCmdPayload pointer to the command payload" << Qt::endl;
+            *pOut << " * \\param pHeader pointer to the header buffer, see LCSF_BRIDGE_" << protocolName.toUpper()
+                  << "_SEG_HEADER_SIZE" << Qt::endl;
+            *pOut << " * \\param headerSize header buffer size" << Qt::endl;
+            *pOut << " * \\param pSegArray pointer to the segment array, see LCSF_BRIDGE_" << protocolName.toUpper()
+                  << "_SEG_NB" << Qt::endl;
+            *pOut << " * \\param segNb segment array size" << Qt::endl;
+            *pOut << " * \\return int: -1 if operation failed, number of segments used if success" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "int LCSF_Bridge_" << protocolName << "EncodeSegments(uint_fast16_t cmdName, const "
+                  << protocolName.toLower()
+                  << "_cmd_payload_t *pCmdPayload, uint8_t *pHeader, size_t headerSize, lcsf_bridge_"
+                  << protocolName.toLower() << "_segment_t *pSegArray, size_t segNb);" << Qt::endl;
+            *pOut << Qt::endl;
+            break;
+
+        case BRIDGE_C_PUBLIC_FCTS:
+            *pOut << Qt::endl;
+            *pOut << "int LCSF_Bridge_" << protocolName << "EncodeSegments(uint_fast16_t cmdName, const "
+                  << protocolName.toLower()
+                  << "_cmd_payload_t *pCmdPayload, uint8_t *pHeader, size_t headerSize, lcsf_bridge_"
+                  << protocolName.toLower() << "_segment_t *pSegArray, size_t segNb) {" << Qt::endl;
+            *pOut << "    lcsf_bridge_" << protocolName.toLower()
+                  << "_seg_writer_t writer = {pHeader, headerSize, 0, 0, pSegArray, segNb, 0};" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "    if (!LCSF_Bridge_" << protocolName << "WriteField(&writer, LCSF_" << protocolName.toUpper()
+                  << "_PROTOCOL_ID) ||" << Qt::endl;
+            *pOut << "        !LCSF_Bridge_" << protocolName << "WriteField(&writer, LCSF_Bridge_" << protocolName
+                  << "_CMDNAME2CMDID[cmdName])) {" << Qt::endl;
+            *pOut << "        return -1;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    switch (cmdName) {" << Qt::endl;
+            for (Command *command : cmdList) {
+                if ((command->getAttArray().size() > 0) && (command->isTransmittable(isA))) {
+                    *pOut << "        case " << protocolName.toUpper() << "_CMD_" << command->getName().toUpper() << ":"
+                          << Qt::endl;
+                    *pOut << "            if (!LCSF_Bridge_" << protocolName << command->getName()
+                          << "EncodeSeg(&writer, pCmdPayload)) {" << Qt::endl;
+                    *pOut << "                return -1;" << Qt::endl;
+                    *pOut << "            }" << Qt::endl;
+                    *pOut << "            break;" << Qt::endl;
+                    *pOut << Qt::endl;
+                }
+            }
+            *pOut << "        default: // Commands that don't have attributes" << Qt::endl;
+            *pOut << "            if (!LCSF_Bridge_" << protocolName << "WriteField(&writer, 0)) {" << Qt::endl;
+            *pOut << "                return -1;" << Qt::endl;
+            *pOut << "            }" << Qt::endl;
+            *pOut << "            break;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    if (!LCSF_Bridge_" << protocolName << "CloseHeader(&writer)) {" << Qt::endl;
+            *pOut << "        return -1;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    return (int)writer.SegIdx;" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            break;
+
+        default:
+            break;
+    }
 }
 
-QString CodeGenerator::getFlagTypeStringFromAttNb(int attNb, QString varName) {
-    QString typeString = QString();
+void CodeGenerator::writeBridgeStream(
+    QString protocolName, QList<Command *> cmdList, bool isA, T_BridgeSection section, QTextStream *pOut) {
+    QString bridgeCtxParam = this->getBridgeCtxParam(protocolName, false);
+    QString rxParam = "lcsf_bridge_" + protocolName.toLower() + "_rx_stream_t *pStream";
+    QString txParam = "lcsf_bridge_" + protocolName.toLower() + "_tx_stream_t *pStream";
+    QString streamState = "LCSF_BRIDGE_" + protocolName.toUpper() + "_STREAM_";
+    QString fieldSizeMacro = "LCSF_BRIDGE_" + protocolName.toUpper() + "_FIELD_SIZE";
+    bool hasRxStream = false;
 
-    if (attNb > 0) {
-        if (attNb <= 8) {
-            typeString = "uint8_t " + varName;
-        } else if (attNb <= 16) {
-            typeString = "uint16_t " + varName;
-        } else if (attNb <= 32) {
-            typeString = "uint32_t " + varName;
-        } else {
-            int ByteNb = attNb / 8;
-            if (attNb % 8 != 0)
-                ByteNb++;
-            typeString = "uint8_t ";
-            typeString.append(varName + "[");
-            typeString.append(QString::number(ByteNb));
-            typeString.append("] ");
-        }
+    if (!this->hasStreamAtt(cmdList)) {
+        return;
     }
-    return typeString;
-}
-
-QString CodeGenerator::getTypeStringFromDataType(NS_AttDataType::T_AttDataType dataType) {
-    QString typeString;
-    switch (dataType) {
-        case NS_AttDataType::UINT8:
-            typeString = "uint8_t ";
+    switch (section) {
+        case BRIDGE_H_CONSTANTS:
+            {
+                int maxDepth = 1;
+                for (Command *command : cmdList) {
+                    maxDepth = qMax(maxDepth, this->getNestingDepth_Rec(command->getAttArray()));
+                }
+                *pOut << "// Stream decoder attribute nesting depth" << Qt::endl;
+                *pOut << "#define LCSF_BRIDGE_" << protocolName.toUpper() << "_STREAM_DEPTH " << maxDepth << Qt::endl;
+            }
             break;
 
-        case NS_AttDataType::UINT16:
-            typeString = "uint16_t ";
+        case BRIDGE_H_TYPES:
+            *pOut << "// Streamed attribute body callback, returns false to drop the frame" << Qt::endl;
+            *pOut << "typedef bool (*lcsf_bridge_" << protocolName.toLower()
+                  << "_body_cb_t)(void *pCbData, uint_fast16_t cmdName, const uint8_t *pChunk, size_t chunkSize, "
+                  << "size_t bodyLeft);" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "// Stream decoder state, the frame is kept in the buffer except for the streamed attribute body"
+                  << Qt::endl;
+            *pOut << "typedef struct _lcsf_bridge_" << protocolName.toLower() << "_rx_stream {" << Qt::endl;
+            *pOut << "    uint8_t *pBuffer;" << Qt::endl;
+            *pOut << "    size_t BuffSize;" << Qt::endl;
+            *pOut << "    size_t BuffIdx;" << Qt::endl;
+            *pOut << "    size_t FieldStart;" << Qt::endl;
+            *pOut << "    lcsf_bridge_" << protocolName.toLower() << "_body_cb_t pBodyCb;" << Qt::endl;
+            *pOut << "    void *pCbData;" << Qt::endl;
+            *pOut << "    uint_fast8_t State;" << Qt::endl;
+            *pOut << "    uint_fast8_t Depth;" << Qt::endl;
+            *pOut << "    uint_fast16_t AttLeft[LCSF_BRIDGE_" << protocolName.toUpper() << "_STREAM_DEPTH];" << Qt::endl;
+            *pOut << "    uint_fast16_t CmdId;" << Qt::endl;
+            *pOut << "    uint_fast16_t AttId;" << Qt::endl;
+            *pOut << "    size_t DataLeft;" << Qt::endl;
+            *pOut << "    bool IsBodyHere;" << Qt::endl;
+            *pOut << "    size_t BodySize;" << Qt::endl;
+            *pOut << "} lcsf_bridge_" << protocolName.toLower() << "_rx_stream_t;" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "// Stream encoder state" << Qt::endl;
+            *pOut << "typedef struct _lcsf_bridge_" << protocolName.toLower() << "_tx_stream {" << Qt::endl;
+            *pOut << "    size_t BodyLeft;" << Qt::endl;
+            *pOut << "} lcsf_bridge_" << protocolName.toLower() << "_tx_stream_t;" << Qt::endl;
+            *pOut << Qt::endl;
             break;
 
-        case NS_AttDataType::UINT32:
-            typeString = "uint32_t ";
+        case BRIDGE_H_PROTOTYPES:
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn int LCSF_Bridge_" << protocolName << "EncodeStreamHeader(uint_fast16_t cmdName, const "
+                  << protocolName.toLower() << "_cmd_payload_t *pCmdPayload, uint8_t *pBuffer, size_t buffSize, " << txParam
+                  << ")" << Qt::endl;
+            *pOut << " * \\brief Encode a command up to the size of its streamed attribute, the attribute data pointer is"
+                  << Qt::endl;
+            *pOut << " * not used and its body must be sent after the header, see LCSF_Bridge_" << protocolName
+                  << "EncodeStreamBody" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param cmdName name of the command" << Qt::endl;
+            *pOut << " * \\param pCmdPayload pointer to the command payload" << Qt::endl;
+            *pOut << " * \\param pBuffer pointer to the header buffer" << Qt::endl;
+            *pOut << " * \\param buffSize buffer size" << Qt::endl;
+            *pOut << " * \\param pStream pointer to the stream encoder state" << Qt::endl;
+            *pOut << " * \\return int: -1 if operation failed or the command has no streamed attribute, header size if"
+                  << " success" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "int LCSF_Bridge_" << protocolName << "EncodeStreamHeader(uint_fast16_t cmdName, const "
+                  << protocolName.toLower() << "_cmd_payload_t *pCmdPayload, uint8_t *pBuffer, size_t buffSize, " << txParam
+                  << ");" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn int LCSF_Bridge_" << protocolName << "EncodeStreamBody(" << txParam << ", size_t chunkSize)"
+                  << Qt::endl;
+            *pOut << " * \\brief Account for a body chunk sent after the header, chunks can have any size" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pStream pointer to the stream encoder state" << Qt::endl;
+            *pOut << " * \\param chunkSize chunk size" << Qt::endl;
+            *pOut << " * \\return int: -1 if the chunk overflows the body, remaining body size if success" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "int LCSF_Bridge_" << protocolName << "EncodeStreamBody(" << txParam << ", size_t chunkSize);"
+                  << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn void LCSF_Bridge_" << protocolName << "StreamInit(" << rxParam
+                  << ", uint8_t *pBuffer, size_t buffSize, lcsf_bridge_" << protocolName.toLower()
+                  << "_body_cb_t pBodyCb, void *pCbData)" << Qt::endl;
+            *pOut << " * \\brief Initialize a stream decoder, the buffer only holds the frame without the streamed body"
+                  << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pStream pointer to the stream decoder state" << Qt::endl;
+            *pOut << " * \\param pBuffer pointer to the frame buffer" << Qt::endl;
+            *pOut << " * \\param buffSize buffer size" << Qt::endl;
+            *pOut << " * \\param pBodyCb callback receiving the streamed attribute body chunks" << Qt::endl;
+            *pOut << " * \\param pCbData pointer passed to the callback" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "void LCSF_Bridge_" << protocolName << "StreamInit(" << rxParam
+                  << ", uint8_t *pBuffer, size_t buffSize, lcsf_bridge_" << protocolName.toLower()
+                  << "_body_cb_t pBodyCb, void *pCbData);" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn bool LCSF_Bridge_" << protocolName << "StreamReceive(" << bridgeCtxParam << rxParam
+                  << ", const uint8_t *pData, size_t dataSize)" << Qt::endl;
+            *pOut << " * \\brief Feed received bytes of any size to a stream decoder, the streamed attribute body is given"
+                  << Qt::endl;
+            *pOut << " * to the callback as it arrives and the command is ";
+            if (this->deferredMode) {
+                *pOut << "queued for " << protocolName << "_MainPoll once complete, with" << Qt::endl;
+                *pOut << " * the streamed attribute data set to NULL and its size to the body size. Byte array and string"
+                      << Qt::endl;
+                *pOut << " * payloads point to the stream buffer, the next frame overwrites them" << Qt::endl;
+            } else {
+                *pOut << "transmitted to " << protocolName << "_Main once complete, with" << Qt::endl;
+                *pOut << " * the streamed attribute data set to NULL and its size to the body size" << Qt::endl;
+            }
+            *pOut << " *" << Qt::endl;
+            if (this->reentrantMode) {
+                *pOut << " * \\param pCtx pointer to the bridge context" << Qt::endl;
+            }
+            *pOut << " * \\param pStream pointer to the stream decoder state" << Qt::endl;
+            *pOut << " * \\param pData pointer to the received bytes" << Qt::endl;
+            *pOut << " * \\param dataSize number of received bytes" << Qt::endl;
+            *pOut << " * \\return bool: false if a frame was invalid or dropped, the decoder then waits for a new frame"
+                  << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "bool LCSF_Bridge_" << protocolName << "StreamReceive(" << bridgeCtxParam << rxParam
+                  << ", const uint8_t *pData, size_t dataSize);" << Qt::endl;
+            *pOut << Qt::endl;
             break;
 
-        case NS_AttDataType::UINT64:
-            typeString = "uint64_t ";
+        case BRIDGE_C_TYPES:
+            *pOut << "// Stream decoder states" << Qt::endl;
+            *pOut << "enum _lcsf_bridge_" << protocolName.toLower() << "_stream_state {" << Qt::endl;
+            *pOut << "    " << streamState << "PROT_ID," << Qt::endl;
+            *pOut << "    " << streamState << "CMD_ID," << Qt::endl;
+            *pOut << "    " << streamState << "ATT_NB," << Qt::endl;
+            *pOut << "    " << streamState << "ATT_ID," << Qt::endl;
+            *pOut << "    " << streamState << "ATT_SIZE," << Qt::endl;
+            *pOut << "    " << streamState << "DATA," << Qt::endl;
+            *pOut << "    " << streamState << "BODY," << Qt::endl;
+            *pOut << "};" << Qt::endl;
+            *pOut << Qt::endl;
             break;
 
-        case NS_AttDataType::FLOAT32:
-            typeString = "float ";
+        case BRIDGE_C_PROTOTYPES:
+            *pOut << "static bool LCSF_Bridge_" << protocolName << "StreamIsBody(uint_fast16_t cmdId, uint_fast16_t attId);"
+                  << Qt::endl;
+            *pOut << "static void LCSF_Bridge_" << protocolName << "StreamReset(" << rxParam << ");" << Qt::endl;
+            *pOut << "static bool LCSF_Bridge_" << protocolName << "StreamEndAtt(" << rxParam << ");" << Qt::endl;
+            *pOut << "static int LCSF_Bridge_" << protocolName << "StreamField(" << rxParam << ", uint_fast16_t value);"
+                  << Qt::endl;
+            *pOut << "static int LCSF_Bridge_" << protocolName << "StreamDecode(" << rxParam << ", uint16_t *pCmdName, "
+                  << protocolName.toLower() << "_cmd_payload_t *pCmdPayload);" << Qt::endl;
+            *pOut << "static bool LCSF_Bridge_" << protocolName << "StreamDispatch(" << bridgeCtxParam << rxParam << ");"
+                  << Qt::endl;
             break;
 
-        case NS_AttDataType::FLOAT64:
-            typeString = "double ";
-            break;
+        case BRIDGE_C_PRIVATE_FCTS:
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn static bool LCSF_Bridge_" << protocolName
+                  << "StreamIsBody(uint_fast16_t cmdId, uint_fast16_t attId)" << Qt::endl;
+            *pOut << " * \\brief Tell if a top level attribute is a streamed attribute" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param cmdId command identifier" << Qt::endl;
+            *pOut << " * \\param attId attribute identifier" << Qt::endl;
+            *pOut << " * \\return bool: true if the attribute is streamed" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "static bool LCSF_Bridge_" << protocolName << "StreamIsBody(uint_fast16_t cmdId, uint_fast16_t attId) {"
+                  << Qt::endl;
+            for (Command *command : cmdList) {
+                if ((this->getStreamAtt(command) != nullptr) && command->isReceivable(isA)) {
+                    hasRxStream = true;
+                }
+            }
+            if (hasRxStream) {
+                *pOut << "    switch (cmdId) {" << Qt::endl;
+                for (Command *command : cmdList) {
+                    Attribute *pStreamAtt = this->getStreamAtt(command);
+                    if ((pStreamAtt == nullptr) || !command->isReceivable(isA)) {
+                        continue;
+                    }
+                    *pOut << "        case LCSF_" << protocolName.toUpper() << "_CMD_ID_" << command->getName().toUpper()
+                          << ":" << Qt::endl;
+                    *pOut << "            return (attId == LCSF_" << protocolName.toUpper() << "_"
+                          << command->getName().toUpper() << "_ATT_ID_" << pStreamAtt->getName().toUpper() << ");"
+                          << Qt::endl;
+                    *pOut << Qt::endl;
+                }
+                *pOut << "        default:" << Qt::endl;
+                *pOut << "            return false;" << Qt::endl;
+                *pOut << "    }" << Qt::endl;
+            } else {
+                *pOut << "    // No streamed attribute is received on this side" << Qt::endl;
+                *pOut << "    (void)cmdId;" << Qt::endl;
+                *pOut << "    (void)attId;" << Qt::endl;
+                *pOut << "    return false;" << Qt::endl;
+            }
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
 
-        case NS_AttDataType::BYTE_ARRAY:
-            typeString = "uint8_t *";
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn static void LCSF_Bridge_" << protocolName << "StreamReset(" << rxParam << ")" << Qt::endl;
+            *pOut << " * \\brief Make a stream decoder wait for a new frame" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pStream pointer to the stream decoder state" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "static void LCSF_Bridge_" << protocolName << "StreamReset(" << rxParam << ") {" << Qt::endl;
+            *pOut << "    pStream->BuffIdx = 0;" << Qt::endl;
+            *pOut << "    pStream->FieldStart = 0;" << Qt::endl;
+            *pOut << "    pStream->State = " << streamState << "PROT_ID;" << Qt::endl;
+            *pOut << "    pStream->Depth = 0;" << Qt::endl;
+            *pOut << "    pStream->IsBodyHere = false;" << Qt::endl;
+            *pOut << "    pStream->BodySize = 0;" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn static bool LCSF_Bridge_" << protocolName << "StreamEndAtt(" << rxParam << ")" << Qt::endl;
+            *pOut << " * \\brief Count a complete attribute, and the complex attributes it completes" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pStream pointer to the stream decoder state" << Qt::endl;
+            *pOut << " * \\return bool: true if the frame is complete" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "static bool LCSF_Bridge_" << protocolName << "StreamEndAtt(" << rxParam << ") {" << Qt::endl;
+            *pOut << "    pStream->State = " << streamState << "ATT_ID;" << Qt::endl;
+            *pOut << "    while (--(pStream->AttLeft[pStream->Depth]) == 0) {" << Qt::endl;
+            *pOut << "        if (pStream->Depth == 0) {" << Qt::endl;
+            *pOut << "            return true;" << Qt::endl;
+            *pOut << "        }" << Qt::endl;
+            *pOut << "        pStream->Depth--;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    return false;" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn static int LCSF_Bridge_" << protocolName << "StreamField(" << rxParam
+                  << ", uint_fast16_t value)" << Qt::endl;
+            *pOut << " * \\brief Process a complete frame field" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pStream pointer to the stream decoder state" << Qt::endl;
+            *pOut << " * \\param value field value" << Qt::endl;
+            *pOut << " * \\return int: -1 if the frame is invalid, 1 if the frame is complete, 0 otherwise" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "static int LCSF_Bridge_" << protocolName << "StreamField(" << rxParam << ", uint_fast16_t value) {"
+                  << Qt::endl;
+            *pOut << "    switch (pStream->State) {" << Qt::endl;
+            *pOut << "        case " << streamState << "PROT_ID:" << Qt::endl;
+            *pOut << "            if (value != LCSF_" << protocolName.toUpper() << "_PROTOCOL_ID) {" << Qt::endl;
+            *pOut << "                return -1;" << Qt::endl;
+            *pOut << "            }" << Qt::endl;
+            *pOut << "            pStream->State = " << streamState << "CMD_ID;" << Qt::endl;
+            *pOut << "            return 0;" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "        case " << streamState << "CMD_ID:" << Qt::endl;
+            *pOut << "            pStream->CmdId = value;" << Qt::endl;
+            *pOut << "            pStream->State = " << streamState << "ATT_NB;" << Qt::endl;
+            *pOut << "            return 0;" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "        case " << streamState << "ATT_NB:" << Qt::endl;
+            *pOut << "            if (value == 0) {" << Qt::endl;
+            *pOut << "                return 1;" << Qt::endl;
+            *pOut << "            }" << Qt::endl;
+            *pOut << "            pStream->AttLeft[0] = value;" << Qt::endl;
+            *pOut << "            pStream->State = " << streamState << "ATT_ID;" << Qt::endl;
+            *pOut << "            return 0;" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "        case " << streamState << "ATT_ID:" << Qt::endl;
+            *pOut << "            pStream->AttId = value;" << Qt::endl;
+            *pOut << "            pStream->State = " << streamState << "ATT_SIZE;" << Qt::endl;
+            *pOut << "            return 0;" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "        case " << streamState << "ATT_SIZE:" << Qt::endl;
+            *pOut << "            // Complex attribute size field holds its sub-attribute number" << Qt::endl;
+            *pOut << "            if ((pStream->AttId & LCSF_BRIDGE_" << protocolName.toUpper() << "_CMPLX_FLAG) != 0) {"
+                  << Qt::endl;
+            *pOut << "                if (value == 0) {" << Qt::endl;
+            *pOut << "                    return (LCSF_Bridge_" << protocolName << "StreamEndAtt(pStream)) ? 1 : 0;"
+                  << Qt::endl;
+            *pOut << "                }" << Qt::endl;
+            *pOut << "                if ((pStream->Depth + 1) >= LCSF_BRIDGE_" << protocolName.toUpper()
+                  << "_STREAM_DEPTH) {" << Qt::endl;
+            *pOut << "                    return -1;" << Qt::endl;
+            *pOut << "                }" << Qt::endl;
+            *pOut << "                pStream->Depth++;" << Qt::endl;
+            *pOut << "                pStream->AttLeft[pStream->Depth] = value;" << Qt::endl;
+            *pOut << "                pStream->State = " << streamState << "ATT_ID;" << Qt::endl;
+            *pOut << "                return 0;" << Qt::endl;
+            *pOut << "            }" << Qt::endl;
+            *pOut << "            if ((pStream->Depth == 0) && LCSF_Bridge_" << protocolName
+                  << "StreamIsBody(pStream->CmdId, pStream->AttId)) {" << Qt::endl;
+            *pOut << "                if (pStream->IsBodyHere) {" << Qt::endl;
+            *pOut << "                    return -1;" << Qt::endl;
+            *pOut << "                }" << Qt::endl;
+            *pOut << "                pStream->IsBodyHere = true;" << Qt::endl;
+            *pOut << "                pStream->BodySize = value;" << Qt::endl;
+            *pOut << "                // The body is not buffered, the frame decoder sees an empty array" << Qt::endl;
+            *pOut << "                memset(&(pStream->pBuffer[pStream->FieldStart - " << fieldSizeMacro << "]), 0, "
+                  << fieldSizeMacro << ");" << Qt::endl;
+            *pOut << "                pStream->State = " << streamState << "BODY;" << Qt::endl;
+            *pOut << "            } else {" << Qt::endl;
+            *pOut << "                pStream->State = " << streamState << "DATA;" << Qt::endl;
+            *pOut << "            }" << Qt::endl;
+            *pOut << "            if (value == 0) {" << Qt::endl;
+            *pOut << "                return (LCSF_Bridge_" << protocolName << "StreamEndAtt(pStream)) ? 1 : 0;" << Qt::endl;
+            *pOut << "            }" << Qt::endl;
+            *pOut << "            pStream->DataLeft = value;" << Qt::endl;
+            *pOut << "            return 0;" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "        default:" << Qt::endl;
+            *pOut << "            return -1;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn static int LCSF_Bridge_" << protocolName << "StreamDecode(" << rxParam
+                  << ", uint16_t *pCmdName, " << protocolName.toLower() << "_cmd_payload_t *pCmdPayload)" << Qt::endl;
+            *pOut << " * \\brief Decode a complete stream frame, the streamed attribute only keeps its body size"
+                  << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pStream pointer to the stream decoder state" << Qt::endl;
+            *pOut << " * \\param pCmdName pointer to contain the command name" << Qt::endl;
+            *pOut << " * \\param pCmdPayload pointer to the payload to contain the command data" << Qt::endl;
+            *pOut << " * \\return int: -1 if the frame is invalid, decoded frame size if success" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "static int LCSF_Bridge_" << protocolName << "StreamDecode(" << rxParam << ", uint16_t *pCmdName, "
+                  << protocolName.toLower() << "_cmd_payload_t *pCmdPayload) {" << Qt::endl;
+            *pOut << "    int ret = LCSF_Bridge_" << protocolName
+                  << "Decode(pStream->pBuffer, pStream->BuffIdx, pCmdName, pCmdPayload);" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "    if ((ret < 0) || !pStream->IsBodyHere) {" << Qt::endl;
+            *pOut << "        return ret;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    switch (*pCmdName) {" << Qt::endl;
+            for (Command *command : cmdList) {
+                Attribute *pStreamAtt = this->getStreamAtt(command);
+                if ((pStreamAtt == nullptr) || !command->isReceivable(isA)) {
+                    continue;
+                }
+                QString payloadPath = "pCmdPayload->" + this->getPayloadPath({command->getName()});
+                *pOut << "        case " << protocolName.toUpper() << "_CMD_" << command->getName().toUpper() << ":"
+                      << Qt::endl;
+                *pOut << "            " << payloadPath << "p_" << pStreamAtt->getName().toLower() << " = NULL;" << Qt::endl;
+                *pOut << "            " << payloadPath << pStreamAtt->getName().toLower() << "Size = pStream->BodySize;"
+                      << Qt::endl;
+                *pOut << "            break;" << Qt::endl;
+                *pOut << Qt::endl;
+            }
+            *pOut << "        default:" << Qt::endl;
+            *pOut << "            break;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    return ret;" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn static bool LCSF_Bridge_" << protocolName << "StreamDispatch(" << bridgeCtxParam << rxParam
+                  << ")" << Qt::endl;
+            if (this->deferredMode) {
+                *pOut << " * \\brief Decode a complete stream frame and queue it for " << protocolName << "_MainPoll"
+                      << Qt::endl;
+            } else {
+                *pOut << " * \\brief Decode a complete stream frame and transmit it to " << protocolName << "_Main"
+                      << Qt::endl;
+            }
+            *pOut << " *" << Qt::endl;
+            if (this->reentrantMode) {
+                *pOut << " * \\param pCtx pointer to the bridge context" << Qt::endl;
+            }
+            *pOut << " * \\param pStream pointer to the stream decoder state" << Qt::endl;
+            *pOut << " * \\return bool: true if operation was a success" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "static bool LCSF_Bridge_" << protocolName << "StreamDispatch(" << bridgeCtxParam << rxParam << ") {"
+                  << Qt::endl;
+            this->writeFrameDispatch(protocolName, "LCSF_Bridge_" + protocolName + "StreamDecode(pStream", pOut);
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
             break;
 
-        case NS_AttDataType::STRING:
-            typeString = "char *";
+        case BRIDGE_C_PUBLIC_FCTS:
+            *pOut << Qt::endl;
+            *pOut << "int LCSF_Bridge_" << protocolName << "EncodeStreamHeader(uint_fast16_t cmdName, const "
+                  << protocolName.toLower() << "_cmd_payload_t *pCmdPayload, uint8_t *pBuffer, size_t buffSize, " << txParam
+                  << ") {" << Qt::endl;
+            *pOut << "    // Without segment array the writer copies everything in the buffer" << Qt::endl;
+            *pOut << "    lcsf_bridge_" << protocolName.toLower()
+                  << "_seg_writer_t writer = {pBuffer, buffSize, 0, 0, NULL, 0, 0};" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "    pStream->BodyLeft = 0;" << Qt::endl;
+            *pOut << "    if (!LCSF_Bridge_" << protocolName << "WriteField(&writer, LCSF_" << protocolName.toUpper()
+                  << "_PROTOCOL_ID) ||" << Qt::endl;
+            *pOut << "        !LCSF_Bridge_" << protocolName << "WriteField(&writer, LCSF_Bridge_" << protocolName
+                  << "_CMDNAME2CMDID[cmdName])) {" << Qt::endl;
+            *pOut << "        return -1;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    switch (cmdName) {" << Qt::endl;
+            for (Command *command : cmdList) {
+                Attribute *pStreamAtt = this->getStreamAtt(command);
+                if ((pStreamAtt == nullptr) || !command->isTransmittable(isA)) {
+                    continue;
+                }
+                QString payloadPath = "pCmdPayload->" + this->getPayloadPath({command->getName()});
+                *pOut << "        case " << protocolName.toUpper() << "_CMD_" << command->getName().toUpper() << ":"
+                      << Qt::endl;
+                *pOut << "            if (!LCSF_Bridge_" << protocolName << command->getName()
+                      << "EncodeStream(&writer, pCmdPayload)) {" << Qt::endl;
+                *pOut << "                return -1;" << Qt::endl;
+                *pOut << "            }" << Qt::endl;
+                if (pStreamAtt->getIsOptional()) {
+                    *pOut << "            if ((" << payloadPath << "optAttFlagsBitfield & " << protocolName.toUpper() << "_"
+                          << command->getName().toUpper() << "_ATT_" << pStreamAtt->getName().toUpper() << "_FLAG) != 0) {"
+                          << Qt::endl;
+                    *pOut << "                pStream->BodyLeft = " << payloadPath << pStreamAtt->getName().toLower()
+                          << "Size;" << Qt::endl;
+                    *pOut << "            }" << Qt::endl;
+                } else {
+                    *pOut << "            pStream->BodyLeft = " << payloadPath << pStreamAtt->getName().toLower()
+                          << "Size;" << Qt::endl;
+                }
+                *pOut << "            break;" << Qt::endl;
+                *pOut << Qt::endl;
+            }
+            *pOut << "        default: // Commands that don't have a streamed attribute" << Qt::endl;
+            *pOut << "            return -1;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    return (int)writer.HeaderIdx;" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+
+            *pOut << "int LCSF_Bridge_" << protocolName << "EncodeStreamBody(" << txParam << ", size_t chunkSize) {"
+                  << Qt::endl;
+            *pOut << "    if (chunkSize > pStream->BodyLeft) {" << Qt::endl;
+            *pOut << "        return -1;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    pStream->BodyLeft -= chunkSize;" << Qt::endl;
+            *pOut << "    return (int)pStream->BodyLeft;" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+
+            *pOut << "void LCSF_Bridge_" << protocolName << "StreamInit(" << rxParam
+                  << ", uint8_t *pBuffer, size_t buffSize, lcsf_bridge_" << protocolName.toLower()
+                  << "_body_cb_t pBodyCb, void *pCbData) {" << Qt::endl;
+            *pOut << "    pStream->pBuffer = pBuffer;" << Qt::endl;
+            *pOut << "    pStream->BuffSize = buffSize;" << Qt::endl;
+            *pOut << "    pStream->pBodyCb = pBodyCb;" << Qt::endl;
+            *pOut << "    pStream->pCbData = pCbData;" << Qt::endl;
+            *pOut << "    LCSF_Bridge_" << protocolName << "StreamReset(pStream);" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+
+            *pOut << "bool LCSF_Bridge_" << protocolName << "StreamReceive(" << bridgeCtxParam << rxParam
+                  << ", const uint8_t *pData, size_t dataSize) {" << Qt::endl;
+            *pOut << "    size_t idx = 0;" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "    while (idx < dataSize) {" << Qt::endl;
+            *pOut << "        bool isData = (pStream->State == " << streamState << "DATA) || (pStream->State == "
+                  << streamState << "BODY);" << Qt::endl;
+            *pOut << "        size_t chunkSize = dataSize - idx;" << Qt::endl;
+            *pOut << "        int ret = 0;" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "        // Stop at the end of the current data or field" << Qt::endl;
+            *pOut << "        if (isData) {" << Qt::endl;
+            *pOut << "            chunkSize = (chunkSize < pStream->DataLeft) ? chunkSize : pStream->DataLeft;" << Qt::endl;
+            *pOut << "        } else {" << Qt::endl;
+            *pOut << "            size_t fieldLeft = " << fieldSizeMacro << " - (pStream->BuffIdx - pStream->FieldStart);"
+                  << Qt::endl;
+            *pOut << "            chunkSize = (chunkSize < fieldLeft) ? chunkSize : fieldLeft;" << Qt::endl;
+            *pOut << "        }" << Qt::endl;
+            *pOut << "        if (pStream->State == " << streamState << "BODY) {" << Qt::endl;
+            *pOut << "            pStream->DataLeft -= chunkSize;" << Qt::endl;
+            *pOut << "            if (!pStream->pBodyCb(pStream->pCbData, LCSF_Bridge_" << protocolName
+                  << "_CMDID2CMDNAME(pStream->CmdId), &(pData[idx]), chunkSize," << Qt::endl;
+            *pOut << "                    pStream->DataLeft)) {" << Qt::endl;
+            *pOut << "                LCSF_Bridge_" << protocolName << "StreamReset(pStream);" << Qt::endl;
+            *pOut << "                return false;" << Qt::endl;
+            *pOut << "            }" << Qt::endl;
+            *pOut << "        } else {" << Qt::endl;
+            *pOut << "            if ((pStream->BuffSize - pStream->BuffIdx) < chunkSize) {" << Qt::endl;
+            *pOut << "                LCSF_Bridge_" << protocolName << "StreamReset(pStream);" << Qt::endl;
+            *pOut << "                return false;" << Qt::endl;
+            *pOut << "            }" << Qt::endl;
+            *pOut << "            memcpy(&(pStream->pBuffer[pStream->BuffIdx]), &(pData[idx]), chunkSize);" << Qt::endl;
+            *pOut << "            pStream->BuffIdx += chunkSize;" << Qt::endl;
+            *pOut << "            if (isData) {" << Qt::endl;
+            *pOut << "                pStream->DataLeft -= chunkSize;" << Qt::endl;
+            *pOut << "            }" << Qt::endl;
+            *pOut << "        }" << Qt::endl;
+            *pOut << "        idx += chunkSize;" << Qt::endl;
+            *pOut << "        if (isData) {" << Qt::endl;
+            *pOut << "            if (pStream->DataLeft == 0) {" << Qt::endl;
+            *pOut << "                pStream->FieldStart = pStream->BuffIdx;" << Qt::endl;
+            *pOut << "                ret = (LCSF_Bridge_" << protocolName << "StreamEndAtt(pStream)) ? 1 : 0;" << Qt::endl;
+            *pOut << "            }" << Qt::endl;
+            *pOut << "        } else if ((pStream->BuffIdx - pStream->FieldStart) == " << fieldSizeMacro << ") {"
+                  << Qt::endl;
+            *pOut << "            uint_fast16_t value;" << Qt::endl;
+            *pOut << "            (void)LCSF_Bridge_" << protocolName
+                  << "ReadField(pStream->pBuffer, pStream->BuffIdx, &(pStream->FieldStart), &value);" << Qt::endl;
+            *pOut << "            ret = LCSF_Bridge_" << protocolName << "StreamField(pStream, value);" << Qt::endl;
+            *pOut << "        }" << Qt::endl;
+            *pOut << "        if (ret < 0) {" << Qt::endl;
+            *pOut << "            LCSF_Bridge_" << protocolName << "StreamReset(pStream);" << Qt::endl;
+            *pOut << "            return false;" << Qt::endl;
+            *pOut << "        }" << Qt::endl;
+            *pOut << "        if (ret > 0) {" << Qt::endl;
+            *pOut << "            bool isOk = LCSF_Bridge_" << protocolName << "StreamDispatch("
+                  << ((this->reentrantMode) ? "pCtx, " : "") << "pStream);" << Qt::endl;
+            *pOut << "            LCSF_Bridge_" << protocolName << "StreamReset(pStream);" << Qt::endl;
+            *pOut << "            if (!isOk) {" << Qt::endl;
+            *pOut << "                return false;" << Qt::endl;
+            *pOut << "            }" << Qt::endl;
+            *pOut << "        }" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    return true;" << Qt::endl;
+            *pOut << "}" << Qt::endl;
             break;
 
         default:
-            typeString = "void *";
             break;
     }
-    return typeString;
 }
 
-QString CodeGenerator::getInitStringFromDataType(NS_AttDataType::T_AttDataType dataType) {
-    QString initString;
-    switch (dataType) {
-        case NS_AttDataType::UINT8:
-        case NS_AttDataType::UINT16:
-        case NS_AttDataType::UINT32:
-        case NS_AttDataType::UINT64:
-        case NS_AttDataType::FLOAT32:
-        case NS_AttDataType::FLOAT64:
-        default:
-            initString = " = 0";
+void CodeGenerator::writeBridgeStats(
+    QString protocolName, QList<Command *> cmdList, T_BridgeSection section, QTextStream *pOut) {
+    QString statePrefix = (this->reentrantMode) ? QString("pCtx->") : "LcsfBridge" + protocolName + "Info.";
+    QString pStats = "&(" + statePrefix + "Stats)";
+    QString statsPrefix = "LCSF_Bridge_" + protocolName + "Stats";
+    QString hookPrefix = "LCSF_BRIDGE_" + protocolName.toUpper() + "_HOOK_";
+    QString statsType = "lcsf_bridge_" + protocolName.toLower() + "_stats_t";
+    QString bridgeCtxOnly = this->getBridgeCtxParam(protocolName, true);
+    QString statsParam = "lcsf_bridge_" + protocolName.toLower() + "_stats_t *pStats, uint_fast16_t cmdName";
+    QString cmdNb = "LCSF_" + protocolName.toUpper() + "_CMD_NB";
+
+    if (!this->instrumentMode) {
+        return;
+    }
+    switch (section) {
+        case BRIDGE_H_CONSTANTS:
+            *pOut << "// Instrumentation hooks, define LCSF_BRIDGE_" << protocolName.toUpper() << "_NO_STATS to remove them"
+                  << Qt::endl;
+            *pOut << "#ifndef LCSF_BRIDGE_" << protocolName.toUpper() << "_NO_STATS" << Qt::endl;
+            *pOut << "#define LCSF_BRIDGE_" << protocolName.toUpper() << "_STATS" << Qt::endl;
+            *pOut << "#endif" << Qt::endl;
+            *pOut << "// Cycle counter timing the commands, e.g. #define LCSF_BRIDGE_" << protocolName.toUpper()
+                  << "_CYCLES() DWT->CYCCNT" << Qt::endl;
+            *pOut << "#ifndef LCSF_BRIDGE_" << protocolName.toUpper() << "_CYCLES" << Qt::endl;
+            *pOut << "#define LCSF_BRIDGE_" << protocolName.toUpper() << "_CYCLES() 0u" << Qt::endl;
+            *pOut << "#endif" << Qt::endl;
             break;
 
-        case NS_AttDataType::BYTE_ARRAY:
-        case NS_AttDataType::STRING:
-            initString = " = NULL";
+        case BRIDGE_H_TYPES:
+            *pOut << "#ifdef LCSF_BRIDGE_" << protocolName.toUpper() << "_STATS" << Qt::endl;
+            *pOut << "// Instrumentation failure reasons" << Qt::endl;
+            *pOut << "enum _lcsf_bridge_" << protocolName.toLower() << "_fail {" << Qt::endl;
+            for (QPair<QString, QString> reason : this->getFailReasons(protocolName)) {
+                *pOut << "    LCSF_BRIDGE_" << protocolName.toUpper() << "_FAIL_" << reason.first << ", // " << reason.second
+                      << Qt::endl;
+            }
+            *pOut << "    LCSF_BRIDGE_" << protocolName.toUpper() << "_FAIL_NB," << Qt::endl;
+            *pOut << "};" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "// Per command statistics, timings are in LCSF_BRIDGE_" << protocolName.toUpper() << "_CYCLES units"
+                  << Qt::endl;
+            *pOut << "typedef struct _lcsf_bridge_" << protocolName.toLower() << "_cmd_stats {" << Qt::endl;
+            this->writeCFields(this->getCmdStatsFields(), pOut);
+            *pOut << "} lcsf_bridge_" << protocolName.toLower() << "_cmd_stats_t;" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "// Bridge statistics, commands are indexed by name, failures without a command use LCSF_"
+                  << protocolName.toUpper() << "_CMD_NB" << Qt::endl;
+            *pOut << "// Receive failures (decode, queue full) are kept apart from the handler and encode ones, so the"
+                  << Qt::endl;
+            *pOut << "// receive context and the context executing the commands never write the same counter" << Qt::endl;
+            *pOut << "typedef struct _lcsf_bridge_" << protocolName.toLower() << "_stats {" << Qt::endl;
+            this->writeCFields(this->getStatsFields(protocolName, cmdList.size()), pOut);
+            *pOut << "} " << statsType << ";" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "// Instrumentation hooks" << Qt::endl;
+            *pOut << "#define " << hookPrefix << "START(var) uint32_t var = LCSF_BRIDGE_" << protocolName.toUpper()
+                  << "_CYCLES()" << Qt::endl;
+            *pOut << "#define " << hookPrefix << "RX(pStats, cmdName, frameSize, start) \\" << Qt::endl;
+            *pOut << "    " << statsPrefix << "Rx(pStats, cmdName, frameSize, (uint32_t)(LCSF_BRIDGE_"
+                  << protocolName.toUpper() << "_CYCLES() - (start)))" << Qt::endl;
+            *pOut << "#define " << hookPrefix << "HANDLER(pStats, cmdName, isOk, start) \\" << Qt::endl;
+            *pOut << "    " << statsPrefix << "Handler(pStats, cmdName, isOk, (uint32_t)(LCSF_BRIDGE_"
+                  << protocolName.toUpper() << "_CYCLES() - (start)))" << Qt::endl;
+            *pOut << "#define " << hookPrefix << "TX(pStats, cmdName, frameSize, start) \\" << Qt::endl;
+            *pOut << "    " << statsPrefix << "Tx(pStats, cmdName, frameSize, (uint32_t)(LCSF_BRIDGE_"
+                  << protocolName.toUpper() << "_CYCLES() - (start)))" << Qt::endl;
+            *pOut << "#define " << hookPrefix << "FAIL(pStats, cmdName, reason) " << statsPrefix
+                  << "Fail(pStats, cmdName, reason)" << Qt::endl;
+            *pOut << "#else" << Qt::endl;
+            *pOut << "#define " << hookPrefix << "START(var)" << Qt::endl;
+            *pOut << "#define " << hookPrefix << "RX(pStats, cmdName, frameSize, start) ((void)0)" << Qt::endl;
+            *pOut << "#define " << hookPrefix << "HANDLER(pStats, cmdName, isOk, start) ((void)(isOk))" << Qt::endl;
+            *pOut << "#define " << hookPrefix << "TX(pStats, cmdName, frameSize, start) ((void)0)" << Qt::endl;
+            *pOut << "#define " << hookPrefix << "FAIL(pStats, cmdName, reason) ((void)0)" << Qt::endl;
+            *pOut << "#endif" << Qt::endl;
+            *pOut << Qt::endl;
+            break;
+
+        case BRIDGE_H_PROTOTYPES:
+            *pOut << "#ifdef LCSF_BRIDGE_" << protocolName.toUpper() << "_STATS" << Qt::endl;
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn lcsf_bridge_" << protocolName.toLower() << "_stats_t *LCSF_Bridge_" << protocolName
+                  << "GetStats(" << bridgeCtxOnly << ")" << Qt::endl;
+            *pOut << " * \\brief Get the bridge statistics, they are updated by the threads calling the bridge without"
+                  << Qt::endl;
+            *pOut << " * locking so read them from the same thread" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            if (this->reentrantMode) {
+                *pOut << " * \\param pCtx pointer to the bridge context" << Qt::endl;
+            }
+            *pOut << " * \\return lcsf_bridge_" << protocolName.toLower() << "_stats_t *: pointer to the statistics"
+                  << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "lcsf_bridge_" << protocolName.toLower() << "_stats_t *LCSF_Bridge_" << protocolName << "GetStats("
+                  << bridgeCtxOnly << ");" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn void LCSF_Bridge_" << protocolName << "ResetStats(" << bridgeCtxOnly << ")" << Qt::endl;
+            *pOut << " * \\brief Clear the bridge statistics" << Qt::endl;
+            if (this->reentrantMode) {
+                *pOut << " *" << Qt::endl;
+                *pOut << " * \\param pCtx pointer to the bridge context" << Qt::endl;
+            }
+            *pOut << " */" << Qt::endl;
+            *pOut << "void LCSF_Bridge_" << protocolName << "ResetStats(" << bridgeCtxOnly << ");" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn void LCSF_Bridge_" << protocolName << "StatsRx(" << statsParam
+                  << ", int frameSize, uint32_t cycles)" << Qt::endl;
+            *pOut << " * \\brief Record a received command, used by the hooks" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pStats pointer to the statistics" << Qt::endl;
+            *pOut << " * \\param cmdName name of the command" << Qt::endl;
+            *pOut << " * \\param frameSize decoded frame size, 0 when received through LCSF_Validator" << Qt::endl;
+            *pOut << " * \\param cycles decode duration" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "void LCSF_Bridge_" << protocolName << "StatsRx(" << statsParam << ", int frameSize, uint32_t cycles);"
+                  << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn void LCSF_Bridge_" << protocolName << "StatsHandler(" << statsParam
+                  << ", bool isOk, uint32_t cycles)" << Qt::endl;
+            *pOut << " * \\brief Record a command execution, used by the hooks" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pStats pointer to the statistics" << Qt::endl;
+            *pOut << " * \\param cmdName name of the command" << Qt::endl;
+            *pOut << " * \\param isOk " << protocolName << "_MainExecute return value" << Qt::endl;
+            *pOut << " * \\param cycles handler duration" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "void LCSF_Bridge_" << protocolName << "StatsHandler(" << statsParam << ", bool isOk, uint32_t cycles);"
+                  << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn void LCSF_Bridge_" << protocolName << "StatsTx(" << statsParam
+                  << ", int frameSize, uint32_t cycles)" << Qt::endl;
+            *pOut << " * \\brief Record an encoded command, used by the hooks" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pStats pointer to the statistics" << Qt::endl;
+            *pOut << " * \\param cmdName name of the command" << Qt::endl;
+            *pOut << " * \\param frameSize encoded frame size, -1 if the encoding failed" << Qt::endl;
+            *pOut << " * \\param cycles encode duration" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "void LCSF_Bridge_" << protocolName << "StatsTx(" << statsParam << ", int frameSize, uint32_t cycles);"
+                  << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "/**" << Qt::endl;
+            *pOut << " * \\fn void LCSF_Bridge_" << protocolName << "StatsFail(" << statsParam << ", uint_fast8_t reason)"
+                  << Qt::endl;
+            *pOut << " * \\brief Record a failure, used by the hooks" << Qt::endl;
+            *pOut << " *" << Qt::endl;
+            *pOut << " * \\param pStats pointer to the statistics" << Qt::endl;
+            *pOut << " * \\param cmdName name of the command, LCSF_" << protocolName.toUpper() << "_CMD_NB if unknown"
+                  << Qt::endl;
+            *pOut << " * \\param reason failure reason" << Qt::endl;
+            *pOut << " */" << Qt::endl;
+            *pOut << "void LCSF_Bridge_" << protocolName << "StatsFail(" << statsParam << ", uint_fast8_t reason);"
+                  << Qt::endl;
+            *pOut << "#endif" << Qt::endl;
+            *pOut << Qt::endl;
+            break;
+
+        case BRIDGE_C_PUBLIC_FCTS:
+            *pOut << Qt::endl;
+            *pOut << "#ifdef LCSF_BRIDGE_" << protocolName.toUpper() << "_STATS" << Qt::endl;
+            *pOut << "lcsf_bridge_" << protocolName.toLower() << "_stats_t *LCSF_Bridge_" << protocolName << "GetStats("
+                  << this->getBridgeCtxParam(protocolName, true) << ") {" << Qt::endl;
+            *pOut << "    return " << pStats << ";" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "void LCSF_Bridge_" << protocolName << "ResetStats(" << this->getBridgeCtxParam(protocolName, true)
+                  << ") {" << Qt::endl;
+            *pOut << "    memset(" << pStats << ", 0, sizeof(" << statePrefix << "Stats));" << Qt::endl;
+            *pOut << "    " << statePrefix << "Stats.RxLastFailCmdName = " << cmdNb << ";" << Qt::endl;
+            *pOut << "    " << statePrefix << "Stats.RxLastFail = LCSF_BRIDGE_" << protocolName.toUpper() << "_FAIL_NB;"
+                  << Qt::endl;
+            *pOut << "    " << statePrefix << "Stats.LastFailCmdName = " << cmdNb << ";" << Qt::endl;
+            *pOut << "    " << statePrefix << "Stats.LastFail = LCSF_BRIDGE_" << protocolName.toUpper() << "_FAIL_NB;"
+                  << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "void LCSF_Bridge_" << protocolName << "StatsRx(" << statsParam << ", int frameSize, uint32_t cycles) {"
+                  << Qt::endl;
+            *pOut << "    if (cmdName >= " << cmdNb << ") {" << Qt::endl;
+            *pOut << "        return;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    pStats->Cmd[cmdName].RxCount++;" << Qt::endl;
+            *pOut << "    pStats->Cmd[cmdName].RxBytes += (uint64_t)frameSize;" << Qt::endl;
+            *pOut << "    pStats->Cmd[cmdName].DecodeCycles += cycles;" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "void LCSF_Bridge_" << protocolName << "StatsHandler(" << statsParam
+                  << ", bool isOk, uint32_t cycles) {" << Qt::endl;
+            *pOut << "    if (cmdName < " << cmdNb << ") {" << Qt::endl;
+            *pOut << "        pStats->Cmd[cmdName].HandlerCycles += cycles;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    if (!isOk) {" << Qt::endl;
+            *pOut << "        LCSF_Bridge_" << protocolName << "StatsFail(pStats, cmdName, LCSF_BRIDGE_"
+                  << protocolName.toUpper() << "_FAIL_HANDLER);" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "void LCSF_Bridge_" << protocolName << "StatsTx(" << statsParam << ", int frameSize, uint32_t cycles) {"
+                  << Qt::endl;
+            *pOut << "    if (frameSize < 0) {" << Qt::endl;
+            *pOut << "        LCSF_Bridge_" << protocolName << "StatsFail(pStats, cmdName, LCSF_BRIDGE_"
+                  << protocolName.toUpper() << "_FAIL_ENCODE);" << Qt::endl;
+            *pOut << "        return;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    if (cmdName >= " << cmdNb << ") {" << Qt::endl;
+            *pOut << "        return;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    pStats->Cmd[cmdName].TxCount++;" << Qt::endl;
+            *pOut << "    pStats->Cmd[cmdName].TxBytes += (uint64_t)frameSize;" << Qt::endl;
+            *pOut << "    pStats->Cmd[cmdName].EncodeCycles += cycles;" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+            *pOut << "void LCSF_Bridge_" << protocolName << "StatsFail(" << statsParam << ", uint_fast8_t reason) {"
+                  << Qt::endl;
+            *pOut << "    if (reason >= LCSF_BRIDGE_" << protocolName.toUpper() << "_FAIL_NB) {" << Qt::endl;
+            *pOut << "        return;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    if (cmdName > " << cmdNb << ") {" << Qt::endl;
+            *pOut << "        cmdName = " << cmdNb << ";" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "    // Each reason is only counted by one context" << Qt::endl;
+            *pOut << "    pStats->FailCount[reason]++;" << Qt::endl;
+            *pOut << "    if ((reason == LCSF_BRIDGE_" << protocolName.toUpper()
+                  << "_FAIL_DECODE) || (reason == LCSF_BRIDGE_"
+                  << protocolName.toUpper() << "_FAIL_QUEUE_FULL)) {" << Qt::endl;
+            *pOut << "        if (cmdName < " << cmdNb << ") {" << Qt::endl;
+            *pOut << "            pStats->Cmd[cmdName].RxFailCount++;" << Qt::endl;
+            *pOut << "        }" << Qt::endl;
+            *pOut << "        pStats->RxLastFailCmdName = (uint16_t)cmdName;" << Qt::endl;
+            *pOut << "        pStats->RxLastFail = (uint8_t)reason;" << Qt::endl;
+            *pOut << "    } else {" << Qt::endl;
+            *pOut << "        if (cmdName < " << cmdNb << ") {" << Qt::endl;
+            *pOut << "            pStats->Cmd[cmdName].FailCount++;" << Qt::endl;
+            *pOut << "        }" << Qt::endl;
+            *pOut << "        pStats->LastFailCmdName = (uint16_t)cmdName;" << Qt::endl;
+            *pOut << "        pStats->LastFail = (uint8_t)reason;" << Qt::endl;
+            *pOut << "    }" << Qt::endl;
+            *pOut << "}" << Qt::endl;
+            *pOut << "#endif" << Qt::endl;
+            break;
+
+        default:
             break;
     }
-    return initString;
 }
 
-QString CodeGenerator::getAttDescString(QString protocolName, QString parentName, Attribute *attribute) {
-    QString descString = "";
-    if (attribute != nullptr) {
-        // Optionality
-        if (attribute->getIsOptional()) {
-            descString.append("true, ");
-        } else {
-            descString.append("false, ");
-        }
-        // Type
-        descString.append(NS_AttDataType::SL_AttDataType.at(attribute->getDataType()) + ", ");
-        // Id
-        descString.append("LCSF_" + protocolName.toUpper() + "_" + parentName.toUpper() + "_ATT_ID_" +
-            attribute->getName().toUpper() + ", ");
-        // Sub-attributes descriptor
+void CodeGenerator::writeHandlerCall(QString protocolName, QString pStats, QString cmdName, QTextStream *pOut) {
+    QString hookPrefix = "LCSF_BRIDGE_" + protocolName.toUpper() + "_HOOK_";
+
+    // The handler is timed here as the extractor regenerates the whole execute function
+    *pOut << "    " << hookPrefix << "START(handlerStart);" << Qt::endl;
+    *pOut << "    bool isOk = " << protocolName << "_MainExecute(" << ((this->reentrantMode) ? "pCtx->pMainCtx, " : "")
+          << cmdName << ", pCmdPayload);" << Qt::endl;
+    *pOut << "    " << hookPrefix << "HANDLER(" << pStats << ", " << cmdName << ", isOk, handlerStart);" << Qt::endl;
+    *pOut << "    return isOk;" << Qt::endl;
+}
+
+int CodeGenerator::getNestingDepth_Rec(QList<Attribute *> attList) {
+    int maxDepth = 0;
+
+    for (Attribute *attribute : attList) {
         if (attribute->getSubAttArray().size() > 0) {
-            descString.append("LCSF_" + protocolName.toUpper() + "_ATT_" + attribute->getName().toUpper() + "_SUBATT_NB, ");
-            descString.append("LCSF_" + protocolName + "_" + attribute->getName() + "_AttDescArray");
-        } else {
-            descString.append("0, NULL");
+            int depth = this->getNestingDepth_Rec(attribute->getSubAttArray());
+            if (depth > maxDepth) {
+                maxDepth = depth;
+            }
         }
     }
-    return descString;
+    return (attList.size() > 0) ? maxDepth + 1 : 0;
 }
 
 QList<Attribute::T_attInfos> CodeGenerator::getAttInfos_Rec(QString parentName, QList<Attribute *> attList) {
@@ -351,7 +2731,7 @@ void CodeGenerator::fillSubAttPayload_Rec(
                         *pOut << indent << "// Intermediary variable" << Qt::endl;
                         *pOut << indent << "pSubAttArray = &(" << attDataPath << "Payload.pSubAttArray);" << Qt::endl;
                         *pOut << indent << "// Allocate sub-attribute array" << Qt::endl;
-                        *pOut << indent << "if (!LifoGet(&LcsfBridge" << protocolName << "Info.Lifo, LCSF_"
+                        *pOut << indent << "if (!LifoGet(" << this->getLifoPtr(protocolName) << ", LCSF_"
                               << protocolName.toUpper() << "_ATT_" << attribute->getName().toUpper()
                               << "_SUBATT_NB, (void *)pSubAttArray)) {" << Qt::endl;
                         *pOut << indent << "    return false;" << Qt::endl;
@@ -399,7 +2779,7 @@ void CodeGenerator::fillSubAttPayload_Rec(
                         *pOut << indent << "// Intermediary variable" << Qt::endl;
                         *pOut << indent << "pSubAttArray = &(" << attDataPath << "Payload.pSubAttArray);" << Qt::endl;
                         *pOut << indent << "// Allocate sub-attribute array" << Qt::endl;
-                        *pOut << indent << "if (!LifoGet(&LcsfBridge" << protocolName << "Info.Lifo, LCSF_"
+                        *pOut << indent << "if (!LifoGet(" << this->getLifoPtr(protocolName) << ", LCSF_"
                               << protocolName.toUpper() << "_ATT_" << attribute->getName().toUpper()
                               << "_SUBATT_NB, (void *)pSubAttArray)) {" << Qt::endl;
                         *pOut << indent << "    return false;" << Qt::endl;
@@ -542,10 +2922,11 @@ QString CodeGenerator::toFirstLetterUpperCase(const QString &s) {
 QList<Attribute::T_attInfos> CodeGenerator::removeCommandAttributes(
     QList<Attribute::T_attInfos> attInfosList, QList<Command *> cmdList) {
     QList<Attribute::T_attInfos> trimmedAttInfosList = QList<Attribute::T_attInfos>();
+    QHash<QString, Command *> cmdNameIndex = Command::getNameIndex(cmdList);
 
     for (Attribute::T_attInfos attInfo : attInfosList) {
         // If attribute doesn't have command as parent
-        if (Command::findCmdAddr(attInfo.parentName, cmdList) == nullptr) {
+        if (!cmdNameIndex.contains(attInfo.parentName)) {
             trimmedAttInfosList.append(attInfo);
         }
     }
@@ -565,11 +2946,13 @@ int findCmdFctIdxFromName(QString cmdName, QStringList cmdFcts) {
 
 void CodeGenerator::generateMainHeader(
     QString protocolName, QList<Command *> cmdList, CodeExtractor codeExtract, QString dirPath) {
+    LCSF_PROFILE_SCOPE("CodeGenerator::generateMainHeader", "emit");
     QDir dir(dirPath);
     if (!dir.exists()) {
         dir.mkpath(".");
     }
     QString fileName = dirPath + "/" + protocolName + "_Main.h";
+    QString ctxParam = this->getCtxParam(protocolName, false);
     QList<Attribute::T_attInfos> attInfosList = this->getAttInfos(cmdList);
     bool hasOptAtt = false;
     QFile file(fileName);
@@ -749,6 +3132,20 @@ void CodeGenerator::generateMainHeader(
         out << "} " << protocolName.toLower() << "_cmd_payload_t;" << Qt::endl;
         out << Qt::endl;
 
+        // Module context
+        if (this->reentrantMode) {
+            out << "// Module context, one per channel" << Qt::endl;
+            out << "struct _lcsf_bridge_" << protocolName.toLower() << "_ctx;" << Qt::endl;
+            out << "typedef struct _" << protocolName.toLower() << "_ctx {" << Qt::endl;
+            out << "    struct _lcsf_bridge_" << protocolName.toLower() << "_ctx *pBridgeCtx;" << Qt::endl;
+            out << "    uint8_t *pSendBuffer;" << Qt::endl;
+            out << "    uint16_t buffSize;" << Qt::endl;
+            out << "    " << protocolName.toLower() << "_cmd_payload_t SendCmdPayload;" << Qt::endl;
+            out << "    void *pUserData;" << Qt::endl;
+            out << "} " << protocolName.toLower() << "_ctx_t;" << Qt::endl;
+            out << Qt::endl;
+        }
+
         // Function headers
         out << "// --- Public Function Prototypes ---" << Qt::endl;
         out << Qt::endl;
@@ -756,41 +3153,69 @@ void CodeGenerator::generateMainHeader(
             out << codeExtract.getUnknownPublicFunctionsHeaders();
         } else {
             out << "/**" << Qt::endl;
-            out << " * \\fn bool " << protocolName << "_MainInit(uint8_t *pBuffer, size_t buffSize)" << Qt::endl;
+            out << " * \\fn bool " << protocolName << "_MainInit(" << ctxParam << "uint8_t *pBuffer, size_t buffSize)"
+                << Qt::endl;
             out << " * \\brief Initialize the module" << Qt::endl;
             out << " *" << Qt::endl;
+            if (this->reentrantMode) {
+                out << " * \\param pCtx pointer to the module context" << Qt::endl;
+            }
             out << " * \\param pBuffer pointer to send buffer" << Qt::endl;
             out << " * \\param buffSize buffer size" << Qt::endl;
             out << " * \\return bool: true if operation was a success" << Qt::endl;
             out << " */" << Qt::endl;
-            out << "bool " << protocolName << "_MainInit(uint8_t *pBuffer, size_t buffSize);" << Qt::endl;
+            out << "bool " << protocolName << "_MainInit(" << ctxParam << "uint8_t *pBuffer, size_t buffSize);" << Qt::endl;
             out << Qt::endl;
+            if (this->deferredMode) {
+                out << "/**" << Qt::endl;
+                out << " * \\fn uint_fast16_t " << protocolName << "_MainPoll(" << ctxParam << "uint_fast16_t maxCmds)"
+                    << Qt::endl;
+                out << " * \\brief Execute the commands queued by the bridge, to call from the main loop" << Qt::endl;
+                out << " *" << Qt::endl;
+                if (this->reentrantMode) {
+                    out << " * \\param pCtx pointer to the module context" << Qt::endl;
+                }
+                out << " * \\param maxCmds maximum number of commands to execute" << Qt::endl;
+                out << " * \\return uint_fast16_t: number of executed commands" << Qt::endl;
+                out << " */" << Qt::endl;
+                out << "uint_fast16_t " << protocolName << "_MainPoll(" << ctxParam << "uint_fast16_t maxCmds);" << Qt::endl;
+                out << Qt::endl;
+            }
         }
         out << "/**" << Qt::endl;
-        out << " * \\fn bool " << protocolName << "_MainExecute(uint_fast16_t cmdName, " << protocolName.toLower()
-            << "_cmd_payload_t *pCmdPayload)" << Qt::endl;
+        out << " * \\fn bool " << protocolName << "_MainExecute(" << ctxParam << "uint_fast16_t cmdName, "
+            << protocolName.toLower() << "_cmd_payload_t *pCmdPayload)" << Qt::endl;
         out << " * \\brief Execute a command" << Qt::endl;
         out << " *" << Qt::endl;
+        if (this->reentrantMode) {
+            out << " * \\param pCtx pointer to the module context" << Qt::endl;
+        }
         out << " * \\param cmdName name of the command" << Qt::endl;
         out << " * \\param pCmdPayload pointer to command payload" << Qt::endl;
         out << " * \\return bool: true if operation was a success" << Qt::endl;
         out << " */" << Qt::endl;
-        out << "bool " << protocolName << "_MainExecute(uint_fast16_t cmdName, " << protocolName.toLower()
+        out << "bool " << protocolName << "_MainExecute(" << ctxParam << "uint_fast16_t cmdName, " << protocolName.toLower()
             << "_cmd_payload_t *pCmdPayload);" << Qt::endl;
         out << Qt::endl;
         out << "// *** End Definitions ***" << Qt::endl;
         out << "#endif // " << protocolName.toLower() << "_Main_h" << Qt::endl;
         file.close();
+        Profiler::addCounter("Bytes written", file.size());
     }
 }
 
 void CodeGenerator::generateMain(
     QString protocolName, QList<Command *> cmdList, CodeExtractor codeExtract, bool isA, QString dirPath) {
+    LCSF_PROFILE_SCOPE("CodeGenerator::generateMain", "emit");
     QDir dir(dirPath);
     if (!dir.exists()) {
         dir.mkpath(".");
     }
     QString fileName = dirPath + "/" + protocolName + "_Main_" + ((isA) ? "a" : "b") + ".c";
+    QString ctxParam = this->getCtxParam(protocolName, false);
+    QString ctxArg = this->getCtxArg(false);
+    QString infoPrefix = (this->reentrantMode) ? QString("pCtx->") : protocolName + "Info.";
+    QString bridgeCtxArg = (this->reentrantMode) ? QString("pCtx->pBridgeCtx, ") : QString();
     QFile file(fileName);
 
     if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
@@ -823,15 +3248,19 @@ void CodeGenerator::generateMain(
         } else {
             out << "// --- Private Macros ---" << Qt::endl;
             out << "// --- Private Types ---" << Qt::endl;
-            out << "typedef struct _" << protocolName.toLower() << "_info {" << Qt::endl;
-            out << "    uint8_t *pSendBuffer;" << Qt::endl;
-            out << "    uint16_t buffSize;" << Qt::endl;
-            out << "    " << protocolName.toLower() << "_cmd_payload_t SendCmdPayload;" << Qt::endl;
-            out << "} " << protocolName.toLower() << "_info_t;" << Qt::endl;
-            out << Qt::endl;
+            // Module state lives in the caller context in reentrant mode
+            if (!this->reentrantMode) {
+                out << "typedef struct _" << protocolName.toLower() << "_info {" << Qt::endl;
+                out << "    uint8_t *pSendBuffer;" << Qt::endl;
+                out << "    uint16_t buffSize;" << Qt::endl;
+                out << "    " << protocolName.toLower() << "_cmd_payload_t SendCmdPayload;" << Qt::endl;
+                out << "} " << protocolName.toLower() << "_info_t;" << Qt::endl;
+                out << Qt::endl;
+            }
             out << "// --- Private Function Prototypes ---" << Qt::endl;
             out << "// Generated functions" << Qt::endl;
-            out << "static bool " << protocolName << "SendCommand(uint_fast16_t cmdName, bool hasPayload);" << Qt::endl;
+            out << "static bool " << protocolName << "SendCommand(" << ctxParam << "uint_fast16_t cmdName, bool hasPayload);"
+                << Qt::endl;
 
             for (int idx = 0; idx < cmdList.size(); idx++) {
                 Command *command = cmdList.at(idx);
@@ -839,15 +3268,17 @@ void CodeGenerator::generateMain(
                 if (command->isReceivable(isA)) {
                     out << "static bool " << protocolName << "Execute" << command->getName() << "(";
                     if (command->getAttArray().size() > 0) {
-                        out << protocolName.toLower() << "_cmd_payload_t *pCmdPayload);" << Qt::endl;
+                        out << ctxParam << protocolName.toLower() << "_cmd_payload_t *pCmdPayload);" << Qt::endl;
                     } else {
-                        out << "void);" << Qt::endl;
+                        out << this->getCtxParam(protocolName, true) << ");" << Qt::endl;
                     }
                 }
             }
             out << Qt::endl;
             out << "// --- Private Variables ---" << Qt::endl;
-            out << "static " << protocolName.toLower() << "_info_t " << protocolName << "Info;" << Qt::endl;
+            if (!this->reentrantMode) {
+                out << "static " << protocolName.toLower() << "_info_t " << protocolName << "Info;" << Qt::endl;
+            }
             out << Qt::endl;
             out << "// *** End Definitions ***" << Qt::endl;
             out << Qt::endl;
@@ -859,27 +3290,31 @@ void CodeGenerator::generateMain(
             out << codeExtract.getUnknownPrivateFunctions();
         } else {
             out << "/**" << Qt::endl;
-            out << " * \\fn static bool " << protocolName << "SendCommand(uint_fast16_t cmdName, bool hasPayload)"
-                << Qt::endl;
+            out << " * \\fn static bool " << protocolName << "SendCommand(" << ctxParam
+                << "uint_fast16_t cmdName, bool hasPayload)" << Qt::endl;
             out << " * \\brief Send a command" << Qt::endl;
             out << " *=" << Qt::endl;
+            if (this->reentrantMode) {
+                out << " * \\param pCtx pointer to the module context" << Qt::endl;
+            }
             out << " * \\param cmdName name of the command to send" << Qt::endl;
             out << " * \\param hasPayload indicates if command has a payload or not" << Qt::endl;
             out << " * \\return bool: true if operation was a success" << Qt::endl;
             out << " */" << Qt::endl;
-            out << "static bool " << protocolName << "SendCommand(uint_fast16_t cmdName, bool hasPayload) {" << Qt::endl;
+            out << "static bool " << protocolName << "SendCommand(" << ctxParam
+                << "uint_fast16_t cmdName, bool hasPayload) {" << Qt::endl;
             out << "    if (cmdName >= " << protocolName.toUpper() << "_CMD_COUNT) {" << Qt::endl;
             out << "        return false;" << Qt::endl;
             out << "    }" << Qt::endl;
             out << "    int msgSize = 0;" << Qt::endl;
             out << "    if (hasPayload) {" << Qt::endl;
-            out << "        " << protocolName.toLower() << "_cmd_payload_t *pCmdPayload = &" << protocolName
-                << "Info.SendCmdPayload;" << Qt::endl;
-            out << "        msgSize = LCSF_Bridge_" << protocolName << "Encode(cmdName, pCmdPayload, " << protocolName
-                << "Info.pSendBuffer, " << protocolName << "Info.buffSize);" << Qt::endl;
+            out << "        " << protocolName.toLower() << "_cmd_payload_t *pCmdPayload = &" << infoPrefix
+                << "SendCmdPayload;" << Qt::endl;
+            out << "        msgSize = LCSF_Bridge_" << protocolName << "Encode(" << bridgeCtxArg << "cmdName, pCmdPayload, "
+                << infoPrefix << "pSendBuffer, " << infoPrefix << "buffSize);" << Qt::endl;
             out << "    } else {" << Qt::endl;
-            out << "        msgSize = LCSF_Bridge_" << protocolName << "Encode(cmdName, NULL, " << protocolName
-                << "Info.pSendBuffer, " << protocolName << "Info.buffSize);" << Qt::endl;
+            out << "        msgSize = LCSF_Bridge_" << protocolName << "Encode(" << bridgeCtxArg << "cmdName, NULL, "
+                << infoPrefix << "pSendBuffer, " << infoPrefix << "buffSize);" << Qt::endl;
             out << "    }" << Qt::endl;
             out << "    if (msgSize <= 0) {" << Qt::endl;
             out << "        return false;" << Qt::endl;
@@ -889,17 +3324,24 @@ void CodeGenerator::generateMain(
             out << "}" << Qt::endl;
             out << Qt::endl;
             out << "/**" << Qt::endl;
-            out << " * \\fn static bool " << protocolName << "ExecuteX(void)" << Qt::endl;
+            out << " * \\fn static bool " << protocolName << "ExecuteX(" << this->getCtxParam(protocolName, true) << ")"
+                << Qt::endl;
             out << " * \\brief Execute command X (no payload)" << Qt::endl;
             out << " *" << Qt::endl;
+            if (this->reentrantMode) {
+                out << " * \\param pCtx pointer to the module context" << Qt::endl;
+            }
             out << " * \\return bool: true if operation was a success" << Qt::endl;
             out << " */" << Qt::endl;
             out << Qt::endl;
             out << "/**" << Qt::endl;
-            out << " * \\fn static bool " << protocolName << "ExecuteX(" << protocolName.toLower()
+            out << " * \\fn static bool " << protocolName << "ExecuteX(" << ctxParam << protocolName.toLower()
                 << "_cmd_payload_t *pCmdPayload)" << Qt::endl;
             out << " * \\brief Execute command X (with payload)" << Qt::endl;
             out << " *" << Qt::endl;
+            if (this->reentrantMode) {
+                out << " * \\param pCtx pointer to the module context" << Qt::endl;
+            }
             out << " * \\param pCmdPayload pointer to the command payload" << Qt::endl;
             out << " * \\return bool: true if operation was a success" << Qt::endl;
             out << " */" << Qt::endl;
@@ -924,7 +3366,7 @@ void CodeGenerator::generateMain(
                 } else {
                     out << "static bool " << protocolName << "Execute" << command->getName() << "(";
                     if (command->getAttArray().size() > 0) {
-                        out << protocolName.toLower() << "_cmd_payload_t *pCmdPayload) {" << Qt::endl;
+                        out << ctxParam << protocolName.toLower() << "_cmd_payload_t *pCmdPayload) {" << Qt::endl;
                         out << "    // Declare attributes" << Qt::endl;
                         declareAtt_REC(command->getName(), command->getAttArray(), &out);
                         out << "    // Retrieve attributes data" << Qt::endl;
@@ -989,7 +3431,7 @@ void CodeGenerator::generateMain(
                         out << "    // Process data" << Qt::endl;
                         out << "#pragma GCC warning \"#warning TODO: function to implement\"" << Qt::endl;
                     } else {
-                        out << "void) {" << Qt::endl;
+                        out << this->getCtxParam(protocolName, true) << ") {" << Qt::endl;
                         out << "#pragma GCC warning \"#warning TODO: function to implement\"" << Qt::endl;
                     }
                     out << "    return true;" << Qt::endl;
@@ -1006,36 +3448,90 @@ void CodeGenerator::generateMain(
             out << codeExtract.getUnknownPublicFunctions();
         } else {
             out << "/**" << Qt::endl;
-            out << " * \\fn bool " << protocolName << "_MainInit(uint8_t *pBuffer, size_t buffSize)" << Qt::endl;
+            out << " * \\fn bool " << protocolName << "_MainInit(" << ctxParam << "uint8_t *pBuffer, size_t buffSize)"
+                << Qt::endl;
             out << " * \\brief Initialize the module" << Qt::endl;
             out << " *" << Qt::endl;
+            if (this->reentrantMode) {
+                out << " * \\param pCtx pointer to the module context" << Qt::endl;
+            }
             out << " * \\param pBuffer pointer to send buffer" << Qt::endl;
             out << " * \\param buffSize buffer size" << Qt::endl;
             out << " * \\return bool: true if operation was a success" << Qt::endl;
             out << " */" << Qt::endl;
-            out << "bool " << protocolName << "_MainInit(uint8_t *pBuffer, size_t buffSize) {" << Qt::endl;
-            out << "    if (pBuffer == NULL) {" << Qt::endl;
+            out << "bool " << protocolName << "_MainInit(" << ctxParam << "uint8_t *pBuffer, size_t buffSize) {" << Qt::endl;
+            if (this->reentrantMode) {
+                out << "    if ((pCtx == NULL) || (pBuffer == NULL)) {" << Qt::endl;
+            } else {
+                out << "    if (pBuffer == NULL) {" << Qt::endl;
+            }
             out << "        return false;" << Qt::endl;
             out << "    }" << Qt::endl;
             out << "    // Note infos" << Qt::endl;
-            out << "    " << protocolName << "Info.pSendBuffer = pBuffer;" << Qt::endl;
-            out << "    " << protocolName << "Info.buffSize = buffSize;" << Qt::endl;
+            out << "    " << infoPrefix << "pSendBuffer = pBuffer;" << Qt::endl;
+            out << "    " << infoPrefix << "buffSize = buffSize;" << Qt::endl;
             out << "    return true;" << Qt::endl;
             out << "}" << Qt::endl;
             out << Qt::endl;
+            if (this->deferredMode) {
+                out << "/**" << Qt::endl;
+                out << " * \\fn uint_fast16_t " << protocolName << "_MainPoll(" << ctxParam << "uint_fast16_t maxCmds)"
+                    << Qt::endl;
+                out << " * \\brief Execute the commands queued by the bridge, to call from the main loop" << Qt::endl;
+                out << " *" << Qt::endl;
+                if (this->reentrantMode) {
+                    out << " * \\param pCtx pointer to the module context" << Qt::endl;
+                }
+                out << " * \\param maxCmds maximum number of commands to execute" << Qt::endl;
+                out << " * \\return uint_fast16_t: number of executed commands" << Qt::endl;
+                out << " */" << Qt::endl;
+                out << "uint_fast16_t " << protocolName << "_MainPoll(" << ctxParam << "uint_fast16_t maxCmds) {"
+                    << Qt::endl;
+                out << "    uint_fast16_t cmdNb = 0;" << Qt::endl;
+                out << "    uint16_t cmdName = 0;" << Qt::endl;
+                out << "    " << protocolName.toLower() << "_cmd_payload_t *pCmdPayload = NULL;" << Qt::endl;
+                out << Qt::endl;
+                out << "    while (cmdNb < maxCmds) {" << Qt::endl;
+                out << "        pCmdPayload = LCSF_Bridge_" << protocolName << "Peek(" << bridgeCtxArg << "&cmdName);"
+                    << Qt::endl;
+                out << "        if (pCmdPayload == NULL) {" << Qt::endl;
+                out << "            break;" << Qt::endl;
+                out << "        }" << Qt::endl;
+                out << "        // The payload stays in its queue slot until released" << Qt::endl;
+                if (this->instrumentMode) {
+                    QString hookPrefix = "LCSF_BRIDGE_" + protocolName.toUpper() + "_HOOK_";
+                    out << "        " << hookPrefix << "START(start);" << Qt::endl;
+                    out << "        bool isOk = " << protocolName << "_MainExecute(" << ctxArg << "cmdName, pCmdPayload);"
+                        << Qt::endl;
+                    out << "        " << hookPrefix << "HANDLER(LCSF_Bridge_" << protocolName << "GetStats("
+                        << ((this->reentrantMode) ? "pCtx->pBridgeCtx" : "") << "), cmdName, isOk, start);" << Qt::endl;
+                } else {
+                    out << "        " << protocolName << "_MainExecute(" << ctxArg << "cmdName, pCmdPayload);" << Qt::endl;
+                }
+                out << "        LCSF_Bridge_" << protocolName << "Release("
+                    << ((this->reentrantMode) ? "pCtx->pBridgeCtx" : "") << ");" << Qt::endl;
+                out << "        cmdNb++;" << Qt::endl;
+                out << "    }" << Qt::endl;
+                out << "    return cmdNb;" << Qt::endl;
+                out << "}" << Qt::endl;
+                out << Qt::endl;
+            }
             out << "// Place custom public functions here" << Qt::endl;
             out << Qt::endl;
         }
         out << "/**" << Qt::endl;
-        out << " * \\fn bool " << protocolName << "_MainExecute(uint_fast16_t cmdName, " << protocolName.toLower()
-            << "_cmd_payload_t *pCmdPayload)" << Qt::endl;
+        out << " * \\fn bool " << protocolName << "_MainExecute(" << ctxParam << "uint_fast16_t cmdName, "
+            << protocolName.toLower() << "_cmd_payload_t *pCmdPayload)" << Qt::endl;
         out << " * \\brief Execute a command" << Qt::endl;
         out << " *" << Qt::endl;
+        if (this->reentrantMode) {
+            out << " * \\param pCtx pointer to the module context" << Qt::endl;
+        }
         out << " * \\param cmdName name of the command" << Qt::endl;
         out << " * \\param pCmdPayload pointer to command payload" << Qt::endl;
         out << " * \\return bool: true if operation was a success" << Qt::endl;
         out << " */" << Qt::endl;
-        out << "bool " << protocolName << "_MainExecute(uint_fast16_t cmdName, " << protocolName.toLower()
+        out << "bool " << protocolName << "_MainExecute(" << ctxParam << "uint_fast16_t cmdName, " << protocolName.toLower()
             << "_cmd_payload_t *pCmdPayload) {" << Qt::endl;
         out << "    switch (cmdName) {" << Qt::endl;
         for (Command *command : cmdList) {
@@ -1044,9 +3540,9 @@ void CodeGenerator::generateMain(
                     << Qt::endl;
                 out << "            return " << protocolName << "Execute" << command->getName();
                 if (command->getAttArray().size() > 0) {
-                    out << "(pCmdPayload);" << Qt::endl;
+                    out << "(" << ctxArg << "pCmdPayload);" << Qt::endl;
                 } else {
-                    out << "();" << Qt::endl;
+                    out << "(" << this->getCtxArg(true) << ");" << Qt::endl;
                 }
                 out << Qt::endl;
             }
@@ -1065,18 +3561,24 @@ void CodeGenerator::generateMain(
         out << "}" << Qt::endl;
 
         file.close();
+        Profiler::addCounter("Bytes written", file.size());
     }
 }
 
 void CodeGenerator::generateBridgeHeader(
     QString protocolName, QString protocolId, QString protocolVersion, QList<Command *> cmdList, QString dirPath) {
+    LCSF_PROFILE_SCOPE("CodeGenerator::generateBridgeHeader", "emit");
     QDir dir(dirPath);
     if (!dir.exists()) {
         dir.mkpath(".");
     }
     QString fileName = dirPath + "/LCSF_Bridge_" + protocolName + ".h";
+    QString bridgeCtxParam = this->getBridgeCtxParam(protocolName, false);
     QList<Attribute::T_attInfos> attIdxList = this->getAttInfos(cmdList);
     QList<Attribute::T_attInfos> sortedAttInfosList = this->insertSortAttInfosListByParentName(attIdxList);
+    bool isStream = this->hasStreamAtt(cmdList);
+    // Reentrant channels receive through the decoder, LCSF_Validator has a single receive state
+    bool isDecoder = this->fastDecoderMode || this->reentrantMode || isStream;
     QFile file(fileName);
 
     if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
@@ -1096,10 +3598,16 @@ void CodeGenerator::generateBridgeHeader(
         out << Qt::endl;
         out << "// *** Libraries include ***" << Qt::endl;
         out << "// Standard lib" << Qt::endl;
+        if (this->deferredMode) {
+            out << "#include <stdatomic.h>" << Qt::endl;
+        }
         out << "// Custom lib" << Qt::endl;
         out << "#include \"" << protocolName << "_Main.h\"" << Qt::endl;
         out << "#include <LCSF_Config.h>" << Qt::endl;
         out << "#include <lib/LCSF_Validator.h>" << Qt::endl;
+        if (this->reentrantMode) {
+            out << "#include <lib/Lifo.h>" << Qt::endl;
+        }
         out << Qt::endl;
         out << "// *** Definitions ***" << Qt::endl;
         out << "// --- Public Types ---" << Qt::endl;
@@ -1150,6 +3658,18 @@ void CodeGenerator::generateBridgeHeader(
         out << "// Bridge decoder lifo size" << Qt::endl;
         out << "#define LCSF_BRIDGE_" << protocolName.toUpper() << "_LIFO_SIZE " << Command::getMaxAttNb(cmdList)
             << Qt::endl;
+        this->writeBridgeQueue(protocolName, BRIDGE_H_CONSTANTS, &out);
+        if (isDecoder || this->segmentEncodeMode) {
+            // Must match the representation the LCSF stack is built with
+            out << "// Frame field size and complex attribute flag" << Qt::endl;
+            out << "#ifdef LCSF_SMALL" << Qt::endl;
+            out << "#define LCSF_BRIDGE_" << protocolName.toUpper() << "_FIELD_SIZE 1" << Qt::endl;
+            out << "#define LCSF_BRIDGE_" << protocolName.toUpper() << "_CMPLX_FLAG 0x80" << Qt::endl;
+            out << "#else" << Qt::endl;
+            out << "#define LCSF_BRIDGE_" << protocolName.toUpper() << "_FIELD_SIZE 2" << Qt::endl;
+            out << "#define LCSF_BRIDGE_" << protocolName.toUpper() << "_CMPLX_FLAG 0x8000" << Qt::endl;
+            out << "#endif" << Qt::endl;
+        }
         out << "// Lcsf protocol identifier" << Qt::endl;
         out << "#define LCSF_" << protocolName.toUpper() << "_PROTOCOL_ID 0x" << protocolId << Qt::endl;
         out << "// Lcsf protocol version" << Qt::endl;
@@ -1174,53 +3694,128 @@ void CodeGenerator::generateBridgeHeader(
                 }
             }
         }
+        // The header is shared by both sides, its sections don't depend on the side
+        this->writeBridgeSegments(protocolName, cmdList, true, BRIDGE_H_CONSTANTS, &out);
+        this->writeBridgeStream(protocolName, cmdList, true, BRIDGE_H_CONSTANTS, &out);
+        this->writeBridgeStats(protocolName, cmdList, BRIDGE_H_CONSTANTS, &out);
         out << Qt::endl;
+        this->writeBridgeQueue(protocolName, BRIDGE_H_TYPES, &out);
+        this->writeBridgeSegWriter(protocolName, cmdList, true, BRIDGE_H_TYPES, &out);
+        this->writeBridgeStream(protocolName, cmdList, true, BRIDGE_H_TYPES, &out);
+        this->writeBridgeStats(protocolName, cmdList, BRIDGE_H_TYPES, &out);
+        if (this->reentrantMode) {
+            out << "// Bridge context, one per channel" << Qt::endl;
+            out << "typedef struct _lcsf_bridge_" << protocolName.toLower() << "_ctx {" << Qt::endl;
+            out << "    lifo_desc_t Lifo;" << Qt::endl;
+            out << "    lcsf_valid_att_t LifoData[LCSF_BRIDGE_" << protocolName.toUpper() << "_LIFO_SIZE];" << Qt::endl;
+            this->declareCmdStorage(protocolName, &out);
+            this->declareStatsStorage(protocolName, &out);
+            out << "    " << protocolName.toLower() << "_ctx_t *pMainCtx;" << Qt::endl;
+            out << "} lcsf_bridge_" << protocolName.toLower() << "_ctx_t;" << Qt::endl;
+            out << Qt::endl;
+        }
         out << "// Protocol descriptor" << Qt::endl;
         out << "extern const lcsf_validator_protocol_desc_t LCSF_" << protocolName << "_ProtDesc;" << Qt::endl;
         out << Qt::endl;
         out << "// --- Public Function Prototypes ---" << Qt::endl;
         out << Qt::endl;
-        out << "/**" << Qt::endl;
-        out << " * \\fn bool LCSF_Bridge_" << protocolName << "Init(void)" << Qt::endl;
-        out << " * \\brief Initialize the module" << Qt::endl;
-        out << " *" << Qt::endl;
-        out << " * \\return bool: true if operation was a success" << Qt::endl;
-        out << " */" << Qt::endl;
-        out << "bool LCSF_Bridge_" << protocolName << "Init(void);" << Qt::endl;
+        if (this->reentrantMode) {
+            out << "/**" << Qt::endl;
+            out << " * \\fn bool LCSF_Bridge_" << protocolName << "Init(lcsf_bridge_" << protocolName.toLower()
+                << "_ctx_t *pCtx, " << protocolName.toLower() << "_ctx_t *pMainCtx)" << Qt::endl;
+            out << " * \\brief Initialize a bridge context and link it to its main module context" << Qt::endl;
+            out << " *" << Qt::endl;
+            out << " * \\param pCtx pointer to the bridge context" << Qt::endl;
+            out << " * \\param pMainCtx pointer to the main module context of the same channel" << Qt::endl;
+            out << " * \\return bool: true if operation was a success" << Qt::endl;
+            out << " */" << Qt::endl;
+            out << "bool LCSF_Bridge_" << protocolName << "Init(lcsf_bridge_" << protocolName.toLower() << "_ctx_t *pCtx, "
+                << protocolName.toLower() << "_ctx_t *pMainCtx);" << Qt::endl;
+            out << Qt::endl;
+            out << "/**" << Qt::endl;
+            out << " * \\fn void LCSF_Bridge_" << protocolName << "Bind(lcsf_bridge_" << protocolName.toLower()
+                << "_ctx_t *pCtx)" << Qt::endl;
+            out << " * \\brief Select the context used by the calling thread to receive commands, call it before"
+                << Qt::endl;
+            out << " * feeding the channel data to LCSF_Validator. LCSF_Validator keeps a single receive state, its"
+                << Qt::endl;
+            out << " * calls must be serialized across channels, use LCSF_Bridge_" << protocolName
+                << "ReceiveFrame to receive concurrently" << Qt::endl;
+            out << " *" << Qt::endl;
+            out << " * \\param pCtx pointer to the bridge context" << Qt::endl;
+            out << " */" << Qt::endl;
+            out << "void LCSF_Bridge_" << protocolName << "Bind(lcsf_bridge_" << protocolName.toLower() << "_ctx_t *pCtx);"
+                << Qt::endl;
+        } else {
+            out << "/**" << Qt::endl;
+            out << " * \\fn bool LCSF_Bridge_" << protocolName << "Init(void)" << Qt::endl;
+            out << " * \\brief Initialize the module" << Qt::endl;
+            out << " *" << Qt::endl;
+            out << " * \\return bool: true if operation was a success" << Qt::endl;
+            out << " */" << Qt::endl;
+            out << "bool LCSF_Bridge_" << protocolName << "Init(void);" << Qt::endl;
+        }
         out << Qt::endl;
         out << "/**" << Qt::endl;
         out << " * \\fn bool LCSF_Bridge_" << protocolName << "Receive(lcsf_valid_cmd_t *pValidCmd)" << Qt::endl;
-        out << " * \\brief Receive valid command from LCSF_Validator and transmit to " << protocolName << "_Main"
-            << Qt::endl;
-        out << " *" << Qt::endl;
-        out << " * \\param pValidCmd pointer to the valid command" << Qt::endl;
-        out << " * \\return bool: true if operation was a success" << Qt::endl;
+        if (this->deferredMode) {
+            out << " * \\brief Receive valid command from LCSF_Validator and queue it for " << protocolName << "_MainPoll"
+                << Qt::endl;
+            out << " * Byte array and string payloads point to the receive buffer, it must stay valid until the command"
+                << Qt::endl;
+            out << " * is polled" << Qt::endl;
+            out << " *" << Qt::endl;
+            out << " * \\param pValidCmd pointer to the valid command" << Qt::endl;
+            out << " * \\return bool: true if the command was queued, false if the queue is full" << Qt::endl;
+        } else {
+            out << " * \\brief Receive valid command from LCSF_Validator and transmit to " << protocolName << "_Main"
+                << Qt::endl;
+            out << " *" << Qt::endl;
+            out << " * \\param pValidCmd pointer to the valid command" << Qt::endl;
+            out << " * \\return bool: true if operation was a success" << Qt::endl;
+        }
         out << " */" << Qt::endl;
         out << "bool LCSF_Bridge_" << protocolName << "Receive(lcsf_valid_cmd_t *pValidCmd);" << Qt::endl;
         out << Qt::endl;
+        this->writeBridgeQueue(protocolName, BRIDGE_H_PROTOTYPES, &out);
         out << "/**" << Qt::endl;
-        out << " * \\fn int LCSF_Bridge_" << protocolName << "Encode(uint_fast16_t cmdName, " << protocolName.toLower()
-            << "_cmd_payload_t *pCmdPayload, uint8_t *pBuffer, size_t buffSize)" << Qt::endl;
+        out << " * \\fn int LCSF_Bridge_" << protocolName << "Encode(" << bridgeCtxParam << "uint_fast16_t cmdName, "
+            << protocolName.toLower() << "_cmd_payload_t *pCmdPayload, uint8_t *pBuffer, size_t buffSize)" << Qt::endl;
         out << " * \\brief Receive command from " << protocolName << "_Main and transmit to LCSF_Validator for encoding"
             << Qt::endl;
         out << " *" << Qt::endl;
+        if (this->reentrantMode) {
+            out << " * \\param pCtx pointer to the bridge context" << Qt::endl;
+        }
         out << " * \\param cmdName name of the command" << Qt::endl;
         out << " * \\param pValidCmd pointer to the valid command" << Qt::endl;
         out << " * \\param pBuffer pointer to the send buffer" << Qt::endl;
         out << " * \\param buffSize buffer size" << Qt::endl;
         out << " * \\return int: -1 if operation failed, encoded message size if success" << Qt::endl;
         out << " */" << Qt::endl;
-        out << "int LCSF_Bridge_" << protocolName << "Encode(uint_fast16_t cmdName, " << protocolName.toLower()
-            << "_cmd_payload_t *pCmdPayload, uint8_t *pBuffer, size_t buffSize);" << Qt::endl;
+        out << "int LCSF_Bridge_" << protocolName << "Encode(" << bridgeCtxParam << "uint_fast16_t cmdName, "
+            << protocolName.toLower() << "_cmd_payload_t *pCmdPayload, uint8_t *pBuffer, size_t buffSize);" << Qt::endl;
         out << Qt::endl;
+        this->writeBridgeSegments(protocolName, cmdList, true, BRIDGE_H_PROTOTYPES, &out);
+        this->writeBridgeDecoder(protocolName, cmdList, true, BRIDGE_H_PROTOTYPES, &out);
+        this->writeBridgeStream(protocolName, cmdList, true, BRIDGE_H_PROTOTYPES, &out);
+        this->writeBridgeStats(protocolName, cmdList, BRIDGE_H_PROTOTYPES, &out);
         out << "// *** End Definitions ***" << Qt::endl;
         out << "#endif // Lcsf_bridge_" << protocolName.toLower() << "_h" << Qt::endl;
 
         file.close();
+        Profiler::addCounter("Bytes written", file.size());
     }
 }
 
 void CodeGenerator::generateBridge(QString protocolName, QList<Command *> cmdList, bool isA, QString dirPath) {
+    LCSF_PROFILE_SCOPE("CodeGenerator::generateBridge", "emit");
+    QString lifoParam = (this->reentrantMode) ? QString("lifo_desc_t *pLifo, ") : QString();
+    QString lifoArg = (this->reentrantMode) ? QString("pLifo, ") : QString();
+    QString bridgeCtxParam = this->getBridgeCtxParam(protocolName, false);
+    QString statePrefix = (this->reentrantMode) ? QString("pCtx->") : "LcsfBridge" + protocolName + "Info.";
+    QString hookPrefix = "LCSF_BRIDGE_" + protocolName.toUpper() + "_HOOK_";
+    QString pStats = "&(" + statePrefix + "Stats)";
     QDir dir(dirPath);
     if (!dir.exists()) {
         dir.mkpath(".");
@@ -1250,18 +3845,31 @@ void CodeGenerator::generateBridge(QString protocolName, QList<Command *> cmdLis
         out << "#include <lib/Lifo.h>" << Qt::endl;
         out << Qt::endl;
         out << "// *** Definitions ***" << Qt::endl;
-        out << "// --- Private Types ---" << Qt::endl;
-        out << Qt::endl;
-        out << "static uint8_t LifoData[LCSF_BRIDGE_" << protocolName.toUpper()
-            << "_LIFO_SIZE * sizeof(lcsf_valid_att_t)];" << Qt::endl;
-        out << Qt::endl;
-        out << "// Module information structure" << Qt::endl;
-        out << "typedef struct _lcsf_bridge_" << protocolName.toLower() << "_info {" << Qt::endl;
-        out << "    lifo_desc_t Lifo;" << Qt::endl;
-        out << "    " << protocolName.toLower() << "_cmd_payload_t CmdPayload;" << Qt::endl;
-        out << "} lcsf_bridge_" << protocolName.toLower() << "_info_t;" << Qt::endl;
-        out << Qt::endl;
+        if (this->reentrantMode) {
+            // Module state lives in the channel contexts
+            out << "// --- Private Macros ---" << Qt::endl;
+            out << "#ifndef LCSF_THREAD_LOCAL" << Qt::endl;
+            out << "#define LCSF_THREAD_LOCAL _Thread_local" << Qt::endl;
+            out << "#endif" << Qt::endl;
+            out << Qt::endl;
+        } else {
+            out << "// --- Private Types ---" << Qt::endl;
+            out << Qt::endl;
+            out << "static uint8_t LifoData[LCSF_BRIDGE_" << protocolName.toUpper()
+                << "_LIFO_SIZE * sizeof(lcsf_valid_att_t)];" << Qt::endl;
+            out << Qt::endl;
+            out << "// Module information structure" << Qt::endl;
+            out << "typedef struct _lcsf_bridge_" << protocolName.toLower() << "_info {" << Qt::endl;
+            out << "    lifo_desc_t Lifo;" << Qt::endl;
+            this->declareCmdStorage(protocolName, &out);
+            this->declareStatsStorage(protocolName, &out);
+            out << "} lcsf_bridge_" << protocolName.toLower() << "_info_t;" << Qt::endl;
+            out << Qt::endl;
+        }
+        this->writeBridgeSegWriter(protocolName, cmdList, isA, BRIDGE_C_TYPES, &out);
+        this->writeBridgeStream(protocolName, cmdList, isA, BRIDGE_C_TYPES, &out);
         out << "// --- Private Constants ---" << Qt::endl;
+        this->writeBridgeQueue(protocolName, BRIDGE_C_CONSTANTS, &out);
         out << "// Array to convert command name value to their lcsf command id" << Qt::endl;
         out << "static const uint16_t LCSF_Bridge_" << protocolName << "_CMDNAME2CMDID[LCSF_" << protocolName.toUpper()
             << "_CMD_NB] = {" << Qt::endl;
@@ -1282,20 +3890,29 @@ void CodeGenerator::generateBridge(QString protocolName, QList<Command *> cmdLis
         out << "static void LCSF_Bridge_" << protocolName
             << "GetCmdData(uint_fast16_t cmdName, lcsf_valid_att_t *pAttArray, " << protocolName.toLower()
             << "_cmd_payload_t *pCmdPayload);" << Qt::endl;
+        this->writeBridgeDecoder(protocolName, cmdList, isA, BRIDGE_C_PROTOTYPES, &out);
         for (Command *command : cmdList) {
             if ((command->getAttArray().size() > 0) && (command->isReceivable(!isA))) {
-                out << "static bool LCSF_Bridge_" << protocolName << command->getName()
-                    << "FillAtt(lcsf_valid_att_t **pAttArrayAddr, " << protocolName.toLower()
-                    << "_cmd_payload_t *pCmdPayload);" << Qt::endl;
+                out << "static bool LCSF_Bridge_" << protocolName << command->getName() << "FillAtt(" << lifoParam
+                    << "lcsf_valid_att_t **pAttArrayAddr, " << protocolName.toLower() << "_cmd_payload_t *pCmdPayload);"
+                    << Qt::endl;
             }
         }
-        out << "static bool LCSF_Bridge_" << protocolName
-            << "FillCmdAtt(uint_fast16_t cmdName, lcsf_valid_att_t **pAttArrayAddr, " << protocolName.toLower()
+        out << "static bool LCSF_Bridge_" << protocolName << "FillCmdAtt(" << lifoParam
+            << "uint_fast16_t cmdName, lcsf_valid_att_t **pAttArrayAddr, " << protocolName.toLower()
             << "_cmd_payload_t *pCmdPayload);" << Qt::endl;
+        this->writeBridgeSegWriter(protocolName, cmdList, isA, BRIDGE_C_PROTOTYPES, &out);
+        this->writeBridgeStream(protocolName, cmdList, isA, BRIDGE_C_PROTOTYPES, &out);
         out << Qt::endl;
         out << "// --- Private Variables ---" << Qt::endl;
-        out << "static lcsf_bridge_" << protocolName.toLower() << "_info_t LcsfBridge" << protocolName << "Info;"
-            << Qt::endl;
+        if (this->reentrantMode) {
+            out << "// Context of the channel being decoded by the current thread" << Qt::endl;
+            out << "static LCSF_THREAD_LOCAL lcsf_bridge_" << protocolName.toLower() << "_ctx_t *pLcsfBridge"
+                << protocolName << "BoundCtx = NULL;" << Qt::endl;
+        } else {
+            out << "static lcsf_bridge_" << protocolName.toLower() << "_info_t LcsfBridge" << protocolName << "Info;"
+                << Qt::endl;
+        }
         out << Qt::endl;
         out << "// *** End Definitions ***" << Qt::endl;
         out << Qt::endl;
@@ -1440,26 +4057,31 @@ void CodeGenerator::generateBridge(QString protocolName, QList<Command *> cmdLis
         out << "}" << Qt::endl;
         out << Qt::endl;
 
+        this->writeBridgeDecoder(protocolName, cmdList, isA, BRIDGE_C_PRIVATE_FCTS, &out);
+
         // Command fill attribute functions
         out << "/**" << Qt::endl;
-        out << " * \\fn static bool LCSF_Bridge_" << protocolName << "XFillAtt(lcsf_valid_att_t **pAttArrayAddr, "
-            << protocolName.toLower() << "_cmd_payload_t *pCmdPayload)" << Qt::endl;
+        out << " * \\fn static bool LCSF_Bridge_" << protocolName << "XFillAtt(" << lifoParam
+            << "lcsf_valid_att_t **pAttArrayAddr, " << protocolName.toLower() << "_cmd_payload_t *pCmdPayload)" << Qt::endl;
         out << " * \\brief Allocate and fill attribute array of command X from its payload" << Qt::endl;
         out << " *" << Qt::endl;
+        if (this->reentrantMode) {
+            out << " * \\param pLifo pointer to the attribute allocation lifo" << Qt::endl;
+        }
         out << " * \\param pAttArrayAddr pointer to contain the attribute array" << Qt::endl;
         out << " * \\param pCmdPayload pointer to the command payload" << Qt::endl;
         out << " * \\return bool: true if operation was a success" << Qt::endl;
         out << " */" << Qt::endl;
         for (Command *command : cmdList) {
             if ((command->getAttArray().size() > 0) && (command->isTransmittable(isA))) {
-                out << "static bool LCSF_Bridge_" << protocolName << command->getName()
-                    << "FillAtt(lcsf_valid_att_t **pAttArrayAddr, " << protocolName.toLower()
-                    << "_cmd_payload_t *pCmdPayload) {" << Qt::endl;
+                out << "static bool LCSF_Bridge_" << protocolName << command->getName() << "FillAtt(" << lifoParam
+                    << "lcsf_valid_att_t **pAttArrayAddr, " << protocolName.toLower() << "_cmd_payload_t *pCmdPayload) {"
+                    << Qt::endl;
                 out << "    if (pCmdPayload == NULL) {" << Qt::endl;
                 out << "        return false;" << Qt::endl;
                 out << "    }" << Qt::endl;
                 out << "    // Allocate attribute array" << Qt::endl;
-                out << "    if (!LifoGet(&LcsfBridge" << protocolName << "Info.Lifo, LCSF_" << protocolName.toUpper()
+                out << "    if (!LifoGet(" << this->getLifoPtr(protocolName) << ", LCSF_" << protocolName.toUpper()
                     << "_CMD_" << command->getName().toUpper() << "_ATT_NB, (void *)pAttArrayAddr)) {" << Qt::endl;
                 out << "        return false;" << Qt::endl;
                 out << "    }" << Qt::endl;
@@ -1482,7 +4104,7 @@ void CodeGenerator::generateBridge(QString protocolName, QList<Command *> cmdLis
                                         << command->getName().toUpper() << "_ATT_" << attribute->getName().toUpper()
                                         << "].Payload.pSubAttArray);" << Qt::endl;
                                     out << "        // Allocate sub-attribute array" << Qt::endl;
-                                    out << "        if (!LifoGet(&LcsfBridge" << protocolName << "Info.Lifo, LCSF_"
+                                    out << "        if (!LifoGet(" << this->getLifoPtr(protocolName) << ", LCSF_"
                                         << protocolName.toUpper() << "_ATT_" << attribute->getName().toUpper()
                                         << "_SUBATT_NB, (void *)pSubAttArray)) {" << Qt::endl;
                                     out << "            return false;" << Qt::endl;
@@ -1545,7 +4167,7 @@ void CodeGenerator::generateBridge(QString protocolName, QList<Command *> cmdLis
                                         << command->getName().toUpper() << "_ATT_" << attribute->getName().toUpper()
                                         << "].Payload.pSubAttArray);" << Qt::endl;
                                     out << "    // Allocate sub-attribute array" << Qt::endl;
-                                    out << "    if (!LifoGet(&LcsfBridge" << protocolName << "Info.Lifo, LCSF_"
+                                    out << "    if (!LifoGet(" << this->getLifoPtr(protocolName) << ", LCSF_"
                                         << protocolName.toUpper() << "_ATT_" << attribute->getName().toUpper()
                                         << "_SUBATT_NB, (void *)pSubAttArray)) {" << Qt::endl;
                                     out << "        return false;" << Qt::endl;
@@ -1605,18 +4227,21 @@ void CodeGenerator::generateBridge(QString protocolName, QList<Command *> cmdLis
 
         // Master fill attribute function
         out << "/**" << Qt::endl;
-        out << " * \\fn static bool LCSF_Bridge_" << protocolName
-            << "FillCmdAtt(uint_fast16_t cmdName, lcsf_valid_att_t **pAttArrayAddr, " << protocolName.toLower()
+        out << " * \\fn static bool LCSF_Bridge_" << protocolName << "FillCmdAtt(" << lifoParam
+            << "uint_fast16_t cmdName, lcsf_valid_att_t **pAttArrayAddr, " << protocolName.toLower()
             << "_cmd_payload_t *pCmdPayload)" << Qt::endl;
         out << " * \\brief Fill the attribute array of a command from its payload" << Qt::endl;
         out << " *" << Qt::endl;
+        if (this->reentrantMode) {
+            out << " * \\param pLifo pointer to the attribute allocation lifo" << Qt::endl;
+        }
         out << " * \\param cmdName name of the command" << Qt::endl;
         out << " * \\param pAttArrayAddr pointer to contain the attribute array" << Qt::endl;
         out << " * \\param pCmdPayload pointer to the command payload" << Qt::endl;
         out << " * \\return bool: true if operation was a success" << Qt::endl;
         out << " */" << Qt::endl;
-        out << "static bool LCSF_Bridge_" << protocolName
-            << "FillCmdAtt(uint_fast16_t cmdName, lcsf_valid_att_t **pAttArrayAddr, " << protocolName.toLower()
+        out << "static bool LCSF_Bridge_" << protocolName << "FillCmdAtt(" << lifoParam
+            << "uint_fast16_t cmdName, lcsf_valid_att_t **pAttArrayAddr, " << protocolName.toLower()
             << "_cmd_payload_t *pCmdPayload) {" << Qt::endl;
         out << "    switch (cmdName) {" << Qt::endl;
         for (Command *command : cmdList) {
@@ -1624,7 +4249,7 @@ void CodeGenerator::generateBridge(QString protocolName, QList<Command *> cmdLis
                 out << "        case " << protocolName.toUpper() << "_CMD_" << command->getName().toUpper() << ":"
                     << Qt::endl;
                 out << "            return LCSF_Bridge_" << protocolName << command->getName()
-                    << "FillAtt(pAttArrayAddr, pCmdPayload);" << Qt::endl;
+                    << "FillAtt(" << lifoArg << "pAttArrayAddr, pCmdPayload);" << Qt::endl;
                 out << Qt::endl;
             }
         }
@@ -1635,54 +4260,125 @@ void CodeGenerator::generateBridge(QString protocolName, QList<Command *> cmdLis
         out << "}" << Qt::endl;
         out << Qt::endl;
 
+        this->writeBridgeSegWriter(protocolName, cmdList, isA, BRIDGE_C_PRIVATE_FCTS, &out);
+        this->writeBridgeStream(protocolName, cmdList, isA, BRIDGE_C_PRIVATE_FCTS, &out);
+
         // Public functions
 
         out << "// *** Public Functions ***" << Qt::endl;
         out << Qt::endl;
 
-        out << "bool LCSF_Bridge_" << protocolName << "Init(void) {" << Qt::endl;
-        out << "    return LifoInit(&LcsfBridge" << protocolName << "Info.Lifo, LifoData, LCSF_BRIDGE_"
-            << protocolName.toUpper() << "_LIFO_SIZE, sizeof(lcsf_valid_att_t));" << Qt::endl;
-        out << "}" << Qt::endl;
-        out << Qt::endl;
+        if (this->reentrantMode) {
+            out << "bool LCSF_Bridge_" << protocolName << "Init(lcsf_bridge_" << protocolName.toLower() << "_ctx_t *pCtx, "
+                << protocolName.toLower() << "_ctx_t *pMainCtx) {" << Qt::endl;
+            out << "    if ((pCtx == NULL) || (pMainCtx == NULL)) {" << Qt::endl;
+            out << "        return false;" << Qt::endl;
+            out << "    }" << Qt::endl;
+            out << "    // Link the channel contexts" << Qt::endl;
+            out << "    pCtx->pMainCtx = pMainCtx;" << Qt::endl;
+            out << "    pMainCtx->pBridgeCtx = pCtx;" << Qt::endl;
+            if (this->deferredMode) {
+                out << "    atomic_init(&(pCtx->QueueHead), 0);" << Qt::endl;
+                out << "    atomic_init(&(pCtx->QueueTail), 0);" << Qt::endl;
+            }
+            if (this->instrumentMode) {
+                out << "#ifdef LCSF_BRIDGE_" << protocolName.toUpper() << "_STATS" << Qt::endl;
+                out << "    LCSF_Bridge_" << protocolName << "ResetStats(pCtx);" << Qt::endl;
+                out << "#endif" << Qt::endl;
+            }
+            out << "    return LifoInit(&(pCtx->Lifo), (void *)pCtx->LifoData, LCSF_BRIDGE_" << protocolName.toUpper()
+                << "_LIFO_SIZE, sizeof(lcsf_valid_att_t));" << Qt::endl;
+            out << "}" << Qt::endl;
+            out << Qt::endl;
 
-        out << "bool LCSF_Bridge_" << protocolName << "Receive(lcsf_valid_cmd_t *pValidCmd) {" << Qt::endl;
-        out << "    uint16_t cmdName = LCSF_Bridge_" << protocolName << "_CMDID2CMDNAME(pValidCmd->CmdId);" << Qt::endl;
-        out << "    " << protocolName.toLower() << "_cmd_payload_t *pCmdPayload = &LcsfBridge" << protocolName
-            << "Info.CmdPayload;" << Qt::endl;
-        out << Qt::endl;
-        out << "    // Clear payload to remove stale VLE bytes" << Qt::endl;
-        out << "    memset(pCmdPayload, 0, sizeof(*pCmdPayload));" << Qt::endl;
-        out << "    LCSF_Bridge_" << protocolName << "GetCmdData(cmdName, pValidCmd->pAttArray, pCmdPayload);" << Qt::endl;
-        out << "    return " << protocolName << "_MainExecute(cmdName, pCmdPayload);" << Qt::endl;
+            out << "void LCSF_Bridge_" << protocolName << "Bind(lcsf_bridge_" << protocolName.toLower() << "_ctx_t *pCtx) {"
+                << Qt::endl;
+            out << "    pLcsfBridge" << protocolName << "BoundCtx = pCtx;" << Qt::endl;
+            out << "}" << Qt::endl;
+            out << Qt::endl;
+
+            out << "bool LCSF_Bridge_" << protocolName << "Receive(lcsf_valid_cmd_t *pValidCmd) {" << Qt::endl;
+            out << "    lcsf_bridge_" << protocolName.toLower() << "_ctx_t *pCtx = pLcsfBridge" << protocolName
+                << "BoundCtx;" << Qt::endl;
+            out << Qt::endl;
+            out << "    if (pCtx == NULL) {" << Qt::endl;
+            out << "        return false;" << Qt::endl;
+            out << "    }" << Qt::endl;
+        } else {
+            out << "bool LCSF_Bridge_" << protocolName << "Init(void) {" << Qt::endl;
+            if (this->deferredMode) {
+                out << "    atomic_init(&(LcsfBridge" << protocolName << "Info.QueueHead), 0);" << Qt::endl;
+                out << "    atomic_init(&(LcsfBridge" << protocolName << "Info.QueueTail), 0);" << Qt::endl;
+            }
+            if (this->instrumentMode) {
+                out << "#ifdef LCSF_BRIDGE_" << protocolName.toUpper() << "_STATS" << Qt::endl;
+                out << "    LCSF_Bridge_" << protocolName << "ResetStats();" << Qt::endl;
+                out << "#endif" << Qt::endl;
+            }
+            out << "    return LifoInit(&LcsfBridge" << protocolName << "Info.Lifo, LifoData, LCSF_BRIDGE_"
+                << protocolName.toUpper() << "_LIFO_SIZE, sizeof(lcsf_valid_att_t));" << Qt::endl;
+            out << "}" << Qt::endl;
+            out << Qt::endl;
+
+            out << "bool LCSF_Bridge_" << protocolName << "Receive(lcsf_valid_cmd_t *pValidCmd) {" << Qt::endl;
+        }
+        this->writeFrameDispatch(protocolName, "", &out);
         out << "}" << Qt::endl;
         out << Qt::endl;
+        this->writeBridgeQueue(protocolName, BRIDGE_C_PUBLIC_FCTS, &out);
+        this->writeBridgeDecoder(protocolName, cmdList, isA, BRIDGE_C_PUBLIC_FCTS, &out);
 
-        out << "int LCSF_Bridge_" << protocolName << "Encode(uint_fast16_t cmdName, " << protocolName.toLower()
-            << "_cmd_payload_t *pCmdPayload, uint8_t *pBuffer, size_t buffSize) {" << Qt::endl;
+        out << "int LCSF_Bridge_" << protocolName << "Encode(" << bridgeCtxParam << "uint_fast16_t cmdName, "
+            << protocolName.toLower() << "_cmd_payload_t *pCmdPayload, uint8_t *pBuffer, size_t buffSize) {" << Qt::endl;
+        if (this->instrumentMode) {
+            out << "    " << hookPrefix << "START(start);" << Qt::endl;
+        }
         out << "    lcsf_valid_cmd_t sendCmd;" << Qt::endl;
+        if (this->instrumentMode) {
+            out << "    int msgSize = -1;" << Qt::endl;
+        }
         out << "    sendCmd.CmdId = LCSF_Bridge_" << protocolName << "_CMDNAME2CMDID[cmdName];" << Qt::endl;
-        out << "    LifoFreeAll(&LcsfBridge" << protocolName << "Info.Lifo);" << Qt::endl;
+        if (this->reentrantMode) {
+            out << "    lifo_desc_t *pLifo = &(pCtx->Lifo);" << Qt::endl;
+        }
+        out << "    LifoFreeAll(" << this->getLifoPtr(protocolName) << ");" << Qt::endl;
         out << Qt::endl;
-        out << "    if (!LCSF_Bridge_" << protocolName << "FillCmdAtt(cmdName, &(sendCmd.pAttArray), pCmdPayload)) {"
-            << Qt::endl;
-        out << "        return -1;" << Qt::endl;
-        out << "    }" << Qt::endl;
-        out << "    return LCSF_ValidatorEncode(LCSF_" << protocolName.toUpper()
-            << "_PROTOCOL_ID, &sendCmd, pBuffer, buffSize);" << Qt::endl;
+        if (this->instrumentMode) {
+            out << "    if (LCSF_Bridge_" << protocolName << "FillCmdAtt(" << lifoArg
+                << "cmdName, &(sendCmd.pAttArray), pCmdPayload)) {" << Qt::endl;
+            out << "        msgSize = LCSF_ValidatorEncode(LCSF_" << protocolName.toUpper()
+                << "_PROTOCOL_ID, &sendCmd, pBuffer, buffSize);" << Qt::endl;
+            out << "    }" << Qt::endl;
+            out << "    " << hookPrefix << "TX(" << pStats << ", cmdName, msgSize, start);" << Qt::endl;
+            out << "    return msgSize;" << Qt::endl;
+        } else {
+            out << "    if (!LCSF_Bridge_" << protocolName << "FillCmdAtt(" << lifoArg
+                << "cmdName, &(sendCmd.pAttArray), pCmdPayload)) {" << Qt::endl;
+            out << "        return -1;" << Qt::endl;
+            out << "    }" << Qt::endl;
+            out << "    return LCSF_ValidatorEncode(LCSF_" << protocolName.toUpper()
+                << "_PROTOCOL_ID, &sendCmd, pBuffer, buffSize);" << Qt::endl;
+        }
         out << "}" << Qt::endl;
 
+        this->writeBridgeSegments(protocolName, cmdList, isA, BRIDGE_C_PUBLIC_FCTS, &out);
+        this->writeBridgeStream(protocolName, cmdList, isA, BRIDGE_C_PUBLIC_FCTS, &out);
+        this->writeBridgeStats(protocolName, cmdList, BRIDGE_C_PUBLIC_FCTS, &out);
+
         file.close();
+        Profiler::addCounter("Bytes written", file.size());
     }
 }
 
 void CodeGenerator::generateDescription(QString protocolName, QList<Command *> cmdList, QString dirPath) {
+    LCSF_PROFILE_SCOPE("CodeGenerator::generateDescription", "emit");
     QDir dir(dirPath);
     if (!dir.exists()) {
         dir.mkpath(".");
     }
     QString fileName = dirPath + "/LCSF_Desc_" + protocolName + ".c";
     QList<Attribute::T_attInfos> attInfosList = this->getAttInfos(cmdList);
+    this->findSharedDescArrays(attInfosList);
     QFile file(fileName);
 
     if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
@@ -1706,13 +4402,24 @@ void CodeGenerator::generateDescription(QString protocolName, QList<Command *> c
         out << "// *** Definitions ***" << Qt::endl;
         out << "// --- Private Constants ---" << Qt::endl;
         out << Qt::endl;
+        if (this->sharedDescArrayNb > 0) {
+            out << "// Shared sub-attribute descriptors: " << this->sharedDescArrayNb << " arrays merged, "
+                << this->sharedDescEntryNb << " entries saved" << Qt::endl;
+            out << Qt::endl;
+        }
 
-        // Sub-attribute descriptor arrays
+        // Sub-attribute descriptor arrays, one per class of isomorphic subtrees
         if (this->protocolHasSubAtt) {
             for (int idx = attInfosList.size() - 1; idx >= 0; idx--) {
                 Attribute::T_attInfos attInfo = attInfosList.at(idx);
-                if (attInfo.subAttNb > 0) {
-                    out << "// Sub-attribute array descriptor of attribute " << attInfo.attName << Qt::endl;
+                if ((attInfo.subAttNb > 0) && !this->sharedDescNames.contains(attInfo.attName)) {
+                    QStringList sharingNames = this->sharedDescNames.keys(attInfo.attName);
+                    out << "// Sub-attribute array descriptor of attribute " << attInfo.attName;
+                    if (!sharingNames.isEmpty()) {
+                        sharingNames.sort();
+                        out << ", shared with " << sharingNames.join(", ");
+                    }
+                    out << Qt::endl;
                     out << "static const lcsf_attribute_desc_t LCSF_" << protocolName << "_" << attInfo.attName
                         << "_AttDescArray[LCSF_"
                         << protocolName.toUpper() + "_ATT_" + attInfo.attName.toUpper() + "_SUBATT_NB] = {" << Qt::endl;
@@ -1770,5 +4477,1455 @@ void CodeGenerator::generateDescription(QString protocolName, QList<Command *> c
             << protocolName << "Receive};" << Qt::endl;
 
         file.close();
+        Profiler::addCounter("Bytes written", file.size());
+    }
+}
+
+bool CodeGenerator::generateDecoderBench(QString protocolName, QList<Command *> cmdList, bool isA, QString dirPath) {
+    LCSF_PROFILE_SCOPE("CodeGenerator::generateDecoderBench", "emit");
+    // The benchmark drives the single channel immediate dispatch
+    if (!this->fastDecoderMode || this->reentrantMode || this->deferredMode) {
+        return false;
+    }
+    QDir dir(dirPath);
+    if (!dir.exists()) {
+        dir.mkpath(".");
+    }
+    QString fileName = dirPath + "/LCSF_Bench_" + protocolName + "_" + ((isA) ? "a" : "b") + ".c";
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    QTextStream out(&file);
+    out.setCodec("ISO 8859-1");
+
+    out << "/**" << Qt::endl;
+    out << " * \\file LCSF_Bench_" << protocolName << "_" << ((isA) ? "a" : "b") << ".c" << Qt::endl;
+    out << " * \\brief " << protocolName << " decoder benchmark (" << ((isA) ? "A" : "B") << "), specialised decoder against"
+        << " LCSF_Validator" << Qt::endl;
+    out << " * \\author LCSF Generator v" << APP_VERSION << Qt::endl;
+    out << " *" << Qt::endl;
+    out << " * Build with LCSF_Bridge_" << protocolName << "_" << ((isA) ? "a" : "b") << ".c, LCSF_Desc_" << protocolName
+        << ".c and the LCSF stack, but without " << protocolName << "_Main_" << ((isA) ? "a" : "b") << ".c" << Qt::endl;
+    out << " */" << Qt::endl;
+    out << Qt::endl;
+    out << "// *** Libraries include ***" << Qt::endl;
+    out << "// Standard lib" << Qt::endl;
+    out << "#define _POSIX_C_SOURCE 199309L" << Qt::endl;
+    out << "#include <stdio.h>" << Qt::endl;
+    out << "#include <stdlib.h>" << Qt::endl;
+    out << "#include <time.h>" << Qt::endl;
+    out << "// Custom lib" << Qt::endl;
+    out << "#include \"LCSF_Bridge_" << protocolName << ".h\"" << Qt::endl;
+    out << "#include <LCSF_Config.h>" << Qt::endl;
+    out << "#include <lib/LCSF_Validator.h>" << Qt::endl;
+    out << Qt::endl;
+    out << "// *** Definitions ***" << Qt::endl;
+    out << "// --- Private Macros ---" << Qt::endl;
+    out << "#ifndef LCSF_BENCH_ITERATIONS" << Qt::endl;
+    out << "#define LCSF_BENCH_ITERATIONS 100000" << Qt::endl;
+    out << "#endif" << Qt::endl;
+    out << "// Override to match the validator initialization of the LCSF stack version in use" << Qt::endl;
+    out << "#ifndef LCSF_BENCH_VALIDATOR_INIT" << Qt::endl;
+    out << "#define LCSF_BENCH_VALIDATOR_INIT() LCSF_ValidatorAddProtocol(0, &LCSF_" << protocolName << "_ProtDesc)"
+        << Qt::endl;
+    out << "#endif" << Qt::endl;
+    out << "#ifdef LCSF_SMALL" << Qt::endl;
+    out << "#define LCSF_BENCH_FIELD(value) ((value)&0xFF)" << Qt::endl;
+    out << "#define LCSF_BENCH_CMPLX_FLAG 0x80" << Qt::endl;
+    out << "#else" << Qt::endl;
+    out << "#define LCSF_BENCH_FIELD(value) ((value)&0xFF), (((value) >> 8) & 0xFF)" << Qt::endl;
+    out << "#define LCSF_BENCH_CMPLX_FLAG 0x8000" << Qt::endl;
+    out << "#endif" << Qt::endl;
+    out << Qt::endl;
+    out << "// --- Private Types ---" << Qt::endl;
+    out << "typedef struct _lcsf_bench_frame {" << Qt::endl;
+    out << "    const char *pName;" << Qt::endl;
+    out << "    const uint8_t *pFrame;" << Qt::endl;
+    out << "    size_t frameSize;" << Qt::endl;
+    out << "} lcsf_bench_frame_t;" << Qt::endl;
+    out << Qt::endl;
+    out << "// --- Private Constants ---" << Qt::endl;
+    for (Command *command : cmdList) {
+        if (!command->isReceivable(isA)) {
+            continue;
+        }
+        out << "// " << command->getName() << " frame, with all its attributes" << Qt::endl;
+        out << "static const uint8_t LCSF_Bench_" << command->getName() << "Frame[] = {" << Qt::endl;
+        out << "    LCSF_BENCH_FIELD(LCSF_" << protocolName.toUpper() << "_PROTOCOL_ID), LCSF_BENCH_FIELD(LCSF_"
+            << protocolName.toUpper() << "_CMD_ID_" << command->getName().toUpper() << "), LCSF_BENCH_FIELD("
+            << command->getAttArray().size() << ")," << Qt::endl;
+        this->writeBenchAtt_Rec(protocolName, command->getName(), command->getAttArray(), &out);
+        out << "};" << Qt::endl;
+        out << Qt::endl;
+    }
+    out << "static const lcsf_bench_frame_t LCSF_Bench_Frames[] = {" << Qt::endl;
+    for (Command *command : cmdList) {
+        if (command->isReceivable(isA)) {
+            out << "    {\"" << command->getName() << "\", LCSF_Bench_" << command->getName() << "Frame, sizeof(LCSF_Bench_"
+                << command->getName() << "Frame)}," << Qt::endl;
+        }
+    }
+    out << "};" << Qt::endl;
+    out << Qt::endl;
+    out << "// --- Private Variables ---" << Qt::endl;
+    out << "static uint32_t LcsfBenchExecCount;" << Qt::endl;
+    out << Qt::endl;
+    out << "// *** End Definitions ***" << Qt::endl;
+    out << Qt::endl;
+    out << "// *** Private Functions ***" << Qt::endl;
+    out << Qt::endl;
+    out << "static bool LCSF_Bench_ValidatorReceive(const uint8_t *pBuffer, size_t buffSize) {" << Qt::endl;
+    out << "    return LCSF_ValidatorReceive(pBuffer, buffSize);" << Qt::endl;
+    out << "}" << Qt::endl;
+    out << Qt::endl;
+    out << "static bool LCSF_Bench_DecoderReceive(const uint8_t *pBuffer, size_t buffSize) {" << Qt::endl;
+    out << "    return LCSF_Bridge_" << protocolName << "ReceiveFrame(pBuffer, buffSize);" << Qt::endl;
+    out << "}" << Qt::endl;
+    out << Qt::endl;
+    out << "/**" << Qt::endl;
+    out << " * \\fn static double LCSF_Bench_Run(bool (*pFnReceive)(const uint8_t *, size_t), const lcsf_bench_frame_t "
+        << "*pFrame)" << Qt::endl;
+    out << " * \\brief Receive a frame LCSF_BENCH_ITERATIONS times" << Qt::endl;
+    out << " *" << Qt::endl;
+    out << " * \\param pFnReceive pointer to the receive path" << Qt::endl;
+    out << " * \\param pFrame pointer to the frame" << Qt::endl;
+    out << " * \\return double: received messages per second, negative if a frame was not executed" << Qt::endl;
+    out << " */" << Qt::endl;
+    out << "static double LCSF_Bench_Run(bool (*pFnReceive)(const uint8_t *, size_t), const lcsf_bench_frame_t *pFrame) {"
+        << Qt::endl;
+    out << "    struct timespec start;" << Qt::endl;
+    out << "    struct timespec end;" << Qt::endl;
+    out << Qt::endl;
+    out << "    LcsfBenchExecCount = 0;" << Qt::endl;
+    out << "    clock_gettime(CLOCK_MONOTONIC, &start);" << Qt::endl;
+    out << "    for (uint32_t idx = 0; idx < LCSF_BENCH_ITERATIONS; idx++) {" << Qt::endl;
+    out << "        pFnReceive(pFrame->pFrame, pFrame->frameSize);" << Qt::endl;
+    out << "    }" << Qt::endl;
+    out << "    clock_gettime(CLOCK_MONOTONIC, &end);" << Qt::endl;
+    out << "    if (LcsfBenchExecCount != LCSF_BENCH_ITERATIONS) {" << Qt::endl;
+    out << "        return -1.0;" << Qt::endl;
+    out << "    }" << Qt::endl;
+    out << "    double elapsed = (double)(end.tv_sec - start.tv_sec) + ((double)(end.tv_nsec - start.tv_nsec) / 1e9);"
+        << Qt::endl;
+    out << "    return (elapsed > 0.0) ? (LCSF_BENCH_ITERATIONS / elapsed) : 0.0;" << Qt::endl;
+    out << "}" << Qt::endl;
+    out << Qt::endl;
+    out << "// *** Public Functions ***" << Qt::endl;
+    out << Qt::endl;
+    out << "// Stands for " << protocolName << "_MainExecute, only counts executed commands" << Qt::endl;
+    out << "bool " << protocolName << "_MainExecute(uint_fast16_t cmdName, " << protocolName.toLower()
+        << "_cmd_payload_t *pCmdPayload) {" << Qt::endl;
+    out << "    (void)cmdName;" << Qt::endl;
+    out << "    (void)pCmdPayload;" << Qt::endl;
+    out << "    LcsfBenchExecCount++;" << Qt::endl;
+    out << "    return true;" << Qt::endl;
+    out << "}" << Qt::endl;
+    out << Qt::endl;
+    out << "int main(void) {" << Qt::endl;
+    out << "    int ret = EXIT_SUCCESS;" << Qt::endl;
+    out << Qt::endl;
+    out << "    if (!LCSF_Bridge_" << protocolName << "Init() || !LCSF_BENCH_VALIDATOR_INIT()) {" << Qt::endl;
+    out << "        printf(\"Initialization failed\\n\");" << Qt::endl;
+    out << "        return EXIT_FAILURE;" << Qt::endl;
+    out << "    }" << Qt::endl;
+    out << "    printf(\"%-24s %16s %16s %8s\\n\", \"Command\", \"Validator msg/s\", \"Decoder msg/s\", \"Speedup\");"
+        << Qt::endl;
+    out << "    for (size_t idx = 0; idx < (sizeof(LCSF_Bench_Frames) / sizeof(LCSF_Bench_Frames[0])); idx++) {" << Qt::endl;
+    out << "        const lcsf_bench_frame_t *pFrame = &(LCSF_Bench_Frames[idx]);" << Qt::endl;
+    out << "        double validatorRate = LCSF_Bench_Run(LCSF_Bench_ValidatorReceive, pFrame);" << Qt::endl;
+    out << "        double decoderRate = LCSF_Bench_Run(LCSF_Bench_DecoderReceive, pFrame);" << Qt::endl;
+    out << Qt::endl;
+    out << "        if ((validatorRate < 0.0) || (decoderRate < 0.0)) {" << Qt::endl;
+    out << "            printf(\"%-24s frame rejected\\n\", pFrame->pName);" << Qt::endl;
+    out << "            ret = EXIT_FAILURE;" << Qt::endl;
+    out << "            continue;" << Qt::endl;
+    out << "        }" << Qt::endl;
+    out << "        printf(\"%-24s %16.0f %16.0f %7.2fx\\n\", pFrame->pName, validatorRate, decoderRate," << Qt::endl;
+    out << "            (validatorRate > 0.0) ? (decoderRate / validatorRate) : 0.0);" << Qt::endl;
+    out << "    }" << Qt::endl;
+    out << "    return ret;" << Qt::endl;
+    out << "}" << Qt::endl;
+
+    file.close();
+    Profiler::addCounter("Bytes written", file.size());
+    return true;
+}
+
+bool CodeGenerator::generateThroughputBench(QString protocolName, QList<Command *> cmdList, bool isA, QString dirPath) {
+    LCSF_PROFILE_SCOPE("CodeGenerator::generateThroughputBench", "emit");
+    // The benchmark drives the single channel immediate dispatch
+    if (this->reentrantMode || this->deferredMode) {
+        return false;
+    }
+    QDir dir(dirPath);
+    if (!dir.exists()) {
+        dir.mkpath(".");
+    }
+    QString sideSuffix = (isA) ? "a" : "b";
+    // The side encodes, the other side decodes
+    QString txSide = (isA) ? "A" : "B";
+    QString rxSide = (isA) ? "B" : "A";
+    bool isFrameReceive = this->fastDecoderMode;
+    QString fileName = dirPath + "/LCSF_Throughput_" + protocolName + "_" + sideSuffix + ".c";
+    QFile file(fileName);
+    int maxFieldNb = 3;
+    int maxDataSize = 0;
+    int maxRefNb = 0;
+
+    if (!this->writeLoopbackHeader(protocolName, cmdList, dirPath) ||
+        !file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    QTextStream out(&file);
+    out.setCodec("ISO 8859-1");
+
+    // Worst-case frame, byte arrays and strings at their maximum size
+    for (Command *command : cmdList) {
+        int fieldNb = 2;
+        int dataSize = 0;
+        int refNb = 0;
+        this->getSegmentBounds_Rec(command->getAttArray(), fieldNb, dataSize, refNb);
+        maxFieldNb = qMax(maxFieldNb, fieldNb);
+        maxDataSize = qMax(maxDataSize, dataSize);
+        maxRefNb = qMax(maxRefNb, refNb);
+    }
+
+    out << "/**" << Qt::endl;
+    out << " * \\file LCSF_Throughput_" << protocolName << "_" << sideSuffix << ".c" << Qt::endl;
+    out << " * \\brief " << protocolName << " throughput benchmark (" << ((isA) ? "A" : "B")
+        << "), encode/decode round trips of random payloads" << Qt::endl;
+    out << " * \\author LCSF Generator v" << APP_VERSION << Qt::endl;
+    out << " *" << Qt::endl;
+    out << " * Build both sides as for the loopback harness: LCSF_Bridge_" << protocolName << "_a.c, LCSF_Bridge_"
+        << protocolName << "_b.c, LCSF_Desc_" << protocolName << ".c" << Qt::endl;
+    out << " * and LCSF_Validator.c compiled once per side with LCSF_Loopback_" << protocolName
+        << ".h force included, and a single Lifo." << Qt::endl;
+    out << " *" << Qt::endl;
+    out << " * Each command sent by the side is encoded by its bridge then decoded by the bridge of side " << rxSide
+        << ", which" << Qt::endl;
+    out << " * extracts the payload and executes it." << Qt::endl;
+    out << " */" << Qt::endl;
+    out << Qt::endl;
+    out << "// *** Libraries include ***" << Qt::endl;
+    out << "// Standard lib" << Qt::endl;
+    out << "#define _POSIX_C_SOURCE 199309L" << Qt::endl;
+    out << "#include <stdio.h>" << Qt::endl;
+    out << "#include <stdlib.h>" << Qt::endl;
+    out << "#include <string.h>" << Qt::endl;
+    out << "#include <time.h>" << Qt::endl;
+    out << "// Custom lib" << Qt::endl;
+    out << "#include \"LCSF_Loopback_" << protocolName << ".h\"" << Qt::endl;
+    out << Qt::endl;
+    out << "// *** Definitions ***" << Qt::endl;
+    out << "// --- Private Macros ---" << Qt::endl;
+    out << "#ifndef LCSF_BENCH_ITERATIONS" << Qt::endl;
+    out << "#define LCSF_BENCH_ITERATIONS 100000" << Qt::endl;
+    out << "#endif" << Qt::endl;
+    out << "// Random payloads built per command, used in turn" << Qt::endl;
+    out << "#ifndef LCSF_BENCH_SAMPLES" << Qt::endl;
+    out << "#define LCSF_BENCH_SAMPLES 16" << Qt::endl;
+    out << "#endif" << Qt::endl;
+    out << "// Maximum byte array and string size" << Qt::endl;
+    out << "#ifndef LCSF_BENCH_MAX_DATA_SIZE" << Qt::endl;
+    out << "#define LCSF_BENCH_MAX_DATA_SIZE 64" << Qt::endl;
+    out << "#endif" << Qt::endl;
+    out << "#ifndef LCSF_BENCH_SEED" << Qt::endl;
+    out << "#define LCSF_BENCH_SEED 1" << Qt::endl;
+    out << "#endif" << Qt::endl;
+    out << "// Override to match the validator initialization of the LCSF stack version in use" << Qt::endl;
+    out << "#ifndef LCSF_BENCH_VALIDATOR_INIT" << Qt::endl;
+    out << "#define LCSF_BENCH_VALIDATOR_INIT() (LCSF_ValidatorAddProtocol_A(0, &LCSF_" << protocolName
+        << "_ProtDesc_A) && LCSF_ValidatorAddProtocol_B(0, &LCSF_" << protocolName << "_ProtDesc_B))" << Qt::endl;
+    out << "#endif" << Qt::endl;
+    out << "// Worst-case frame size" << Qt::endl;
+    out << "#define LCSF_BENCH_BUFFER_SIZE ((" << maxFieldNb << " * 2) + " << maxDataSize << " + (" << maxRefNb
+        << " * (LCSF_BENCH_MAX_DATA_SIZE + 1)))" << Qt::endl;
+    out << Qt::endl;
+    out << "// --- Private Types ---" << Qt::endl;
+    out << "typedef struct _lcsf_bench_cmd {" << Qt::endl;
+    out << "    const char *pName;" << Qt::endl;
+    out << "    uint_fast16_t cmdName;" << Qt::endl;
+    out << "    void (*pFnBuild)(" << protocolName.toLower() << "_cmd_payload_t *pCmdPayload);" << Qt::endl;
+    out << "} lcsf_bench_cmd_t;" << Qt::endl;
+    out << Qt::endl;
+    out << "// --- Private Variables ---" << Qt::endl;
+    out << "static uint32_t LcsfBenchRandState = LCSF_BENCH_SEED;" << Qt::endl;
+    out << "static uint32_t LcsfBenchExecCount;" << Qt::endl;
+    out << "static uint8_t LcsfBenchBytes[LCSF_BENCH_MAX_DATA_SIZE];" << Qt::endl;
+    out << "static char LcsfBenchChars[LCSF_BENCH_MAX_DATA_SIZE + 1];" << Qt::endl;
+    out << "static " << protocolName.toLower() << "_cmd_payload_t LcsfBenchPayloads[LCSF_BENCH_SAMPLES];" << Qt::endl;
+    out << "static uint8_t LcsfBenchBuffer[LCSF_BENCH_BUFFER_SIZE];" << Qt::endl;
+    out << Qt::endl;
+    out << "// *** End Definitions ***" << Qt::endl;
+    out << Qt::endl;
+    out << "// *** Private Functions ***" << Qt::endl;
+    out << Qt::endl;
+    QList<Command *> txCmdList;
+    for (Command *command : cmdList) {
+        if (command->isTransmittable(isA)) {
+            txCmdList.append(command);
+        }
+    }
+    this->writeBenchBuilders(protocolName, txCmdList, &out);
+    out << "static const lcsf_bench_cmd_t LCSF_Bench_Cmds[] = {" << Qt::endl;
+    for (Command *command : cmdList) {
+        if (command->isTransmittable(isA)) {
+            out << "    {\"" << command->getName() << "\", " << protocolName.toUpper() << "_CMD_"
+                << command->getName().toUpper() << ", ";
+            if (command->getAttArray().size() > 0) {
+                out << "LCSF_Bench_Build" << command->getName() << "}," << Qt::endl;
+            } else {
+                out << "NULL}," << Qt::endl;
+            }
+        }
+    }
+    out << "};" << Qt::endl;
+    out << Qt::endl;
+    out << "/**" << Qt::endl;
+    out << " * \\fn static bool LCSF_Bench_Run(const lcsf_bench_cmd_t *pCmd, double *pMsgRate, double *pByteRate)"
+        << Qt::endl;
+    out << " * \\brief Encode and decode a command LCSF_BENCH_ITERATIONS times, cycling through its sample payloads"
+        << Qt::endl;
+    out << " *" << Qt::endl;
+    out << " * \\param pCmd pointer to the command" << Qt::endl;
+    out << " * \\param pMsgRate pointer to the round trips per second" << Qt::endl;
+    out << " * \\param pByteRate pointer to the frame bytes per second" << Qt::endl;
+    out << " * \\return bool: true if every frame was encoded and executed" << Qt::endl;
+    out << " */" << Qt::endl;
+    out << "static bool LCSF_Bench_Run(const lcsf_bench_cmd_t *pCmd, double *pMsgRate, double *pByteRate) {" << Qt::endl;
+    out << "    struct timespec start;" << Qt::endl;
+    out << "    struct timespec end;" << Qt::endl;
+    out << "    uint64_t byteNb = 0;" << Qt::endl;
+    out << Qt::endl;
+    out << "    for (uint32_t idx = 0; idx < LCSF_BENCH_SAMPLES; idx++) {" << Qt::endl;
+    out << "        if (pCmd->pFnBuild != NULL) {" << Qt::endl;
+    out << "            pCmd->pFnBuild(&(LcsfBenchPayloads[idx]));" << Qt::endl;
+    out << "        }" << Qt::endl;
+    out << "    }" << Qt::endl;
+    out << "    LcsfBenchExecCount = 0;" << Qt::endl;
+    out << "    clock_gettime(CLOCK_MONOTONIC, &start);" << Qt::endl;
+    out << "    for (uint32_t idx = 0; idx < LCSF_BENCH_ITERATIONS; idx++) {" << Qt::endl;
+    out << "        int frameSize = LCSF_Bridge_" << protocolName << "Encode_" << txSide
+        << "(pCmd->cmdName, &(LcsfBenchPayloads[idx % LCSF_BENCH_SAMPLES]), LcsfBenchBuffer, sizeof(LcsfBenchBuffer));"
+        << Qt::endl;
+    out << Qt::endl;
+    out << "        if (frameSize <= 0) {" << Qt::endl;
+    out << "            return false;" << Qt::endl;
+    out << "        }" << Qt::endl;
+    if (isFrameReceive) {
+        out << "        LCSF_Bridge_" << protocolName << "ReceiveFrame_" << rxSide
+            << "(LcsfBenchBuffer, (size_t)frameSize);" << Qt::endl;
+    } else {
+        out << "        LCSF_ValidatorReceive_" << rxSide << "(LcsfBenchBuffer, (size_t)frameSize);" << Qt::endl;
+    }
+    out << "        byteNb += (uint64_t)frameSize;" << Qt::endl;
+    out << "    }" << Qt::endl;
+    out << "    clock_gettime(CLOCK_MONOTONIC, &end);" << Qt::endl;
+    out << "    if (LcsfBenchExecCount != LCSF_BENCH_ITERATIONS) {" << Qt::endl;
+    out << "        return false;" << Qt::endl;
+    out << "    }" << Qt::endl;
+    out << "    double elapsed = (double)(end.tv_sec - start.tv_sec) + ((double)(end.tv_nsec - start.tv_nsec) / 1e9);"
+        << Qt::endl;
+    out << "    *pMsgRate = (elapsed > 0.0) ? (LCSF_BENCH_ITERATIONS / elapsed) : 0.0;" << Qt::endl;
+    out << "    *pByteRate = (elapsed > 0.0) ? ((double)byteNb / elapsed) : 0.0;" << Qt::endl;
+    out << "    return true;" << Qt::endl;
+    out << "}" << Qt::endl;
+    out << Qt::endl;
+    out << "// *** Public Functions ***" << Qt::endl;
+    out << Qt::endl;
+    for (const QString &side : {QString("A"), QString("B")}) {
+        out << "// Stands for " << protocolName << "_MainExecute of side " << side << ", only counts executed commands"
+            << Qt::endl;
+        out << "bool " << protocolName << "_MainExecute_" << side << "(uint_fast16_t cmdName, "
+            << protocolName.toLower() << "_cmd_payload_t *pCmdPayload) {" << Qt::endl;
+        out << "    (void)cmdName;" << Qt::endl;
+        out << "    (void)pCmdPayload;" << Qt::endl;
+        out << "    LcsfBenchExecCount++;" << Qt::endl;
+        out << "    return true;" << Qt::endl;
+        out << "}" << Qt::endl;
+        out << Qt::endl;
+    }
+    out << "int main(void) {" << Qt::endl;
+    out << "    int ret = EXIT_SUCCESS;" << Qt::endl;
+    out << Qt::endl;
+    out << "    if (!LCSF_Bridge_" << protocolName << "Init_A() || !LCSF_Bridge_" << protocolName
+        << "Init_B() || !LCSF_BENCH_VALIDATOR_INIT()) {" << Qt::endl;
+    out << "        printf(\"Initialization failed\\n\");" << Qt::endl;
+    out << "        return EXIT_FAILURE;" << Qt::endl;
+    out << "    }" << Qt::endl;
+    out << "    for (uint32_t idx = 0; idx < LCSF_BENCH_MAX_DATA_SIZE; idx++) {" << Qt::endl;
+    out << "        LcsfBenchBytes[idx] = (uint8_t)LCSF_Bench_Rand();" << Qt::endl;
+    out << "        LcsfBenchChars[idx] = (char)('a' + (LCSF_Bench_Rand() % 26));" << Qt::endl;
+    out << "    }" << Qt::endl;
+    out << "    LcsfBenchChars[LCSF_BENCH_MAX_DATA_SIZE] = '\\0';" << Qt::endl;
+    out << "    printf(\"%-24s %16s %16s\\n\", \"Command\", \"msg/s\", \"bytes/s\");" << Qt::endl;
+    out << "    for (size_t idx = 0; idx < (sizeof(LCSF_Bench_Cmds) / sizeof(LCSF_Bench_Cmds[0])); idx++) {" << Qt::endl;
+    out << "        double msgRate;" << Qt::endl;
+    out << "        double byteRate;" << Qt::endl;
+    out << Qt::endl;
+    out << "        if (!LCSF_Bench_Run(&(LCSF_Bench_Cmds[idx]), &msgRate, &byteRate)) {" << Qt::endl;
+    out << "            printf(\"%-24s round trip failed\\n\", LCSF_Bench_Cmds[idx].pName);" << Qt::endl;
+    out << "            ret = EXIT_FAILURE;" << Qt::endl;
+    out << "            continue;" << Qt::endl;
+    out << "        }" << Qt::endl;
+    out << "        printf(\"%-24s %16.0f %16.0f\\n\", LCSF_Bench_Cmds[idx].pName, msgRate, byteRate);" << Qt::endl;
+    out << "    }" << Qt::endl;
+    out << "    return ret;" << Qt::endl;
+    out << "}" << Qt::endl;
+
+    file.close();
+    Profiler::addCounter("Bytes written", file.size());
+    return true;
+}
+
+// Loopback side symbols header, shared by the loopback harness and the throughput benchmarks
+bool CodeGenerator::writeLoopbackHeader(QString protocolName, QList<Command *> cmdList, QString dirPath) {
+    QString headerName = "LCSF_Loopback_" + protocolName + ".h";
+    QFile headerFile(dirPath + "/" + headerName);
+    QString payloadType = protocolName.toLower() + "_cmd_payload_t";
+    QString ctxType = protocolName.toLower() + "_ctx_t";
+    QString bridgeCtxType = "lcsf_bridge_" + protocolName.toLower() + "_ctx_t";
+    QString bridgeCtxParam = this->getBridgeCtxParam(protocolName, false);
+    QStringList sideSymbols = {"LCSF_Bridge_" + protocolName + "Init", "LCSF_Bridge_" + protocolName + "Receive",
+        "LCSF_Bridge_" + protocolName + "Encode", "LCSF_" + protocolName + "_ProtDesc", protocolName + "_MainExecute",
+        "LCSF_ValidatorAddProtocol", "LCSF_ValidatorReceive", "LCSF_ValidatorEncode", "GetVLESize"};
+    QString statsMacro = "LCSF_BRIDGE_" + protocolName.toUpper() + "_STATS";
+    QString statsType = "lcsf_bridge_" + protocolName.toLower() + "_stats_t";
+    QString segType = "lcsf_bridge_" + protocolName.toLower() + "_segment_t";
+    QString txStreamType = "lcsf_bridge_" + protocolName.toLower() + "_tx_stream_t";
+    QString rxStreamType = "lcsf_bridge_" + protocolName.toLower() + "_rx_stream_t";
+    bool isStream = this->hasStreamAtt(cmdList);
+    bool isFrameReceive = this->fastDecoderMode || this->reentrantMode;
+
+    if (this->reentrantMode) {
+        sideSymbols.append("LCSF_Bridge_" + protocolName + "Bind");
+    }
+    if (this->segmentEncodeMode) {
+        sideSymbols.append("LCSF_Bridge_" + protocolName + "EncodeSegments");
+    }
+    if (isStream) {
+        QStringList streamSymbols = {"EncodeStreamHeader", "EncodeStreamBody", "StreamInit", "StreamReceive"};
+        for (const QString &name : streamSymbols) {
+            sideSymbols.append("LCSF_Bridge_" + protocolName + name);
+        }
+    }
+    if (this->deferredMode) {
+        sideSymbols.append("LCSF_Bridge_" + protocolName + "Peek");
+        sideSymbols.append("LCSF_Bridge_" + protocolName + "Release");
+    }
+    if (this->fastDecoderMode || this->reentrantMode || isStream) {
+        sideSymbols.append("LCSF_Bridge_" + protocolName + "Decode");
+        sideSymbols.append("LCSF_Bridge_" + protocolName + "ReceiveFrame");
+    }
+    if (this->instrumentMode) {
+        QStringList statsSymbols = {"GetStats", "ResetStats", "StatsRx", "StatsHandler", "StatsTx", "StatsFail"};
+        for (const QString &name : statsSymbols) {
+            sideSymbols.append("LCSF_Bridge_" + protocolName + name);
+        }
+    }
+    if (!headerFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    QTextStream hOut(&headerFile);
+    hOut.setCodec("ISO 8859-1");
+
+    hOut << "/**" << Qt::endl;
+    hOut << " * \\file " << headerName << Qt::endl;
+    hOut << " * \\brief " << protocolName << " loopback harness, side symbols" << Qt::endl;
+    hOut << " * \\author LCSF Generator v" << APP_VERSION << Qt::endl;
+    hOut << " *" << Qt::endl;
+    hOut << " * Force include it with LCSF_LOOPBACK_SIDE defined to A or B when compiling a side (bridge, descriptor"
+         << Qt::endl;
+    hOut << " * and LCSF_Validator), the side symbols get suffixed so both sides link in the same harness or benchmark."
+         << Qt::endl;
+    hOut << " */" << Qt::endl;
+    hOut << Qt::endl;
+    hOut << "#ifndef LCSF_LOOPBACK_" << protocolName.toUpper() << "_H" << Qt::endl;
+    hOut << "#define LCSF_LOOPBACK_" << protocolName.toUpper() << "_H" << Qt::endl;
+    hOut << Qt::endl;
+    hOut << "#ifdef LCSF_LOOPBACK_SIDE" << Qt::endl;
+    hOut << "#define LCSF_LOOPBACK_CAT(name, side) name##_##side" << Qt::endl;
+    hOut << "#define LCSF_LOOPBACK_SYM(name, side) LCSF_LOOPBACK_CAT(name, side)" << Qt::endl;
+    for (const QString &symbol : sideSymbols) {
+        hOut << "#define " << symbol << " LCSF_LOOPBACK_SYM(" << symbol << ", LCSF_LOOPBACK_SIDE)" << Qt::endl;
+    }
+    hOut << "#else" << Qt::endl;
+    hOut << "// *** Libraries include ***" << Qt::endl;
+    hOut << "#include \"LCSF_Bridge_" << protocolName << ".h\"" << Qt::endl;
+    hOut << Qt::endl;
+    hOut << "// --- Public Function Prototypes ---" << Qt::endl;
+    for (const QString &side : {QString("A"), QString("B")}) {
+        hOut << "extern const lcsf_validator_protocol_desc_t LCSF_" << protocolName << "_ProtDesc_" << side << ";"
+             << Qt::endl;
+        if (this->reentrantMode) {
+            hOut << "bool LCSF_Bridge_" << protocolName << "Init_" << side << "(" << bridgeCtxType << " *pCtx, "
+                 << ctxType << " *pMainCtx);" << Qt::endl;
+        } else {
+            hOut << "bool LCSF_Bridge_" << protocolName << "Init_" << side << "(void);" << Qt::endl;
+        }
+        hOut << "int LCSF_Bridge_" << protocolName << "Encode_" << side << "(" << bridgeCtxParam
+             << "uint_fast16_t cmdName, " << payloadType << " *pCmdPayload, uint8_t *pBuffer, size_t buffSize);"
+             << Qt::endl;
+        if (this->segmentEncodeMode) {
+            hOut << "int LCSF_Bridge_" << protocolName << "EncodeSegments_" << side << "(uint_fast16_t cmdName, const "
+                 << payloadType << " *pCmdPayload, uint8_t *pHeader, size_t headerSize, " << segType
+                 << " *pSegArray, size_t segNb);" << Qt::endl;
+        }
+        if (isStream) {
+            hOut << "int LCSF_Bridge_" << protocolName << "EncodeStreamHeader_" << side << "(uint_fast16_t cmdName, const "
+                 << payloadType << " *pCmdPayload, uint8_t *pBuffer, size_t buffSize, " << txStreamType
+                 << " *pStream);" << Qt::endl;
+            hOut << "int LCSF_Bridge_" << protocolName << "EncodeStreamBody_" << side << "(" << txStreamType
+                 << " *pStream, size_t chunkSize);" << Qt::endl;
+            hOut << "void LCSF_Bridge_" << protocolName << "StreamInit_" << side << "(" << rxStreamType
+                 << " *pStream, uint8_t *pBuffer, size_t buffSize, lcsf_bridge_" << protocolName.toLower()
+                 << "_body_cb_t pBodyCb, void *pCbData);" << Qt::endl;
+            hOut << "bool LCSF_Bridge_" << protocolName << "StreamReceive_" << side << "(" << bridgeCtxParam
+                 << rxStreamType << " *pStream, const uint8_t *pData, size_t dataSize);" << Qt::endl;
+        }
+        if (this->deferredMode) {
+            hOut << payloadType << " *LCSF_Bridge_" << protocolName << "Peek_" << side << "(" << bridgeCtxParam
+                 << "uint16_t *pCmdName);" << Qt::endl;
+            hOut << "void LCSF_Bridge_" << protocolName << "Release_" << side << "("
+                 << this->getBridgeCtxParam(protocolName, true) << ");" << Qt::endl;
+        } else {
+            hOut << "bool " << protocolName << "_MainExecute_" << side << "(" << this->getCtxParam(protocolName, false)
+                 << "uint_fast16_t cmdName, " << payloadType << " *pCmdPayload);" << Qt::endl;
+        }
+        hOut << "bool LCSF_ValidatorAddProtocol_" << side
+             << "(uint_fast8_t protIdx, const lcsf_validator_protocol_desc_t *pProtDesc);" << Qt::endl;
+        if (isFrameReceive) {
+            hOut << "bool LCSF_Bridge_" << protocolName << "ReceiveFrame_" << side << "(" << bridgeCtxParam
+                 << "const uint8_t *pBuffer, size_t buffSize);" << Qt::endl;
+        } else {
+            hOut << "bool LCSF_ValidatorReceive_" << side << "(const uint8_t *pBuffer, size_t buffSize);" << Qt::endl;
+        }
+        if (this->instrumentMode) {
+            hOut << "#ifdef " << statsMacro << Qt::endl;
+            hOut << statsType << " *LCSF_Bridge_" << protocolName << "GetStats_" << side << "("
+                 << this->getBridgeCtxParam(protocolName, true) << ");" << Qt::endl;
+            hOut << "#endif" << Qt::endl;
+        }
+    }
+    hOut << "#endif" << Qt::endl;
+    hOut << Qt::endl;
+    hOut << "#endif // LCSF_LOOPBACK_" << protocolName.toUpper() << "_H" << Qt::endl;
+    headerFile.close();
+    Profiler::addCounter("Bytes written", headerFile.size());
+    return true;
+}
+
+void CodeGenerator::writeLoopbackStore(QString protocolName, QList<Command *> cmdList, QTextStream *pOut) {
+    QString payloadType = protocolName.toLower() + "_cmd_payload_t";
+    bool isStream = this->hasStreamAtt(cmdList);
+
+    *pOut << "static bool LCSF_Loopback_Store(lcsf_loopback_chan_t *pChan, uint_fast16_t cmdName, " << payloadType
+          << " *pCmdPayload) {" << Qt::endl;
+    if (isStream) {
+        *pOut << "    size_t bodySize = pChan->BodySize;" << Qt::endl;
+        *pOut << Qt::endl;
+        *pOut << "    pChan->BodySize = 0;" << Qt::endl;
+    }
+    *pOut << "    pChan->RxCmdName = cmdName;" << Qt::endl;
+    *pOut << "    if (pCmdPayload != NULL) {" << Qt::endl;
+    *pOut << "        pChan->RxPayload = *pCmdPayload;" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    if (isStream) {
+        *pOut << "    // Streamed bodies went through the body callback, point the payload to them" << Qt::endl;
+        *pOut << "    switch (cmdName) {" << Qt::endl;
+        for (Command *command : cmdList) {
+            Attribute *streamAtt = this->getStreamAtt(command);
+            if (streamAtt == nullptr) {
+                continue;
+            }
+            QString attPath = "pChan->RxPayload." + this->getPayloadPath(QStringList(command->getName()));
+            *pOut << "        case " << protocolName.toUpper() << "_CMD_" << command->getName().toUpper() << ":" << Qt::endl;
+            *pOut << "            if (" << attPath << streamAtt->getName().toLower() << "Size != bodySize) {" << Qt::endl;
+            *pOut << "                return false;" << Qt::endl;
+            *pOut << "            }" << Qt::endl;
+            *pOut << "            " << attPath << "p_" << streamAtt->getName().toLower() << " = pChan->Body;" << Qt::endl;
+            *pOut << "            break;" << Qt::endl;
+            *pOut << Qt::endl;
+        }
+        *pOut << "        default:" << Qt::endl;
+        *pOut << "            break;" << Qt::endl;
+        *pOut << "    }" << Qt::endl;
+    }
+    *pOut << "    pChan->RxCount++;" << Qt::endl;
+    *pOut << "    return true;" << Qt::endl;
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+    if (isStream) {
+        *pOut << "/**" << Qt::endl;
+        *pOut << " * \\fn static bool LCSF_Loopback_Body(void *pCbData, uint_fast16_t cmdName, const uint8_t *pChunk, "
+              << "size_t chunkSize, size_t bodyLeft)" << Qt::endl;
+        *pOut << " * \\brief Gather a streamed attribute body in the channel" << Qt::endl;
+        *pOut << " *" << Qt::endl;
+        *pOut << " * \\param pCbData pointer to the channel" << Qt::endl;
+        *pOut << " * \\param cmdName name of the command" << Qt::endl;
+        *pOut << " * \\param pChunk pointer to the body chunk" << Qt::endl;
+        *pOut << " * \\param chunkSize chunk size" << Qt::endl;
+        *pOut << " * \\param bodyLeft body size left after the chunk" << Qt::endl;
+        *pOut << " * \\return bool: true if the body fits the channel" << Qt::endl;
+        *pOut << " */" << Qt::endl;
+        *pOut << "static bool LCSF_Loopback_Body(void *pCbData, uint_fast16_t cmdName, const uint8_t *pChunk, "
+              << "size_t chunkSize, size_t bodyLeft) {" << Qt::endl;
+        *pOut << "    lcsf_loopback_chan_t *pChan = (lcsf_loopback_chan_t *)pCbData;" << Qt::endl;
+        *pOut << Qt::endl;
+        *pOut << "    (void)cmdName;" << Qt::endl;
+        *pOut << "    if ((pChan->BodySize + chunkSize + bodyLeft) > sizeof(pChan->Body)) {" << Qt::endl;
+        *pOut << "        return false;" << Qt::endl;
+        *pOut << "    }" << Qt::endl;
+        *pOut << "    memcpy(&(pChan->Body[pChan->BodySize]), pChunk, chunkSize);" << Qt::endl;
+        *pOut << "    pChan->BodySize += chunkSize;" << Qt::endl;
+        *pOut << "    return true;" << Qt::endl;
+        *pOut << "}" << Qt::endl;
+        *pOut << Qt::endl;
+    }
+}
+
+void CodeGenerator::writeLoopbackStream(QString protocolName, QList<Command *> cmdList, QString side, QTextStream *pOut) {
+    QString payloadType = protocolName.toLower() + "_cmd_payload_t";
+    QString txStreamType = "lcsf_bridge_" + protocolName.toLower() + "_tx_stream_t";
+    QString bridgeCtxArg = (this->reentrantMode) ? "&(pChan->BridgeCtx" + side + "), " : QString("");
+    QList<Command *> streamCmds = this->getStreamCmds(cmdList, side == "A");
+
+    if (!this->hasStreamAtt(cmdList)) {
+        return;
+    }
+    // Streamed bodies are sent after their header, as a transport sends them from their own storage
+    if (!streamCmds.isEmpty()) {
+        *pOut << "static int LCSF_Loopback_EncodeStream" << side << "(uint_fast16_t cmdName, const " << payloadType
+              << " *pCmdPayload, const uint8_t *pBody, uint8_t *pBuffer," << Qt::endl;
+        *pOut << "    size_t buffSize) {" << Qt::endl;
+        *pOut << "    " << txStreamType << " txStream;" << Qt::endl;
+        *pOut << "    int headerSize = LCSF_Bridge_" << protocolName << "EncodeStreamHeader_" << side
+              << "(cmdName, pCmdPayload, pBuffer, buffSize, &txStream);" << Qt::endl;
+        *pOut << Qt::endl;
+        *pOut << "    if ((headerSize < 0) || (txStream.BodyLeft > (buffSize - (size_t)headerSize))) {" << Qt::endl;
+        *pOut << "        return -1;" << Qt::endl;
+        *pOut << "    }" << Qt::endl;
+        *pOut << "    size_t bodySize = txStream.BodyLeft;" << Qt::endl;
+        *pOut << "    // Body follows the header, as a transport sends it from its own storage" << Qt::endl;
+        *pOut << "    if (bodySize > 0) {" << Qt::endl;
+        *pOut << "        memcpy(&(pBuffer[headerSize]), pBody, bodySize);" << Qt::endl;
+        *pOut << "    }" << Qt::endl;
+        *pOut << "    if (LCSF_Bridge_" << protocolName << "EncodeStreamBody_" << side << "(&txStream, bodySize) != 0) {"
+              << Qt::endl;
+        *pOut << "        return -1;" << Qt::endl;
+        *pOut << "    }" << Qt::endl;
+        *pOut << "    return headerSize + (int)bodySize;" << Qt::endl;
+        *pOut << "}" << Qt::endl;
+        *pOut << Qt::endl;
+    }
+    *pOut << "static bool LCSF_Loopback_Feed" << side
+          << "(lcsf_loopback_chan_t *pChan, const uint8_t *pBuffer, size_t buffSize) {" << Qt::endl;
+    *pOut << "    // Feed the frame in chunks, as a byte stream delivers it" << Qt::endl;
+    *pOut << "    for (size_t idx = 0; idx < buffSize; idx += LCSF_LOOPBACK_STREAM_CHUNK) {" << Qt::endl;
+    *pOut << "        size_t chunkSize = ((buffSize - idx) < LCSF_LOOPBACK_STREAM_CHUNK) ? (buffSize - idx) : "
+          << "LCSF_LOOPBACK_STREAM_CHUNK;" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "        if (!LCSF_Bridge_" << protocolName << "StreamReceive_" << side << "(" << bridgeCtxArg
+          << "&(pChan->RxStream" << side << "), &(pBuffer[idx]), chunkSize)) {" << Qt::endl;
+    *pOut << "            return false;" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << "    return true;" << Qt::endl;
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+}
+
+void CodeGenerator::writeLoopbackSide(QString protocolName, QList<Command *> cmdList, QString side, QTextStream *pOut) {
+    QString payloadType = protocolName.toLower() + "_cmd_payload_t";
+    QString segMacroPrefix = "LCSF_BRIDGE_" + protocolName.toUpper() + "_SEG_";
+    QString bridgeCtxArg = (this->reentrantMode) ? "&(pChan->BridgeCtx" + side + "), " : QString("");
+    bool isStream = this->hasStreamAtt(cmdList);
+    // Fast decoder and reentrant channels receive through the decoder
+    bool isFrameReceive = this->fastDecoderMode || this->reentrantMode;
+    QList<Command *> streamCmds = this->getStreamCmds(cmdList, side == "A");
+
+    *pOut << "static bool LCSF_Loopback_Init" << side << "(lcsf_loopback_chan_t *pChan) {" << Qt::endl;
+    if (isStream) {
+        *pOut << "    LCSF_Bridge_" << protocolName << "StreamInit_" << side << "(&(pChan->RxStream" << side
+              << "), pChan->RxFrame" << side << ", sizeof(pChan->RxFrame" << side << "), LCSF_Loopback_Body, pChan);"
+              << Qt::endl;
+    }
+    if (this->reentrantMode) {
+        *pOut << "    pChan->MainCtx" << side << ".pUserData = pChan;" << Qt::endl;
+        *pOut << "    return LCSF_Bridge_" << protocolName << "Init_" << side << "(&(pChan->BridgeCtx" << side
+              << "), &(pChan->MainCtx" << side << "));" << Qt::endl;
+    } else {
+        if (!isStream) {
+            *pOut << "    (void)pChan;" << Qt::endl;
+        }
+        *pOut << "    return LCSF_Bridge_" << protocolName << "Init_" << side << "();" << Qt::endl;
+    }
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+    this->writeLoopbackStream(protocolName, cmdList, side, pOut);
+    *pOut << "static int LCSF_Loopback_Encode" << side << "(lcsf_loopback_chan_t *pChan, uint_fast16_t cmdName, "
+          << payloadType << " *pCmdPayload, uint8_t *pBuffer, size_t buffSize) {" << Qt::endl;
+    if (!streamCmds.isEmpty()) {
+        *pOut << "    // Commands with a streamed attribute send their header then their body" << Qt::endl;
+        *pOut << "    switch (cmdName) {" << Qt::endl;
+        for (Command *command : streamCmds) {
+            *pOut << "        case " << protocolName.toUpper() << "_CMD_" << command->getName().toUpper() << ":"
+                  << Qt::endl;
+            *pOut << "            return LCSF_Loopback_EncodeStream" << side << "(cmdName, pCmdPayload, pCmdPayload->"
+                  << this->getPayloadPath(QStringList(command->getName())) << "p_"
+                  << this->getStreamAtt(command)->getName().toLower() << ", pBuffer," << Qt::endl;
+            *pOut << "                buffSize);" << Qt::endl;
+            *pOut << Qt::endl;
+        }
+        *pOut << "        default:" << Qt::endl;
+        *pOut << "            break;" << Qt::endl;
+        *pOut << "    }" << Qt::endl;
+    }
+    // Segments are gathered into a single frame for the receiver
+    if (this->segmentEncodeMode) {
+        *pOut << "    size_t frameSize = 0;" << Qt::endl;
+        *pOut << "    int segNb = LCSF_Bridge_" << protocolName << "EncodeSegments_" << side
+              << "(cmdName, pCmdPayload, pChan->SegHeader, sizeof(pChan->SegHeader)," << Qt::endl;
+        *pOut << "        pChan->Segs, " << segMacroPrefix << "NB);" << Qt::endl;
+        *pOut << Qt::endl;
+        *pOut << "    if (segNb < 0) {" << Qt::endl;
+        *pOut << "        return -1;" << Qt::endl;
+        *pOut << "    }" << Qt::endl;
+        *pOut << "    // Gather the segments as a vectored write would" << Qt::endl;
+        *pOut << "    for (int idx = 0; idx < segNb; idx++) {" << Qt::endl;
+        *pOut << "        if ((frameSize + pChan->Segs[idx].Size) > buffSize) {" << Qt::endl;
+        *pOut << "            return -1;" << Qt::endl;
+        *pOut << "        }" << Qt::endl;
+        *pOut << "        memcpy(&(pBuffer[frameSize]), pChan->Segs[idx].pData, pChan->Segs[idx].Size);" << Qt::endl;
+        *pOut << "        frameSize += pChan->Segs[idx].Size;" << Qt::endl;
+        *pOut << "    }" << Qt::endl;
+        *pOut << "    return (int)frameSize;" << Qt::endl;
+    } else {
+        if (!this->reentrantMode) {
+            *pOut << "    (void)pChan;" << Qt::endl;
+        }
+        *pOut << "    return LCSF_Bridge_" << protocolName << "Encode_" << side << "(" << bridgeCtxArg
+              << "cmdName, pCmdPayload, pBuffer, buffSize);" << Qt::endl;
+    }
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "static bool LCSF_Loopback_Receive" << side
+          << "(lcsf_loopback_chan_t *pChan, const uint8_t *pBuffer, size_t buffSize) {" << Qt::endl;
+    if (!this->reentrantMode && !isStream) {
+        *pOut << "    (void)pChan;" << Qt::endl;
+    }
+    // Frames go through LCSF_Validator unless the bridge receives them itself
+    QString receiveCall = "LCSF_ValidatorReceive_" + side + "(pBuffer, buffSize)";
+    if (isStream) {
+        receiveCall = "LCSF_Loopback_Feed" + side + "(pChan, pBuffer, buffSize)";
+    } else if (isFrameReceive) {
+        receiveCall = "LCSF_Bridge_" + protocolName + "ReceiveFrame_" + side + "(" + bridgeCtxArg + "pBuffer, buffSize)";
+    }
+    // Deferred commands wait in the receiver queue, drain it after each frame
+    if (this->deferredMode) {
+        QString releaseArg = (this->reentrantMode) ? "&(pChan->BridgeCtx" + side + ")" : QString("");
+
+        *pOut << "    " << payloadType << " *pCmdPayload;" << Qt::endl;
+        *pOut << "    uint16_t cmdName;" << Qt::endl;
+        *pOut << "    bool isOk = true;" << Qt::endl;
+        *pOut << Qt::endl;
+        *pOut << "    if (!" << receiveCall << ") {" << Qt::endl;
+        *pOut << "        return false;" << Qt::endl;
+        *pOut << "    }" << Qt::endl;
+        *pOut << "    // Stand for " << protocolName << "_MainPoll, drain the queue" << Qt::endl;
+        *pOut << "    while ((pCmdPayload = LCSF_Bridge_" << protocolName << "Peek_" << side << "(" << bridgeCtxArg
+              << "&cmdName)) != NULL) {" << Qt::endl;
+        *pOut << "        isOk = LCSF_Loopback_Store(pChan, cmdName, pCmdPayload) && isOk;" << Qt::endl;
+        *pOut << "        LCSF_Bridge_" << protocolName << "Release_" << side << "(" << releaseArg << ");" << Qt::endl;
+        *pOut << "    }" << Qt::endl;
+        *pOut << "    return isOk;" << Qt::endl;
+    } else {
+        *pOut << "    return " << receiveCall << ";" << Qt::endl;
+    }
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+}
+
+void CodeGenerator::writeLoopbackChecks(QString protocolName, QList<Command *> cmdList, QTextStream *pOut) {
+    QString payloadType = protocolName.toLower() + "_cmd_payload_t";
+
+    *pOut << "static const lcsf_loopback_link_t LcsfLoopbackAToB = {\"A->B\", LCSF_Loopback_EncodeA, "
+          << "LCSF_Loopback_ReceiveB};" << Qt::endl;
+    *pOut << "static const lcsf_loopback_link_t LcsfLoopbackBToA = {\"B->A\", LCSF_Loopback_EncodeB, "
+          << "LCSF_Loopback_ReceiveA};" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "static const lcsf_loopback_cmd_t LCSF_Loopback_Cmds[LCSF_LOOPBACK_CMD_NB] = {" << Qt::endl;
+    for (Command *command : cmdList) {
+        QString fnString = (command->getAttArray().size() > 0)
+            ? "LCSF_Bench_Build" + command->getName() + ", LCSF_Loopback_Compare" + command->getName()
+            : QString("NULL, NULL");
+        if (command->isTransmittable(true)) {
+            *pOut << "    {\"" << command->getName() << "\", " << protocolName.toUpper() << "_CMD_"
+                  << command->getName().toUpper() << ", &LcsfLoopbackAToB, " << fnString << "}," << Qt::endl;
+        }
+        if (command->isTransmittable(false)) {
+            *pOut << "    {\"" << command->getName() << "\", " << protocolName.toUpper() << "_CMD_"
+                  << command->getName().toUpper() << ", &LcsfLoopbackBToA, " << fnString << "}," << Qt::endl;
+        }
+    }
+    *pOut << "};" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "/**" << Qt::endl;
+    *pOut << " * \\fn static bool LCSF_Loopback_Check(lcsf_loopback_chan_t *pChan, const lcsf_loopback_cmd_t *pCmd)"
+          << Qt::endl;
+    *pOut << " * \\brief Send random payloads of a command through its link and compare what the other side received"
+          << Qt::endl;
+    *pOut << " *" << Qt::endl;
+    *pOut << " * \\param pChan pointer to the channel" << Qt::endl;
+    *pOut << " * \\param pCmd pointer to the command" << Qt::endl;
+    *pOut << " * \\return bool: true if every payload was received unchanged" << Qt::endl;
+    *pOut << " */" << Qt::endl;
+    *pOut << "static bool LCSF_Loopback_Check(lcsf_loopback_chan_t *pChan, const lcsf_loopback_cmd_t *pCmd) {"
+          << Qt::endl;
+    *pOut << "    " << payloadType << " sentPayload;" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    for (uint32_t idx = 0; idx < LCSF_LOOPBACK_CHECKS; idx++) {" << Qt::endl;
+    *pOut << "        memset(&sentPayload, 0, sizeof(sentPayload));" << Qt::endl;
+    *pOut << "        if (pCmd->pFnBuild != NULL) {" << Qt::endl;
+    *pOut << "            pCmd->pFnBuild(&sentPayload);" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "        int frameSize = pCmd->pLink->pFnEncode(pChan, pCmd->cmdName, &sentPayload, pChan->Buffer, "
+          << "sizeof(pChan->Buffer));" << Qt::endl;
+    *pOut << "        uint32_t rxCount = pChan->RxCount;" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "        if ((frameSize <= 0) || !pCmd->pLink->pFnReceive(pChan, pChan->Buffer, (size_t)frameSize)) {"
+          << Qt::endl;
+    *pOut << "            return false;" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "        if ((pChan->RxCount != (rxCount + 1)) || (pChan->RxCmdName != pCmd->cmdName)) {" << Qt::endl;
+    *pOut << "            return false;" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "        // Received payload points into the frame, compare before it gets reused" << Qt::endl;
+    *pOut << "        if ((pCmd->pFnCompare != NULL) && !pCmd->pFnCompare(&sentPayload, &(pChan->RxPayload))) {"
+          << Qt::endl;
+    *pOut << "            return false;" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << "    return true;" << Qt::endl;
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "/**" << Qt::endl;
+    *pOut << " * \\fn static bool LCSF_Loopback_Bench(lcsf_loopback_chan_t *pChan, const lcsf_loopback_cmd_t *pCmd, "
+          << "lcsf_loopback_result_t *pResult)" << Qt::endl;
+    *pOut << " * \\brief Time LCSF_BENCH_ITERATIONS round trips of a command through its link" << Qt::endl;
+    *pOut << " *" << Qt::endl;
+    *pOut << " * \\param pChan pointer to the channel" << Qt::endl;
+    *pOut << " * \\param pCmd pointer to the command" << Qt::endl;
+    *pOut << " * \\param pResult pointer to contain the round trips and the frame bytes per second" << Qt::endl;
+    *pOut << " * \\return bool: true if every frame was encoded and executed" << Qt::endl;
+    *pOut << " */" << Qt::endl;
+    *pOut << "static bool LCSF_Loopback_Bench(lcsf_loopback_chan_t *pChan, const lcsf_loopback_cmd_t *pCmd, "
+          << "lcsf_loopback_result_t *pResult) {" << Qt::endl;
+    *pOut << "    struct timespec start;" << Qt::endl;
+    *pOut << "    struct timespec end;" << Qt::endl;
+    *pOut << "    uint64_t byteNb = 0;" << Qt::endl;
+    *pOut << "    uint32_t rxCount = pChan->RxCount;" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    for (uint32_t idx = 0; idx < LCSF_BENCH_SAMPLES; idx++) {" << Qt::endl;
+    *pOut << "        memset(&(pChan->BenchPayloads[idx]), 0, sizeof(pChan->BenchPayloads[idx]));" << Qt::endl;
+    *pOut << "        if (pCmd->pFnBuild != NULL) {" << Qt::endl;
+    *pOut << "            pCmd->pFnBuild(&(pChan->BenchPayloads[idx]));" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << "    clock_gettime(CLOCK_MONOTONIC, &start);" << Qt::endl;
+    *pOut << "    for (uint32_t idx = 0; idx < LCSF_BENCH_ITERATIONS; idx++) {" << Qt::endl;
+    *pOut << "        int frameSize = pCmd->pLink->pFnEncode(pChan, pCmd->cmdName, &(pChan->BenchPayloads[idx % "
+          << "LCSF_BENCH_SAMPLES]), pChan->Buffer, sizeof(pChan->Buffer));" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "        if (frameSize <= 0) {" << Qt::endl;
+    *pOut << "            return false;" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "        pCmd->pLink->pFnReceive(pChan, pChan->Buffer, (size_t)frameSize);" << Qt::endl;
+    *pOut << "        byteNb += (uint64_t)frameSize;" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << "    clock_gettime(CLOCK_MONOTONIC, &end);" << Qt::endl;
+    *pOut << "    if ((pChan->RxCount - rxCount) != LCSF_BENCH_ITERATIONS) {" << Qt::endl;
+    *pOut << "        return false;" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << "    double elapsed = (double)(end.tv_sec - start.tv_sec) + ((double)(end.tv_nsec - start.tv_nsec) / 1e9);"
+          << Qt::endl;
+    *pOut << "    pResult->MsgRate = (elapsed > 0.0) ? (LCSF_BENCH_ITERATIONS / elapsed) : 0.0;" << Qt::endl;
+    *pOut << "    pResult->ByteRate = (elapsed > 0.0) ? ((double)byteNb / elapsed) : 0.0;" << Qt::endl;
+    *pOut << "    return true;" << Qt::endl;
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+    // Frames of another encoder, from the header named by LCSF_LOOPBACK_GOLDEN
+    *pOut << "#ifdef LCSF_LOOPBACK_GOLDEN" << Qt::endl;
+    *pOut << "/**" << Qt::endl;
+    *pOut << " * \\fn static bool LCSF_Loopback_CheckGolden(lcsf_loopback_chan_t *pChan)" << Qt::endl;
+    *pOut << " * \\brief Receive each reference frame on the side it is sent to and encode it back on the other side"
+          << Qt::endl;
+    *pOut << " *" << Qt::endl;
+    *pOut << " * \\param pChan pointer to the channel" << Qt::endl;
+    *pOut << " * \\return bool: true if every frame was received and encoded back byte for byte" << Qt::endl;
+    *pOut << " */" << Qt::endl;
+    *pOut << "static bool LCSF_Loopback_CheckGolden(lcsf_loopback_chan_t *pChan) {" << Qt::endl;
+    *pOut << "    bool isOk = true;" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    for (size_t idx = 0; idx < LCSF_GOLDEN_FRAME_NB; idx++) {" << Qt::endl;
+    *pOut << "        const lcsf_golden_frame_t *pGolden = &(LcsfGoldenFrames[idx]);" << Qt::endl;
+    *pOut << "        const lcsf_loopback_link_t *pLink = (pGolden->IsAToB) ? &LcsfLoopbackAToB : &LcsfLoopbackBToA;"
+          << Qt::endl;
+    *pOut << "        uint32_t rxCount = pChan->RxCount;" << Qt::endl;
+    *pOut << "        int frameSize = -1;" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "        if (pLink->pFnReceive(pChan, pGolden->pFrame, pGolden->FrameSize) && "
+          << "(pChan->RxCount == (rxCount + 1))) {" << Qt::endl;
+    *pOut << "            frameSize = pLink->pFnEncode(pChan, pChan->RxCmdName, &(pChan->RxPayload), pChan->Buffer, "
+          << "sizeof(pChan->Buffer));" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "        if ((frameSize != (int)pGolden->FrameSize) || "
+          << "(memcmp(pChan->Buffer, pGolden->pFrame, pGolden->FrameSize) != 0)) {" << Qt::endl;
+    *pOut << "            printf(\"Reference frame %s %s mismatch\\n\", pGolden->pName, pLink->pName);" << Qt::endl;
+    *pOut << "            isOk = false;" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << "    return isOk;" << Qt::endl;
+    *pOut << "}" << Qt::endl;
+    *pOut << "#endif" << Qt::endl;
+    *pOut << Qt::endl;
+}
+
+void CodeGenerator::writeLoopbackStats(QString protocolName, QList<Command *> cmdList, QTextStream *pOut) {
+    QString statsMacro = "LCSF_BRIDGE_" + protocolName.toUpper() + "_STATS";
+    QString statsType = "lcsf_bridge_" + protocolName.toLower() + "_stats_t";
+    QString statsArgA = (this->reentrantMode) ? QString("&(pChan->BridgeCtxA)") : QString("");
+    QString statsArgB = (this->reentrantMode) ? QString("&(pChan->BridgeCtxB)") : QString("");
+    // EncodeSegments and EncodeStreamHeader have no hook, only the received side counts
+    bool isTxCounted = !this->segmentEncodeMode && !this->hasStreamAtt(cmdList);
+
+    if (!this->instrumentMode) {
+        return;
+    }
+    *pOut << "#ifdef " << statsMacro << Qt::endl;
+    *pOut << "/**" << Qt::endl;
+    *pOut << " * \\fn static bool LCSF_Loopback_CheckStats(lcsf_loopback_chan_t *pChan)" << Qt::endl;
+    *pOut << " * \\brief Check the instrumentation counted each frame on both sides of its link" << Qt::endl;
+    *pOut << " *" << Qt::endl;
+    *pOut << " * \\param pChan pointer to the channel" << Qt::endl;
+    if (!isTxCounted) {
+        *pOut << " * \\return bool: true if nothing failed, segment and stream encoding are not counted" << Qt::endl;
+    } else {
+        *pOut << " * \\return bool: true if the sent and received counts match and nothing failed" << Qt::endl;
+    }
+    *pOut << " */" << Qt::endl;
+    *pOut << "static bool LCSF_Loopback_CheckStats(lcsf_loopback_chan_t *pChan) {" << Qt::endl;
+    if (!this->reentrantMode) {
+        *pOut << "    (void)pChan;" << Qt::endl;
+    }
+    *pOut << "    const " << statsType << " *pStatsA = LCSF_Bridge_" << protocolName << "GetStats_A(" << statsArgA
+          << ");" << Qt::endl;
+    *pOut << "    const " << statsType << " *pStatsB = LCSF_Bridge_" << protocolName << "GetStats_B(" << statsArgB
+          << ");" << Qt::endl;
+    *pOut << Qt::endl;
+    if (isTxCounted) {
+        *pOut << "    for (uint_fast16_t cmdName = 0; cmdName < LCSF_" << protocolName.toUpper()
+              << "_CMD_NB; cmdName++) {" << Qt::endl;
+        *pOut << "        if ((pStatsA->Cmd[cmdName].TxCount != pStatsB->Cmd[cmdName].RxCount) ||" << Qt::endl;
+        *pOut << "            (pStatsB->Cmd[cmdName].TxCount != pStatsA->Cmd[cmdName].RxCount)) {" << Qt::endl;
+        *pOut << "            return false;" << Qt::endl;
+        *pOut << "        }" << Qt::endl;
+        *pOut << "    }" << Qt::endl;
+    }
+    *pOut << "    for (uint_fast8_t reason = 0; reason < LCSF_BRIDGE_" << protocolName.toUpper() << "_FAIL_NB; reason++) {"
+          << Qt::endl;
+    *pOut << "        if ((pStatsA->FailCount[reason] != 0) || (pStatsB->FailCount[reason] != 0)) {" << Qt::endl;
+    *pOut << "            return false;" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << "    return true;" << Qt::endl;
+    *pOut << "}" << Qt::endl;
+    *pOut << "#endif" << Qt::endl;
+    *pOut << Qt::endl;
+}
+
+void CodeGenerator::writeLoopbackMain(QString protocolName, QTextStream *pOut) {
+    QString payloadType = protocolName.toLower() + "_cmd_payload_t";
+    QString statsMacro = "LCSF_BRIDGE_" + protocolName.toUpper() + "_STATS";
+
+    *pOut << "// *** Public Functions ***" << Qt::endl;
+    *pOut << Qt::endl;
+    // Deferred commands are drained by the receive calls instead
+    if (!this->deferredMode) {
+        *pOut << "// Stand for " << protocolName << "_MainExecute of each side, store the received command" << Qt::endl;
+        for (const QString &side : {QString("A"), QString("B")}) {
+            *pOut << "bool " << protocolName << "_MainExecute_" << side << "(" << this->getCtxParam(protocolName, false)
+                  << "uint_fast16_t cmdName, " << payloadType << " *pCmdPayload) {" << Qt::endl;
+            if (this->reentrantMode) {
+                *pOut << "    return LCSF_Loopback_Store((lcsf_loopback_chan_t *)pCtx->pUserData, cmdName, pCmdPayload);"
+                      << Qt::endl;
+            } else {
+                *pOut << "    return LCSF_Loopback_Store(&(LcsfLoopbackChans[0]), cmdName, pCmdPayload);" << Qt::endl;
+            }
+            *pOut << "}" << Qt::endl;
+            *pOut << Qt::endl;
+        }
+    }
+    *pOut << "int main(void) {" << Qt::endl;
+    *pOut << "    int ret = EXIT_SUCCESS;" << Qt::endl;
+    if (this->reentrantMode) {
+        *pOut << "    pthread_t threads[LCSF_LOOPBACK_CHAN_NB];" << Qt::endl;
+    }
+    *pOut << Qt::endl;
+    *pOut << "    if (!LCSF_ValidatorAddProtocol_A(0, &LCSF_" << protocolName << "_ProtDesc_A) ||" << Qt::endl;
+    *pOut << "        !LCSF_ValidatorAddProtocol_B(0, &LCSF_" << protocolName << "_ProtDesc_B)) {" << Qt::endl;
+    *pOut << "        printf(\"Initialization failed\\n\");" << Qt::endl;
+    *pOut << "        return EXIT_FAILURE;" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << "    for (uint32_t chanIdx = 0; chanIdx < LCSF_LOOPBACK_CHAN_NB; chanIdx++) {" << Qt::endl;
+    *pOut << "        if (!LCSF_Loopback_InitA(&(LcsfLoopbackChans[chanIdx])) || "
+          << "!LCSF_Loopback_InitB(&(LcsfLoopbackChans[chanIdx]))) {" << Qt::endl;
+    *pOut << "            printf(\"Initialization failed\\n\");" << Qt::endl;
+    *pOut << "            return EXIT_FAILURE;" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << "    for (uint32_t idx = 0; idx < LCSF_BENCH_MAX_DATA_SIZE; idx++) {" << Qt::endl;
+    *pOut << "        LcsfBenchBytes[idx] = (uint8_t)LCSF_Bench_Rand();" << Qt::endl;
+    *pOut << "        LcsfBenchChars[idx] = (char)('a' + (LCSF_Bench_Rand() % 26));" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << "    LcsfBenchChars[LCSF_BENCH_MAX_DATA_SIZE] = '\\0';" << Qt::endl;
+    *pOut << "#ifdef LCSF_LOOPBACK_GOLDEN" << Qt::endl;
+    *pOut << "    if (!LCSF_Loopback_CheckGolden(&(LcsfLoopbackChans[0]))) {" << Qt::endl;
+    *pOut << "        ret = EXIT_FAILURE;" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << "#endif" << Qt::endl;
+    // Reentrant bridges loop back each channel in its own thread
+    if (this->reentrantMode) {
+        *pOut << "    // Channels run concurrently, each thread only touches its own contexts" << Qt::endl;
+        *pOut << "    for (uint32_t chanIdx = 0; chanIdx < LCSF_LOOPBACK_CHAN_NB; chanIdx++) {" << Qt::endl;
+        *pOut << "        if (pthread_create(&(threads[chanIdx]), NULL, LCSF_Loopback_Run, "
+              << "&(LcsfLoopbackChans[chanIdx])) != 0) {" << Qt::endl;
+        *pOut << "            printf(\"Thread creation failed\\n\");" << Qt::endl;
+        *pOut << "            return EXIT_FAILURE;" << Qt::endl;
+        *pOut << "        }" << Qt::endl;
+        *pOut << "    }" << Qt::endl;
+        *pOut << "    for (uint32_t chanIdx = 0; chanIdx < LCSF_LOOPBACK_CHAN_NB; chanIdx++) {" << Qt::endl;
+        *pOut << "        pthread_join(threads[chanIdx], NULL);" << Qt::endl;
+        *pOut << "    }" << Qt::endl;
+    } else {
+        *pOut << "    LCSF_Loopback_Run(&(LcsfLoopbackChans[0]));" << Qt::endl;
     }
-}
\ No newline at end of file
+    *pOut << "    printf(\"%-4s %-24s %-6s %-8s %16s %16s\\n\", \"Chan\", \"Command\", \"Link\", \"Loopback\", \"msg/s\", "
+          << "\"bytes/s\");" << Qt::endl;
+    *pOut << "    for (uint32_t chanIdx = 0; chanIdx < LCSF_LOOPBACK_CHAN_NB; chanIdx++) {" << Qt::endl;
+    *pOut << "        lcsf_loopback_chan_t *pChan = &(LcsfLoopbackChans[chanIdx]);" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "        for (size_t idx = 0; idx < LCSF_LOOPBACK_CMD_NB; idx++) {" << Qt::endl;
+    *pOut << "            const lcsf_loopback_cmd_t *pCmd = &(LCSF_Loopback_Cmds[idx]);" << Qt::endl;
+    *pOut << "            const lcsf_loopback_result_t *pResult = &(pChan->Results[idx]);" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "            if (!pResult->IsOk) {" << Qt::endl;
+    *pOut << "                printf(\"%-4u %-24s %-6s %-8s\\n\", (unsigned)chanIdx, pCmd->pName, pCmd->pLink->pName, "
+          << "\"FAILED\");" << Qt::endl;
+    *pOut << "                ret = EXIT_FAILURE;" << Qt::endl;
+    *pOut << "                continue;" << Qt::endl;
+    *pOut << "            }" << Qt::endl;
+    *pOut << "            printf(\"%-4u %-24s %-6s %-8s %16.0f %16.0f\\n\", (unsigned)chanIdx, pCmd->pName, "
+          << "pCmd->pLink->pName, \"ok\"," << Qt::endl;
+    *pOut << "                pResult->MsgRate, pResult->ByteRate);" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    if (this->instrumentMode) {
+        *pOut << "#ifdef " << statsMacro << Qt::endl;
+        *pOut << "        if (!LCSF_Loopback_CheckStats(pChan)) {" << Qt::endl;
+        *pOut << "            printf(\"Instrumentation counts mismatch\\n\");" << Qt::endl;
+        *pOut << "            ret = EXIT_FAILURE;" << Qt::endl;
+        *pOut << "        }" << Qt::endl;
+        *pOut << "#endif" << Qt::endl;
+    }
+    *pOut << "    }" << Qt::endl;
+    *pOut << "    return ret;" << Qt::endl;
+    *pOut << "}" << Qt::endl;
+}
+
+bool CodeGenerator::generateLoopback(QString protocolName, QList<Command *> cmdList, QString dirPath) {
+    LCSF_PROFILE_SCOPE("CodeGenerator::generateLoopback", "emit");
+    QDir dir(dirPath);
+    if (!dir.exists()) {
+        dir.mkpath(".");
+    }
+    QString headerName = "LCSF_Loopback_" + protocolName + ".h";
+    QFile file(dirPath + "/LCSF_Loopback_" + protocolName + ".c");
+    QString payloadType = protocolName.toLower() + "_cmd_payload_t";
+    QString ctxType = protocolName.toLower() + "_ctx_t";
+    QString bridgeCtxType = "lcsf_bridge_" + protocolName.toLower() + "_ctx_t";
+    QString segType = "lcsf_bridge_" + protocolName.toLower() + "_segment_t";
+    QString segMacroPrefix = "LCSF_BRIDGE_" + protocolName.toUpper() + "_SEG_";
+    QString rxStreamType = "lcsf_bridge_" + protocolName.toLower() + "_rx_stream_t";
+    // Stream frames are fed to the stream decoder in chunks, streamed bodies go through the body callback
+    bool isStream = this->hasStreamAtt(cmdList);
+    // Fast decoder and reentrant channels receive through the decoder, each reentrant channel runs in its own thread
+    bool isFrameReceive = this->fastDecoderMode || this->reentrantMode;
+    int chanNb = (this->reentrantMode) ? 2 : 1;
+    int cmdEntryNb = 0;
+    int maxFieldNb = 3;
+    int maxDataSize = 0;
+    int maxRefNb = 0;
+
+    if (!this->writeLoopbackHeader(protocolName, cmdList, dirPath)) {
+        return false;
+    }
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    QTextStream out(&file);
+    out.setCodec("ISO 8859-1");
+
+    // Worst-case frame, byte arrays and strings at their maximum size
+    for (Command *command : cmdList) {
+        int fieldNb = 2;
+        int dataSize = 0;
+        int refNb = 0;
+        this->getSegmentBounds_Rec(command->getAttArray(), fieldNb, dataSize, refNb);
+        maxFieldNb = qMax(maxFieldNb, fieldNb);
+        maxDataSize = qMax(maxDataSize, dataSize);
+        maxRefNb = qMax(maxRefNb, refNb);
+        cmdEntryNb += (command->isTransmittable(true) ? 1 : 0) + (command->isTransmittable(false) ? 1 : 0);
+    }
+
+    out << "/**" << Qt::endl;
+    out << " * \\file LCSF_Loopback_" << protocolName << ".c" << Qt::endl;
+    out << " * \\brief " << protocolName << " loopback harness, A and B bridges encode and decode each other's commands"
+        << Qt::endl;
+    out << " * \\author LCSF Generator v" << APP_VERSION << Qt::endl;
+    out << " *" << Qt::endl;
+    out << " * Link with both sides, each built from LCSF_Bridge_" << protocolName << "_<a|b>.c, LCSF_Desc_"
+        << protocolName << ".c and LCSF_Validator" << Qt::endl;
+    out << " * with " << headerName << " force included, and a single Lifo." << Qt::endl;
+    out << " *" << Qt::endl;
+    out << " * Every command is checked in each direction it is sent: random payloads are encoded by the sender,"
+        << Qt::endl;
+    out << " * decoded by the receiver and compared field by field, then the round trip throughput is measured."
+        << Qt::endl;
+    if (this->reentrantMode) {
+        out << " * Each channel has its own pair of contexts and runs in its own thread, concurrently with the others."
+            << Qt::endl;
+    }
+    if (this->segmentEncodeMode) {
+        out << " * Frames are encoded as segments with LCSF_Bridge_" << protocolName
+            << "EncodeSegments and gathered before being received." << Qt::endl;
+    }
+    if (isStream) {
+        out << " * Streamed attribute bodies are sent after their header and frames are fed to the stream decoder in"
+            << Qt::endl;
+        out << " * chunks." << Qt::endl;
+    } else if (isFrameReceive) {
+        out << " * Frames are received with LCSF_Bridge_" << protocolName << "ReceiveFrame, bypassing LCSF_Validator."
+            << Qt::endl;
+    }
+    if (this->deferredMode) {
+        out << " * The receiver queues the decoded command, the harness drains its queue after each frame." << Qt::endl;
+    }
+    out << " * Built with LCSF_LOOPBACK_GOLDEN naming a header of reference frames (golden_frames.h), each of them is"
+        << Qt::endl;
+    out << " * first received and encoded back byte for byte." << Qt::endl;
+    out << " */" << Qt::endl;
+    out << Qt::endl;
+    out << "// *** Libraries include ***" << Qt::endl;
+    out << "// Standard lib" << Qt::endl;
+    out << "#define _POSIX_C_SOURCE 199309L" << Qt::endl;
+    if (this->reentrantMode) {
+        out << "#include <pthread.h>" << Qt::endl;
+    }
+    out << "#include <stdio.h>" << Qt::endl;
+    out << "#include <stdlib.h>" << Qt::endl;
+    out << "#include <string.h>" << Qt::endl;
+    out << "#include <time.h>" << Qt::endl;
+    out << "// Custom lib" << Qt::endl;
+    out << "#include \"" << headerName << "\"" << Qt::endl;
+    out << "#ifdef LCSF_LOOPBACK_GOLDEN" << Qt::endl;
+    out << "#include LCSF_LOOPBACK_GOLDEN" << Qt::endl;
+    out << "#endif" << Qt::endl;
+    out << Qt::endl;
+    out << "// *** Definitions ***" << Qt::endl;
+    out << "// --- Private Macros ---" << Qt::endl;
+    out << "// Random payloads checked per command and direction" << Qt::endl;
+    out << "#ifndef LCSF_LOOPBACK_CHECKS" << Qt::endl;
+    out << "#define LCSF_LOOPBACK_CHECKS 1000" << Qt::endl;
+    out << "#endif" << Qt::endl;
+    out << "#ifndef LCSF_BENCH_ITERATIONS" << Qt::endl;
+    out << "#define LCSF_BENCH_ITERATIONS 100000" << Qt::endl;
+    out << "#endif" << Qt::endl;
+    out << "// Random payloads built per command for the throughput, used in turn" << Qt::endl;
+    out << "#ifndef LCSF_BENCH_SAMPLES" << Qt::endl;
+    out << "#define LCSF_BENCH_SAMPLES 16" << Qt::endl;
+    out << "#endif" << Qt::endl;
+    out << "// Maximum byte array and string size" << Qt::endl;
+    out << "#ifndef LCSF_BENCH_MAX_DATA_SIZE" << Qt::endl;
+    out << "#define LCSF_BENCH_MAX_DATA_SIZE 64" << Qt::endl;
+    out << "#endif" << Qt::endl;
+    out << "#ifndef LCSF_BENCH_SEED" << Qt::endl;
+    out << "#define LCSF_BENCH_SEED 1" << Qt::endl;
+    out << "#endif" << Qt::endl;
+    out << "// Worst-case frame size" << Qt::endl;
+    out << "#define LCSF_BENCH_BUFFER_SIZE ((" << maxFieldNb << " * 2) + " << maxDataSize << " + (" << maxRefNb
+        << " * (LCSF_BENCH_MAX_DATA_SIZE + 1)))" << Qt::endl;
+    if (this->reentrantMode) {
+        out << "#ifndef LCSF_THREAD_LOCAL" << Qt::endl;
+        out << "#define LCSF_THREAD_LOCAL _Thread_local" << Qt::endl;
+        out << "#endif" << Qt::endl;
+    }
+    if (isStream) {
+        out << "// Bytes fed to the stream decoder at once" << Qt::endl;
+        out << "#ifndef LCSF_LOOPBACK_STREAM_CHUNK" << Qt::endl;
+        out << "#define LCSF_LOOPBACK_STREAM_CHUNK 7" << Qt::endl;
+        out << "#endif" << Qt::endl;
+    }
+    out << "// Channels looped back" << Qt::endl;
+    out << "#define LCSF_LOOPBACK_CHAN_NB " << chanNb << Qt::endl;
+    out << "// Commands in each of their directions" << Qt::endl;
+    out << "#define LCSF_LOOPBACK_CMD_NB " << cmdEntryNb << Qt::endl;
+    out << Qt::endl;
+    out << "// --- Private Types ---" << Qt::endl;
+    out << "typedef struct _lcsf_loopback_result {" << Qt::endl;
+    out << "    bool IsOk;" << Qt::endl;
+    out << "    double MsgRate;" << Qt::endl;
+    out << "    double ByteRate;" << Qt::endl;
+    out << "} lcsf_loopback_result_t;" << Qt::endl;
+    out << Qt::endl;
+    out << "typedef struct _lcsf_loopback_chan {" << Qt::endl;
+    if (this->reentrantMode) {
+        out << "    " << ctxType << " MainCtxA;" << Qt::endl;
+        out << "    " << ctxType << " MainCtxB;" << Qt::endl;
+        out << "    " << bridgeCtxType << " BridgeCtxA;" << Qt::endl;
+        out << "    " << bridgeCtxType << " BridgeCtxB;" << Qt::endl;
+    }
+    out << "    uint8_t Buffer[LCSF_BENCH_BUFFER_SIZE];" << Qt::endl;
+    if (this->segmentEncodeMode) {
+        out << "    uint8_t SegHeader[" << segMacroPrefix << "HEADER_SIZE];" << Qt::endl;
+        out << "    " << segType << " Segs[" << segMacroPrefix << "NB];" << Qt::endl;
+    }
+    out << "    " << payloadType << " BenchPayloads[LCSF_BENCH_SAMPLES];" << Qt::endl;
+    out << "    // Last command executed by a side" << Qt::endl;
+    out << "    uint32_t RxCount;" << Qt::endl;
+    out << "    uint_fast16_t RxCmdName;" << Qt::endl;
+    out << "    " << payloadType << " RxPayload;" << Qt::endl;
+    if (isStream) {
+        out << "    " << rxStreamType << " RxStreamA;" << Qt::endl;
+        out << "    " << rxStreamType << " RxStreamB;" << Qt::endl;
+        out << "    uint8_t RxFrameA[LCSF_BENCH_BUFFER_SIZE];" << Qt::endl;
+        out << "    uint8_t RxFrameB[LCSF_BENCH_BUFFER_SIZE];" << Qt::endl;
+        out << "    // Streamed attribute body received" << Qt::endl;
+        out << "    uint8_t Body[LCSF_BENCH_MAX_DATA_SIZE];" << Qt::endl;
+        out << "    size_t BodySize;" << Qt::endl;
+    }
+    out << "    lcsf_loopback_result_t Results[LCSF_LOOPBACK_CMD_NB];" << Qt::endl;
+    out << "} lcsf_loopback_chan_t;" << Qt::endl;
+    out << Qt::endl;
+    out << "// One direction of the loopback" << Qt::endl;
+    out << "typedef struct _lcsf_loopback_link {" << Qt::endl;
+    out << "    const char *pName;" << Qt::endl;
+    out << "    int (*pFnEncode)(lcsf_loopback_chan_t *pChan, uint_fast16_t cmdName, " << payloadType
+        << " *pCmdPayload, uint8_t *pBuffer, size_t buffSize);" << Qt::endl;
+    out << "    bool (*pFnReceive)(lcsf_loopback_chan_t *pChan, const uint8_t *pBuffer, size_t buffSize);" << Qt::endl;
+    out << "} lcsf_loopback_link_t;" << Qt::endl;
+    out << Qt::endl;
+    out << "typedef struct _lcsf_loopback_cmd {" << Qt::endl;
+    out << "    const char *pName;" << Qt::endl;
+    out << "    uint_fast16_t cmdName;" << Qt::endl;
+    out << "    const lcsf_loopback_link_t *pLink;" << Qt::endl;
+    out << "    void (*pFnBuild)(" << payloadType << " *pCmdPayload);" << Qt::endl;
+    out << "    bool (*pFnCompare)(const " << payloadType << " *pSent, const " << payloadType << " *pRecv);"
+        << Qt::endl;
+    out << "} lcsf_loopback_cmd_t;" << Qt::endl;
+    out << Qt::endl;
+    out << "// --- Private Variables ---" << Qt::endl;
+    if (this->reentrantMode) {
+        out << "static LCSF_THREAD_LOCAL uint32_t LcsfBenchRandState = LCSF_BENCH_SEED;" << Qt::endl;
+    } else {
+        out << "static uint32_t LcsfBenchRandState = LCSF_BENCH_SEED;" << Qt::endl;
+    }
+    out << "static uint8_t LcsfBenchBytes[LCSF_BENCH_MAX_DATA_SIZE];" << Qt::endl;
+    out << "static char LcsfBenchChars[LCSF_BENCH_MAX_DATA_SIZE + 1];" << Qt::endl;
+    out << "static lcsf_loopback_chan_t LcsfLoopbackChans[LCSF_LOOPBACK_CHAN_NB];" << Qt::endl;
+    out << Qt::endl;
+    out << "// *** End Definitions ***" << Qt::endl;
+    out << Qt::endl;
+    out << "// *** Private Functions ***" << Qt::endl;
+    out << Qt::endl;
+    this->writeBenchBuilders(protocolName, cmdList, &out);
+    for (Command *command : cmdList) {
+        if (command->getAttArray().size() == 0) {
+            continue;
+        }
+        out << "static bool LCSF_Loopback_Compare" << command->getName() << "(const " << payloadType
+            << " *pSent, const " << payloadType << " *pRecv) {" << Qt::endl;
+        this->writeLoopbackCompare_Rec(protocolName, QStringList(command->getName()), command->getAttArray(), &out, 1);
+        out << "    return true;" << Qt::endl;
+        out << "}" << Qt::endl;
+        out << Qt::endl;
+    }
+    this->writeLoopbackStore(protocolName, cmdList, &out);
+    // Side calls on a channel
+    for (const QString &side : {QString("A"), QString("B")}) {
+        this->writeLoopbackSide(protocolName, cmdList, side, &out);
+    }
+    this->writeLoopbackChecks(protocolName, cmdList, &out);
+    this->writeLoopbackStats(protocolName, cmdList, &out);
+    out << "/**" << Qt::endl;
+    out << " * \\fn static void *LCSF_Loopback_Run(void *pArg)" << Qt::endl;
+    out << " * \\brief Check and time every command on a channel" << Qt::endl;
+    out << " *" << Qt::endl;
+    out << " * \\param pArg pointer to the channel" << Qt::endl;
+    out << " * \\return void *: NULL" << Qt::endl;
+    out << " */" << Qt::endl;
+    out << "static void *LCSF_Loopback_Run(void *pArg) {" << Qt::endl;
+    out << "    lcsf_loopback_chan_t *pChan = (lcsf_loopback_chan_t *)pArg;" << Qt::endl;
+    out << Qt::endl;
+    out << "    for (size_t idx = 0; idx < LCSF_LOOPBACK_CMD_NB; idx++) {" << Qt::endl;
+    out << "        pChan->Results[idx].IsOk = LCSF_Loopback_Check(pChan, &(LCSF_Loopback_Cmds[idx])) &&" << Qt::endl;
+    out << "            LCSF_Loopback_Bench(pChan, &(LCSF_Loopback_Cmds[idx]), &(pChan->Results[idx]));" << Qt::endl;
+    out << "    }" << Qt::endl;
+    out << "    return NULL;" << Qt::endl;
+    out << "}" << Qt::endl;
+    out << Qt::endl;
+    this->writeLoopbackMain(protocolName, &out);
+
+    file.close();
+    Profiler::addCounter("Bytes written", file.size());
+    return true;
+}
+
+int CodeGenerator::getSharedDescArrayNb(void) {
+    return this->sharedDescArrayNb;
+}
+
+int CodeGenerator::getSharedDescEntryNb(void) {
+    return this->sharedDescEntryNb;
+}
+
+CodeGenerator::T_Footprint CodeGenerator::getFootprint(QList<Command *> cmdList) {
+    LCSF_PROFILE_SCOPE("CodeGenerator::getFootprint", "analyze");
+    T_Footprint footprint = {QList<T_CmdFootprint>(), 0, 0, 0, 0, 0, 0, 0};
+    QHash<quint64, Attribute *> descShapes;
+    int unionAlign = 1;
+    int descEntryNb = 0;
+
+    for (Command *command : cmdList) {
+        T_CmdFootprint cmdFootprint = {command->getName(), 0, 0, 0, 0, 0};
+        QList<Attribute *> attList = command->getAttArray();
+
+        if (attList.size() > 0) {
+            int structAlign = 1;
+            QHash<quint64, Attribute *> cmdDescShapes;
+            this->getPayloadLayout_Rec(attList, cmdFootprint.payloadSize, structAlign, cmdFootprint.flagsSize);
+            cmdFootprint.descSize = (attList.size() + this->getDescEntryNb_Rec(attList, &cmdDescShapes)) * ATT_DESC_SIZE;
+            cmdFootprint.attNb = command->getTotalAttNb();
+            cmdFootprint.nestingDepth = this->getNestingDepth_Rec(attList);
+            // Payload union
+            if (structAlign > unionAlign) {
+                unionAlign = structAlign;
+            }
+            if (cmdFootprint.payloadSize > footprint.payloadUnionSize) {
+                footprint.payloadUnionSize = cmdFootprint.payloadSize;
+            }
+            descEntryNb += attList.size() + this->getDescEntryNb_Rec(attList, &descShapes);
+        }
+        if (cmdFootprint.nestingDepth > footprint.maxNestingDepth) {
+            footprint.maxNestingDepth = cmdFootprint.nestingDepth;
+        }
+        footprint.cmdFootprints.append(cmdFootprint);
+    }
+    this->addStructField(footprint.payloadUnionSize, unionAlign, 0, unionAlign);
+    footprint.descTableSize = descEntryNb * ATT_DESC_SIZE;
+    // Command descriptor array and command name to id array
+    footprint.cmdTableSize = cmdList.size() * (CMD_DESC_SIZE + 2);
+    footprint.lifoSize = Command::getMaxAttNb(cmdList) * VALID_ATT_SIZE;
+    footprint.flashSize = footprint.descTableSize + footprint.cmdTableSize;
+    // Bridge receive payload, Main send payload and bridge LIFO
+    footprint.ramSize = (2 * footprint.payloadUnionSize) + footprint.lifoSize;
+    if (this->deferredMode) {
+        // Queue slots and atomic indexes replace the bridge receive payload, the layout doesn't use the protocol name
+        QHash<QString, QPair<int, int>> structLayouts;
+        int slotSize = 0;
+        int slotAlign = 1;
+        int queueSize = 0;
+        int queueAlign = 1;
+        structLayouts.insert("CmdPayload", {footprint.payloadUnionSize, unionAlign});
+        this->addCFields(this->getQueueSlotFields(""), structLayouts, slotSize, slotAlign);
+        this->addStructField(slotSize, slotAlign, 0, slotAlign);
+        structLayouts.insert("Queue", {slotSize, slotAlign});
+        this->addCFields(this->getQueueFields(""), structLayouts, queueSize, queueAlign);
+        footprint.ramSize += queueSize - footprint.payloadUnionSize;
+    }
+    if (this->instrumentMode) {
+        // Stats struct: per command statistics, failure counters and the receive and execute last failures,
+        // the layout doesn't use the protocol name
+        QHash<QString, QPair<int, int>> structLayouts;
+        int cmdStatsSize = 0;
+        int cmdStatsAlign = 1;
+        int statsSize = 0;
+        int statsAlign = 1;
+        this->addCFields(this->getCmdStatsFields(), structLayouts, cmdStatsSize, cmdStatsAlign);
+        this->addStructField(cmdStatsSize, cmdStatsAlign, 0, cmdStatsAlign);
+        structLayouts.insert("Cmd", {cmdStatsSize, cmdStatsAlign});
+        this->addCFields(this->getStatsFields("", cmdList.size()), structLayouts, statsSize, statsAlign);
+        this->addStructField(statsSize, statsAlign, 0, statsAlign);
+        footprint.ramSize += statsSize;
+    }
+    return footprint;
+}
+
+bool CodeGenerator::generateFootprintReport(QString protocolName, T_Footprint footprint, QString filePath) {
+    QFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    if (filePath.endsWith(".json", Qt::CaseInsensitive)) {
+        QJsonArray cmdArray;
+        for (T_CmdFootprint cmdFootprint : footprint.cmdFootprints) {
+            QJsonObject cmdObject;
+            cmdObject.insert("name", cmdFootprint.cmdName);
+            cmdObject.insert("payloadSize", cmdFootprint.payloadSize);
+            cmdObject.insert("flagsSize", cmdFootprint.flagsSize);
+            cmdObject.insert("descSize", cmdFootprint.descSize);
+            cmdObject.insert("attNb", cmdFootprint.attNb);
+            cmdObject.insert("nestingDepth", cmdFootprint.nestingDepth);
+            cmdArray.append(cmdObject);
+        }
+        QJsonObject reportObject;
+        reportObject.insert("protocol", protocolName);
+        reportObject.insert("commands", cmdArray);
+        reportObject.insert("payloadUnionSize", footprint.payloadUnionSize);
+        reportObject.insert("descTableSize", footprint.descTableSize);
+        reportObject.insert("cmdTableSize", footprint.cmdTableSize);
+        reportObject.insert("lifoSize", footprint.lifoSize);
+        reportObject.insert("maxNestingDepth", footprint.maxNestingDepth);
+        reportObject.insert("flashSize", footprint.flashSize);
+        reportObject.insert("ramSize", footprint.ramSize);
+        file.write(QJsonDocument(reportObject).toJson());
+    } else {
+        QTextStream out(&file);
+        out << "# " << protocolName << " footprint" << Qt::endl;
+        out << Qt::endl;
+        out << "Estimated for a 32 bits target, in bytes." << Qt::endl;
+        out << Qt::endl;
+        out << "| Command | Payload | Flags | Descriptors | Attributes | Nesting depth |" << Qt::endl;
+        out << "|:--------|--------:|------:|------------:|-----------:|--------------:|" << Qt::endl;
+        for (T_CmdFootprint cmdFootprint : footprint.cmdFootprints) {
+            out << "| " << cmdFootprint.cmdName << " | " << cmdFootprint.payloadSize << " | " << cmdFootprint.flagsSize
+                << " | " << cmdFootprint.descSize << " | " << cmdFootprint.attNb << " | " << cmdFootprint.nestingDepth
+                << " |" << Qt::endl;
+        }
+        out << Qt::endl;
+        out << "| Total | Size |" << Qt::endl;
+        out << "|:------|-----:|" << Qt::endl;
+        out << "| Payload union | " << footprint.payloadUnionSize << " |" << Qt::endl;
+        out << "| Attribute descriptors | " << footprint.descTableSize << " |" << Qt::endl;
+        out << "| Command tables | " << footprint.cmdTableSize << " |" << Qt::endl;
+        out << "| Bridge LIFO | " << footprint.lifoSize << " |" << Qt::endl;
+        out << "| Max nesting depth | " << footprint.maxNestingDepth << " |" << Qt::endl;
+        out << "| **Flash** | " << footprint.flashSize << " |" << Qt::endl;
+        out << "| **RAM** | " << footprint.ramSize << " |" << Qt::endl;
+    }
+    file.close();
+    return true;
+}
@@ -0,0 +1,222 @@
+/**
+ * \file codescanner.cpp
+ * \brief Source code lexical scanner module
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#include "codescanner.h"
+
+static bool isIdentifierChar(QChar ch) {
+    return ch.isLetterOrNumber() || (ch == '_');
+}
+
+CodeScanner::CodeScanner(T_ScannerLanguage language) {
+    this->m_language = language;
+    this->reset();
+}
+
+void CodeScanner::reset() {
+    this->m_state = SCAN_CODE;
+    this->m_bracketCounter = 0;
+    this->m_blockBegan = false;
+    this->m_commentDepth = 0;
+    this->m_rawHashNb = 0;
+    this->m_lineContinued = false;
+}
+
+// Rust string prefixes: b"..", r".." , r#".."#, br#".."# and byte chars b'.'
+int CodeScanner::scanRawStringStart(const QStringRef &line, int idx) {
+    int pos = idx;
+    int hashNb = 0;
+
+    if ((idx > 0) && isIdentifierChar(line.at(idx - 1))) {
+        return idx;
+    }
+    if (line.at(pos) == 'b') {
+        pos++;
+        if ((pos < line.size()) && (line.at(pos) == '\'')) {
+            return this->scanRustQuote(line, pos);
+        }
+        if ((pos < line.size()) && (line.at(pos) == '"')) {
+            this->m_state = SCAN_STRING;
+            return pos + 1;
+        }
+    }
+    if ((pos >= line.size()) || (line.at(pos) != 'r')) {
+        return idx;
+    }
+    pos++;
+    while ((pos < line.size()) && (line.at(pos) == '#')) {
+        hashNb++;
+        pos++;
+    }
+    // Raw identifiers (r#type) are not strings
+    if ((pos < line.size()) && (line.at(pos) == '"')) {
+        this->m_rawHashNb = hashNb;
+        this->m_state = SCAN_RAW_STRING;
+        return pos + 1;
+    }
+    return idx;
+}
+
+bool CodeScanner::isRawStringEnd(const QStringRef &line, int idx) {
+    if (idx + this->m_rawHashNb >= line.size()) {
+        return false;
+    }
+    for (int hashIdx = 1; hashIdx <= this->m_rawHashNb; hashIdx++) {
+        if (line.at(idx + hashIdx) != '#') {
+            return false;
+        }
+    }
+    return true;
+}
+
+// A Rust quote is either a char literal or a lifetime/label
+int CodeScanner::scanRustQuote(const QStringRef &line, int idx) {
+    int size = line.size();
+
+    if ((idx + 1 < size) && (line.at(idx + 1) == '\\')) {
+        // Escaped char, skip the escaped character then up to the closing quote ('\u{..}', '\x41')
+        int pos = idx + 3;
+        while ((pos < size) && (line.at(pos) != '\'')) {
+            pos++;
+        }
+        return qMin(pos + 1, size);
+    }
+    if ((idx + 2 < size) && (line.at(idx + 2) == '\'')) {
+        return idx + 3;
+    }
+    if ((idx + 3 < size) && line.at(idx + 1).isHighSurrogate() && (line.at(idx + 3) == '\'')) {
+        return idx + 4;
+    }
+    return idx + 1;
+}
+
+int CodeScanner::scanLine(const QStringRef &line) {
+    const int size = line.size();
+    const bool isRust = (this->m_language == LANGUAGE_RUST);
+    int idx = 0;
+
+    // C literals and line comments only span lines with a trailing backslash
+    if (!this->m_lineContinued &&
+        ((this->m_state == SCAN_LINE_COMMENT) ||
+            (!isRust && ((this->m_state == SCAN_STRING) || (this->m_state == SCAN_CHAR))))) {
+        this->m_state = SCAN_CODE;
+    }
+    this->m_lineContinued = !isRust && (size > 0) && (line.at(size - 1) == '\\');
+
+    while (idx < size) {
+        const QChar ch = line.at(idx);
+        const QChar nextCh = (idx + 1 < size) ? line.at(idx + 1) : QChar();
+
+        switch (this->m_state) {
+            case SCAN_CODE:
+                if ((ch == '/') && (nextCh == '/')) {
+                    this->m_state = SCAN_LINE_COMMENT;
+                    idx = size;
+                } else if ((ch == '/') && (nextCh == '*')) {
+                    this->m_state = SCAN_BLOCK_COMMENT;
+                    this->m_commentDepth = 1;
+                    idx += 2;
+                } else if (ch == '"') {
+                    this->m_state = SCAN_STRING;
+                    idx++;
+                } else if (ch == '\'') {
+                    if (isRust) {
+                        idx = this->scanRustQuote(line, idx);
+                    } else {
+                        this->m_state = SCAN_CHAR;
+                        idx++;
+                    }
+                } else if (isRust && ((ch == 'r') || (ch == 'b'))) {
+                    int nextIdx = this->scanRawStringStart(line, idx);
+                    idx = (nextIdx > idx) ? nextIdx : idx + 1;
+                } else {
+                    if (ch == '{') {
+                        if (this->m_bracketCounter == 0) {
+                            this->m_blockBegan = true;
+                        }
+                        this->m_bracketCounter++;
+                    } else if (ch == '}') {
+                        this->m_bracketCounter--;
+                    }
+                    idx++;
+                }
+                break;
+
+            case SCAN_LINE_COMMENT:
+                idx = size;
+                break;
+
+            case SCAN_BLOCK_COMMENT:
+                if ((ch == '*') && (nextCh == '/')) {
+                    this->m_commentDepth--;
+                    if (this->m_commentDepth <= 0) {
+                        this->m_state = SCAN_CODE;
+                    }
+                    idx += 2;
+                } else if (isRust && (ch == '/') && (nextCh == '*')) {
+                    // Rust block comments nest
+                    this->m_commentDepth++;
+                    idx += 2;
+                } else {
+                    idx++;
+                }
+                break;
+
+            case SCAN_STRING:
+            case SCAN_CHAR:
+                if (ch == '\\') {
+                    idx += 2;
+                } else if (((this->m_state == SCAN_STRING) && (ch == '"')) ||
+                           ((this->m_state == SCAN_CHAR) && (ch == '\''))) {
+                    this->m_state = SCAN_CODE;
+                    idx++;
+                } else {
+                    idx++;
+                }
+                break;
+
+            case SCAN_RAW_STRING:
+                if ((ch == '"') && this->isRawStringEnd(line, idx)) {
+                    this->m_state = SCAN_CODE;
+                    idx += 1 + this->m_rawHashNb;
+                } else {
+                    idx++;
+                }
+                break;
+        }
+    }
+    return this->m_bracketCounter;
+}
+
+int CodeScanner::scanLine(const QString &line) {
+    return this->scanLine(QStringRef(&line));
+}
+
+int CodeScanner::getBracketCounter() const {
+    return this->m_bracketCounter;
+}
+
+bool CodeScanner::getBlockBegan() const {
+    return this->m_blockBegan;
+}
+
+bool CodeScanner::isInCode() const {
+    return (this->m_state == SCAN_CODE) || (this->m_state == SCAN_LINE_COMMENT);
+}
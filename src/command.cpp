@@ -25,8 +25,12 @@ Command::Command(void) {
     this->m_name = "default";
     this->m_id = 0;
     this->m_hasAttributes = false;
+    this->m_direction = NS_DirectionType::UNKNOWN;
     this->m_attArray = QList<Attribute *>();
+    this->m_attIndex.setOwner(this);
     this->m_desc = QString();
+    this->m_structHash.storeRelaxed(0);
+    this->m_isStructHashValid.storeRelaxed(0);
 }
 
 Command::Command(
@@ -36,7 +40,10 @@ Command::Command(
     this->m_hasAttributes = cmdHasAtt;
     this->m_direction = cmdDirection;
     this->m_attArray = QList<Attribute *>();
+    this->m_attIndex.setOwner(this);
     this->m_desc = commandDesc;
+    this->m_structHash.storeRelaxed(0);
+    this->m_isStructHashValid.storeRelaxed(0);
 }
 
 Command::Command(QString cmdName, short cmdCode, bool cmdHasAtt, NS_DirectionType::T_DirectionType cmdDirection,
@@ -45,12 +52,16 @@ Command::Command(QString cmdName, short cmdCode, bool cmdHasAtt, NS_DirectionTyp
     this->m_id = cmdCode;
     this->m_hasAttributes = cmdHasAtt;
     this->m_direction = cmdDirection;
-    this->m_attArray = attArray;
+    this->m_attIndex.setOwner(this);
+    this->m_attArray = this->m_attIndex.rebuild(attArray);
     this->m_desc = commandDesc;
+    this->m_structHash.storeRelaxed(0);
+    this->m_isStructHashValid.storeRelaxed(0);
 }
 
 void Command::setName(QString cmdName) {
     this->m_name = cmdName;
+    this->invalidateStructHash();
 }
 
 QString Command::getName(void) {
@@ -59,6 +70,7 @@ QString Command::getName(void) {
 
 void Command::setId(short cmdCode) {
     this->m_id = cmdCode;
+    this->invalidateStructHash();
 }
 
 short Command::getId(void) {
@@ -67,6 +79,7 @@ short Command::getId(void) {
 
 void Command::setHasAtt(bool cmdHasAtt) {
     this->m_hasAttributes = cmdHasAtt;
+    this->invalidateStructHash();
 }
 
 bool Command::getHasAtt(void) {
@@ -84,6 +97,7 @@ bool Command::hasSubAtt(void) {
 
 void Command::setDesc(QString cmdDesc) {
     this->m_desc = cmdDesc;
+    this->invalidateStructHash();
 }
 
 QString Command::getDesc(void) {
@@ -92,6 +106,7 @@ QString Command::getDesc(void) {
 
 void Command::setDirection(NS_DirectionType::T_DirectionType cmdDirection) {
     this->m_direction = cmdDirection;
+    this->invalidateStructHash();
 }
 
 NS_DirectionType::T_DirectionType Command::getDirection(void) {
@@ -121,11 +136,16 @@ bool Command::isReceivable(bool isA) {
 }
 
 void Command::setAttArray(QList<Attribute *> attArray) {
-    this->m_attArray = attArray;
+    this->m_attArray = this->m_attIndex.rebuild(attArray);
+    this->invalidateStructHash();
 }
 
 void Command::addAttribute(Attribute *newAtt) {
+    if (!this->m_attIndex.insert(newAtt)) {
+        return;
+    }
     this->m_attArray.append(newAtt);
+    this->invalidateStructHash();
 }
 
 QList<Attribute *> Command::getAttArray(void) {
@@ -166,7 +186,8 @@ void Command::sortAttArrayById(void) {
             j = j - 1;
         }
     }
-    this->m_attArray = sortedAttArray;
+    this->m_attArray = this->m_attIndex.rebuild(sortedAttArray);
+    this->invalidateStructHash();
 }
 
 void Command::editParameters(
@@ -176,6 +197,7 @@ void Command::editParameters(
     this->m_hasAttributes = cmdHasAtt;
     this->m_direction = cmdDirection;
     this->m_desc = cmdDesc;
+    this->invalidateStructHash();
 }
 
 void Command::removeAttByName(QString attName) {
@@ -183,7 +205,9 @@ void Command::removeAttByName(QString attName) {
     if (attStorage != nullptr) {
         attStorage->clearArray_rec();
         this->m_attArray.removeAll(attStorage);
+        this->m_attIndex.remove(attStorage);
         delete attStorage;
+        this->invalidateStructHash();
     }
 }
 
@@ -193,21 +217,19 @@ void Command::clearAttArray(void) {
             attribute->clearArray_rec();
         }
     }
+    this->m_attIndex.clear();
     while (!this->m_attArray.isEmpty()) {
         delete this->m_attArray.takeFirst();
     }
+    this->invalidateStructHash();
 }
 
 Attribute *Command::getAttByName(QString cmdAttName) {
-    Attribute *cmdAttPointer = nullptr;
+    return this->m_attIndex.findByName(cmdAttName);
+}
 
-    for (Attribute *attribute : this->m_attArray) {
-        if ((attribute != nullptr) && (attribute->getName().compare(cmdAttName) == 0)) {
-            cmdAttPointer = attribute;
-            break;
-        }
-    }
-    return cmdAttPointer;
+Attribute *Command::getAttById(short cmdAttId) {
+    return this->m_attIndex.findById(cmdAttId);
 }
 
 Command *Command::findCmdAddr(QString cmdName, QList<Command *> cmdList) {
@@ -261,6 +283,79 @@ QStringList Command::getListCmdNames(QList<Command *> cmdList) {
     return cmdNames;
 }
 
+// Build once before looking up several commands, the first command wins on duplicated names
+QHash<QString, Command *> Command::getNameIndex(QList<Command *> cmdList) {
+    QHash<QString, Command *> nameIndex;
+
+    nameIndex.reserve(cmdList.size());
+    for (Command *command : cmdList) {
+        if (!nameIndex.contains(command->getName())) {
+            nameIndex.insert(command->getName(), command);
+        }
+    }
+    return nameIndex;
+}
+
+QList<Command *> Command::filterListByNames(QList<Command *> cmdList, QStringList cmdNames, QStringList &unknownNames) {
+    QHash<QString, Command *> nameIndex = Command::getNameIndex(cmdList);
+    QSet<QString> subsetNames(cmdNames.begin(), cmdNames.end());
+    QList<Command *> subsetList;
+
+    unknownNames.clear();
+    for (const QString &cmdName : cmdNames) {
+        if (!nameIndex.contains(cmdName)) {
+            unknownNames.append(cmdName);
+        }
+    }
+    // Keep the description order so the generated tables follow it
+    for (Command *command : cmdList) {
+        if (subsetNames.contains(command->getName())) {
+            subsetList.append(command);
+        }
+    }
+    return subsetList;
+}
+
+QHash<short, Command *> Command::getIdIndex(QList<Command *> cmdList) {
+    QHash<short, Command *> idIndex;
+
+    idIndex.reserve(cmdList.size());
+    for (Command *command : cmdList) {
+        if (!idIndex.contains(command->getId())) {
+            idIndex.insert(command->getId(), command);
+        }
+    }
+    return idIndex;
+}
+
+quint64 Command::getStructHash(void) const {
+    if (this->m_isStructHashValid.loadAcquire() == 0) {
+        quint64 hash = Attribute::hashString(Attribute::HASH_SEED, this->m_name);
+        hash = Attribute::hashValue(hash, static_cast<quint64>(this->m_id));
+        hash = Attribute::hashValue(hash, this->m_hasAttributes ? 1 : 0);
+        hash = Attribute::hashValue(hash, static_cast<quint64>(this->m_direction));
+        hash = Attribute::hashString(hash, this->m_desc);
+        hash = Attribute::hashValue(hash, static_cast<quint64>(this->m_attArray.size()));
+        for (Attribute *attribute : this->m_attArray) {
+            hash = Attribute::hashValue(hash, attribute->getStructHash());
+        }
+        // Concurrent readers compute the same value, publishing it twice is harmless
+        this->m_structHash.storeRelaxed(hash);
+        this->m_isStructHashValid.storeRelease(1);
+    }
+    return this->m_structHash.loadRelaxed();
+}
+
+void Command::invalidateStructHash(void) {
+    this->m_isStructHashValid.storeRelease(0);
+}
+
+bool Command::hasSameParams(const Command &other) const {
+    return (this->m_name == other.m_name) && (this->m_id == other.m_id)
+           && (this->m_hasAttributes == other.m_hasAttributes) && (this->m_direction == other.m_direction)
+           && (this->m_desc == other.m_desc);
+}
+
 bool Command::compareRefCmdList(QList<Command *> a_list, QList<Command *> b_list, int &err_idx) {
     if (a_list.count() != b_list.count()) {
         err_idx = -1;
@@ -275,6 +370,38 @@ bool Command::compareRefCmdList(QList<Command *> a_list, QList<Command *> b_list
     return true;
 }
 
+QStringList Command::diffCmdList(QList<Command *> a_list, QList<Command *> b_list) {
+    QStringList diffPaths;
+    QHash<QString, Command *> aNameIndex = Command::getNameIndex(a_list);
+    QHash<QString, Command *> bNameIndex = Command::getNameIndex(b_list);
+
+    // Modified and removed commands
+    for (Command *aCmd : a_list) {
+        Command *bCmd = bNameIndex.value(aCmd->getName(), nullptr);
+
+        if (bCmd == nullptr) {
+            diffPaths.append(aCmd->getName());
+            continue;
+        }
+        if (aCmd->getStructHash() == bCmd->getStructHash()) {
+            continue;
+        }
+        // Attributes only reordered are reported on their command
+        QStringList attDiffPaths = Attribute::diffAttList(aCmd->m_attArray, bCmd->m_attArray, aCmd->getName());
+        if (!aCmd->hasSameParams(*bCmd) || attDiffPaths.isEmpty()) {
+            diffPaths.append(aCmd->getName());
+        }
+        diffPaths.append(attDiffPaths);
+    }
+    // Added commands
+    for (Command *bCmd : b_list) {
+        if (!aNameIndex.contains(bCmd->getName())) {
+            diffPaths.append(bCmd->getName());
+        }
+    }
+    return diffPaths;
+}
+
 int Command::getMaxAttNb(QList<Command *> cmdList) {
     int max = 0;
 
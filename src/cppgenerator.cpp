@@ -0,0 +1,905 @@
+/**
+ * \file cppgenerator.cpp
+ * \brief C++ code generator module
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#include "cppgenerator.h"
+#include "profiler.h"
+
+CppGenerator::CppGenerator() {
+}
+
+// Convert a snake case name into a camel case name
+QString CppGenerator::capitalize(const QString &str) {
+    QString result;
+    bool capitalizeNext = true;
+    for (int i = 0; i < str.length(); ++i) {
+        QChar ch = str[i];
+        if (ch == '_') {
+            capitalizeNext = true;
+        } else {
+            if (capitalizeNext) {
+                result += ch.toUpper();
+                capitalizeNext = false;
+            } else {
+                result += ch.toLower();
+            }
+        }
+    }
+    return result;
+}
+
+// Payload types are named after the attribute path, so they stay unique whatever the attribute names
+QString CppGenerator::getPayloadName(QStringList attPath) {
+    QString payloadName = "";
+    for (const QString &name : attPath) {
+        payloadName.append(this->capitalize(name));
+    }
+    return payloadName + "Payload";
+}
+
+QString CppGenerator::getConstPrefix(QStringList attPath) {
+    return attPath.join("_").toUpper();
+}
+
+QString CppGenerator::getMemberType(Attribute *attribute, QStringList attPath) {
+    QString memberType;
+
+    switch (attribute->getDataType()) {
+        case NS_AttDataType::UINT8:
+            memberType = "uint8_t";
+            break;
+        case NS_AttDataType::UINT16:
+            memberType = "uint16_t";
+            break;
+        case NS_AttDataType::UINT32:
+            memberType = "uint32_t";
+            break;
+        case NS_AttDataType::UINT64:
+            memberType = "uint64_t";
+            break;
+        case NS_AttDataType::FLOAT32:
+            memberType = "float";
+            break;
+        case NS_AttDataType::FLOAT64:
+            memberType = "double";
+            break;
+        case NS_AttDataType::BYTE_ARRAY:
+            memberType = "std::span<const uint8_t>";
+            break;
+        case NS_AttDataType::STRING:
+            memberType = "std::string_view";
+            break;
+        case NS_AttDataType::SUB_ATTRIBUTES:
+            memberType = this->getPayloadName(attPath);
+            break;
+        default:
+            memberType = "void";
+            break;
+    }
+    if (attribute->getIsOptional()) {
+        memberType = "std::optional<" + memberType + ">";
+    }
+    return memberType;
+}
+
+QString CppGenerator::getDataTypeName(NS_AttDataType::T_AttDataType dataType) {
+    switch (dataType) {
+        case NS_AttDataType::UINT8:
+            return "DataType::Uint8";
+        case NS_AttDataType::UINT16:
+            return "DataType::Uint16";
+        case NS_AttDataType::UINT32:
+            return "DataType::Uint32";
+        case NS_AttDataType::UINT64:
+            return "DataType::Uint64";
+        case NS_AttDataType::FLOAT32:
+            return "DataType::Float32";
+        case NS_AttDataType::FLOAT64:
+            return "DataType::Float64";
+        case NS_AttDataType::BYTE_ARRAY:
+            return "DataType::ByteArray";
+        case NS_AttDataType::SUB_ATTRIBUTES:
+            return "DataType::SubAttributes";
+        case NS_AttDataType::STRING:
+            return "DataType::String";
+        default:
+            return "";
+    }
+}
+
+void CppGenerator::declareAttIds_Rec(QStringList parentPath, QList<Attribute *> attList, QTextStream *pOut) {
+    QString constPrefix = this->getConstPrefix(parentPath);
+
+    for (Attribute *attribute : attList) {
+        *pOut << "inline constexpr uint16_t " << constPrefix << "_ATT_ID_" << attribute->getName().toUpper() << " = 0x"
+              << QString::number(attribute->getId(), 16) << ";" << Qt::endl;
+    }
+    for (Attribute *attribute : attList) {
+        if (attribute->getDataType() == NS_AttDataType::SUB_ATTRIBUTES) {
+            this->declareAttIds_Rec(parentPath + QStringList(attribute->getName()), attribute->getSubAttArray(), pOut);
+        }
+    }
+}
+
+void CppGenerator::declareAttDesc_Rec(QStringList parentPath, QList<Attribute *> attList, QTextStream *pOut) {
+    QString constPrefix = this->getConstPrefix(parentPath);
+
+    // Sub-attribute descriptors are declared before the descriptor pointing to them
+    for (Attribute *attribute : attList) {
+        if ((attribute->getDataType() == NS_AttDataType::SUB_ATTRIBUTES) && (attribute->getSubAttArray().size() > 0)) {
+            this->declareAttDesc_Rec(parentPath + QStringList(attribute->getName()), attribute->getSubAttArray(), pOut);
+        }
+    }
+    *pOut << "inline constexpr AttDesc " << constPrefix << "_ATT_DESC[] = {" << Qt::endl;
+    for (Attribute *attribute : attList) {
+        *pOut << "    {" << constPrefix << "_ATT_ID_" << attribute->getName().toUpper() << ", "
+              << ((attribute->getIsOptional()) ? "true" : "false") << ", "
+              << this->getDataTypeName(attribute->getDataType()) << ", ";
+        if ((attribute->getDataType() == NS_AttDataType::SUB_ATTRIBUTES) && (attribute->getSubAttArray().size() > 0)) {
+            *pOut << this->getConstPrefix(parentPath + QStringList(attribute->getName())) << "_ATT_DESC, "
+                  << attribute->getSubAttArray().size() << "}," << Qt::endl;
+        } else {
+            *pOut << "nullptr, 0}," << Qt::endl;
+        }
+    }
+    *pOut << "};" << Qt::endl;
+    *pOut << Qt::endl;
+}
+
+void CppGenerator::declarePayload_Rec(QStringList parentPath, QList<Attribute *> attList, QTextStream *pOut) {
+    // Sub-attribute payloads are declared before the payload holding them
+    for (Attribute *attribute : attList) {
+        if (attribute->getDataType() == NS_AttDataType::SUB_ATTRIBUTES) {
+            this->declarePayload_Rec(parentPath + QStringList(attribute->getName()), attribute->getSubAttArray(), pOut);
+        }
+    }
+    *pOut << "// " << parentPath.join(" ") << ((parentPath.size() > 1) ? " sub-attributes" : " attributes")
+          << " payload" << Qt::endl;
+    *pOut << "struct " << this->getPayloadName(parentPath) << " {" << Qt::endl;
+    if (parentPath.size() == 1) {
+        *pOut << "    static constexpr CmdId ID = CmdId::" << this->capitalize(parentPath.at(0)) << ";" << Qt::endl;
+        *pOut << "    static constexpr std::span<const AttDesc> ATT_DESC = " << this->getConstPrefix(parentPath)
+              << "_ATT_DESC;" << Qt::endl;
+        *pOut << Qt::endl;
+    }
+    for (Attribute *attribute : attList) {
+        *pOut << "    " << this->getMemberType(attribute, parentPath + QStringList(attribute->getName())) << " "
+              << attribute->getName().toLower() << ";" << Qt::endl;
+    }
+    *pOut << "};" << Qt::endl;
+    *pOut << Qt::endl;
+}
+
+void CppGenerator::writeDecodeFct_Rec(QStringList parentPath, QList<Attribute *> attList, QTextStream *pOut) {
+    QString constPrefix = this->getConstPrefix(parentPath);
+    bool hasSubAtt = false;
+    QStringList mandatoryChecks;
+
+    for (Attribute *attribute : attList) {
+        if (attribute->getDataType() == NS_AttDataType::SUB_ATTRIBUTES) {
+            hasSubAtt = true;
+            this->writeDecodeFct_Rec(parentPath + QStringList(attribute->getName()), attribute->getSubAttArray(), pOut);
+        }
+    }
+    *pOut << "inline bool decodeAtts(Reader &reader, uint_fast16_t attNb, " << this->getPayloadName(parentPath)
+          << " &payload) {" << Qt::endl;
+    *pOut << "    bool isAttHere[" << attList.size() << "] = {};" << Qt::endl;
+    *pOut << "    uint_fast16_t attId;" << Qt::endl;
+    if (hasSubAtt) {
+        *pOut << "    uint_fast16_t subAttNb;" << Qt::endl;
+    }
+    *pOut << Qt::endl;
+    *pOut << "    for (uint_fast16_t attIdx = 0; attIdx < attNb; attIdx++) {" << Qt::endl;
+    *pOut << "        if (!reader.field(attId)) {" << Qt::endl;
+    *pOut << "            return false;" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "        switch (attId) {" << Qt::endl;
+    for (int attIdx = 0; attIdx < attList.size(); attIdx++) {
+        Attribute *attribute = attList.at(attIdx);
+        QString attId = constPrefix + "_ATT_ID_" + attribute->getName().toUpper();
+        QString member = "payload." + attribute->getName().toLower();
+        QString isHere = "isAttHere[" + QString::number(attIdx) + "]";
+        QString target = (attribute->getIsOptional()) ? member + ".emplace()" : member;
+        QString readCall;
+
+        if (!attribute->getIsOptional()) {
+            mandatoryChecks.append(isHere);
+        }
+        switch (attribute->getDataType()) {
+            case NS_AttDataType::UINT8:
+            case NS_AttDataType::UINT16:
+            case NS_AttDataType::UINT32:
+            case NS_AttDataType::UINT64:
+                readCall = "reader.uint(" + target + ")";
+                break;
+            case NS_AttDataType::FLOAT32:
+                readCall = "reader.float32(" + target + ")";
+                break;
+            case NS_AttDataType::FLOAT64:
+                readCall = "reader.float64(" + target + ")";
+                break;
+            case NS_AttDataType::BYTE_ARRAY:
+                readCall = "reader.bytes(" + target + ")";
+                break;
+            case NS_AttDataType::STRING:
+                readCall = "reader.string(" + target + ")";
+                break;
+            case NS_AttDataType::SUB_ATTRIBUTES:
+                readCall = "!reader.field(subAttNb) || !decodeAtts(reader, subAttNb, " + target + ")";
+                attId = "(" + attId + " | CMPLX_FLAG)";
+                break;
+            default:
+                break;
+        }
+        if (attribute->getDataType() != NS_AttDataType::SUB_ATTRIBUTES) {
+            readCall = "!" + readCall;
+        }
+        *pOut << "            case " << attId << ":" << Qt::endl;
+        *pOut << "                // Reject duplicated attribute" << Qt::endl;
+        *pOut << "                if (" << isHere << " || " << readCall << ") {" << Qt::endl;
+        *pOut << "                    return false;" << Qt::endl;
+        *pOut << "                }" << Qt::endl;
+        *pOut << "                " << isHere << " = true;" << Qt::endl;
+        *pOut << "                break;" << Qt::endl;
+        *pOut << Qt::endl;
+    }
+    *pOut << "            default: // Unknown attribute" << Qt::endl;
+    *pOut << "                return false;" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    if (mandatoryChecks.isEmpty()) {
+        *pOut << "    return true;" << Qt::endl;
+    } else {
+        *pOut << "    // Check mandatory attributes presence" << Qt::endl;
+        *pOut << "    return " << mandatoryChecks.join(" && ") << ";" << Qt::endl;
+    }
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+}
+
+void CppGenerator::writeEncodeFct_Rec(QStringList parentPath, QList<Attribute *> attList, QTextStream *pOut) {
+    QString constPrefix = this->getConstPrefix(parentPath);
+    int mandatoryNb = 0;
+
+    for (Attribute *attribute : attList) {
+        if (attribute->getDataType() == NS_AttDataType::SUB_ATTRIBUTES) {
+            this->writeEncodeFct_Rec(parentPath + QStringList(attribute->getName()), attribute->getSubAttArray(), pOut);
+        }
+        if (!attribute->getIsOptional()) {
+            mandatoryNb++;
+        }
+    }
+    *pOut << "inline void encodeAtts(Writer &writer, const " << this->getPayloadName(parentPath) << " &payload) {"
+          << Qt::endl;
+    *pOut << "    uint_fast16_t attNb = " << mandatoryNb << ";" << Qt::endl;
+    *pOut << Qt::endl;
+    if (mandatoryNb < attList.size()) {
+        *pOut << "    // Count present attributes" << Qt::endl;
+        for (Attribute *attribute : attList) {
+            if (attribute->getIsOptional()) {
+                *pOut << "    if (payload." << attribute->getName().toLower() << ".has_value()) {" << Qt::endl;
+                *pOut << "        attNb++;" << Qt::endl;
+                *pOut << "    }" << Qt::endl;
+            }
+        }
+    }
+    *pOut << "    writer.field(attNb);" << Qt::endl;
+    for (Attribute *attribute : attList) {
+        QString attId = constPrefix + "_ATT_ID_" + attribute->getName().toUpper();
+        QString member = "payload." + attribute->getName().toLower();
+        QString value = (attribute->getIsOptional()) ? "*" + member : member;
+        QString indent = (attribute->getIsOptional()) ? "        " : "    ";
+
+        *pOut << "    // Write attribute " << attribute->getName() << Qt::endl;
+        if (attribute->getIsOptional()) {
+            *pOut << "    if (" << member << ".has_value()) {" << Qt::endl;
+        }
+        switch (attribute->getDataType()) {
+            case NS_AttDataType::UINT8:
+            case NS_AttDataType::UINT16:
+            case NS_AttDataType::UINT32:
+            case NS_AttDataType::UINT64:
+                *pOut << indent << "writer.uint(" << attId << ", " << value << ");" << Qt::endl;
+                break;
+            case NS_AttDataType::FLOAT32:
+                *pOut << indent << "writer.float32(" << attId << ", " << value << ");" << Qt::endl;
+                break;
+            case NS_AttDataType::FLOAT64:
+                *pOut << indent << "writer.float64(" << attId << ", " << value << ");" << Qt::endl;
+                break;
+            case NS_AttDataType::BYTE_ARRAY:
+                *pOut << indent << "writer.bytes(" << attId << ", " << value << ");" << Qt::endl;
+                break;
+            case NS_AttDataType::STRING:
+                *pOut << indent << "writer.string(" << attId << ", " << value << ");" << Qt::endl;
+                break;
+            case NS_AttDataType::SUB_ATTRIBUTES:
+                *pOut << indent << "writer.field(" << attId << " | CMPLX_FLAG);" << Qt::endl;
+                *pOut << indent << "encodeAtts(writer, " << value << ");" << Qt::endl;
+                break;
+            default:
+                break;
+        }
+        if (attribute->getIsOptional()) {
+            *pOut << "    }" << Qt::endl;
+        }
+    }
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+}
+
+void CppGenerator::generateBinding(
+    QString protocolName, QString protocolId, QString protocolVersion, QList<Command *> cmdList, QString dirPath) {
+    LCSF_PROFILE_SCOPE("CppGenerator::generateBinding", "emit");
+    QString nsName = "lcsf_" + protocolName.toLower();
+    QDir dir(dirPath);
+    if (!dir.exists()) {
+        dir.mkpath(".");
+    }
+    QString fileName = dirPath + "/LCSF_Binding_" + protocolName + ".hpp";
+    QFile file(fileName);
+
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        QTextStream out(&file);
+
+        // Header
+        out << "/**" << Qt::endl;
+        out << " * \\file LCSF_Binding_" << protocolName << ".hpp" << Qt::endl;
+        out << " * \\brief " << protocolName << " LCSF header-only C++20 binding" << Qt::endl;
+        out << " * \\author LCSF Generator v" << APP_VERSION << Qt::endl;
+        out << " *" << Qt::endl;
+        out << " * Byte array and string payloads are views over the frame buffer. Received commands are dispatched at"
+            << Qt::endl;
+        out << " * compile time to a handler with an operator() overload per command received by its side, here A:"
+            << Qt::endl;
+        out << " *" << Qt::endl;
+        out << " *     struct Handler {" << Qt::endl;
+        for (Command *command : cmdList) {
+            if (command->isReceivable(true)) {
+                out << " *         void operator()(const " << nsName << "::"
+                    << this->getPayloadName(QStringList(command->getName())) << " &payload);" << Qt::endl;
+            }
+        }
+        out << " *     };" << Qt::endl;
+        out << " *     " << nsName << "::receive<" << nsName << "::Side::A>(frame, handler);" << Qt::endl;
+        out << " */" << Qt::endl;
+        out << Qt::endl;
+        out << "#ifndef Lcsf_binding_" << protocolName.toLower() << "_hpp" << Qt::endl;
+        out << "#define Lcsf_binding_" << protocolName.toLower() << "_hpp" << Qt::endl;
+        out << Qt::endl;
+        out << "// *** Libraries include ***" << Qt::endl;
+        out << "// Standard lib" << Qt::endl;
+        out << "#include <algorithm>" << Qt::endl;
+        out << "#include <array>" << Qt::endl;
+        out << "#include <bit>" << Qt::endl;
+        out << "#include <cstddef>" << Qt::endl;
+        out << "#include <cstdint>" << Qt::endl;
+        out << "#include <optional>" << Qt::endl;
+        out << "#include <span>" << Qt::endl;
+        out << "#include <string_view>" << Qt::endl;
+        out << Qt::endl;
+        out << "namespace " << nsName << " {" << Qt::endl;
+        out << Qt::endl;
+
+        // Constants
+        out << "// *** Constants ***" << Qt::endl;
+        out << Qt::endl;
+        out << "// Frame field size and complex attribute flag" << Qt::endl;
+        out << "#ifdef LCSF_SMALL" << Qt::endl;
+        out << "inline constexpr std::size_t FIELD_SIZE = 1;" << Qt::endl;
+        out << "inline constexpr uint_fast16_t CMPLX_FLAG = 0x80;" << Qt::endl;
+        out << "#else" << Qt::endl;
+        out << "inline constexpr std::size_t FIELD_SIZE = 2;" << Qt::endl;
+        out << "inline constexpr uint_fast16_t CMPLX_FLAG = 0x8000;" << Qt::endl;
+        out << "#endif" << Qt::endl;
+        out << "// Frame field maximum value" << Qt::endl;
+        out << "inline constexpr std::size_t FIELD_MAX = (CMPLX_FLAG << 1) - 1;" << Qt::endl;
+        out << "// Lcsf protocol identifier" << Qt::endl;
+        out << "inline constexpr uint16_t PROT_ID = 0x" << protocolId << ";" << Qt::endl;
+        out << "// Lcsf protocol version" << Qt::endl;
+        out << "inline constexpr uint16_t PROT_VER = " << protocolVersion << ";" << Qt::endl;
+        out << Qt::endl;
+        out << "// Protocol sides" << Qt::endl;
+        out << "enum class Side {" << Qt::endl;
+        out << "    A," << Qt::endl;
+        out << "    B," << Qt::endl;
+        out << "};" << Qt::endl;
+        out << Qt::endl;
+        out << "// Command identifiers" << Qt::endl;
+        out << "enum class CmdId : uint16_t {" << Qt::endl;
+        for (Command *command : cmdList) {
+            out << "    " << this->capitalize(command->getName()) << " = 0x" << QString::number(command->getId(), 16)
+                << "," << Qt::endl;
+        }
+        out << "};" << Qt::endl;
+        out << Qt::endl;
+        out << "// Attribute identifiers" << Qt::endl;
+        for (Command *command : cmdList) {
+            this->declareAttIds_Rec(QStringList(command->getName()), command->getAttArray(), &out);
+        }
+        out << Qt::endl;
+
+        // Descriptor
+        out << "// *** Protocol descriptor ***" << Qt::endl;
+        out << Qt::endl;
+        out << "enum class DataType : uint8_t {" << Qt::endl;
+        out << "    Uint8," << Qt::endl;
+        out << "    Uint16," << Qt::endl;
+        out << "    Uint32," << Qt::endl;
+        out << "    Uint64," << Qt::endl;
+        out << "    Float32," << Qt::endl;
+        out << "    Float64," << Qt::endl;
+        out << "    ByteArray," << Qt::endl;
+        out << "    SubAttributes," << Qt::endl;
+        out << "    String," << Qt::endl;
+        out << "};" << Qt::endl;
+        out << Qt::endl;
+        out << "struct AttDesc {" << Qt::endl;
+        out << "    uint16_t id;" << Qt::endl;
+        out << "    bool isOptional;" << Qt::endl;
+        out << "    DataType dataType;" << Qt::endl;
+        out << "    const AttDesc *pSubAtts;" << Qt::endl;
+        out << "    std::size_t subAttNb;" << Qt::endl;
+        out << Qt::endl;
+        out << "    constexpr std::span<const AttDesc> subAtts(void) const {" << Qt::endl;
+        out << "        return {pSubAtts, subAttNb};" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << "};" << Qt::endl;
+        out << Qt::endl;
+        out << "struct CmdDesc {" << Qt::endl;
+        out << "    CmdId id;" << Qt::endl;
+        out << "    std::span<const AttDesc> atts;" << Qt::endl;
+        out << "};" << Qt::endl;
+        out << Qt::endl;
+        out << "struct ProtDesc {" << Qt::endl;
+        out << "    uint16_t id;" << Qt::endl;
+        out << "    uint16_t version;" << Qt::endl;
+        out << "    std::span<const CmdDesc> cmds;" << Qt::endl;
+        out << "};" << Qt::endl;
+        out << Qt::endl;
+        for (Command *command : cmdList) {
+            if (command->getAttArray().size() > 0) {
+                this->declareAttDesc_Rec(QStringList(command->getName()), command->getAttArray(), &out);
+            }
+        }
+        out << "inline constexpr CmdDesc CMD_DESC[] = {" << Qt::endl;
+        for (Command *command : cmdList) {
+            out << "    {CmdId::" << this->capitalize(command->getName()) << ", ";
+            if (command->getAttArray().size() > 0) {
+                out << command->getName().toUpper() << "_ATT_DESC}," << Qt::endl;
+            } else {
+                out << "{}}," << Qt::endl;
+            }
+        }
+        out << "};" << Qt::endl;
+        out << Qt::endl;
+        out << "inline constexpr ProtDesc PROT_DESC = {PROT_ID, PROT_VER, CMD_DESC};" << Qt::endl;
+        out << Qt::endl;
+
+        // Descriptor checks
+        out << "namespace detail {" << Qt::endl;
+        out << Qt::endl;
+        out << "// Worst-case encoded size of an attribute list, byte array and string bodies excluded" << Qt::endl;
+        out << "constexpr std::size_t getMaxAttListSize(std::span<const AttDesc> atts) {" << Qt::endl;
+        out << "    std::size_t size = FIELD_SIZE;" << Qt::endl;
+        out << Qt::endl;
+        out << "    for (const AttDesc &att : atts) {" << Qt::endl;
+        out << "        size += 2 * FIELD_SIZE;" << Qt::endl;
+        out << "        switch (att.dataType) {" << Qt::endl;
+        out << "            case DataType::Uint8:" << Qt::endl;
+        out << "            case DataType::String:" << Qt::endl;
+        out << "                size += 1;" << Qt::endl;
+        out << "                break;" << Qt::endl;
+        out << "            case DataType::Uint16:" << Qt::endl;
+        out << "                size += 2;" << Qt::endl;
+        out << "                break;" << Qt::endl;
+        out << "            case DataType::Uint32:" << Qt::endl;
+        out << "            case DataType::Float32:" << Qt::endl;
+        out << "                size += 4;" << Qt::endl;
+        out << "                break;" << Qt::endl;
+        out << "            case DataType::Uint64:" << Qt::endl;
+        out << "            case DataType::Float64:" << Qt::endl;
+        out << "                size += 8;" << Qt::endl;
+        out << "                break;" << Qt::endl;
+        out << "            case DataType::SubAttributes:" << Qt::endl;
+        out << "                // The sub-attribute number is the attribute size field" << Qt::endl;
+        out << "                size += getMaxAttListSize(att.subAtts()) - FIELD_SIZE;"
+            << Qt::endl;
+        out << "                break;" << Qt::endl;
+        out << "            case DataType::ByteArray:" << Qt::endl;
+        out << "                break;" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << "    return size;" << Qt::endl;
+        out << "}" << Qt::endl;
+        out << Qt::endl;
+        out << "// An attribute list is bounded if it has no byte array or string" << Qt::endl;
+        out << "constexpr bool isBounded(std::span<const AttDesc> atts) {" << Qt::endl;
+        out << "    for (const AttDesc &att : atts) {" << Qt::endl;
+        out << "        if ((att.dataType == DataType::ByteArray) || (att.dataType == DataType::String) ||" << Qt::endl;
+        out << "            !isBounded(att.subAtts())) {" << Qt::endl;
+        out << "            return false;" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << "    return true;" << Qt::endl;
+        out << "}" << Qt::endl;
+        out << Qt::endl;
+        out << "// Attribute ids must leave the complex flag free and attribute numbers must fit in a field" << Qt::endl;
+        out << "constexpr bool isFieldValid(std::span<const AttDesc> atts) {" << Qt::endl;
+        out << "    if (atts.size() > FIELD_MAX) {" << Qt::endl;
+        out << "        return false;" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << "    for (const AttDesc &att : atts) {" << Qt::endl;
+        out << "        if ((att.id >= CMPLX_FLAG) || !isFieldValid(att.subAtts())) {" << Qt::endl;
+        out << "            return false;" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << "    return true;" << Qt::endl;
+        out << "}" << Qt::endl;
+        out << Qt::endl;
+        out << "constexpr bool isFieldValid(const ProtDesc &prot) {" << Qt::endl;
+        out << "    if (prot.id > FIELD_MAX) {" << Qt::endl;
+        out << "        return false;" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << "    for (const CmdDesc &cmd : prot.cmds) {" << Qt::endl;
+        out << "        if ((static_cast<std::size_t>(cmd.id) > FIELD_MAX) || !isFieldValid(cmd.atts)) {" << Qt::endl;
+        out << "            return false;" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << "    return true;" << Qt::endl;
+        out << "}" << Qt::endl;
+        out << Qt::endl;
+        out << "} // namespace detail" << Qt::endl;
+        out << Qt::endl;
+        out << "static_assert(detail::isFieldValid(PROT_DESC), "
+            << "\"Identifiers or attribute numbers overflow the frame fields\");" << Qt::endl;
+        out << Qt::endl;
+
+        // Payloads
+        out << "// *** Payloads ***" << Qt::endl;
+        out << Qt::endl;
+        for (Command *command : cmdList) {
+            QStringList cmdPath = QStringList(command->getName());
+            if (command->getAttArray().size() > 0) {
+                this->declarePayload_Rec(cmdPath, command->getAttArray(), &out);
+            } else {
+                out << "// " << command->getName() << " payload" << Qt::endl;
+                out << "struct " << this->getPayloadName(cmdPath) << " {" << Qt::endl;
+                out << "    static constexpr CmdId ID = CmdId::" << this->capitalize(command->getName()) << ";" << Qt::endl;
+                out << "    static constexpr std::span<const AttDesc> ATT_DESC = {};" << Qt::endl;
+                out << "};" << Qt::endl;
+                out << Qt::endl;
+            }
+        }
+        out << "// Worst-case frame size of a command, byte array and string bodies excluded" << Qt::endl;
+        out << "template <typename T_Payload>" << Qt::endl;
+        out << "inline constexpr std::size_t MAX_FRAME_SIZE =" << Qt::endl;
+        out << "    (2 * FIELD_SIZE) + detail::getMaxAttListSize(T_Payload::ATT_DESC);" << Qt::endl;
+        out << Qt::endl;
+        out << "// A command is bounded if it has no byte array or string, its frame size is then at most MAX_FRAME_SIZE"
+            << Qt::endl;
+        out << "template <typename T_Payload> inline constexpr bool IS_BOUNDED = detail::isBounded(T_Payload::ATT_DESC);"
+            << Qt::endl;
+        out << Qt::endl;
+        // Reader and writer
+        out << "namespace detail {" << Qt::endl;
+        out << Qt::endl;
+        out << "// *** Frame reader and writer ***" << Qt::endl;
+        out << Qt::endl;
+        out << "class Reader {" << Qt::endl;
+        out << "  public:" << Qt::endl;
+        out << "    explicit Reader(std::span<const uint8_t> frame) : m_frame(frame), m_idx(0) {" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "    // Little endian frame field" << Qt::endl;
+        out << "    bool field(uint_fast16_t &value) {" << Qt::endl;
+        out << "        if ((m_frame.size() - m_idx) < FIELD_SIZE) {" << Qt::endl;
+        out << "            return false;" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "        value = 0;" << Qt::endl;
+        out << "        for (std::size_t idx = 0; idx < FIELD_SIZE; idx++) {" << Qt::endl;
+        out << "            value |= static_cast<uint_fast16_t>(m_frame[m_idx++]) << (8 * idx);" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "        return true;" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "    // Attribute data size and data, the data stays in the frame" << Qt::endl;
+        out << "    bool bytes(std::span<const uint8_t> &value) {" << Qt::endl;
+        out << "        uint_fast16_t dataSize;" << Qt::endl;
+        out << Qt::endl;
+        out << "        if (!field(dataSize) || ((m_frame.size() - m_idx) < dataSize)) {" << Qt::endl;
+        out << "            return false;" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "        value = m_frame.subspan(m_idx, dataSize);" << Qt::endl;
+        out << "        m_idx += dataSize;" << Qt::endl;
+        out << "        return true;" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "    // Strings are sent with their null terminator, the view leaves it out" << Qt::endl;
+        out << "    bool string(std::string_view &value) {" << Qt::endl;
+        out << "        std::span<const uint8_t> data;" << Qt::endl;
+        out << Qt::endl;
+        out << "        if (!bytes(data) || data.empty() || (data.back() != 0)) {" << Qt::endl;
+        out << "            return false;" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "        value = std::string_view(reinterpret_cast<const char *>(data.data()), data.size() - 1);"
+            << Qt::endl;
+        out << "        return true;" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "    // Unsigned integers are little endian, without their upper zero bytes" << Qt::endl;
+        out << "    template <typename T> bool uint(T &value) {" << Qt::endl;
+        out << "        std::span<const uint8_t> data;" << Qt::endl;
+        out << Qt::endl;
+        out << "        if (!bytes(data) || data.empty() || (data.size() > sizeof(T))) {" << Qt::endl;
+        out << "            return false;" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "        value = 0;" << Qt::endl;
+        out << "        for (std::size_t idx = 0; idx < data.size(); idx++) {" << Qt::endl;
+        out << "            value = static_cast<T>(value | (static_cast<T>(data[idx]) << (8 * idx)));" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "        return true;" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "    bool float32(float &value) {" << Qt::endl;
+        out << "        uint32_t bits;" << Qt::endl;
+        out << Qt::endl;
+        out << "        if ((remainingData() != sizeof(float)) || !uint(bits)) {" << Qt::endl;
+        out << "            return false;" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "        value = std::bit_cast<float>(bits);" << Qt::endl;
+        out << "        return true;" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "    bool float64(double &value) {" << Qt::endl;
+        out << "        uint64_t bits;" << Qt::endl;
+        out << Qt::endl;
+        out << "        if ((remainingData() != sizeof(double)) || !uint(bits)) {" << Qt::endl;
+        out << "            return false;" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "        value = std::bit_cast<double>(bits);" << Qt::endl;
+        out << "        return true;" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "  private:" << Qt::endl;
+        out << "    std::span<const uint8_t> m_frame;" << Qt::endl;
+        out << "    std::size_t m_idx;" << Qt::endl;
+        out << Qt::endl;
+        out << "    // Peeks the size of the next attribute data" << Qt::endl;
+        out << "    std::size_t remainingData(void) {" << Qt::endl;
+        out << "        std::size_t idx = m_idx;" << Qt::endl;
+        out << "        uint_fast16_t dataSize = 0;" << Qt::endl;
+        out << Qt::endl;
+        out << "        if (field(dataSize)) {" << Qt::endl;
+        out << "            m_idx = idx;" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "        return dataSize;" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << "};" << Qt::endl;
+        out << Qt::endl;
+        out << "class Writer {" << Qt::endl;
+        out << "  public:" << Qt::endl;
+        out << "    explicit Writer(std::span<uint8_t> buffer) : m_buffer(buffer), m_idx(0), m_isOverflow(false) {"
+            << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "    // Little endian frame field" << Qt::endl;
+        out << "    void field(std::size_t value) {" << Qt::endl;
+        out << "        if (m_isOverflow || (value > FIELD_MAX) || ((m_buffer.size() - m_idx) < FIELD_SIZE)) {"
+            << Qt::endl;
+        out << "            m_isOverflow = true;" << Qt::endl;
+        out << "            return;" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "        for (std::size_t idx = 0; idx < FIELD_SIZE; idx++) {" << Qt::endl;
+        out << "            m_buffer[m_idx++] = static_cast<uint8_t>(value >> (8 * idx));" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "    void bytes(uint_fast16_t attId, std::span<const uint8_t> value) {" << Qt::endl;
+        out << "        if (attHeader(attId, value.size())) {" << Qt::endl;
+        out << "            m_idx = std::copy(value.begin(), value.end(), m_buffer.begin() + m_idx) - m_buffer.begin();"
+            << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "    void string(uint_fast16_t attId, std::string_view value) {" << Qt::endl;
+        out << "        if (attHeader(attId, value.size() + 1)) {" << Qt::endl;
+        out << "            m_idx = std::copy(value.begin(), value.end(), m_buffer.begin() + m_idx) - m_buffer.begin();"
+            << Qt::endl;
+        out << "            m_buffer[m_idx++] = 0;" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "    // Little endian, without the upper zero bytes but at least one byte" << Qt::endl;
+        out << "    void uint(uint_fast16_t attId, uint64_t value) {" << Qt::endl;
+        out << "        std::array<uint8_t, sizeof(uint64_t)> data;" << Qt::endl;
+        out << "        std::size_t dataSize = 0;" << Qt::endl;
+        out << Qt::endl;
+        out << "        do {" << Qt::endl;
+        out << "            data[dataSize++] = static_cast<uint8_t>(value);" << Qt::endl;
+        out << "            value >>= 8;" << Qt::endl;
+        out << "        } while (value != 0);" << Qt::endl;
+        out << "        bytes(attId, std::span<const uint8_t>(data.data(), dataSize));" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "    void float32(uint_fast16_t attId, float value) {" << Qt::endl;
+        out << "        fixed(attId, std::bit_cast<uint32_t>(value));" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "    void float64(uint_fast16_t attId, double value) {" << Qt::endl;
+        out << "        fixed(attId, std::bit_cast<uint64_t>(value));" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "    // Frame size, 0 if the buffer overflowed" << Qt::endl;
+        out << "    std::size_t size(void) const {" << Qt::endl;
+        out << "        return (m_isOverflow) ? 0 : m_idx;" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "  private:" << Qt::endl;
+        out << "    std::span<uint8_t> m_buffer;" << Qt::endl;
+        out << "    std::size_t m_idx;" << Qt::endl;
+        out << "    bool m_isOverflow;" << Qt::endl;
+        out << Qt::endl;
+        out << "    // Writes an attribute id and data size, and checks the data fits in the buffer" << Qt::endl;
+        out << "    bool attHeader(uint_fast16_t attId, std::size_t dataSize) {" << Qt::endl;
+        out << "        field(attId);" << Qt::endl;
+        out << "        field(dataSize);" << Qt::endl;
+        out << "        if (m_isOverflow || ((m_buffer.size() - m_idx) < dataSize)) {" << Qt::endl;
+        out << "            m_isOverflow = true;" << Qt::endl;
+        out << "            return false;" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "        return true;" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "    // Little endian, full size" << Qt::endl;
+        out << "    template <typename T> void fixed(uint_fast16_t attId, T bits) {" << Qt::endl;
+        out << "        std::array<uint8_t, sizeof(T)> data;" << Qt::endl;
+        out << Qt::endl;
+        out << "        for (std::size_t idx = 0; idx < sizeof(T); idx++) {" << Qt::endl;
+        out << "            data[idx] = static_cast<uint8_t>(bits >> (8 * idx));" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "        bytes(attId, data);" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << "};" << Qt::endl;
+        out << Qt::endl;
+
+        // Decoders and encoders
+        out << "// *** Payload decoders ***" << Qt::endl;
+        out << Qt::endl;
+        for (Command *command : cmdList) {
+            QStringList cmdPath = QStringList(command->getName());
+            if (command->getAttArray().size() > 0) {
+                this->writeDecodeFct_Rec(cmdPath, command->getAttArray(), &out);
+            } else {
+                out << "inline bool decodeAtts(Reader &, uint_fast16_t attNb, " << this->getPayloadName(cmdPath)
+                    << " &) {" << Qt::endl;
+                out << "    return attNb == 0;" << Qt::endl;
+                out << "}" << Qt::endl;
+                out << Qt::endl;
+            }
+        }
+        out << "// *** Payload encoders ***" << Qt::endl;
+        out << Qt::endl;
+        for (Command *command : cmdList) {
+            QStringList cmdPath = QStringList(command->getName());
+            if (command->getAttArray().size() > 0) {
+                this->writeEncodeFct_Rec(cmdPath, command->getAttArray(), &out);
+            } else {
+                out << "inline void encodeAtts(Writer &writer, const " << this->getPayloadName(cmdPath) << " &) {"
+                    << Qt::endl;
+                out << "    writer.field(0);" << Qt::endl;
+                out << "}" << Qt::endl;
+                out << Qt::endl;
+            }
+        }
+        out << "// Decodes a command payload and passes it to the handler" << Qt::endl;
+        out << "template <typename T_Payload, typename T_Handler>" << Qt::endl;
+        out << "bool dispatch(Reader &reader, uint_fast16_t attNb, T_Handler &handler) {" << Qt::endl;
+        out << "    T_Payload payload{};" << Qt::endl;
+        out << Qt::endl;
+        out << "    if (!decodeAtts(reader, attNb, payload)) {" << Qt::endl;
+        out << "        return false;" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << "    handler(static_cast<const T_Payload &>(payload));" << Qt::endl;
+        out << "    return true;" << Qt::endl;
+        out << "}" << Qt::endl;
+        out << Qt::endl;
+        out << "} // namespace detail" << Qt::endl;
+        out << Qt::endl;
+
+        // Public functions
+        out << "// *** Public functions ***" << Qt::endl;
+        out << Qt::endl;
+        out << "// Checks if a side receives a command" << Qt::endl;
+        out << "constexpr bool isReceivable(Side side, CmdId cmdId) {" << Qt::endl;
+        out << "    switch (cmdId) {" << Qt::endl;
+        for (Command *command : cmdList) {
+            out << "        case CmdId::" << this->capitalize(command->getName()) << ":" << Qt::endl;
+            if (command->isReceivable(true) && command->isReceivable(false)) {
+                out << "            return true;" << Qt::endl;
+            } else {
+                out << "            return side == Side::" << ((command->isReceivable(true)) ? "A" : "B") << ";"
+                    << Qt::endl;
+            }
+        }
+        out << "    }" << Qt::endl;
+        out << "    return false;" << Qt::endl;
+        out << "}" << Qt::endl;
+        out << Qt::endl;
+        out << "// Encodes a command frame, returns the frame size or 0 if the buffer is too small" << Qt::endl;
+        out << "template <typename T_Payload> std::size_t encode(const T_Payload &payload, std::span<uint8_t> buffer) {"
+            << Qt::endl;
+        out << "    detail::Writer writer(buffer);" << Qt::endl;
+        out << Qt::endl;
+        out << "    writer.field(PROT_ID);" << Qt::endl;
+        out << "    writer.field(static_cast<std::size_t>(T_Payload::ID));" << Qt::endl;
+        out << "    detail::encodeAtts(writer, payload);" << Qt::endl;
+        out << "    return writer.size();" << Qt::endl;
+        out << "}" << Qt::endl;
+        out << Qt::endl;
+        out << "// Encodes a command frame in an array, large enough for any frame of a bounded command" << Qt::endl;
+        out << "template <typename T_Payload, std::size_t N>" << Qt::endl;
+        out << "std::size_t encode(const T_Payload &payload, std::array<uint8_t, N> &buffer) {" << Qt::endl;
+        out << "    static_assert(!IS_BOUNDED<T_Payload> || (N >= MAX_FRAME_SIZE<T_Payload>), "
+            << "\"Buffer smaller than the worst-case frame\");" << Qt::endl;
+        out << "    return encode(payload, std::span<uint8_t>(buffer));" << Qt::endl;
+        out << "}" << Qt::endl;
+        out << Qt::endl;
+        out << "// Decodes a frame and calls the handler with its payload, only the commands received by the side are"
+            << Qt::endl;
+        out << "// decoded so the handler only needs to accept their payloads. Returns false if the frame is invalid or"
+            << Qt::endl;
+        out << "// not received by the side." << Qt::endl;
+        out << "template <Side side, typename T_Handler> bool receive(std::span<const uint8_t> frame, T_Handler &&handler) {"
+            << Qt::endl;
+        out << "    detail::Reader reader(frame);" << Qt::endl;
+        out << "    uint_fast16_t protId;" << Qt::endl;
+        out << "    uint_fast16_t cmdId;" << Qt::endl;
+        out << "    uint_fast16_t attNb;" << Qt::endl;
+        out << Qt::endl;
+        out << "    if (!reader.field(protId) || (protId != PROT_ID) || !reader.field(cmdId) || !reader.field(attNb)) {"
+            << Qt::endl;
+        out << "        return false;" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << "    switch (cmdId) {" << Qt::endl;
+        for (Command *command : cmdList) {
+            QString cmdName = this->capitalize(command->getName());
+            out << "        case static_cast<uint_fast16_t>(CmdId::" << cmdName << "):" << Qt::endl;
+            out << "            if constexpr (isReceivable(side, CmdId::" << cmdName << ")) {" << Qt::endl;
+            out << "                return detail::dispatch<" << this->getPayloadName(QStringList(command->getName()))
+                << ">(reader, attNb, handler);" << Qt::endl;
+            out << "            } else {" << Qt::endl;
+            out << "                return false;" << Qt::endl;
+            out << "            }" << Qt::endl;
+            out << Qt::endl;
+        }
+        out << "        default: // Unknown command" << Qt::endl;
+        out << "            return false;" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << "}" << Qt::endl;
+        out << Qt::endl;
+        out << "} // namespace " << nsName << Qt::endl;
+        out << Qt::endl;
+        out << "#endif // Lcsf_binding_" << protocolName.toLower() << "_hpp" << Qt::endl;
+
+        file.close();
+        Profiler::addCounter("Bytes written", file.size());
+    }
+}
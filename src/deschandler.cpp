@@ -25,10 +25,14 @@
 #include <QJsonValue>
 #include <QList>
 #include <QRandomGenerator>
+#include <QSaveFile>
+#include <QSet>
+#include <QTextStream>
 
 #include "attribute.h"
 #include "deschandler.h"
 #include "enumtype.h"
+#include "profiler.h"
 
 static QString correctInputString(QString input) {
     QRegExp re(R"([^\w])");
@@ -72,6 +76,10 @@ static void loadAtt_Rec(Command *pParentCmd, Attribute *pParentAtt, const QJsonO
         attribute.value(QLatin1String("isOptional")).toBool(),
         convertDataType(attribute.value(QLatin1String("dataType")).toString()),
         attribute.value(QLatin1String("desc")).toString()));
+    // Only byte arrays can be streamed
+    if (Attr->getDataType() == NS_AttDataType::BYTE_ARRAY) {
+        Attr->setIsStreamed(attribute.value(QLatin1String("isStreamed")).toBool());
+    }
     // If this is a sub-attribute
     if (pParentAtt != nullptr) {
         pParentAtt->addSubAtt(Attr);
@@ -89,28 +97,139 @@ static void loadAtt_Rec(Command *pParentCmd, Attribute *pParentAtt, const QJsonO
     }
 }
 
-static void saveAtt_Rec(QJsonArray &attributes, QList<Attribute *> attList) {
+// Buffer size before flushing to file
+static const int JSON_BUFFER_SIZE = 64 * 1024;
+
+static bool flushJsonBuffer(QSaveFile &file, QByteArray &buffer, bool force) {
+    if (!force && (buffer.size() < JSON_BUFFER_SIZE)) {
+        return true;
+    }
+    bool isOk = (file.write(buffer) == buffer.size());
+    buffer.clear();
+    return isOk;
+}
+
+static void writeJsonIndent(QByteArray &buffer, int level, bool isCompact) {
+    if (!isCompact) {
+        buffer.append(QByteArray(4 * level, ' '));
+    }
+}
+
+static void writeJsonString(QByteArray &buffer, const QString &value) {
+    static const char hexDigits[] = "0123456789abcdef";
+    const QByteArray utf8 = value.toUtf8();
+
+    // Same escaping rules as QJsonDocument
+    buffer.append('"');
+    for (const char c : utf8) {
+        const uchar u = static_cast<uchar>(c);
+        if ((u >= 0x20) && (u != '"') && (u != '\\')) {
+            buffer.append(c);
+            continue;
+        }
+        buffer.append('\\');
+        switch (u) {
+            case '"':
+                buffer.append('"');
+                break;
+            case '\\':
+                buffer.append('\\');
+                break;
+            case '\b':
+                buffer.append('b');
+                break;
+            case '\f':
+                buffer.append('f');
+                break;
+            case '\n':
+                buffer.append('n');
+                break;
+            case '\r':
+                buffer.append('r');
+                break;
+            case '\t':
+                buffer.append('t');
+                break;
+            default:
+                buffer.append("u00");
+                buffer.append(hexDigits[u >> 4]);
+                buffer.append(hexDigits[u & 0xf]);
+                break;
+        }
+    }
+    buffer.append('"');
+}
+
+// Members must be written in alphabetical order to match QJsonDocument output
+static void writeJsonKey(QByteArray &buffer, const char *key, int level, bool isFirst, bool isCompact) {
+    if (!isFirst) {
+        buffer.append(isCompact ? "," : ",\n");
+    }
+    writeJsonIndent(buffer, level, isCompact);
+    buffer.append('"');
+    buffer.append(key);
+    buffer.append(isCompact ? "\":" : "\": ");
+}
+
+static void writeJsonArrayStart(QByteArray &buffer, bool isCompact) {
+    buffer.append(isCompact ? "[" : "[\n");
+}
+
+static void writeJsonArrayEnd(QByteArray &buffer, int level, bool isEmpty, bool isCompact) {
+    if (!isEmpty && !isCompact) {
+        buffer.append('\n');
+    }
+    writeJsonIndent(buffer, level, isCompact);
+    buffer.append(']');
+}
+
+static bool saveAtt_Rec(QSaveFile &file, QByteArray &buffer, QList<Attribute *> attList, int level, bool isCompact) {
+    writeJsonArrayStart(buffer, isCompact);
     // Parse attributes
-    for (Attribute *attribute : attList) {
-        QJsonObject Attr;
+    for (int idx = 0; idx < attList.size(); idx++) {
+        Attribute *attribute = attList.at(idx);
 
+        if (idx > 0) {
+            buffer.append(isCompact ? "," : ",\n");
+        }
+        writeJsonIndent(buffer, level + 1, isCompact);
+        buffer.append(isCompact ? "{" : "{\n");
         // Attribute parameters
-        Attr.insert(QLatin1String("name"), attribute->getName());
-        Attr.insert(QLatin1String("id"), attribute->getId());
-        Attr.insert(QLatin1String("isOptional"), attribute->getIsOptional());
-        Attr.insert(QLatin1String("dataType"), NS_AttDataType::SL_AttDataType.at(attribute->getDataType()));
-        Attr.insert(QLatin1String("desc"), attribute->getDesc());
-        Attr.insert(QLatin1String("size"), attribute->getSubAttArray().size());
-
+        writeJsonKey(buffer, "dataType", level + 2, true, isCompact);
+        writeJsonString(buffer, NS_AttDataType::SL_AttDataType.at(attribute->getDataType()));
+        writeJsonKey(buffer, "desc", level + 2, false, isCompact);
+        writeJsonString(buffer, attribute->getDesc());
+        writeJsonKey(buffer, "id", level + 2, false, isCompact);
+        buffer.append(QByteArray::number(attribute->getId()));
+        writeJsonKey(buffer, "isOptional", level + 2, false, isCompact);
+        buffer.append(attribute->getIsOptional() ? "true" : "false");
+        // Key is omitted by default to keep descriptions without streaming unchanged
+        if (attribute->getIsStreamed()) {
+            writeJsonKey(buffer, "isStreamed", level + 2, false, isCompact);
+            buffer.append("true");
+        }
+        writeJsonKey(buffer, "name", level + 2, false, isCompact);
+        writeJsonString(buffer, attribute->getName());
+        writeJsonKey(buffer, "size", level + 2, false, isCompact);
+        buffer.append(QByteArray::number(attribute->getSubAttArray().size()));
         // Parse sub-attributes
         if (attribute->getDataType() == NS_AttDataType::SUB_ATTRIBUTES) {
-            QJsonArray SubAttr;
-            saveAtt_Rec(SubAttr, attribute->getSubAttArray());
-            Attr.insert(QLatin1String("subAttr"), SubAttr);
+            writeJsonKey(buffer, "subAttr", level + 2, false, isCompact);
+            if (!saveAtt_Rec(file, buffer, attribute->getSubAttArray(), level + 2, isCompact)) {
+                return false;
+            }
+        }
+        if (!isCompact) {
+            buffer.append('\n');
+        }
+        writeJsonIndent(buffer, level + 1, isCompact);
+        buffer.append('}');
+        if (!flushJsonBuffer(file, buffer, false)) {
+            return false;
         }
-        // Add the attribute
-        attributes.append(Attr);
     }
+    writeJsonArrayEnd(buffer, level, attList.isEmpty(), isCompact);
+    return true;
 }
 
 DescHandler::DescHandler() {
@@ -118,6 +237,7 @@ DescHandler::DescHandler() {
 
 void DescHandler::load_desc(QFile &file, QList<Command *> &cmdArray, QString &protocolName, QString &protocolId,
     QString &protocolVersion, QString &protocolDesc) {
+    LCSF_PROFILE_SCOPE("DescHandler::load_desc", "desc");
     QJsonDocument DescFile(QJsonDocument::fromJson(file.readAll()));
     QJsonObject DescFileObject(DescFile.object());
 
@@ -151,43 +271,97 @@ void DescHandler::load_desc(QFile &file, QList<Command *> &cmdArray, QString &pr
     }
 }
 
+void DescHandler::load_subset(QFile &file, QStringList &cmdNames) {
+    // One command name per line, '#' starts a comment
+    QTextStream in(&file);
+    QSet<QString> knownNames(cmdNames.begin(), cmdNames.end());
+
+    while (!in.atEnd()) {
+        QString line = in.readLine();
+        int commentIdx = line.indexOf('#');
+        if (commentIdx >= 0) {
+            line.truncate(commentIdx);
+        }
+        line = line.trimmed();
+        if (!line.isEmpty() && !knownNames.contains(line)) {
+            knownNames.insert(line);
+            cmdNames.append(line);
+        }
+    }
+}
+
 bool DescHandler::save_desc(QString filename, QList<Command *> cmdArray, QString protocolName, QString protocolId,
-    QString protocolVersion, QString protocolDesc) {
-    // Generate JSON
-    QJsonObject DescFile;
-    DescFile.insert(QLatin1String("name"), protocolName);
-    DescFile.insert(QLatin1String("id"), protocolId);
-    DescFile.insert(QLatin1String("version"), protocolVersion.toInt());
-    DescFile.insert(QLatin1String("desc"), protocolDesc);
+    QString protocolVersion, QString protocolDesc, bool isCompact) {
+    LCSF_PROFILE_SCOPE("DescHandler::save_desc", "desc");
+    // Stream JSON into a temporary file, it replaces the destination on commit
+    QSaveFile JsonDescFile(filename);
+    QByteArray buffer;
+
+    if (!JsonDescFile.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    buffer.reserve(JSON_BUFFER_SIZE + 4096);
+    buffer.append(isCompact ? "{" : "{\n");
 
     // Save commands
-    QJsonArray DescCmd;
-    for (Command *Cmd : cmdArray) {
-        // Commands parameters
-        QJsonObject jsonCmd;
-        jsonCmd.insert(QLatin1String("parentName"), "NONE");
-        jsonCmd.insert(QLatin1String("name"), Cmd->getName());
-        jsonCmd.insert(QLatin1String("id"), Cmd->getId());
-        jsonCmd.insert(QLatin1String("hasAtt"), Cmd->getHasAtt());
-        jsonCmd.insert(QLatin1String("direction"), Cmd->getDirection());
-        jsonCmd.insert(QLatin1String("description"), Cmd->getDesc());
-        jsonCmd.insert(QLatin1String("size"), Cmd->getAttArray().size());
+    writeJsonKey(buffer, "commands", 1, true, isCompact);
+    writeJsonArrayStart(buffer, isCompact);
+    for (int idx = 0; idx < cmdArray.size(); idx++) {
+        Command *Cmd = cmdArray.at(idx);
+
+        if (idx > 0) {
+            buffer.append(isCompact ? "," : ",\n");
+        }
+        writeJsonIndent(buffer, 2, isCompact);
+        buffer.append(isCompact ? "{" : "{\n");
         // Command attributes
-        QJsonArray Attr;
-        saveAtt_Rec(Attr, Cmd->getAttArray());
-        jsonCmd.insert(QLatin1String("attributes"), Attr);
-        // Add command in the array
-        DescCmd.append(jsonCmd);
-    }
-    // Write commands in file
-    DescFile.insert(QLatin1String("commands"), DescCmd);
-    QFile JsonDescFile(filename);
-
-    if (JsonDescFile.open(QIODevice::WriteOnly)) {
-        JsonDescFile.write(QJsonDocument(DescFile).toJson());
-        JsonDescFile.close();
-        return true;
-    } else {
+        writeJsonKey(buffer, "attributes", 3, true, isCompact);
+        if (!saveAtt_Rec(JsonDescFile, buffer, Cmd->getAttArray(), 3, isCompact)) {
+            JsonDescFile.cancelWriting();
+            return false;
+        }
+        // Commands parameters
+        writeJsonKey(buffer, "description", 3, false, isCompact);
+        writeJsonString(buffer, Cmd->getDesc());
+        writeJsonKey(buffer, "direction", 3, false, isCompact);
+        buffer.append(QByteArray::number(Cmd->getDirection()));
+        writeJsonKey(buffer, "hasAtt", 3, false, isCompact);
+        buffer.append(Cmd->getHasAtt() ? "true" : "false");
+        writeJsonKey(buffer, "id", 3, false, isCompact);
+        buffer.append(QByteArray::number(Cmd->getId()));
+        writeJsonKey(buffer, "name", 3, false, isCompact);
+        writeJsonString(buffer, Cmd->getName());
+        writeJsonKey(buffer, "parentName", 3, false, isCompact);
+        writeJsonString(buffer, "NONE");
+        writeJsonKey(buffer, "size", 3, false, isCompact);
+        buffer.append(QByteArray::number(Cmd->getAttArray().size()));
+        if (!isCompact) {
+            buffer.append('\n');
+        }
+        writeJsonIndent(buffer, 2, isCompact);
+        buffer.append('}');
+        if (!flushJsonBuffer(JsonDescFile, buffer, false)) {
+            JsonDescFile.cancelWriting();
+            return false;
+        }
+    }
+    writeJsonArrayEnd(buffer, 1, cmdArray.isEmpty(), isCompact);
+
+    // Protocol parameters
+    writeJsonKey(buffer, "desc", 1, false, isCompact);
+    writeJsonString(buffer, protocolDesc);
+    writeJsonKey(buffer, "id", 1, false, isCompact);
+    writeJsonString(buffer, protocolId);
+    writeJsonKey(buffer, "name", 1, false, isCompact);
+    writeJsonString(buffer, protocolName);
+    writeJsonKey(buffer, "version", 1, false, isCompact);
+    buffer.append(QByteArray::number(protocolVersion.toInt()));
+    buffer.append(isCompact ? "}" : "\n}\n");
+
+    // Write remaining data and replace file
+    if (!flushJsonBuffer(JsonDescFile, buffer, true)) {
+        JsonDescFile.cancelWriting();
         return false;
     }
-}
\ No newline at end of file
+    return JsonDescFile.commit();
+}
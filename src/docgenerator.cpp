@@ -19,377 +19,527 @@
     along with this project. If not, see <https://www.gnu.org/licenses/>
  */
 
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QStringBuilder>
+#include <QtConcurrent>
+#include <functional>
 
 #include "docgenerator.h"
+#include "profiler.h"
 
 DocGenerator::DocGenerator() {
 }
 
-QList<Attribute::T_attInfos> DocGenerator::getAttInfos_Rec(QString parentName, QList<Attribute *> attList) {
-    QList<Attribute::T_attInfos> resultList = QList<Attribute::T_attInfos>();
-    Attribute::T_attInfos localAttInfos;
-    for (Attribute *attribute : attList) {
-        localAttInfos.parentName = parentName;
-        localAttInfos.attName = attribute->getName();
-        localAttInfos.attId = attribute->getId();
-        localAttInfos.attPointer = attribute;
-        localAttInfos.dataType = attribute->getDataType();
-        localAttInfos.isOptional = attribute->getIsOptional();
-        localAttInfos.subAttNb = attribute->getSubAttArray().size();
-        localAttInfos.attDesc = attribute->getDesc();
-        resultList.append(localAttInfos);
-        if ((attribute->getDataType() == NS_AttDataType::SUB_ATTRIBUTES) && (localAttInfos.subAttNb > 0)) {
-            resultList.append(this->getAttInfos_Rec(localAttInfos.attName, attribute->getSubAttArray()));
-        }
-    }
-    return resultList;
+QString DocGenerator::getDocId(short id) {
+    return QString::number(id, 16).rightJustified(2, '0').prepend("0x");
 }
 
-QList<Attribute::T_attInfos> DocGenerator::getAttInfos(QList<Command *> cmdList) {
-    QList<Attribute::T_attInfos> resultList = QList<Attribute::T_attInfos>();
-    for (Command *command : cmdList) {
-        QString cmdName = command->getName();
-        if ((command->getHasAtt()) && (command->getAttArray().size() > 0)) {
-            resultList.append(this->getAttInfos_Rec(cmdName, command->getAttArray()));
+DocGenerator::T_DocRow DocGenerator::getDocRow_Rec(Attribute *attribute) {
+    T_DocRow docRow;
+
+    docRow.name = attribute->getName();
+    docRow.id = this->getDocId(attribute->getId());
+    docRow.isOptional = (attribute->getIsOptional()) ? "Yes" : "No";
+    docRow.dataType = NS_AttDataType::SL_DocAttDataType[attribute->getDataType()];
+    docRow.desc = attribute->getDesc();
+    if (attribute->getDataType() == NS_AttDataType::SUB_ATTRIBUTES) {
+        for (Attribute *subAtt : attribute->getSubAttArray()) {
+            docRow.subRows.append(this->getDocRow_Rec(subAtt));
         }
     }
-    return resultList;
+    return docRow;
 }
 
-QList<Attribute::T_attInfos> DocGenerator::insertSortAttInfosListByParentName(QList<Attribute::T_attInfos> attInfosList) {
-    QList<Attribute::T_attInfos> sortedList = attInfosList;
-    Attribute::T_attInfos bufferAttInfos;
-    int j = 0;
-    int listSize = sortedList.size();
-    for (int i = 0; i < listSize; i++) {
-        j = i;
-        while ((j > 0) && (sortedList.at(j - 1).parentName.compare(sortedList.at(j).parentName) > 0)) {
-            bufferAttInfos = sortedList.at(j);
-            sortedList.replace(j, sortedList.at(j - 1));
-            sortedList.replace(j - 1, bufferAttInfos);
-            j = j - 1;
+void DocGenerator::fillSubAttTables_Rec(
+    QString parentName, const QList<T_DocRow> &rows, QMap<QString, QList<T_DocRow>> &tables) {
+    for (const T_DocRow &docRow : rows) {
+        // Attributes sharing a parent name go in the same table
+        tables[parentName].append(docRow);
+        if (docRow.subRows.size() > 0) {
+            this->fillSubAttTables_Rec(docRow.name, docRow.subRows, tables);
         }
     }
-    return sortedList;
 }
 
-QList<Attribute::T_attInfos> DocGenerator::removeCommandAttributes(
-    QList<Attribute::T_attInfos> attInfosList, QList<Command *> cmdList) {
-    QList<Attribute::T_attInfos> trimmedAttInfosList = QList<Attribute::T_attInfos>();
+DocGenerator::T_DocModel DocGenerator::buildDocModel(
+    QString protocolName, QString protocolId, QString protocolDesc, QList<Command *> cmdList) {
+    LCSF_PROFILE_SCOPE("DocGenerator::buildDocModel", "analyze");
+    T_DocModel model;
+    QMap<QString, QList<T_DocRow>> subAttTables;
 
-    for (Attribute::T_attInfos attInfo : attInfosList) {
-        // If attribute doesn't have command as parent
-        if (Command::findCmdAddr(attInfo.parentName, cmdList) == nullptr) {
-            trimmedAttInfosList.append(attInfo);
+    model.protocolName = protocolName;
+    model.protocolId = protocolId;
+    model.protocolDesc = protocolDesc;
+    for (Command *command : cmdList) {
+        T_DocCmd docCmd;
+        docCmd.name = command->getName();
+        docCmd.id = this->getDocId(command->getId());
+        docCmd.direction = NS_DirectionType::SL_DirectionType[command->getDirection()];
+        docCmd.desc = command->getDesc();
+        if (command->getHasAtt() && (command->getAttArray().size() > 0)) {
+            for (Attribute *attribute : command->getAttArray()) {
+                T_DocRow docRow = this->getDocRow_Rec(attribute);
+                if (docRow.subRows.size() > 0) {
+                    this->fillSubAttTables_Rec(docRow.name, docRow.subRows, subAttTables);
+                }
+                docCmd.attRows.append(docRow);
+            }
         }
+        model.commands.append(docCmd);
     }
-    return trimmedAttInfosList;
-}
-
-void DocGenerator::generateWikiTable(
-    QString protocolName, QString protocolId, QString protocolDesc, QList<Command *> cmdList, QString dirPath) {
-    QDir dir(dirPath);
-    if (!dir.exists()) {
-        dir.mkpath(".");
+    // Sub-attribute tables are sorted by parent name, those named like a command are left out
+    QHash<QString, Command *> cmdNameIndex = Command::getNameIndex(cmdList);
+    for (auto it = subAttTables.constBegin(); it != subAttTables.constEnd(); ++it) {
+        if (!cmdNameIndex.contains(it.key())) {
+            model.subAttTables.append({it.key(), it.value()});
+        }
     }
-    QString fileName = dirPath + "/LCSF_" + protocolName + "_WikiTables.txt";
-    QFile saveFile(fileName);
-    QFileInfo fileInfo(saveFile);
-
-    if (saveFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-        QTextStream out(&saveFile);
+    return model;
+}
 
-        // Main table
-        out << "=== " << protocolName << " protocol ===" << Qt::endl;
-        out << Qt::endl;
-        out << protocolDesc << Qt::endl;
-        out << Qt::endl;
-        out << "Protocol id: " << protocolId << Qt::endl;
-        out << Qt::endl;
-        out << "==== Commands table ====" << Qt::endl;
-        out << Qt::endl;
-        out << "{| class=\"wikitable sortable\"" << Qt::endl;
-        out << "|-" << Qt::endl;
-        out << "! Name !! Id !! Direction !! Description !! Attribute(s) Name !! Attribute(s) Id !! Optional? !! Data type !! Attribute Desc"
-            << Qt::endl;
-        out << "|-" << Qt::endl;
-
-        for (Command *command : cmdList) {
-            if ((command->getHasAtt()) && (command->getAttArray().size() > 0)) {
-                bool isFirtAttribute = true;
-                int attNb = command->getAttArray().size();
-                out << "| rowspan=\"" << attNb << "\" | " << command->getName() << " || rowspan=\"" << attNb << "\" | '''"
-                    << QString::number(command->getId(), 16).rightJustified(2, '0').prepend("0x") << "''' || rowspan=\""
-                    << attNb << "\" | " << NS_DirectionType::SL_DirectionType[command->getDirection()] << " || rowspan=\""
-                    << attNb << "\" | " << command->getDesc() << " || ";
-                for (Attribute *attribute : command->getAttArray()) {
-                    if (isFirtAttribute) {
-                        isFirtAttribute = false;
-                        out << attribute->getName() << " || '''"
-                            << QString::number(attribute->getId(), 16).rightJustified(2, '0').prepend("0x") << "''' || "
-                            << ((attribute->getIsOptional()) ? "Yes" : "No") << " || '''"
-                            << NS_AttDataType::SL_DocAttDataType[attribute->getDataType()] << "''' || "
-                            << attribute->getDesc() << Qt::endl;
-                        out << "|-" << Qt::endl;
-                    } else {
-                        out << "| " << attribute->getName() << " || '''"
-                            << QString::number(attribute->getId(), 16).rightJustified(2, '0').prepend("0x") << "''' || "
-                            << ((attribute->getIsOptional()) ? "Yes" : "No") << " || '''"
-                            << NS_AttDataType::SL_DocAttDataType[attribute->getDataType()] << "''' || "
-                            << attribute->getDesc() << Qt::endl;
-                        out << "|-" << Qt::endl;
-                    }
+void DocGenerator::renderWikiTable(const T_DocModel &model, QTextStream *pOut) {
+    LCSF_PROFILE_SCOPE("DocGenerator::renderWikiTable", "emit");
+
+    // Main table
+    *pOut << "=== " << model.protocolName << " protocol ===" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << model.protocolDesc << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "Protocol id: " << model.protocolId << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "==== Commands table ====" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "{| class=\"wikitable sortable\"" << Qt::endl;
+    *pOut << "|-" << Qt::endl;
+    *pOut << "! Name !! Id !! Direction !! Description !! Attribute(s) Name !! Attribute(s) Id !! Optional? !! Data type !! Attribute Desc"
+          << Qt::endl;
+    *pOut << "|-" << Qt::endl;
+
+    for (const T_DocCmd &docCmd : model.commands) {
+        if (docCmd.attRows.size() > 0) {
+            bool isFirtAttribute = true;
+            int attNb = docCmd.attRows.size();
+            *pOut << "| rowspan=\"" << attNb << "\" | " << docCmd.name << " || rowspan=\"" << attNb << "\" | '''"
+                  << docCmd.id << "''' || rowspan=\"" << attNb << "\" | " << docCmd.direction << " || rowspan=\"" << attNb
+                  << "\" | " << docCmd.desc << " || ";
+            for (const T_DocRow &docRow : docCmd.attRows) {
+                if (isFirtAttribute) {
+                    isFirtAttribute = false;
+                } else {
+                    *pOut << "| ";
                 }
-            } else {
-                out << "| " << command->getName() << " || '''"
-                    << QString::number(command->getId(), 16).rightJustified(2, '0').prepend("0x") << "''' || "
-                    << NS_DirectionType::SL_DirectionType[command->getDirection()] << " || " << command->getDesc()
-                    << " || || || || || " << Qt::endl;
-                out << "|-" << Qt::endl;
+                *pOut << docRow.name << " || '''" << docRow.id << "''' || " << docRow.isOptional << " || '''"
+                      << docRow.dataType << "''' || " << docRow.desc << Qt::endl;
+                *pOut << "|-" << Qt::endl;
             }
+        } else {
+            *pOut << "| " << docCmd.name << " || '''" << docCmd.id << "''' || " << docCmd.direction << " || "
+                  << docCmd.desc << " || || || || || " << Qt::endl;
+            *pOut << "|-" << Qt::endl;
+        }
+    }
+    *pOut << "|}" << Qt::endl;
+    *pOut << Qt::endl;
+
+    // Secondary tables
+    for (const T_DocTable &docTable : model.subAttTables) {
+        *pOut << "==== " << docTable.parentName << " sub-attributes table ====" << Qt::endl;
+        *pOut << Qt::endl;
+        *pOut << "{| class=\"wikitable sortable\"" << Qt::endl;
+        *pOut << "|-" << Qt::endl;
+        *pOut << "! Name !! Id !! Optional? !! Data type !! Description" << Qt::endl;
+        *pOut << "|-" << Qt::endl;
+        for (const T_DocRow &docRow : docTable.rows) {
+            *pOut << "| " << docRow.name << " || '''" << docRow.id << "''' || " << docRow.isOptional << " || '''"
+                  << docRow.dataType << "''' || " << docRow.desc << Qt::endl;
+            *pOut << "|-" << Qt::endl;
         }
-        out << "|}" << Qt::endl;
-        out << Qt::endl;
-
-        // Secondary tables
-        QList<Attribute::T_attInfos> attInfosList = this->getAttInfos(cmdList);
-        QList<Attribute::T_attInfos> sortedAttInfosList = this->insertSortAttInfosListByParentName(attInfosList);
-        QList<Attribute::T_attInfos> trimmedAttInfosList = this->removeCommandAttributes(sortedAttInfosList, cmdList);
-
-        for (int idx = 0; idx < trimmedAttInfosList.size(); idx++) {
-            Attribute::T_attInfos currentAttInfo = trimmedAttInfosList.at(idx);
-            QString previousParentName = currentAttInfo.parentName;
-
-            out << "==== " << previousParentName << " sub-attributes table ====" << Qt::endl;
-            out << Qt::endl;
-            out << "{| class=\"wikitable sortable\"" << Qt::endl;
-            out << "|-" << Qt::endl;
-            out << "! Name !! Id !! Optional? !! Data type !! Description" << Qt::endl;
-            out << "|-" << Qt::endl;
-            out << "| " << currentAttInfo.attName << " || '''"
-                << QString::number(currentAttInfo.attId, 16).rightJustified(2, '0').prepend("0x") << "''' || "
-                << ((currentAttInfo.isOptional) ? "Yes" : "No") << " || '''"
-                << NS_AttDataType::SL_DocAttDataType[currentAttInfo.dataType] << "''' || " << currentAttInfo.attDesc
-                << Qt::endl;
-            out << "|-" << Qt::endl;
-
-            if (idx < trimmedAttInfosList.size() - 1) {
-                currentAttInfo = trimmedAttInfosList.at(idx + 1);
-
-                while (currentAttInfo.parentName.compare(previousParentName) == 0) {
-                    out << "| " << currentAttInfo.attName << " || '''"
-                        << QString::number(currentAttInfo.attId, 16).rightJustified(2, '0').prepend("0x") << "''' || "
-                        << ((currentAttInfo.isOptional) ? "Yes" : "No") << " || '''"
-                        << NS_AttDataType::SL_DocAttDataType[currentAttInfo.dataType] << "''' || " << currentAttInfo.attDesc
-                        << Qt::endl;
-                    out << "|-" << Qt::endl;
-                    previousParentName = currentAttInfo.parentName;
-                    idx++;
-
-                    if (idx < trimmedAttInfosList.size() - 1) {
-                        currentAttInfo = trimmedAttInfosList.at(idx + 1);
-                    } else {
-                        break;
-                    }
+        *pOut << "|}" << Qt::endl;
+        *pOut << Qt::endl;
+    }
+}
+
+void DocGenerator::renderDokuWikiTable(const T_DocModel &model, QTextStream *pOut) {
+    LCSF_PROFILE_SCOPE("DocGenerator::renderDokuWikiTable", "emit");
+
+    // Main table
+    *pOut << "=== " << model.protocolName << " protocol ===" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << model.protocolDesc << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "Protocol id: " << model.protocolId << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "== Commands table ==" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "^ Name ^ Id ^ Direction ^ Description ^ Attribute(s) Name ^ Attribute(s) Id ^ Optional? ^ Data type ^ Attribute Desc ^"
+          << Qt::endl;
+
+    for (const T_DocCmd &docCmd : model.commands) {
+        if (docCmd.attRows.size() > 0) {
+            bool isFirtAttribute = true;
+            *pOut << "| " << docCmd.name << " | " << docCmd.id << " | " << docCmd.direction << " | " << docCmd.desc
+                  << " | ";
+            for (const T_DocRow &docRow : docCmd.attRows) {
+                if (isFirtAttribute) {
+                    isFirtAttribute = false;
+                } else {
+                    *pOut << "| ::: | ::: | ::: | ::: " << "| ";
                 }
+                *pOut << docRow.name << " | " << docRow.id << " | " << docRow.isOptional << " | " << docRow.dataType
+                      << " | " << docRow.desc << " |" << Qt::endl;
             }
-            out << "|}" << Qt::endl;
-            out << Qt::endl;
+        } else {
+            *pOut << "| " << docCmd.name << " | " << docCmd.id << " | " << docCmd.direction << " | " << docCmd.desc
+                  << " | | | | | " << Qt::endl;
         }
-        saveFile.close();
+    }
+    *pOut << Qt::endl;
+
+    // Secondary tables
+    for (const T_DocTable &docTable : model.subAttTables) {
+        *pOut << "== " << docTable.parentName << " sub-attributes table ==" << Qt::endl;
+        *pOut << Qt::endl;
+        *pOut << "^ Name ^ Id ^ Optional? ^ Data type ^ Description ^" << Qt::endl;
+        for (const T_DocRow &docRow : docTable.rows) {
+            *pOut << "| " << docRow.name << " | " << docRow.id << " | " << docRow.isOptional << " | " << docRow.dataType
+                  << " | " << docRow.desc << " |" << Qt::endl;
+        }
+        *pOut << Qt::endl;
     }
 }
 
-void DocGenerator::generateDokuWikiTable(
-    QString protocolName, QString protocolId, QString protocolDesc, QList<Command *> cmdList, QString dirPath) {
-    QDir dir(dirPath);
-    if (!dir.exists()) {
-        dir.mkpath(".");
+void DocGenerator::renderMkdownTable(const T_DocModel &model, QTextStream *pOut) {
+    LCSF_PROFILE_SCOPE("DocGenerator::renderMkdownTable", "emit");
+
+    // Main table
+    *pOut << "# " << model.protocolName << " protocol" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << model.protocolDesc << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "Protocol id: `" << model.protocolId << "`" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "## Commands table" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "| Name | Id | Direction | Description | Attributes? |" << Qt::endl;
+    *pOut << "|:----:|:--:|:---------:|:-----------:|:------------:|" << Qt::endl;
+    for (const T_DocCmd &docCmd : model.commands) {
+        *pOut << "| " << docCmd.name << " | `" << docCmd.id << "` | `" << docCmd.direction << "` | " << docCmd.desc
+              << " | " << ((docCmd.attRows.size() > 0) ? "Yes" : "No") << " |" << Qt::endl;
     }
-    QString fileName = dirPath + "/LCSF_" + protocolName + "_DokuWikiTables.txt";
-    QFile saveFile(fileName);
-    QFileInfo fileInfo(saveFile);
+    *pOut << Qt::endl;
+    // Command tables
+    for (const T_DocCmd &docCmd : model.commands) {
+        if (docCmd.attRows.size() == 0) {
+            continue;
+        }
+        *pOut << "## " << docCmd.name << " attributes table" << Qt::endl;
+        *pOut << Qt::endl;
+        *pOut << "| Name | Id | Optional? | Data type | Attribute Description |" << Qt::endl;
+        *pOut << "|:----:|:--:|:----------:|:---------:|:---------------------:|" << Qt::endl;
+        for (const T_DocRow &docRow : docCmd.attRows) {
+            *pOut << "| " << docRow.name << " | `" << docRow.id << "` | " << docRow.isOptional << " | `"
+                  << docRow.dataType << "` | " << docRow.desc << " |" << Qt::endl;
+        }
+        *pOut << Qt::endl;
+    }
+    // Attribute tables
+    for (const T_DocTable &docTable : model.subAttTables) {
+        *pOut << "## " << docTable.parentName << " sub-attributes table" << Qt::endl;
+        *pOut << Qt::endl;
+        *pOut << "| Name | Id | Optional? | Data type | Description |" << Qt::endl;
+        *pOut << "|:----:|:--:|:----------:|:---------:|:-----------:|" << Qt::endl;
+        for (const T_DocRow &docRow : docTable.rows) {
+            *pOut << "| " << docRow.name << " | `" << docRow.id << "` | " << docRow.isOptional << " | `"
+                  << docRow.dataType << "` | " << docRow.desc << Qt::endl;
+        }
+        *pOut << Qt::endl;
+    }
+}
 
-    if (saveFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-        QTextStream out(&saveFile);
+void DocGenerator::renderHtmlHead(QString title, bool hasSearch, QTextStream *pOut) {
+    *pOut << "<!DOCTYPE html>" << Qt::endl;
+    *pOut << "<html lang=\"en\">" << Qt::endl;
+    *pOut << "<head>" << Qt::endl;
+    *pOut << "<meta charset=\"utf-8\">" << Qt::endl;
+    *pOut << "<title>" << title.toHtmlEscaped() << "</title>" << Qt::endl;
+    *pOut << "<link rel=\"stylesheet\" href=\"lcsf_doc.css\">" << Qt::endl;
+    // The index is a script and not a fetched json so the pages work from the file system
+    if (hasSearch) {
+        *pOut << "<script src=\"lcsf_index.js\"></script>" << Qt::endl;
+    }
+    *pOut << "<script src=\"lcsf_doc.js\"></script>" << Qt::endl;
+    *pOut << "</head>" << Qt::endl;
+    *pOut << "<body>" << Qt::endl;
+}
 
-        // Main table
-        out << "=== " << protocolName << " protocol ===" << Qt::endl;
-        out << Qt::endl;
-        out << protocolDesc << Qt::endl;
-        out << Qt::endl;
-        out << "Protocol id: " << protocolId << Qt::endl;
-        out << Qt::endl;
-        out << "== Commands table ==" << Qt::endl;
-        out << Qt::endl;
-        out << "^ Name ^ Id ^ Direction ^ Description ^ Attribute(s) Name ^ Attribute(s) Id ^ Optional? ^ Data type ^ Attribute Desc ^"
-            << Qt::endl;
-
-        for (Command *command : cmdList) {
-            if ((command->getHasAtt()) && (command->getAttArray().size() > 0)) {
-                bool isFirtAttribute = true;
-                int attNb = command->getAttArray().size();
-                out << "| " << command->getName() << " | "
-                    << QString::number(command->getId(), 16).rightJustified(2, '0').prepend("0x") << " | "
-                    << NS_DirectionType::SL_DirectionType[command->getDirection()] << " | " << command->getDesc() << " | ";
-                for (Attribute *attribute : command->getAttArray()) {
-                    if (isFirtAttribute) {
-                        isFirtAttribute = false;
-                        out << attribute->getName() << " | "
-                            << QString::number(attribute->getId(), 16).rightJustified(2, '0').prepend("0x") << " | "
-                            << ((attribute->getIsOptional()) ? "Yes" : "No") << " | "
-                            << NS_AttDataType::SL_DocAttDataType[attribute->getDataType()] << " | " << attribute->getDesc()
-                            << " |" << Qt::endl;
-                    } else {
-                        out << "| ::: | ::: | ::: | ::: " << "| " << attribute->getName() << " | "
-                            << QString::number(attribute->getId(), 16).rightJustified(2, '0').prepend("0x") << " | "
-                            << ((attribute->getIsOptional()) ? "Yes" : "No") << " | "
-                            << NS_AttDataType::SL_DocAttDataType[attribute->getDataType()] << " | " << attribute->getDesc()
-                            << " |" << Qt::endl;
-                    }
-                }
-            } else {
-                out << "| " << command->getName() << " | "
-                    << QString::number(command->getId(), 16).rightJustified(2, '0').prepend("0x") << " | "
-                    << NS_DirectionType::SL_DirectionType[command->getDirection()] << " | " << command->getDesc()
-                    << " | | | | | " << Qt::endl;
-            }
+void DocGenerator::renderHtmlTree_Rec(QString parentPath, const QList<T_DocRow> &rows, QTextStream *pOut) {
+    *pOut << "<ul class=\"tree\">" << Qt::endl;
+    for (const T_DocRow &docRow : rows) {
+        QString path = parentPath.isEmpty() ? docRow.name : parentPath + "." + docRow.name;
+        QString rowLine = "<b>" + docRow.name.toHtmlEscaped() + "</b> <code>" + docRow.id + "</code> <i>" +
+            docRow.dataType + "</i>" + ((docRow.isOptional == "Yes") ? " (optional)" : "") + " " +
+            docRow.desc.toHtmlEscaped();
+
+        if (docRow.subRows.size() > 0) {
+            // Sub-attributes stay in an inert template until the node is opened
+            *pOut << "<li><details id=\"" << path.toHtmlEscaped() << "\"><summary>" << rowLine << "</summary>"
+                  << Qt::endl;
+            *pOut << "<template>" << Qt::endl;
+            this->renderHtmlTree_Rec(path, docRow.subRows, pOut);
+            *pOut << "</template>" << Qt::endl;
+            *pOut << "</details></li>" << Qt::endl;
+        } else {
+            *pOut << "<li id=\"" << path.toHtmlEscaped() << "\">" << rowLine << "</li>" << Qt::endl;
         }
-        out << Qt::endl;
-
-        // Secondary tables
-        QList<Attribute::T_attInfos> attInfosList = this->getAttInfos(cmdList);
-        QList<Attribute::T_attInfos> sortedAttInfosList = this->insertSortAttInfosListByParentName(attInfosList);
-        QList<Attribute::T_attInfos> trimmedAttInfosList = this->removeCommandAttributes(sortedAttInfosList, cmdList);
-
-        for (int idx = 0; idx < trimmedAttInfosList.size(); idx++) {
-            Attribute::T_attInfos currentAttInfo = trimmedAttInfosList.at(idx);
-            QString previousParentName = currentAttInfo.parentName;
-
-            out << "== " << previousParentName << " sub-attributes table ==" << Qt::endl;
-            out << Qt::endl;
-            out << "^ Name ^ Id ^ Optional? ^ Data type ^ Description ^" << Qt::endl;
-            out << "| " << currentAttInfo.attName << " | "
-                << QString::number(currentAttInfo.attId, 16).rightJustified(2, '0').prepend("0x") << " | "
-                << ((currentAttInfo.isOptional) ? "Yes" : "No") << " | "
-                << NS_AttDataType::SL_DocAttDataType[currentAttInfo.dataType] << " | " << currentAttInfo.attDesc << " |"
-                << Qt::endl;
-
-            if (idx < trimmedAttInfosList.size() - 1) {
-                currentAttInfo = trimmedAttInfosList.at(idx + 1);
-
-                while (currentAttInfo.parentName.compare(previousParentName) == 0) {
-                    out << "| " << currentAttInfo.attName << " | "
-                        << QString::number(currentAttInfo.attId, 16).rightJustified(2, '0').prepend("0x") << " | "
-                        << ((currentAttInfo.isOptional) ? "Yes" : "No") << " | "
-                        << NS_AttDataType::SL_DocAttDataType[currentAttInfo.dataType] << " | " << currentAttInfo.attDesc
-                        << " |" << Qt::endl;
-                    previousParentName = currentAttInfo.parentName;
-                    idx++;
-
-                    if (idx < trimmedAttInfosList.size() - 1) {
-                        currentAttInfo = trimmedAttInfosList.at(idx + 1);
-                    } else {
-                        break;
-                    }
-                }
-            }
-            out << Qt::endl;
+    }
+    *pOut << "</ul>" << Qt::endl;
+}
+
+void DocGenerator::renderHtmlIndex(const T_DocModel &model, QTextStream *pOut) {
+    LCSF_PROFILE_SCOPE("DocGenerator::renderHtmlIndex", "emit");
+
+    this->renderHtmlHead(model.protocolName + " protocol", true, pOut);
+    *pOut << "<h1>" << model.protocolName.toHtmlEscaped() << " protocol</h1>" << Qt::endl;
+    *pOut << "<p>" << model.protocolDesc.toHtmlEscaped() << "</p>" << Qt::endl;
+    *pOut << "<p>Protocol id: <code>" << model.protocolId.toHtmlEscaped() << "</code></p>" << Qt::endl;
+    *pOut << "<input id=\"search\" type=\"search\" placeholder=\"Search names, ids and descriptions\" "
+          << "oninput=\"lcsfSearch(this.value)\">" << Qt::endl;
+    *pOut << "<ul id=\"results\"></ul>" << Qt::endl;
+    *pOut << "<h2>Commands table</h2>" << Qt::endl;
+    *pOut << "<table>" << Qt::endl;
+    *pOut << "<tr><th>Name</th><th>Id</th><th>Direction</th><th>Description</th><th>Attributes?</th></tr>"
+          << Qt::endl;
+    for (const T_DocCmd &docCmd : model.commands) {
+        *pOut << "<tr><td><a href=\"cmd_" << docCmd.name << ".html\">" << docCmd.name.toHtmlEscaped()
+              << "</a></td><td><code>" << docCmd.id << "</code></td><td>" << docCmd.direction << "</td><td>"
+              << docCmd.desc.toHtmlEscaped() << "</td><td>" << ((docCmd.attRows.size() > 0) ? "Yes" : "No")
+              << "</td></tr>" << Qt::endl;
+    }
+    *pOut << "</table>" << Qt::endl;
+    *pOut << "</body>" << Qt::endl;
+    *pOut << "</html>" << Qt::endl;
+}
+
+void DocGenerator::renderHtmlCommand(const T_DocModel &model, const T_DocCmd &docCmd, QTextStream *pOut) {
+    this->renderHtmlHead(model.protocolName + " - " + docCmd.name, false, pOut);
+    *pOut << "<h1><a href=\"index.html\">" << model.protocolName.toHtmlEscaped() << "</a> / "
+          << docCmd.name.toHtmlEscaped() << "</h1>" << Qt::endl;
+    *pOut << "<p>" << docCmd.desc.toHtmlEscaped() << "</p>" << Qt::endl;
+    *pOut << "<p>Command id: <code>" << docCmd.id << "</code>, direction: " << docCmd.direction << "</p>"
+          << Qt::endl;
+    if (docCmd.attRows.size() > 0) {
+        *pOut << "<h2>Attributes</h2>" << Qt::endl;
+        this->renderHtmlTree_Rec("", docCmd.attRows, pOut);
+    }
+    *pOut << "</body>" << Qt::endl;
+    *pOut << "</html>" << Qt::endl;
+}
+
+static void fillSearchIndex_Rec(QString parentPath, int pageIdx, const QList<DocGenerator::T_DocRow> &rows,
+    QJsonArray &entries) {
+    for (const DocGenerator::T_DocRow &docRow : rows) {
+        QString path = parentPath.isEmpty() ? docRow.name : parentPath + "." + docRow.name;
+        entries.append(QJsonArray({docRow.name, docRow.id, docRow.desc, pageIdx, path}));
+        fillSearchIndex_Rec(path, pageIdx, docRow.subRows, entries);
+    }
+}
+
+void DocGenerator::renderHtmlSearchIndex(const T_DocModel &model, QTextStream *pOut) {
+    LCSF_PROFILE_SCOPE("DocGenerator::renderHtmlSearchIndex", "emit");
+    QJsonArray pages;
+    QJsonArray entries;
+
+    // Entries are [name, id, description, page index, anchor], commands have no anchor
+    for (int pageIdx = 0; pageIdx < model.commands.size(); pageIdx++) {
+        const T_DocCmd &docCmd = model.commands.at(pageIdx);
+        pages.append(docCmd.name);
+        entries.append(QJsonArray({docCmd.name, docCmd.id, docCmd.desc, pageIdx, ""}));
+        fillSearchIndex_Rec("", pageIdx, docCmd.attRows, entries);
+    }
+    QJsonObject index;
+    index.insert("pages", pages);
+    index.insert("entries", entries);
+    *pOut << "var LCSF_INDEX = " << QJsonDocument(index).toJson(QJsonDocument::Compact) << ";" << Qt::endl;
+}
+
+void DocGenerator::renderHtmlScript(QTextStream *pOut) {
+    *pOut << "function lcsfExpand(node) {" << Qt::endl;
+    *pOut << "    var tpl = node.querySelector(\":scope > template\");" << Qt::endl;
+    *pOut << "    if (tpl) {" << Qt::endl;
+    *pOut << "        node.appendChild(tpl.content.cloneNode(true));" << Qt::endl;
+    *pOut << "        tpl.remove();" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "function lcsfReveal() {" << Qt::endl;
+    *pOut << "    var path = decodeURIComponent(location.hash.substring(1)).split(\".\");" << Qt::endl;
+    *pOut << "    for (var idx = 1; idx <= path.length; idx++) {" << Qt::endl;
+    *pOut << "        var node = document.getElementById(path.slice(0, idx).join(\".\"));" << Qt::endl;
+    *pOut << "        if (!node) {" << Qt::endl;
+    *pOut << "            return;" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "        if (node.tagName === \"DETAILS\") {" << Qt::endl;
+    *pOut << "            lcsfExpand(node);" << Qt::endl;
+    *pOut << "            node.open = true;" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "        if (idx === path.length) {" << Qt::endl;
+    *pOut << "            node.scrollIntoView();" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "function lcsfSearch(query) {" << Qt::endl;
+    *pOut << "    var results = document.getElementById(\"results\");" << Qt::endl;
+    *pOut << "    var words = query.toLowerCase().split(/\\s+/).filter(Boolean);" << Qt::endl;
+    *pOut << "    var count = 0;" << Qt::endl;
+    *pOut << "    results.textContent = \"\";" << Qt::endl;
+    *pOut << "    if (!LCSF_INDEX.keys) {" << Qt::endl;
+    *pOut << "        LCSF_INDEX.keys = LCSF_INDEX.entries.map(function (e) {" << Qt::endl;
+    *pOut << "            return (e[0] + \" \" + e[1] + \" \" + e[2]).toLowerCase();" << Qt::endl;
+    *pOut << "        });" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << "    for (var idx = 0; (idx < LCSF_INDEX.entries.length) && (words.length > 0) && (count < 50); idx++) {"
+          << Qt::endl;
+    *pOut << "        var key = LCSF_INDEX.keys[idx];" << Qt::endl;
+    *pOut << "        if (!words.every(function (w) { return key.indexOf(w) >= 0; })) {" << Qt::endl;
+    *pOut << "            continue;" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "        var entry = LCSF_INDEX.entries[idx];" << Qt::endl;
+    *pOut << "        var page = LCSF_INDEX.pages[entry[3]];" << Qt::endl;
+    *pOut << "        var link = document.createElement(\"a\");" << Qt::endl;
+    *pOut << "        link.href = \"cmd_\" + page + \".html\" + (entry[4] ? \"#\" + entry[4] : \"\");" << Qt::endl;
+    *pOut << "        link.textContent = (entry[4] ? page + \".\" + entry[4] : page) + \" (\" + entry[1] + \")\";"
+          << Qt::endl;
+    *pOut << "        var item = document.createElement(\"li\");" << Qt::endl;
+    *pOut << "        item.appendChild(link);" << Qt::endl;
+    *pOut << "        item.appendChild(document.createTextNode(\" \" + entry[2]));" << Qt::endl;
+    *pOut << "        results.appendChild(item);" << Qt::endl;
+    *pOut << "        count++;" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "document.addEventListener(\"toggle\", function (evt) {" << Qt::endl;
+    *pOut << "    if (evt.target.open) {" << Qt::endl;
+    *pOut << "        lcsfExpand(evt.target);" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << "}, true);" << Qt::endl;
+    *pOut << "window.addEventListener(\"hashchange\", lcsfReveal);" << Qt::endl;
+    *pOut << "window.addEventListener(\"DOMContentLoaded\", lcsfReveal);" << Qt::endl;
+}
+
+void DocGenerator::renderHtmlStyle(QTextStream *pOut) {
+    *pOut << "body { font-family: sans-serif; margin: 2em; }" << Qt::endl;
+    *pOut << "table { border-collapse: collapse; }" << Qt::endl;
+    *pOut << "th, td { border: 1px solid #aaa; padding: 0.2em 0.5em; text-align: left; }" << Qt::endl;
+    *pOut << "#search { width: 30em; padding: 0.3em; }" << Qt::endl;
+    *pOut << "ul.tree { list-style: none; padding-left: 1.5em; }" << Qt::endl;
+    *pOut << "ul.tree li { margin: 0.2em 0; }" << Qt::endl;
+    *pOut << "summary { cursor: pointer; }" << Qt::endl;
+}
+
+void DocGenerator::writeHtmlDoc(const T_DocModel &model, QString dirPath) {
+    LCSF_PROFILE_SCOPE("DocGenerator::writeHtmlDoc", "emit");
+    QString htmlPath = dirPath + "/LCSF_" + model.protocolName + "_Html";
+    QDir dir(htmlPath);
+    if (!dir.exists()) {
+        dir.mkpath(".");
+    }
+    // One file per command so a page only holds the attribute tree it shows
+    auto writePage = [htmlPath](QString fileName, std::function<void(QTextStream *)> render) {
+        QFile saveFile(htmlPath + "/" + fileName);
+        if (saveFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            QTextStream out(&saveFile);
+            render(&out);
+            saveFile.close();
+            Profiler::addCounter("Bytes written", saveFile.size());
         }
-        saveFile.close();
+    };
+
+    writePage("index.html", [this, &model](QTextStream *pOut) { this->renderHtmlIndex(model, pOut); });
+    writePage("lcsf_index.js", [this, &model](QTextStream *pOut) { this->renderHtmlSearchIndex(model, pOut); });
+    writePage("lcsf_doc.js", [this](QTextStream *pOut) { this->renderHtmlScript(pOut); });
+    writePage("lcsf_doc.css", [this](QTextStream *pOut) { this->renderHtmlStyle(pOut); });
+    for (const T_DocCmd &docCmd : model.commands) {
+        writePage("cmd_" + docCmd.name + ".html",
+            [this, &model, &docCmd](QTextStream *pOut) { this->renderHtmlCommand(model, docCmd, pOut); });
     }
 }
 
-void DocGenerator::generateMkdownTable(
-    QString protocolName, QString protocolId, QString protocolDesc, QList<Command *> cmdList, QString dirPath) {
+void DocGenerator::writeDocFile(const T_DocModel &model, T_DocFormat format, QString dirPath) {
+    if (format == DOC_HTML) {
+        this->writeHtmlDoc(model, dirPath);
+        return;
+    }
     QDir dir(dirPath);
     if (!dir.exists()) {
         dir.mkpath(".");
     }
-    QString fileName = dirPath + "/LCSF_" + protocolName + "_MkdownTables.md";
+    QString fileName = dirPath + "/LCSF_" + model.protocolName;
+    switch (format) {
+        case DOC_WIKI:
+            fileName.append("_WikiTables.txt");
+            break;
+        case DOC_DOKUWIKI:
+            fileName.append("_DokuWikiTables.txt");
+            break;
+        case DOC_MKDOWN:
+            fileName.append("_MkdownTables.md");
+            break;
+        case DOC_HTML:
+            break;
+    }
     QFile saveFile(fileName);
-    QFileInfo fileInfo(saveFile);
 
     if (saveFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
         QTextStream out(&saveFile);
 
-        // Main table
-        out << "# " << protocolName << " protocol" << Qt::endl;
-        out << Qt::endl;
-        out << protocolDesc << Qt::endl;
-        out << Qt::endl;
-        out << "Protocol id: `" << protocolId << "`" << Qt::endl;
-        out << Qt::endl;
-        out << "## Commands table" << Qt::endl;
-        out << Qt::endl;
-        out << "| Name | Id | Direction | Description | Attributes? |" << Qt::endl;
-        out << "|:----:|:--:|:---------:|:-----------:|:------------:|" << Qt::endl;
-        for (Command *command : cmdList) {
-            out << "| " << command->getName() << " | `"
-                << QString::number(command->getId(), 16).rightJustified(2, '0').prepend("0x") << "` | `"
-                << NS_DirectionType::SL_DirectionType[command->getDirection()] << "` | " << command->getDesc() << " | "
-                << ((command->getHasAtt() && (command->getAttArray().size() > 0)) ? "Yes" : "No") << " |" << Qt::endl;
-        }
-        out << Qt::endl;
-        // Command tables
-        for (Command *command : cmdList) {
-            if (!command->getHasAtt() || (command->getAttArray().size() == 0)) {
-                continue;
-            }
-            out << "## " << command->getName() << " attributes table" << Qt::endl;
-            out << Qt::endl;
-            out << "| Name | Id | Optional? | Data type | Attribute Description |" << Qt::endl;
-            out << "|:----:|:--:|:----------:|:---------:|:---------------------:|" << Qt::endl;
-            for (Attribute *attribute : command->getAttArray()) {
-                out << "| " << attribute->getName() << " | `"
-                    << QString::number(attribute->getId(), 16).rightJustified(2, '0').prepend("0x") << "` | "
-                    << ((attribute->getIsOptional()) ? "Yes" : "No") << " | `"
-                    << NS_AttDataType::SL_DocAttDataType[attribute->getDataType()] << "` | " << attribute->getDesc() << " |"
-                    << Qt::endl;
-            }
-            out << Qt::endl;
-        }
-        // Attribute tables
-        QList<Attribute::T_attInfos> attInfosList = this->getAttInfos(cmdList);
-        QList<Attribute::T_attInfos> sortedAttInfosList = this->insertSortAttInfosListByParentName(attInfosList);
-        QList<Attribute::T_attInfos> trimmedAttInfosList = this->removeCommandAttributes(sortedAttInfosList, cmdList);
-
-        for (int idx = 0; idx < trimmedAttInfosList.size(); idx++) {
-            Attribute::T_attInfos currentAttInfo = trimmedAttInfosList.at(idx);
-            QString previousParentName = currentAttInfo.parentName;
-
-            out << "## " << previousParentName << " sub-attributes table" << Qt::endl;
-            out << Qt::endl;
-            out << "| Name | Id | Optional? | Data type | Description |" << Qt::endl;
-            out << "|:----:|:--:|:----------:|:---------:|:-----------:|" << Qt::endl;
-            out << "| " << currentAttInfo.attName << " | `"
-                << QString::number(currentAttInfo.attId, 16).rightJustified(2, '0').prepend("0x") << "` | "
-                << ((currentAttInfo.isOptional) ? "Yes" : "No") << " | `"
-                << NS_AttDataType::SL_DocAttDataType[currentAttInfo.dataType] << "` | " << currentAttInfo.attDesc
-                << Qt::endl;
-
-            if (idx < trimmedAttInfosList.size() - 1) {
-                currentAttInfo = trimmedAttInfosList.at(idx + 1);
-
-                while (currentAttInfo.parentName.compare(previousParentName) == 0) {
-                    out << "| " << currentAttInfo.attName << " | `"
-                        << QString::number(currentAttInfo.attId, 16).rightJustified(2, '0').prepend("0x") << "` | "
-                        << ((currentAttInfo.isOptional) ? "Yes" : "No") << " | `"
-                        << NS_AttDataType::SL_DocAttDataType[currentAttInfo.dataType] << "` | " << currentAttInfo.attDesc
-                        << Qt::endl;
-                    previousParentName = currentAttInfo.parentName;
-                    idx++;
-
-                    if (idx < trimmedAttInfosList.size() - 1) {
-                        currentAttInfo = trimmedAttInfosList.at(idx + 1);
-                    } else {
-                        break;
-                    }
-                }
-            }
-            out << Qt::endl;
+        switch (format) {
+            case DOC_WIKI:
+                this->renderWikiTable(model, &out);
+                break;
+            case DOC_DOKUWIKI:
+                this->renderDokuWikiTable(model, &out);
+                break;
+            case DOC_MKDOWN:
+                this->renderMkdownTable(model, &out);
+                break;
+            case DOC_HTML:
+                break;
         }
         saveFile.close();
+        Profiler::addCounter("Bytes written", saveFile.size());
+    }
+}
+
+void DocGenerator::generateDoc(const T_DocModel &model, QList<T_DocFormat> formats, QString dirPath) {
+    QList<QFuture<void>> renderFutures;
+
+    // Renderers only read the model, each one writes its own file
+    for (T_DocFormat format : formats) {
+        renderFutures.append(
+            QtConcurrent::run([this, &model, format, dirPath]() { this->writeDocFile(model, format, dirPath); }));
+    }
+    for (QFuture<void> &future : renderFutures) {
+        future.waitForFinished();
     }
 }
+
+void DocGenerator::generateWikiTable(
+    QString protocolName, QString protocolId, QString protocolDesc, QList<Command *> cmdList, QString dirPath) {
+    LCSF_PROFILE_SCOPE("DocGenerator::generateWikiTable", "emit");
+    this->writeDocFile(this->buildDocModel(protocolName, protocolId, protocolDesc, cmdList), DOC_WIKI, dirPath);
+}
+
+void DocGenerator::generateDokuWikiTable(
+    QString protocolName, QString protocolId, QString protocolDesc, QList<Command *> cmdList, QString dirPath) {
+    LCSF_PROFILE_SCOPE("DocGenerator::generateDokuWikiTable", "emit");
+    this->writeDocFile(this->buildDocModel(protocolName, protocolId, protocolDesc, cmdList), DOC_DOKUWIKI, dirPath);
+}
+
+void DocGenerator::generateMkdownTable(
+    QString protocolName, QString protocolId, QString protocolDesc, QList<Command *> cmdList, QString dirPath) {
+    LCSF_PROFILE_SCOPE("DocGenerator::generateMkdownTable", "emit");
+    this->writeDocFile(this->buildDocModel(protocolName, protocolId, protocolDesc, cmdList), DOC_MKDOWN, dirPath);
+}
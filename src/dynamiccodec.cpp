@@ -0,0 +1,593 @@
+/**
+ * \file dynamiccodec.cpp
+ * \brief Runtime LCSF frame codec module
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#include "dynamiccodec.h"
+#include "profiler.h"
+#include <cstring>
+
+// Frame fields of the default and small LCSF representations
+static const int FIELD_SIZE = 2;
+static const int SMALL_FIELD_SIZE = 1;
+
+static const QStringList SL_CodecError = (QStringList() << "ok" << "codec not compiled" << "truncated frame"
+                                                        << "wrong protocol id" << "unknown command" << "unknown attribute"
+                                                        << "duplicated attribute" << "attribute type mismatch"
+                                                        << "wrong data size" << "missing mandatory attribute"
+                                                        << "trailing bytes" << "invalid value");
+
+// Byte width of the unsigned types, 0 for the other types
+static int getUintWidth(NS_AttDataType::T_AttDataType dataType) {
+    switch (dataType) {
+        case NS_AttDataType::UINT8:
+            return 1;
+        case NS_AttDataType::UINT16:
+            return 2;
+        case NS_AttDataType::UINT32:
+            return 4;
+        case NS_AttDataType::UINT64:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+static quint64 readLittleEndian(const uchar *pData, int size) {
+    quint64 value = 0;
+
+    for (int idx = 0; idx < size; idx++) {
+        value |= (quint64)pData[idx] << (8 * idx);
+    }
+    return value;
+}
+
+static void appendLittleEndian(QByteArray &frame, quint64 value, int size) {
+    for (int idx = 0; idx < size; idx++) {
+        frame.append((char)(value >> (8 * idx)));
+    }
+}
+
+// Same size as the GetVLESize of the LCSF stack
+static int getVleSize(quint64 value) {
+    int size = 1;
+
+    while ((value >>= 8) != 0) {
+        size++;
+    }
+    return size;
+}
+
+DynamicCodec::DynamicCodec(void) {
+    this->m_isCompiled = false;
+    this->m_isSmall = false;
+    this->m_protocolId = 0;
+    this->m_minCmdId = 0;
+}
+
+void DynamicCodec::setSmallFields(bool isSmall) {
+    this->m_isSmall = isSmall;
+}
+
+bool DynamicCodec::getSmallFields(void) const {
+    return this->m_isSmall;
+}
+
+int DynamicCodec::getFieldSize(void) const {
+    return (this->m_isSmall) ? SMALL_FIELD_SIZE : FIELD_SIZE;
+}
+
+int DynamicCodec::getFieldMax(void) const {
+    return (1 << (8 * this->getFieldSize())) - 1;
+}
+
+int DynamicCodec::getCmplxFlag(void) const {
+    return 1 << ((8 * this->getFieldSize()) - 1);
+}
+
+int DynamicCodec::compileLevel_Rec(QList<Attribute *> attList) {
+    int levelIdx = this->m_levels.size();
+    T_Level level = {this->m_nodes.size(), attList.size(), 0, 0, this->m_idTable.size(), 0};
+    int maxAttId = -1;
+
+    // Reserve the level nodes first so they stay contiguous
+    this->m_levels.append(level);
+    for (Attribute *attribute : attList) {
+        T_Node node = {attribute->getName(), attribute->getId(), attribute->getDataType(), attribute->getIsOptional(), -1};
+
+        if ((node.attId < 0) || (node.attId >= this->getCmplxFlag())) {
+            return -1;
+        }
+        if ((maxAttId < 0) || (node.attId < level.minAttId)) {
+            level.minAttId = node.attId;
+        }
+        maxAttId = qMax(maxAttId, (int)node.attId);
+        if (!node.isOptional) {
+            level.mandatoryNb++;
+        }
+        this->m_nodes.append(node);
+    }
+    // Dense id table, slot of each attribute id of the level
+    level.idTableSize = (maxAttId < 0) ? 0 : (maxAttId - level.minAttId + 1);
+    this->m_idTable.insert(this->m_idTable.size(), level.idTableSize, -1);
+    for (int slot = 0; slot < level.nodeNb; slot++) {
+        int tableIdx = level.idTableIdx + this->m_nodes.at(level.firstNodeIdx + slot).attId - level.minAttId;
+
+        if (this->m_idTable.at(tableIdx) >= 0) {
+            return -1;
+        }
+        this->m_idTable[tableIdx] = slot;
+    }
+    this->m_levels[levelIdx] = level;
+    // Sub-attribute levels
+    for (int slot = 0; slot < level.nodeNb; slot++) {
+        Attribute *attribute = attList.at(slot);
+
+        if (attribute->getDataType() != NS_AttDataType::SUB_ATTRIBUTES) {
+            continue;
+        }
+        int subLevelIdx = this->compileLevel_Rec(attribute->getSubAttArray());
+        if (subLevelIdx < 0) {
+            return -1;
+        }
+        this->m_nodes[level.firstNodeIdx + slot].subLevelIdx = subLevelIdx;
+    }
+    return levelIdx;
+}
+
+bool DynamicCodec::compile(quint16 protocolId, QList<Command *> cmdList) {
+    LCSF_PROFILE_SCOPE("DynamicCodec::compile", "codec");
+    int maxCmdId = -1;
+
+    this->m_isCompiled = false;
+    this->m_protocolId = protocolId;
+    this->m_nodes.clear();
+    this->m_levels.clear();
+    this->m_idTable.clear();
+    this->m_cmds.clear();
+    this->m_cmdTable.clear();
+    this->m_minCmdId = 0;
+    if (protocolId > this->getFieldMax()) {
+        return false;
+    }
+    for (Command *command : cmdList) {
+        T_CmdEntry cmdEntry = {command->getName(), command->getId(), -1};
+
+        if ((cmdEntry.cmdId < 0) || (cmdEntry.cmdId > this->getFieldMax())) {
+            return false;
+        }
+        if ((maxCmdId < 0) || (cmdEntry.cmdId < this->m_minCmdId)) {
+            this->m_minCmdId = cmdEntry.cmdId;
+        }
+        maxCmdId = qMax(maxCmdId, (int)cmdEntry.cmdId);
+        cmdEntry.levelIdx = this->compileLevel_Rec(command->getAttArray());
+        if (cmdEntry.levelIdx < 0) {
+            return false;
+        }
+        this->m_cmds.append(cmdEntry);
+    }
+    // Dense command table
+    this->m_cmdTable.fill(-1, (maxCmdId < 0) ? 0 : (maxCmdId - this->m_minCmdId + 1));
+    for (int cmdIdx = 0; cmdIdx < this->m_cmds.size(); cmdIdx++) {
+        int tableIdx = this->m_cmds.at(cmdIdx).cmdId - this->m_minCmdId;
+
+        if (this->m_cmdTable.at(tableIdx) >= 0) {
+            return false;
+        }
+        this->m_cmdTable[tableIdx] = cmdIdx;
+    }
+    Profiler::addCounter("Codec nodes", this->m_nodes.size());
+    this->m_isCompiled = true;
+    return true;
+}
+
+bool DynamicCodec::isCompiled(void) const {
+    return this->m_isCompiled;
+}
+
+quint16 DynamicCodec::getProtocolId(void) const {
+    return this->m_protocolId;
+}
+
+const DynamicCodec::T_Node &DynamicCodec::getNode(int nodeIdx) const {
+    return this->m_nodes.at(nodeIdx);
+}
+
+QString DynamicCodec::getCmdName(short cmdId) const {
+    int tableIdx = cmdId - this->m_minCmdId;
+
+    if ((tableIdx < 0) || (tableIdx >= this->m_cmdTable.size()) || (this->m_cmdTable.at(tableIdx) < 0)) {
+        return QString();
+    }
+    return this->m_cmds.at(this->m_cmdTable.at(tableIdx)).name;
+}
+
+void DynamicCodec::initValues_Rec(int levelIdx, QVector<T_Value> &values) const {
+    const T_Level &level = this->m_levels.at(levelIdx);
+
+    values.resize(level.nodeNb);
+    for (int slot = 0; slot < level.nodeNb; slot++) {
+        T_Value &value = values[slot];
+        const T_Node &node = this->m_nodes.at(level.firstNodeIdx + slot);
+
+        value.nodeIdx = level.firstNodeIdx + slot;
+        value.isPresent = false;
+        value.uintValue = 0;
+        value.realValue = 0.0;
+        value.data.clear();
+        if (node.subLevelIdx >= 0) {
+            this->initValues_Rec(node.subLevelIdx, value.subValues);
+        } else {
+            value.subValues.clear();
+        }
+    }
+}
+
+bool DynamicCodec::initMessage(short cmdId, T_Message &msg) const {
+    int tableIdx = cmdId - this->m_minCmdId;
+
+    if (!this->m_isCompiled || (tableIdx < 0) || (tableIdx >= this->m_cmdTable.size()) ||
+        (this->m_cmdTable.at(tableIdx) < 0)) {
+        return false;
+    }
+    msg.cmdId = cmdId;
+    this->initValues_Rec(this->m_cmds.at(this->m_cmdTable.at(tableIdx)).levelIdx, msg.attValues);
+    return true;
+}
+
+bool DynamicCodec::readField(const uchar *pFrame, int frameSize, int &frameIdx, int &value) const {
+    int fieldSize = this->getFieldSize();
+
+    if ((frameSize - frameIdx) < fieldSize) {
+        return false;
+    }
+    value = (int)readLittleEndian(&(pFrame[frameIdx]), fieldSize);
+    frameIdx += fieldSize;
+    return true;
+}
+
+void DynamicCodec::writeField(QByteArray &frame, int value) const {
+    appendLittleEndian(frame, (quint64)value, this->getFieldSize());
+}
+
+DynamicCodec::T_CodecError DynamicCodec::decodeData(
+    const T_Node &node, const uchar *pData, int dataSize, T_Value &value) const {
+    int uintWidth = getUintWidth(node.dataType);
+
+    if (dataSize == 0) {
+        return CODEC_ERR_DATA_SIZE;
+    }
+    if (uintWidth > 0) {
+        if (dataSize > uintWidth) {
+            return CODEC_ERR_DATA_SIZE;
+        }
+        value.uintValue = readLittleEndian(pData, dataSize);
+        return CODEC_OK;
+    }
+    switch (node.dataType) {
+        case NS_AttDataType::FLOAT32: {
+            quint32 bits;
+            float real;
+
+            if (dataSize != sizeof(real)) {
+                return CODEC_ERR_DATA_SIZE;
+            }
+            bits = (quint32)readLittleEndian(pData, sizeof(bits));
+            std::memcpy(&real, &bits, sizeof(real));
+            value.realValue = real;
+            return CODEC_OK;
+        }
+        case NS_AttDataType::FLOAT64: {
+            quint64 bits;
+
+            if (dataSize != sizeof(value.realValue)) {
+                return CODEC_ERR_DATA_SIZE;
+            }
+            bits = readLittleEndian(pData, sizeof(bits));
+            std::memcpy(&(value.realValue), &bits, sizeof(value.realValue));
+            return CODEC_OK;
+        }
+        case NS_AttDataType::STRING:
+            if (pData[dataSize - 1] != '\0') {
+                return CODEC_ERR_VALUE;
+            }
+            dataSize--;
+            break;
+        case NS_AttDataType::BYTE_ARRAY:
+            break;
+        default:
+            return CODEC_ERR_ATT_TYPE;
+    }
+    // Resizing keeps the storage of the previous frame
+    value.data.resize(dataSize);
+    std::memcpy(value.data.data(), pData, dataSize);
+    return CODEC_OK;
+}
+
+DynamicCodec::T_CodecError DynamicCodec::decodeLevel_Rec(
+    int levelIdx, int attNb, const uchar *pFrame, int frameSize, int &frameIdx, QVector<T_Value> &values) const {
+    const T_Level &level = this->m_levels.at(levelIdx);
+    int cmplxFlag = this->getCmplxFlag();
+    int mandatoryNb = 0;
+
+    if (attNb > level.nodeNb) {
+        return CODEC_ERR_UNKNOWN_ATT;
+    }
+    values.resize(level.nodeNb);
+    for (int slot = 0; slot < level.nodeNb; slot++) {
+        values[slot].nodeIdx = level.firstNodeIdx + slot;
+        values[slot].isPresent = false;
+    }
+    for (int attIdx = 0; attIdx < attNb; attIdx++) {
+        int attId;
+        int dataSize;
+
+        if (!this->readField(pFrame, frameSize, frameIdx, attId) ||
+            !this->readField(pFrame, frameSize, frameIdx, dataSize)) {
+            return CODEC_ERR_FRAME_SIZE;
+        }
+        bool isComplex = (attId & cmplxFlag) != 0;
+        int tableIdx = (attId & ~cmplxFlag) - level.minAttId;
+        if ((tableIdx < 0) || (tableIdx >= level.idTableSize) || (this->m_idTable.at(level.idTableIdx + tableIdx) < 0)) {
+            return CODEC_ERR_UNKNOWN_ATT;
+        }
+        int slot = this->m_idTable.at(level.idTableIdx + tableIdx);
+        const T_Node &node = this->m_nodes.at(level.firstNodeIdx + slot);
+        T_Value &value = values[slot];
+        if (value.isPresent) {
+            return CODEC_ERR_DUPLICATE_ATT;
+        }
+        if (isComplex != (node.subLevelIdx >= 0)) {
+            return CODEC_ERR_ATT_TYPE;
+        }
+        value.isPresent = true;
+        if (!node.isOptional) {
+            mandatoryNb++;
+        }
+        T_CodecError error;
+        if (isComplex) {
+            error = this->decodeLevel_Rec(node.subLevelIdx, dataSize, pFrame, frameSize, frameIdx, value.subValues);
+        } else if ((frameSize - frameIdx) < dataSize) {
+            error = CODEC_ERR_FRAME_SIZE;
+        } else {
+            error = this->decodeData(node, &(pFrame[frameIdx]), dataSize, value);
+            frameIdx += dataSize;
+        }
+        if (error != CODEC_OK) {
+            return error;
+        }
+    }
+    // Every present attribute is distinct, counting the mandatory ones is enough
+    if (mandatoryNb != level.mandatoryNb) {
+        return CODEC_ERR_MISSING_ATT;
+    }
+    return CODEC_OK;
+}
+
+DynamicCodec::T_CodecError DynamicCodec::decode(const uchar *pFrame, int frameSize, T_Message &msg) const {
+    int frameIdx = 0;
+    int protId;
+    int cmdId;
+    int attNb;
+
+    if (!this->m_isCompiled) {
+        return CODEC_ERR_NOT_COMPILED;
+    }
+    if ((pFrame == nullptr) || !this->readField(pFrame, frameSize, frameIdx, protId) ||
+        !this->readField(pFrame, frameSize, frameIdx, cmdId) || !this->readField(pFrame, frameSize, frameIdx, attNb)) {
+        return CODEC_ERR_FRAME_SIZE;
+    }
+    if (protId != this->m_protocolId) {
+        return CODEC_ERR_PROTOCOL_ID;
+    }
+    int tableIdx = cmdId - this->m_minCmdId;
+    if ((tableIdx < 0) || (tableIdx >= this->m_cmdTable.size()) || (this->m_cmdTable.at(tableIdx) < 0)) {
+        return CODEC_ERR_UNKNOWN_CMD;
+    }
+    msg.cmdId = (short)cmdId;
+    T_CodecError error = this->decodeLevel_Rec(
+        this->m_cmds.at(this->m_cmdTable.at(tableIdx)).levelIdx, attNb, pFrame, frameSize, frameIdx, msg.attValues);
+    if (error != CODEC_OK) {
+        return error;
+    }
+    if (frameIdx != frameSize) {
+        return CODEC_ERR_TRAILING_BYTES;
+    }
+    return CODEC_OK;
+}
+
+DynamicCodec::T_CodecError DynamicCodec::decode(const QByteArray &frame, T_Message &msg) const {
+    return this->decode((const uchar *)frame.constData(), frame.size(), msg);
+}
+
+int DynamicCodec::getPresentNb(const QVector<T_Value> &values) const {
+    int presentNb = 0;
+
+    for (const T_Value &value : values) {
+        if (value.isPresent) {
+            presentNb++;
+        }
+    }
+    return presentNb;
+}
+
+DynamicCodec::T_CodecError DynamicCodec::encodeData(const T_Node &node, const T_Value &value, QByteArray &frame) const {
+    int uintWidth = getUintWidth(node.dataType);
+
+    if (uintWidth > 0) {
+        if ((uintWidth < 8) && ((value.uintValue >> (8 * uintWidth)) != 0)) {
+            return CODEC_ERR_VALUE;
+        }
+        int dataSize = getVleSize(value.uintValue);
+        this->writeField(frame, node.attId);
+        this->writeField(frame, dataSize);
+        appendLittleEndian(frame, value.uintValue, dataSize);
+        return CODEC_OK;
+    }
+    switch (node.dataType) {
+        case NS_AttDataType::FLOAT32: {
+            float real = (float)value.realValue;
+            quint32 bits;
+
+            std::memcpy(&bits, &real, sizeof(bits));
+            this->writeField(frame, node.attId);
+            this->writeField(frame, sizeof(bits));
+            appendLittleEndian(frame, bits, sizeof(bits));
+            return CODEC_OK;
+        }
+        case NS_AttDataType::FLOAT64: {
+            quint64 bits;
+
+            std::memcpy(&bits, &(value.realValue), sizeof(bits));
+            this->writeField(frame, node.attId);
+            this->writeField(frame, sizeof(bits));
+            appendLittleEndian(frame, bits, sizeof(bits));
+            return CODEC_OK;
+        }
+        case NS_AttDataType::STRING:
+            if ((value.data.size() + 1) > this->getFieldMax()) {
+                return CODEC_ERR_DATA_SIZE;
+            }
+            this->writeField(frame, node.attId);
+            this->writeField(frame, value.data.size() + 1);
+            frame.append(value.data);
+            frame.append('\0');
+            return CODEC_OK;
+        case NS_AttDataType::BYTE_ARRAY:
+            if ((value.data.size() == 0) || (value.data.size() > this->getFieldMax())) {
+                return CODEC_ERR_DATA_SIZE;
+            }
+            this->writeField(frame, node.attId);
+            this->writeField(frame, value.data.size());
+            frame.append(value.data);
+            return CODEC_OK;
+        default:
+            return CODEC_ERR_ATT_TYPE;
+    }
+}
+
+DynamicCodec::T_CodecError DynamicCodec::encodeLevel_Rec(
+    int levelIdx, const QVector<T_Value> &values, QByteArray &frame) const {
+    const T_Level &level = this->m_levels.at(levelIdx);
+
+    if (values.size() != level.nodeNb) {
+        return CODEC_ERR_VALUE;
+    }
+    for (int slot = 0; slot < level.nodeNb; slot++) {
+        const T_Node &node = this->m_nodes.at(level.firstNodeIdx + slot);
+        const T_Value &value = values.at(slot);
+        T_CodecError error;
+
+        if (!value.isPresent) {
+            if (!node.isOptional) {
+                return CODEC_ERR_MISSING_ATT;
+            }
+            continue;
+        }
+        if (node.subLevelIdx >= 0) {
+            if (value.subValues.size() != this->m_levels.at(node.subLevelIdx).nodeNb) {
+                return CODEC_ERR_VALUE;
+            }
+            this->writeField(frame, node.attId | this->getCmplxFlag());
+            this->writeField(frame, this->getPresentNb(value.subValues));
+            error = this->encodeLevel_Rec(node.subLevelIdx, value.subValues, frame);
+        } else {
+            error = this->encodeData(node, value, frame);
+        }
+        if (error != CODEC_OK) {
+            return error;
+        }
+    }
+    return CODEC_OK;
+}
+
+DynamicCodec::T_CodecError DynamicCodec::encode(const T_Message &msg, QByteArray &frame) const {
+    int tableIdx = msg.cmdId - this->m_minCmdId;
+
+    frame.clear();
+    if (!this->m_isCompiled) {
+        return CODEC_ERR_NOT_COMPILED;
+    }
+    if ((tableIdx < 0) || (tableIdx >= this->m_cmdTable.size()) || (this->m_cmdTable.at(tableIdx) < 0)) {
+        return CODEC_ERR_UNKNOWN_CMD;
+    }
+    this->writeField(frame, this->m_protocolId);
+    this->writeField(frame, msg.cmdId);
+    this->writeField(frame, this->getPresentNb(msg.attValues));
+    T_CodecError error =
+        this->encodeLevel_Rec(this->m_cmds.at(this->m_cmdTable.at(tableIdx)).levelIdx, msg.attValues, frame);
+    if (error != CODEC_OK) {
+        frame.clear();
+    }
+    return error;
+}
+
+void DynamicCodec::formatLevel_Rec(int levelIdx, const QVector<T_Value> &values, QString indent, QStringList &lines) const {
+    const T_Level &level = this->m_levels.at(levelIdx);
+
+    for (int slot = 0; (slot < level.nodeNb) && (slot < values.size()); slot++) {
+        const T_Node &node = this->m_nodes.at(level.firstNodeIdx + slot);
+        const T_Value &value = values.at(slot);
+        QString line = indent + node.name + ": ";
+
+        if (!value.isPresent) {
+            continue;
+        }
+        switch (node.dataType) {
+            case NS_AttDataType::SUB_ATTRIBUTES:
+                lines.append(indent + node.name);
+                this->formatLevel_Rec(node.subLevelIdx, value.subValues, indent + "  ", lines);
+                continue;
+            case NS_AttDataType::FLOAT32:
+            case NS_AttDataType::FLOAT64:
+                line.append(QString::number(value.realValue, 'g', 17));
+                break;
+            case NS_AttDataType::STRING:
+                line.append("\"" + QString::fromLatin1(value.data) + "\"");
+                break;
+            case NS_AttDataType::BYTE_ARRAY:
+                line.append(QString::fromLatin1(value.data.toHex(' ')));
+                break;
+            default:
+                line.append(QString::number(value.uintValue));
+                break;
+        }
+        lines.append(line);
+    }
+}
+
+QString DynamicCodec::formatMessage(const T_Message &msg) const {
+    int tableIdx = msg.cmdId - this->m_minCmdId;
+    QStringList lines;
+
+    if ((tableIdx < 0) || (tableIdx >= this->m_cmdTable.size()) || (this->m_cmdTable.at(tableIdx) < 0)) {
+        return QString();
+    }
+    const T_CmdEntry &cmdEntry = this->m_cmds.at(this->m_cmdTable.at(tableIdx));
+    lines.append(cmdEntry.name + " (" + QString::number(cmdEntry.cmdId) + ")");
+    this->formatLevel_Rec(cmdEntry.levelIdx, msg.attValues, "  ", lines);
+    return lines.join("\n");
+}
+
+QString DynamicCodec::getErrorString(T_CodecError error) {
+    if ((error < 0) || (error >= CODEC_ERR_COUNT)) {
+        return QString();
+    }
+    return SL_CodecError.at(error);
+}
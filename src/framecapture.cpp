@@ -0,0 +1,102 @@
+/**
+ * \file framecapture.cpp
+ * \brief Frame capture file module
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#include <QDataStream>
+#include <QFile>
+#include <cstring>
+
+#include "framecapture.h"
+#include "profiler.h"
+
+static const char CaptureMagic[4] = {'L', 'C', 'A', 'P'};
+
+bool FrameCapture::write(QIODevice *pDevice, const QList<T_Record> &records) {
+    LCSF_PROFILE_SCOPE("FrameCapture::write", "io");
+    QDataStream stream(pDevice);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    stream.writeRawData(CaptureMagic, sizeof(CaptureMagic));
+    stream << VERSION << (quint16)0;
+    for (const T_Record &record : records) {
+        stream << record.timestampUs << record.protocolId << (quint32)record.frame.size();
+        stream.writeRawData(record.frame.constData(), record.frame.size());
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+bool FrameCapture::read(QIODevice *pDevice, QList<T_Record> &records, QString &error) {
+    LCSF_PROFILE_SCOPE("FrameCapture::read", "io");
+    QDataStream stream(pDevice);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    char magic[sizeof(CaptureMagic)];
+    quint16 version = 0;
+    quint16 reserved = 0;
+
+    records.clear();
+    if ((stream.readRawData(magic, sizeof(magic)) != sizeof(magic)) ||
+        (memcmp(magic, CaptureMagic, sizeof(magic)) != 0)) {
+        error = "not a capture file";
+        return false;
+    }
+    stream >> version >> reserved;
+    if ((stream.status() != QDataStream::Ok) || (version != VERSION)) {
+        error = "unsupported capture version " + QString::number(version);
+        return false;
+    }
+    while (!stream.atEnd()) {
+        T_Record record;
+        quint32 frameSize = 0;
+
+        stream >> record.timestampUs >> record.protocolId >> frameSize;
+        // Check the size against what's left before allocating, a corrupted size would be huge
+        if ((stream.status() != QDataStream::Ok) || (frameSize > (quint64)pDevice->bytesAvailable())) {
+            error = "truncated record " + QString::number(records.size());
+            return false;
+        }
+        record.frame.resize(frameSize);
+        stream.readRawData(record.frame.data(), frameSize);
+        records.append(record);
+    }
+    return true;
+}
+
+bool FrameCapture::save(QString filename, const QList<T_Record> &records) {
+    QFile file(filename);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    bool isOk = write(&file, records);
+    file.close();
+    return isOk;
+}
+
+bool FrameCapture::load(QString filename, QList<T_Record> &records, QString &error) {
+    QFile file(filename);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = file.errorString();
+        return false;
+    }
+    bool isOk = read(&file, records, error);
+    file.close();
+    return isOk;
+}
@@ -0,0 +1,174 @@
+/**
+ * \file framereplay.cpp
+ * \brief Capture replay benchmark module
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#include <QElapsedTimer>
+#include <QMap>
+#include <QVector>
+#include <algorithm>
+#include <limits>
+
+#include "framereplay.h"
+#include "profiler.h"
+
+// Empty timed sections measured to calibrate the timer overhead
+static const int TIMER_CALIBRATION_NB = 1000;
+
+// Smallest duration of an empty timed section, the cost of timing a frame
+static qint64 getTimerOverheadNs(void) {
+    QElapsedTimer timer;
+    qint64 overheadNs = std::numeric_limits<qint64>::max();
+
+    for (int idx = 0; idx < TIMER_CALIBRATION_NB; idx++) {
+        timer.start();
+        overheadNs = qMin(overheadNs, timer.nsecsElapsed());
+    }
+    return overheadNs;
+}
+
+// Nearest rank percentile of sorted latencies
+static qint64 getPercentile(const QVector<qint64> &sortedNs, int percent) {
+    int rank = (sortedNs.size() * percent + 99) / 100;
+    return sortedNs.at(qMax(rank, 1) - 1);
+}
+
+static void finishStats(FrameReplay::T_CmdStats &stats, QVector<qint64> &latenciesNs) {
+    if (latenciesNs.isEmpty()) {
+        return;
+    }
+    std::sort(latenciesNs.begin(), latenciesNs.end());
+    stats.p50Ns = getPercentile(latenciesNs, 50);
+    stats.p90Ns = getPercentile(latenciesNs, 90);
+    stats.p99Ns = getPercentile(latenciesNs, 99);
+    stats.maxNs = latenciesNs.last();
+}
+
+FrameReplay::T_Report FrameReplay::run(
+    const QList<FrameCapture::T_Record> &records, quint16 protocolId, int passNb, T_DecodeFn decodeFn) {
+    LCSF_PROFILE_SCOPE("FrameReplay::run", "replay");
+    T_Report report = {passNb, records.size(), 0, 0, 0, 0, 0, {-1, 0, 0, 0, 0, 0, 0, 0}, {}};
+    QMap<int, T_CmdStats> statsMap;
+    QMap<int, QVector<qint64>> latencyMap;
+    QVector<qint64> totalLatencies;
+    QElapsedTimer timer;
+
+    if (!records.isEmpty()) {
+        quint64 firstUs = records.first().timestampUs;
+        quint64 lastUs = records.first().timestampUs;
+        for (const FrameCapture::T_Record &record : records) {
+            firstUs = qMin(firstUs, record.timestampUs);
+            lastUs = qMax(lastUs, record.timestampUs);
+        }
+        report.spanUs = lastUs - firstUs;
+    }
+    // Throughput passes, timed as a whole so the timer stays out of the decode loop
+    timer.start();
+    for (int pass = 0; pass < passNb; pass++) {
+        for (const FrameCapture::T_Record &record : records) {
+            if (record.protocolId == protocolId) {
+                decodeFn((const uchar *)record.frame.constData(), record.frame.size());
+            }
+        }
+    }
+    report.wallNs = timer.nsecsElapsed();
+    // Latency passes, timed per frame minus the timer overhead
+    report.timerOverheadNs = getTimerOverheadNs();
+    for (int pass = 0; pass < passNb; pass++) {
+        for (const FrameCapture::T_Record &record : records) {
+            if (record.protocolId != protocolId) {
+                report.skippedNb += (pass == 0) ? 1 : 0;
+                continue;
+            }
+            timer.start();
+            int cmdId = decodeFn((const uchar *)record.frame.constData(), record.frame.size());
+            qint64 elapsedNs = qMax(timer.nsecsElapsed() - report.timerOverheadNs, (qint64)0);
+
+            if (cmdId < 0) {
+                report.rejectedNb += (pass == 0) ? 1 : 0;
+                continue;
+            }
+            if (!statsMap.contains(cmdId)) {
+                statsMap.insert(cmdId, {cmdId, 0, 0, 0, 0, 0, 0, 0});
+            }
+            T_CmdStats &stats = statsMap[cmdId];
+            stats.frameNb++;
+            stats.byteNb += record.frame.size();
+            stats.totalNs += elapsedNs;
+            latencyMap[cmdId].append(elapsedNs);
+            report.total.frameNb++;
+            report.total.byteNb += record.frame.size();
+            report.total.totalNs += elapsedNs;
+            totalLatencies.append(elapsedNs);
+        }
+    }
+    // Latency percentiles
+    for (auto it = statsMap.begin(); it != statsMap.end(); ++it) {
+        finishStats(it.value(), latencyMap[it.key()]);
+        report.cmdStats.append(it.value());
+    }
+    finishStats(report.total, totalLatencies);
+    Profiler::addCounter("Replayed frames", report.total.frameNb);
+    return report;
+}
+
+QString FrameReplay::formatReport(const T_Report &report, const QList<Command *> &cmdList) {
+    QMap<int, QString> cmdNames;
+    int nameWidth = 7;
+
+    for (Command *pCmd : cmdList) {
+        cmdNames.insert(pCmd->getId(), pCmd->getName());
+        nameWidth = qMax(nameWidth, pCmd->getName().size());
+    }
+    auto formatLine = [nameWidth](QString name, const T_CmdStats &stats) {
+        double rate = (stats.totalNs > 0) ? (stats.frameNb * 1e9 / stats.totalNs) : 0.0;
+        return QString("%1 %2 %3 %4 %5 %6 %7\n")
+            .arg(name, -nameWidth)
+            .arg(stats.frameNb, 8)
+            .arg(stats.p50Ns, 8)
+            .arg(stats.p90Ns, 8)
+            .arg(stats.p99Ns, 8)
+            .arg(stats.maxNs, 8)
+            .arg(rate, 12, 'f', 0);
+    };
+    QString text;
+    text.append(QString("Replayed %1 records over %2 s of capture, %3 passes, %4 skipped (other protocols), %5 rejected\n")
+                    .arg(report.recordNb)
+                    .arg(report.spanUs / 1e6, 0, 'f', 3)
+                    .arg(report.passNb)
+                    .arg(report.skippedNb)
+                    .arg(report.rejectedNb));
+    text.append(QString("Latencies exclude %1 ns of timer overhead\n").arg(report.timerOverheadNs));
+    text.append(QString("%1 %2 %3 %4 %5 %6 %7\n")
+                    .arg(QString("Command"), -nameWidth)
+                    .arg(QString("Frames"), 8)
+                    .arg(QString("p50 ns"), 8)
+                    .arg(QString("p90 ns"), 8)
+                    .arg(QString("p99 ns"), 8)
+                    .arg(QString("max ns"), 8)
+                    .arg(QString("Frames/s"), 12));
+    for (const T_CmdStats &stats : report.cmdStats) {
+        text.append(formatLine(cmdNames.value(stats.cmdId, QString("0x%1").arg(stats.cmdId, 0, 16)), stats));
+    }
+    text.append(formatLine("Total", report.total));
+    double frameRate = (report.wallNs > 0) ? (report.total.frameNb * 1e9 / report.wallNs) : 0.0;
+    double mbRate = (report.wallNs > 0) ? (report.total.byteNb * 1e3 / report.wallNs) : 0.0;
+    text.append(QString("Throughput: %1 frames/s, %2 MB/s\n").arg(frameRate, 0, 'f', 0).arg(mbRate, 0, 'f', 2));
+    return text;
+}
@@ -154,6 +154,7 @@ void MainWindow::loadProtocolFile(const QString &filePath) {
     // Extract data
     QString protocolName, protocolId, protocolVersion, protocolDesc;
     DescHandler::load_desc(file, this->m_cmdArray, protocolName, protocolId, protocolVersion, protocolDesc);
+    this->updateCmdNameIndex();
 
     ui->leProtocolName->setText(protocolName);
     ui->leProtocolId->setText(protocolId);
@@ -468,7 +469,7 @@ void MainWindow::loadCommandArray(void) {
 }
 
 void MainWindow::loadCommandAttArray(QString cmdName) {
-    Command *command = Command::findCmdAddr(cmdName, this->m_cmdArray);
+    Command *command = this->findCommand(cmdName);
     if (command == nullptr) {
         QMessageBox::warning(this, "Warning", "Unknown command!");
         return;
@@ -615,7 +616,7 @@ void MainWindow::updateDescTreeCmd(void) {
 void MainWindow::updateDescTreeCmdAtt(QString cmdName) {
     QTreeWidgetItem *parentTreeItem = this->findTreeWidgetItem(cmdName + attArraySuffix);
     QStringList childName;
-    Command *command = Command::findCmdAddr(cmdName, this->m_cmdArray);
+    Command *command = this->findCommand(cmdName);
     if ((parentTreeItem == nullptr) || (command == nullptr)) {
         qDebug() << "Null pointers, couldn't update tree\n";
         return;
@@ -845,6 +846,7 @@ bool MainWindow::saveCommandTable(void) {
             this->m_cmdArray.append(new Command(cmdName, cmdCode, cmdHasAtt, cmdDirection, cmdDesc));
         }
     }
+    this->updateCmdNameIndex();
     for (QString noLongerExistingCmdName : noLongerExistingCmdNames) {
         this->deleteCommand(noLongerExistingCmdName);
     }
@@ -865,7 +867,7 @@ NS_AttDataType::T_AttDataType MainWindow::getAttDataTypeFromComboBox(QComboBox *
 }
 
 bool MainWindow::saveCmdAttTable(QString cmdName) {
-    Command *command = Command::findCmdAddr(cmdName, this->m_cmdArray);
+    Command *command = this->findCommand(cmdName);
     QStringList newAttNames = this->getTableNames();
     QList<short> newAttCodes = this->getTableCodes();
 
@@ -1133,12 +1135,23 @@ void MainWindow::on_pbAddTableLine_clicked(void) {
     this->preFillCmdIdxCell(newLineIdx);
 }
 
+// Rebuild the name index, to call whenever commands are added, renamed or removed
+void MainWindow::updateCmdNameIndex(void) {
+    this->m_cmdNameIndex = Command::getNameIndex(this->m_cmdArray);
+}
+
+Command *MainWindow::findCommand(QString cmdName) {
+    return this->m_cmdNameIndex.value(cmdName, nullptr);
+}
+
 void MainWindow::deleteCommand(QString cmdName) {
-    int cmdIdx = Command::findCmdIdx(cmdName, this->m_cmdArray);
-    if (cmdIdx >= 0) {
+    Command *command = this->findCommand(cmdName);
+    if (command != nullptr) {
         qDebug() << "Command deleted: " << cmdName;
-        this->m_cmdArray.at(cmdIdx)->clearAttArray();
-        delete this->m_cmdArray.takeAt(cmdIdx);
+        command->clearAttArray();
+        this->m_cmdArray.removeOne(command);
+        this->m_cmdNameIndex.remove(cmdName);
+        delete command;
         this->updateDescTreeCmd();
     } else {
         qDebug() << "Unknown command: " << cmdName;
@@ -1146,8 +1159,8 @@ void MainWindow::deleteCommand(QString cmdName) {
 }
 
 void MainWindow::deleteCommandAtt(QString cmdName, QString attName) {
-    Command *command = Command::findCmdAddr(
-        cmdName.remove(cmdName.length() - attArraySuffix.length(), attArraySuffix.length()), this->m_cmdArray);
+    Command *command =
+        this->findCommand(cmdName.remove(cmdName.length() - attArraySuffix.length(), attArraySuffix.length()));
     if (command != nullptr) {
         qDebug() << "Attribute deleted: " << attName;
         command->removeAttByName(attName);
@@ -1280,7 +1293,7 @@ void MainWindow::on_pbSortTable_clicked(void) {
                     if (currentTreeItem->parent()->text(0).compare(cmdArrayName) == 0) {
                         QString cmdName =
                             tableName.remove(tableName.length() - attArraySuffix.length(), attArraySuffix.length());
-                        Command *command = Command::findCmdAddr(cmdName, this->m_cmdArray);
+                        Command *command = this->findCommand(cmdName);
 
                         if (command != nullptr) {
                             command->sortAttArrayById();
@@ -1327,6 +1340,7 @@ void MainWindow::clearData(void) {
     while (!this->m_cmdArray.isEmpty()) {
         delete this->m_cmdArray.takeFirst();
     }
+    this->m_cmdNameIndex.clear();
     // Clear ui Tree
     this->clearTree();
     // Clear ui Table
@@ -1616,9 +1630,14 @@ void MainWindow::on_pbGenerateDoc_clicked(void) {
             nullptr, "Warning", "Duplicate complex attribute name: '" + dupName + "' found, this is not supported !");
         return;
     }
-    this->m_docgen.generateWikiTable(protocolName, protocolId, protocolDesc, this->m_cmdArray, exportDirPath);
-    this->m_docgen.generateDokuWikiTable(protocolName, protocolId, protocolDesc, this->m_cmdArray, exportDirPath);
-    this->m_docgen.generateMkdownTable(protocolName, protocolId, protocolDesc, this->m_cmdArray, exportDirPath);
+    DocGenerator::T_DocModel docModel =
+        this->m_docgen.buildDocModel(protocolName, protocolId, protocolDesc, this->m_cmdArray);
+    QList<DocGenerator::T_DocFormat> docFormats = {
+        DocGenerator::DOC_WIKI, DocGenerator::DOC_DOKUWIKI, DocGenerator::DOC_MKDOWN};
+    if (ui->cbDocHtml->isChecked()) {
+        docFormats.append(DocGenerator::DOC_HTML);
+    }
+    this->m_docgen.generateDoc(docModel, docFormats, exportDirPath);
     QMessageBox::information(nullptr, "Info", "Documentation was created at: " + exportDirPath);
 }
 
@@ -59,6 +59,7 @@ class MainWindow : public QMainWindow {
     Ui::MainWindow *ui;
     QAction *m_recentFileActs[MaxRecentFiles];
     QList<Command *> m_cmdArray;
+    QHash<QString, Command *> m_cmdNameIndex;
     DocGenerator m_docgen;
     CodeGenerator m_codegen;
     RustGenerator m_rustgen;
@@ -122,6 +123,8 @@ class MainWindow : public QMainWindow {
     Attribute *findAttStorage(QTreeWidgetItem *item);
     bool saveAttTable(QTreeWidgetItem *item);
     void preFillCmdIdxCell(int lineIdx);
+    void updateCmdNameIndex(void);
+    Command *findCommand(QString cmdName);
     void deleteCommand(QString cmdName);
     void deleteCommandAtt(QString cmdName, QString attName);
     void deleteAttribute(QString attName, QTreeWidgetItem *attItem);
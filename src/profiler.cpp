@@ -0,0 +1,256 @@
+/**
+ * \file profiler.cpp
+ * \brief Generation profiler module
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#include <QAtomicInt>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <algorithm>
+
+#include "profiler.h"
+
+// Aggregated scope statistics, used by the report table
+typedef struct {
+    QString name;
+    int calls;
+    qint64 totalUs;
+    qint64 maxUs;
+    qint64 allocCount;
+    qint64 allocBytes;
+} T_ScopeStats;
+
+// Profiler state
+static QAtomicInt s_isEnabled;
+static QAtomicInt s_nextThreadId;
+static QMutex s_mutex;
+static QElapsedTimer s_clock;
+static QList<Profiler::T_ProfileEvent> s_events;
+static QMap<QString, qint64> s_counters;
+
+// Per thread state, plain integers so the allocation hook never allocates itself
+static thread_local int s_threadId = -1;
+static thread_local qint64 s_threadAllocCount = 0;
+static thread_local qint64 s_threadAllocBytes = 0;
+
+void Profiler::setEnabled(bool isEnabled) {
+    QMutexLocker locker(&s_mutex);
+    if (isEnabled && !s_clock.isValid()) {
+        s_clock.start();
+    }
+    s_isEnabled.storeRelaxed(isEnabled ? 1 : 0);
+}
+
+bool Profiler::isEnabled() {
+    return s_isEnabled.loadRelaxed() != 0;
+}
+
+void Profiler::reset() {
+    QMutexLocker locker(&s_mutex);
+    s_events.clear();
+    s_counters.clear();
+    s_clock.start();
+}
+
+qint64 Profiler::getTimestampUs() {
+    return s_clock.isValid() ? s_clock.nsecsElapsed() / 1000 : 0;
+}
+
+int Profiler::getThreadId() {
+    if (s_threadId < 0) {
+        s_threadId = s_nextThreadId.fetchAndAddRelaxed(1) + 1;
+    }
+    return s_threadId;
+}
+
+void Profiler::recordEvent(T_ProfileEvent event) {
+    QMutexLocker locker(&s_mutex);
+    s_events.append(event);
+}
+
+void Profiler::addCounter(QString name, qint64 value) {
+    if (!Profiler::isEnabled()) {
+        return;
+    }
+    QMutexLocker locker(&s_mutex);
+    s_counters.insert(name, s_counters.value(name, 0) + value);
+}
+
+void Profiler::recordAllocation(size_t size) {
+    if (s_isEnabled.loadRelaxed() == 0) {
+        return;
+    }
+    s_threadAllocCount++;
+    s_threadAllocBytes += static_cast<qint64>(size);
+}
+
+qint64 Profiler::getThreadAllocCount() {
+    return s_threadAllocCount;
+}
+
+qint64 Profiler::getThreadAllocBytes() {
+    return s_threadAllocBytes;
+}
+
+QList<Profiler::T_ProfileEvent> Profiler::getEvents() {
+    QMutexLocker locker(&s_mutex);
+    return s_events;
+}
+
+QMap<QString, qint64> Profiler::getCounters() {
+    QMutexLocker locker(&s_mutex);
+    return s_counters;
+}
+
+QString Profiler::getReportTable() {
+    QList<T_ProfileEvent> events = Profiler::getEvents();
+    QMap<QString, qint64> counters = Profiler::getCounters();
+    QList<T_ScopeStats> statsList;
+    QMap<QString, int> statsIdx;
+    int nameWidth = 5;
+
+    // Aggregate events by scope name
+    for (const T_ProfileEvent &event : events) {
+        if (!statsIdx.contains(event.name)) {
+            statsIdx.insert(event.name, statsList.size());
+            statsList.append({event.name, 0, 0, 0, 0, 0});
+            nameWidth = qMax(nameWidth, event.name.size());
+        }
+        T_ScopeStats &stats = statsList[statsIdx.value(event.name)];
+        stats.calls++;
+        stats.totalUs += event.durationUs;
+        stats.maxUs = qMax(stats.maxUs, event.durationUs);
+        stats.allocCount += event.allocCount;
+        stats.allocBytes += event.allocBytes;
+    }
+    std::sort(statsList.begin(), statsList.end(),
+        [](const T_ScopeStats &a, const T_ScopeStats &b) { return a.totalUs > b.totalUs; });
+
+    // Print the table
+    QString table;
+    table.append(QString("%1 %2 %3 %4 %5 %6\n")
+                     .arg(QString("Scope"), -nameWidth)
+                     .arg(QString("Calls"), 6)
+                     .arg(QString("Total ms"), 10)
+                     .arg(QString("Max ms"), 10)
+                     .arg(QString("new calls"), 10)
+                     .arg(QString("new KiB"), 10));
+    for (const T_ScopeStats &stats : statsList) {
+        table.append(QString("%1 %2 %3 %4 %5 %6\n")
+                         .arg(stats.name, -nameWidth)
+                         .arg(stats.calls, 6)
+                         .arg(stats.totalUs / 1000.0, 10, 'f', 3)
+                         .arg(stats.maxUs / 1000.0, 10, 'f', 3)
+                         .arg(stats.allocCount, 10)
+                         .arg(stats.allocBytes / 1024.0, 10, 'f', 1));
+    }
+    // Print the counters
+    for (auto it = counters.begin(); it != counters.end(); ++it) {
+        table.append(QString("%1 %2\n").arg(it.key(), -nameWidth).arg(it.value(), 6));
+    }
+    table.append("Allocations are partial: only operator new is counted, Qt internal malloc calls are missed\n");
+    return table;
+}
+
+bool Profiler::writeChromeTrace(QString filename) {
+    QList<T_ProfileEvent> events = Profiler::getEvents();
+    QMap<QString, qint64> counters = Profiler::getCounters();
+    QJsonArray traceEvents;
+    qint64 endUs = 0;
+
+    // Complete events, viewable in chrome://tracing or Perfetto
+    for (const T_ProfileEvent &event : events) {
+        QJsonObject args;
+        args.insert("allocs", event.allocCount);
+        args.insert("allocBytes", event.allocBytes);
+
+        QJsonObject traceEvent;
+        traceEvent.insert("name", event.name);
+        traceEvent.insert("cat", event.category);
+        traceEvent.insert("ph", "X");
+        traceEvent.insert("ts", event.startUs);
+        traceEvent.insert("dur", event.durationUs);
+        traceEvent.insert("pid", 1);
+        traceEvent.insert("tid", event.threadId);
+        traceEvent.insert("args", args);
+        traceEvents.append(traceEvent);
+        endUs = qMax(endUs, event.startUs + event.durationUs);
+    }
+    // Counters are reported once, at the end of the trace
+    for (auto it = counters.begin(); it != counters.end(); ++it) {
+        QJsonObject args;
+        args.insert("value", it.value());
+
+        QJsonObject traceEvent;
+        traceEvent.insert("name", it.key());
+        traceEvent.insert("ph", "C");
+        traceEvent.insert("ts", endUs);
+        traceEvent.insert("pid", 1);
+        traceEvent.insert("args", args);
+        traceEvents.append(traceEvent);
+    }
+    QJsonObject traceObject;
+    traceObject.insert("traceEvents", traceEvents);
+    traceObject.insert("displayTimeUnit", "ms");
+
+    QFile traceFile(filename);
+    if (!traceFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "Couldn't open trace file: " << filename << ", reason: " << traceFile.errorString();
+        return false;
+    }
+    traceFile.write(QJsonDocument(traceObject).toJson(QJsonDocument::Compact));
+    traceFile.close();
+    return true;
+}
+
+ProfileScope::ProfileScope(const char *name, const char *category) {
+    this->m_name = name;
+    this->m_category = category;
+    this->m_isActive = Profiler::isEnabled();
+    this->m_startUs = 0;
+    this->m_startAllocCount = 0;
+    this->m_startAllocBytes = 0;
+    if (this->m_isActive) {
+        this->m_startAllocCount = Profiler::getThreadAllocCount();
+        this->m_startAllocBytes = Profiler::getThreadAllocBytes();
+        this->m_startUs = Profiler::getTimestampUs();
+    }
+}
+
+ProfileScope::~ProfileScope() {
+    if (!this->m_isActive) {
+        return;
+    }
+    qint64 endUs = Profiler::getTimestampUs();
+    Profiler::T_ProfileEvent event;
+    event.name = QString(this->m_name);
+    event.category = QString(this->m_category);
+    event.startUs = this->m_startUs;
+    event.durationUs = endUs - this->m_startUs;
+    event.threadId = Profiler::getThreadId();
+    event.allocCount = Profiler::getThreadAllocCount() - this->m_startAllocCount;
+    event.allocBytes = Profiler::getThreadAllocBytes() - this->m_startAllocBytes;
+    Profiler::recordEvent(event);
+}
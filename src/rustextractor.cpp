@@ -20,6 +20,8 @@
  */
 
 #include "rustextractor.h"
+#include "profiler.h"
+#include "codescanner.h"
 
 RustExtractor::RustExtractor() {
     this->m_extractionComplete = false;
@@ -32,29 +34,20 @@ RustExtractor::RustExtractor() {
 }
 
 // Extract a complete brace-balanced function starting from firstLine.
-// Note: brace counting is simple and does not handle braces inside string literals.
+// Braces inside comments, string/char literals and raw strings are ignored.
 QString RustExtractor::extractFunction(QString firstLine, QTextStream *pIn) {
     QString buffer = firstLine + "\n";
-    int braceCount = 0;
-    bool functionBegan = false;
+    CodeScanner scanner(CodeScanner::LANGUAGE_RUST);
 
-    for (QChar ch : firstLine) {
-        if (ch == '{') { braceCount++; functionBegan = true; }
-        else if (ch == '}') { braceCount--; }
-    }
-
-    while (!(functionBegan && braceCount == 0) && !pIn->atEnd()) {
+    scanner.scanLine(firstLine);
+    while (!(scanner.getBlockBegan() && (scanner.getBracketCounter() <= 0)) && !pIn->atEnd()) {
         QString line = pIn->readLine();
         buffer.append(line + "\n");
-        for (QChar ch : line) {
-            if (ch == '{') { braceCount++; functionBegan = true; }
-            else if (ch == '}') { braceCount--; }
-        }
+        scanner.scanLine(line);
     }
     return buffer;
 }
 
-
 // Collect extra uses added by the user between "// --- Custom uses ---"
 // and the "/// Command enum" doc comment.
 bool RustExtractor::extractUses(QTextStream *pIn) {
@@ -200,6 +193,7 @@ void RustExtractor::extractPublicFunctions(QTextStream *pIn) {
 }
 
 bool RustExtractor::extractFromSourceFile(QString protocolName, QTextStream *pIn, QList<Command *> cmdList) {
+    LCSF_PROFILE_SCOPE("RustExtractor::extractFromSourceFile", "extract");
     if (pIn == nullptr) return false;
 
     // Pre-size command functions list with empty entries
@@ -21,10 +21,31 @@
 
 #include <QStringBuilder>
 
+#include "profiler.h"
 #include "rustextractor.h"
 #include "rustgenerator.h"
 
 RustGenerator::RustGenerator() {
+    this->segmentEncodeMode = false;
+    this->handlerTraitMode = false;
+    this->instrumentMode = false;
+    this->staticDescMode = false;
+}
+
+void RustGenerator::setSegmentEncodeMode(bool isSegmentEncode) {
+    this->segmentEncodeMode = isSegmentEncode;
+}
+
+void RustGenerator::setHandlerTraitMode(bool isHandlerTrait) {
+    this->handlerTraitMode = isHandlerTrait;
+}
+
+void RustGenerator::setInstrumentMode(bool isInstrument) {
+    this->instrumentMode = isInstrument;
+}
+
+void RustGenerator::setStaticDescMode(bool isStaticDesc) {
+    this->staticDescMode = isStaticDesc;
 }
 
 // Set all chars of a string to lower then the first to upper
@@ -484,6 +505,80 @@ void RustGenerator::fillSubAttData_Rec(
     }
 }
 
+// Build the present attribute number expression of a payload level
+QString RustGenerator::getSegAttNbString(QStringList parentNames, QList<Attribute *> attList) {
+    int mandatoryNb = 0;
+    QStringList optTerms;
+
+    for (Attribute *attribute : attList) {
+        if (attribute->getIsOptional()) {
+            optTerms.append("u16::from(payload." + this->getPayloadPath(parentNames) + "is_" +
+                attribute->getName().toLower() + "_here)");
+        } else {
+            mandatoryNb++;
+        }
+    }
+    optTerms.prepend(QString::number(mandatoryNb));
+    return optTerms.join(" + ");
+}
+
+// Recursively print code to write attributes in a segment list
+void RustGenerator::fillSegments_Rec(
+    QString parentName, QStringList parentNames, QList<Attribute *> attList, QTextStream *pOut, int indentNb) {
+    QString attDataPath = "payload." + this->getPayloadPath(parentNames);
+
+    for (Attribute *attribute : attList) {
+        QString indent = this->getIndent(indentNb);
+        QString attId = parentName.toUpper() + "_ATT_ID_" + attribute->getName().toUpper();
+        QString attData = attDataPath + attribute->getName().toLower();
+
+        *pOut << indent << "// Write attribute " << attribute->getName().toLower() << Qt::endl;
+        if (attribute->getIsOptional()) {
+            *pOut << indent << "if " << attDataPath << "is_" << attribute->getName().toLower() << "_here {" << Qt::endl;
+            indent = this->getIndent(indentNb + 1);
+        }
+        switch (attribute->getDataType()) {
+            case NS_AttDataType::SUB_ATTRIBUTES:
+                {
+                    QStringList nextParentNames = parentNames;
+                    nextParentNames.append(attribute->getName());
+                    *pOut << indent << "segs.push_field(" << attId << " | segs.cmplx_flag());" << Qt::endl;
+                    *pOut << indent << "segs.push_field("
+                          << this->getSegAttNbString(nextParentNames, attribute->getSubAttArray()) << ");" << Qt::endl;
+                    this->fillSegments_Rec(attribute->getName(), nextParentNames, attribute->getSubAttArray(), pOut,
+                        (attribute->getIsOptional()) ? indentNb + 1 : indentNb);
+                }
+                break;
+            case NS_AttDataType::UINT8:
+            case NS_AttDataType::UINT16:
+            case NS_AttDataType::UINT32:
+                *pOut << indent << "segs.push_field(" << attId << ");" << Qt::endl;
+                *pOut << indent << "segs.push_data(&lcsf_validator::vle_encode(" << attData << " as u64));" << Qt::endl;
+                break;
+            case NS_AttDataType::UINT64:
+                *pOut << indent << "segs.push_field(" << attId << ");" << Qt::endl;
+                *pOut << indent << "segs.push_data(&lcsf_validator::vle_encode(" << attData << "));" << Qt::endl;
+                break;
+            case NS_AttDataType::FLOAT32:
+            case NS_AttDataType::FLOAT64:
+                *pOut << indent << "segs.push_field(" << attId << ");" << Qt::endl;
+                *pOut << indent << "segs.push_data(&" << attData << ".to_le_bytes());" << Qt::endl;
+                break;
+            case NS_AttDataType::BYTE_ARRAY:
+                *pOut << indent << "segs.push_field(" << attId << ");" << Qt::endl;
+                *pOut << indent << "segs.push_ref(&" << attData << ");" << Qt::endl;
+                break;
+            case NS_AttDataType::STRING:
+                *pOut << indent << "segs.push_field(" << attId << ");" << Qt::endl;
+                *pOut << indent << "segs.push_ref(" << attData << ".as_bytes_with_nul());" << Qt::endl;
+                break;
+        }
+        if (attribute->getIsOptional()) {
+            *pOut << this->getIndent(indentNb) << "}" << Qt::endl;
+        }
+    }
+}
+
 // Generate attribute description string from attribute args
 QString RustGenerator::getAttDescString(bool isOptional, NS_AttDataType::T_AttDataType data_type) {
     QString descString = ", LcsfAttDesc { is_optional: ";
@@ -535,18 +630,294 @@ void RustGenerator::printAttDesc_Rec(QString parentName, QList<Attribute *> attL
         QString attDescStr = this->getAttDescString(attribute->getIsOptional(), attribute->getDataType());
         *pOut << indent << "(" << parentName.toUpper() << "_ATT_ID_" << attribute->getName().toUpper() << attDescStr;
         if (attribute->getDataType() == NS_AttDataType::SUB_ATTRIBUTES) {
-            *pOut << "vec![" << Qt::endl;
+            *pOut << ((this->staticDescMode) ? "&[" : "vec![") << Qt::endl;
             this->printAttDesc_Rec(attribute->getName(), attribute->getSubAttArray(), pOut, indentNb + 1);
             *pOut << indent << "]})," << Qt::endl;
         } else {
-            *pOut << "Vec::new()})," << Qt::endl;
+            *pOut << ((this->staticDescMode) ? "&[]" : "Vec::new()") << "})," << Qt::endl;
+        }
+    }
+}
+
+// Recursively print a payload struct filled with random values for the benchmark
+void RustGenerator::printBenchStruct_Rec(QString parentName, QList<Attribute *> attList, QTextStream *pOut, int indentNb) {
+    QString indent = this->getIndent(indentNb);
+    for (Attribute *attribute : attList) {
+        if (attribute->getIsOptional()) {
+            *pOut << indent << "is_" << attribute->getName().toLower() << "_here: rng.next_bool()," << Qt::endl;
+        }
+        switch (attribute->getDataType()) {
+            case NS_AttDataType::SUB_ATTRIBUTES:
+                *pOut << indent << attribute->getName().toLower() << "_payload: " << this->capitalize(parentName) << "Att"
+                      << this->capitalize(attribute->getName()) << "Payload {" << Qt::endl;
+                printBenchStruct_Rec(attribute->getName(), attribute->getSubAttArray(), pOut, indentNb + 1);
+                *pOut << indent << "}," << Qt::endl;
+                break;
+            default:
+            case NS_AttDataType::UINT8:
+                *pOut << indent << attribute->getName().toLower() << ": rng.next() as u8," << Qt::endl;
+                break;
+            case NS_AttDataType::UINT16:
+                *pOut << indent << attribute->getName().toLower() << ": rng.next() as u16," << Qt::endl;
+                break;
+            case NS_AttDataType::UINT32:
+                *pOut << indent << attribute->getName().toLower() << ": rng.next()," << Qt::endl;
+                break;
+            case NS_AttDataType::UINT64:
+                *pOut << indent << attribute->getName().toLower() << ": rng.next_u64()," << Qt::endl;
+                break;
+            case NS_AttDataType::FLOAT32:
+                *pOut << indent << attribute->getName().toLower() << ": rng.next_f64() as f32," << Qt::endl;
+                break;
+            case NS_AttDataType::FLOAT64:
+                *pOut << indent << attribute->getName().toLower() << ": rng.next_f64()," << Qt::endl;
+                break;
+            case NS_AttDataType::BYTE_ARRAY:
+                *pOut << indent << attribute->getName().toLower() << ": rng.bytes()," << Qt::endl;
+                break;
+            case NS_AttDataType::STRING:
+                *pOut << indent << attribute->getName().toLower() << ": rng.string()," << Qt::endl;
+                break;
         }
     }
 }
 
+// Print the handler trait, its generic dispatch functions and its core glue
+void RustGenerator::printHandlerTrait(QString protSuffix, QList<Command *> cmdList, bool isA, QTextStream *pOut) {
+    // Handler trait
+    *pOut << "/// Command handler, implement it in your own files" << Qt::endl;
+    *pOut << "///" << Qt::endl;
+    *pOut << "/// It has one method per received command, called by dispatch" << Qt::endl;
+    *pOut << "pub trait Handler {" << Qt::endl;
+    for (Command *command : cmdList) {
+        if (command->isReceivable(isA)) {
+            *pOut << "    fn " << command->getName().toLower() << "(&mut self";
+            if (command->getAttArray().size() > 0) {
+                *pOut << ", payload: &" << this->capitalize(command->getName()) << "AttPayload";
+            }
+            *pOut << ");" << Qt::endl;
+        }
+    }
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+
+    // Dispatch
+    *pOut << "/// Call the handler method of a command, monomorphized for each handler" << Qt::endl;
+    *pOut << "///" << Qt::endl;
+    *pOut << "/// handler: command handler" << Qt::endl;
+    *pOut << "///" << Qt::endl;
+    *pOut << "/// cmd_name: name of the command" << Qt::endl;
+    *pOut << "///" << Qt::endl;
+    *pOut << "/// cmd_payload: pointer to command payload" << Qt::endl;
+    *pOut << "///" << Qt::endl;
+    *pOut << "/// Returns false if the command is not received or its payload doesn't match" << Qt::endl;
+    *pOut << "#[inline]" << Qt::endl;
+    *pOut << "pub fn dispatch<H: Handler>(handler: &mut H, cmd_name: CmdEnum, cmd_payload: &CmdPayload) -> bool {"
+          << Qt::endl;
+    *pOut << "    match (cmd_name, cmd_payload) {" << Qt::endl;
+    for (Command *command : cmdList) {
+        if (command->isReceivable(isA)) {
+            QString cmdName = this->capitalize(command->getName());
+            if (command->getAttArray().size() > 0) {
+                *pOut << "        (CmdEnum::" << cmdName << ", CmdPayload::" << cmdName << "Payload(payload)) => handler."
+                      << command->getName().toLower() << "(payload)," << Qt::endl;
+            } else {
+                *pOut << "        (CmdEnum::" << cmdName << ", _) => handler." << command->getName().toLower() << "(),"
+                      << Qt::endl;
+            }
+        }
+    }
+    *pOut << "        #[allow(unreachable_patterns)]" << Qt::endl;
+    *pOut << "        _ => return false," << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << "    true" << Qt::endl;
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+
+    // Receive
+    *pOut << "/// Transform a lcsf valid command into a protocol payload and dispatch it" << Qt::endl;
+    *pOut << "///" << Qt::endl;
+    *pOut << "/// handler: command handler" << Qt::endl;
+    *pOut << "///" << Qt::endl;
+    *pOut << "/// valid_cmd: received valid command" << Qt::endl;
+    *pOut << "pub fn receive<H: Handler>(handler: &mut H, valid_cmd: &LcsfValidCmd) -> bool {" << Qt::endl;
+    *pOut << "    let (cmd_name, cmd_payload) = lcsf_protocol_" << protSuffix << "::receive_cmd(valid_cmd);" << Qt::endl;
+    if (this->instrumentMode) {
+        *pOut << "    #[cfg(feature = \"lcsf_stats\")]" << Qt::endl;
+        *pOut << "    let start = std::time::Instant::now();" << Qt::endl;
+        *pOut << "    let is_ok = dispatch(handler, cmd_name, &cmd_payload);" << Qt::endl;
+        *pOut << "    #[cfg(feature = \"lcsf_stats\")]" << Qt::endl;
+        *pOut << "    lcsf_protocol_" << protSuffix << "::stats::handler(cmd_name, is_ok, start);" << Qt::endl;
+        *pOut << "    is_ok" << Qt::endl;
+    } else {
+        *pOut << "    dispatch(handler, cmd_name, &cmd_payload)" << Qt::endl;
+    }
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+
+    // Core glue, the core callback is a plain fn so it is monomorphized for each handler
+    *pOut << "/// Init a LcsfCore with the protocol, its commands are dispatched to a handler" << Qt::endl;
+    *pOut << "///" << Qt::endl;
+    *pOut << "/// The core callback carries no user data, so a handler is built for each command and can't hold state"
+          << Qt::endl;
+    *pOut << "/// across commands, keep that state in a static instead" << Qt::endl;
+    *pOut << "///" << Qt::endl;
+    *pOut << "/// core: LcsfCore reference" << Qt::endl;
+    *pOut << "pub fn init_core<H: Handler + Default>(core: &mut LcsfCore) {" << Qt::endl;
+    *pOut << "    // Add protocol to LcsfCore" << Qt::endl;
+    *pOut << "    core.add_protocol(" << Qt::endl;
+    *pOut << "        lcsf_protocol_" << protSuffix << "::PROT_ID," << Qt::endl;
+    *pOut << "        &lcsf_protocol_" << protSuffix << "::PROT_DESC," << Qt::endl;
+    *pOut << "        process_cmd::<H>," << Qt::endl;
+    *pOut << "    );" << Qt::endl;
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "/// Process command callback, dispatch the command to a new handler" << Qt::endl;
+    *pOut << "///" << Qt::endl;
+    *pOut << "/// valid_cmd: received valid command" << Qt::endl;
+    *pOut << "fn process_cmd<H: Handler + Default>(_core: &LcsfCore, valid_cmd: &LcsfValidCmd) {" << Qt::endl;
+    *pOut << "    receive(&mut H::default(), valid_cmd);" << Qt::endl;
+    *pOut << "}" << Qt::endl;
+}
+
+// Print the instrumentation module of the bridge
+void RustGenerator::printStats(int cmdNb, QTextStream *pOut) {
+    *pOut << "// *** Instrumentation ***" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "/// Per command counters, enabled by the lcsf_stats cargo feature" << Qt::endl;
+    *pOut << "///" << Qt::endl;
+    *pOut << "/// Byte totals count the attribute data, or the encoded message size for send_cmd_segments" << Qt::endl;
+    *pOut << "#[cfg(feature = \"lcsf_stats\")]" << Qt::endl;
+    *pOut << "pub mod stats {" << Qt::endl;
+    *pOut << "    use super::CmdEnum;" << Qt::endl;
+    *pOut << "    use super::LcsfValidAtt;" << Qt::endl;
+    *pOut << "    use super::LcsfValidAttPayload;" << Qt::endl;
+    *pOut << "    use std::sync::Mutex;" << Qt::endl;
+    *pOut << "    use std::time::Instant;" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    /// Number of commands" << Qt::endl;
+    *pOut << "    pub const CMD_NB: usize = " << cmdNb << ";" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    /// Failure reasons" << Qt::endl;
+    *pOut << "    #[derive(Debug, PartialEq, Copy, Clone)]" << Qt::endl;
+    *pOut << "    pub enum FailReason {" << Qt::endl;
+    *pOut << "        Handler," << Qt::endl;
+    *pOut << "        Encode," << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    /// Number of failure reasons" << Qt::endl;
+    *pOut << "    pub const FAIL_NB: usize = 2;" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    /// Counters of a command, times are in nanoseconds" << Qt::endl;
+    *pOut << "    #[derive(Debug, Copy, Clone)]" << Qt::endl;
+    *pOut << "    pub struct CmdStats {" << Qt::endl;
+    *pOut << "        pub rx_count: u32," << Qt::endl;
+    *pOut << "        pub tx_count: u32," << Qt::endl;
+    *pOut << "        pub fail_count: u32," << Qt::endl;
+    *pOut << "        pub rx_bytes: u64," << Qt::endl;
+    *pOut << "        pub tx_bytes: u64," << Qt::endl;
+    *pOut << "        pub decode_ns: u64," << Qt::endl;
+    *pOut << "        pub handler_ns: u64," << Qt::endl;
+    *pOut << "        pub encode_ns: u64," << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    impl CmdStats {" << Qt::endl;
+    *pOut << "        const ZERO: CmdStats = CmdStats {" << Qt::endl;
+    *pOut << "            rx_count: 0," << Qt::endl;
+    *pOut << "            tx_count: 0," << Qt::endl;
+    *pOut << "            fail_count: 0," << Qt::endl;
+    *pOut << "            rx_bytes: 0," << Qt::endl;
+    *pOut << "            tx_bytes: 0," << Qt::endl;
+    *pOut << "            decode_ns: 0," << Qt::endl;
+    *pOut << "            handler_ns: 0," << Qt::endl;
+    *pOut << "            encode_ns: 0," << Qt::endl;
+    *pOut << "        };" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    /// Protocol counters, indexed by command name" << Qt::endl;
+    *pOut << "    #[derive(Debug, Copy, Clone)]" << Qt::endl;
+    *pOut << "    pub struct Stats {" << Qt::endl;
+    *pOut << "        pub cmd: [CmdStats; CMD_NB]," << Qt::endl;
+    *pOut << "        pub fail_count: [u32; FAIL_NB]," << Qt::endl;
+    *pOut << "        pub last_fail: Option<(CmdEnum, FailReason)>," << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    impl Stats {" << Qt::endl;
+    *pOut << "        const ZERO: Stats = Stats {" << Qt::endl;
+    *pOut << "            cmd: [CmdStats::ZERO; CMD_NB]," << Qt::endl;
+    *pOut << "            fail_count: [0; FAIL_NB]," << Qt::endl;
+    *pOut << "            last_fail: None," << Qt::endl;
+    *pOut << "        };" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    static STATS: Mutex<Stats> = Mutex::new(Stats::ZERO);" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    fn elapsed_ns(start: Instant) -> u64 {" << Qt::endl;
+    *pOut << "        start.elapsed().as_nanos() as u64" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    /// Get a copy of the counters" << Qt::endl;
+    *pOut << "    pub fn get() -> Stats {" << Qt::endl;
+    *pOut << "        *STATS.lock().unwrap()" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    /// Reset the counters" << Qt::endl;
+    *pOut << "    pub fn reset() {" << Qt::endl;
+    *pOut << "        *STATS.lock().unwrap() = Stats::ZERO;" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    /// Get the size of the data of an attribute array, sub-attributes included" << Qt::endl;
+    *pOut << "    pub fn att_data_size(att_arr: &[LcsfValidAtt]) -> u64 {" << Qt::endl;
+    *pOut << "        att_arr" << Qt::endl;
+    *pOut << "            .iter()" << Qt::endl;
+    *pOut << "            .map(|att| match &att.payload {" << Qt::endl;
+    *pOut << "                LcsfValidAttPayload::Data(data) => data.len() as u64," << Qt::endl;
+    *pOut << "                LcsfValidAttPayload::SubattArr(subatt_arr) => att_data_size(subatt_arr)," << Qt::endl;
+    *pOut << "            })" << Qt::endl;
+    *pOut << "            .sum()" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    /// Record a received command" << Qt::endl;
+    *pOut << "    pub fn rx(cmd_name: CmdEnum, byte_nb: u64, start: Instant) {" << Qt::endl;
+    *pOut << "        let mut stats = STATS.lock().unwrap();" << Qt::endl;
+    *pOut << "        let cmd_stats = &mut stats.cmd[cmd_name as usize];" << Qt::endl;
+    *pOut << "        cmd_stats.rx_count += 1;" << Qt::endl;
+    *pOut << "        cmd_stats.rx_bytes += byte_nb;" << Qt::endl;
+    *pOut << "        cmd_stats.decode_ns += elapsed_ns(start);" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    /// Record a handler execution, a failed handler counts as a failure" << Qt::endl;
+    *pOut << "    pub fn handler(cmd_name: CmdEnum, is_ok: bool, start: Instant) {" << Qt::endl;
+    *pOut << "        STATS.lock().unwrap().cmd[cmd_name as usize].handler_ns += elapsed_ns(start);" << Qt::endl;
+    *pOut << "        if !is_ok {" << Qt::endl;
+    *pOut << "            fail(cmd_name, FailReason::Handler);" << Qt::endl;
+    *pOut << "        }" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    /// Record a sent command" << Qt::endl;
+    *pOut << "    pub fn tx(cmd_name: CmdEnum, byte_nb: u64, start: Instant) {" << Qt::endl;
+    *pOut << "        let mut stats = STATS.lock().unwrap();" << Qt::endl;
+    *pOut << "        let cmd_stats = &mut stats.cmd[cmd_name as usize];" << Qt::endl;
+    *pOut << "        cmd_stats.tx_count += 1;" << Qt::endl;
+    *pOut << "        cmd_stats.tx_bytes += byte_nb;" << Qt::endl;
+    *pOut << "        cmd_stats.encode_ns += elapsed_ns(start);" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << Qt::endl;
+    *pOut << "    /// Record a failure" << Qt::endl;
+    *pOut << "    pub fn fail(cmd_name: CmdEnum, reason: FailReason) {" << Qt::endl;
+    *pOut << "        let mut stats = STATS.lock().unwrap();" << Qt::endl;
+    *pOut << "        stats.cmd[cmd_name as usize].fail_count += 1;" << Qt::endl;
+    *pOut << "        stats.fail_count[reason as usize] += 1;" << Qt::endl;
+    *pOut << "        stats.last_fail = Some((cmd_name, reason));" << Qt::endl;
+    *pOut << "    }" << Qt::endl;
+    *pOut << "}" << Qt::endl;
+    *pOut << Qt::endl;
+}
+
 // Generate the protocol_<name>.rs file
 void RustGenerator::generateMain(
     QString protocolName, QList<Command *> cmdList, bool isA, QString dirPath, RustExtractor rustExtract) {
+    LCSF_PROFILE_SCOPE("RustGenerator::generateMain", "emit");
     QString low_prot_name = protocolName.toLower();
     QDir dir(dirPath);
     if (!dir.exists()) {
@@ -565,7 +936,11 @@ void RustGenerator::generateMain(
         out << "//! Main file (" << ((isA) ? "A" : "B") << ") for protocol: " << this->capitalize(protocolName) << Qt::endl;
         out << "//!" << Qt::endl;
         out << "//! This file has been auto-generated by LCSF Generator v" << APP_VERSION << Qt::endl;
-        out << "//! Feel free to customize as needed" << Qt::endl;
+        if (this->handlerTraitMode) {
+            out << "//! It shouldn't be edited manually, implement the Handler trait in your own files" << Qt::endl;
+        } else {
+            out << "//! Feel free to customize as needed" << Qt::endl;
+        }
         out << Qt::endl;
         out << "use crate::lcsf_lib::lcsf_core;" << Qt::endl;
         out << "use crate::lcsf_lib::lcsf_validator;" << Qt::endl;
@@ -576,11 +951,14 @@ void RustGenerator::generateMain(
         if (this->is_CString_needed(attInfosList)) {
             out << "use std::ffi::CString;" << Qt::endl;
         }
-        out << "// --- Custom uses ---" << Qt::endl;
-        if (rustExtract.getExtractionComplete()) {
-            QString uses = rustExtract.getExtraUses().trimmed();
-            if (!uses.isEmpty()) {
-                out << uses << Qt::endl;
+        // No user code in the handler trait output, nothing to extract
+        if (!this->handlerTraitMode) {
+            out << "// --- Custom uses ---" << Qt::endl;
+            if (rustExtract.getExtractionComplete()) {
+                QString uses = rustExtract.getExtraUses().trimmed();
+                if (!uses.isEmpty()) {
+                    out << uses << Qt::endl;
+                }
             }
         }
         out << Qt::endl;
@@ -722,6 +1100,13 @@ void RustGenerator::generateMain(
             }
         }
 
+        // No user code in the handler trait output, it ends with the trait and its core glue
+        if (this->handlerTraitMode) {
+            this->printHandlerTrait(protSuffix, cmdList, isA, &out);
+            file.close();
+            Profiler::addCounter("Bytes written", file.size());
+            return;
+        }
         out << "// --- Custom definitions ---" << Qt::endl;
         if (rustExtract.getExtractionComplete()) {
             QString defs = rustExtract.getCustomDefinitions().trimmed();
@@ -871,7 +1256,15 @@ void RustGenerator::generateMain(
             out << "    // Process received command" << Qt::endl;
             out << "    let (cmd_name, cmd_payload) = lcsf_protocol_" << protSuffix << "::receive_cmd(valid_cmd);"
                 << Qt::endl;
-            out << "    execute_cmd(cmd_name, &cmd_payload);" << Qt::endl;
+            if (this->instrumentMode) {
+                out << "    #[cfg(feature = \"lcsf_stats\")]" << Qt::endl;
+                out << "    let start = std::time::Instant::now();" << Qt::endl;
+                out << "    execute_cmd(cmd_name, &cmd_payload);" << Qt::endl;
+                out << "    #[cfg(feature = \"lcsf_stats\")]" << Qt::endl;
+                out << "    lcsf_protocol_" << protSuffix << "::stats::handler(cmd_name, true, start);" << Qt::endl;
+            } else {
+                out << "    execute_cmd(cmd_name, &cmd_payload);" << Qt::endl;
+            }
             out << "    // Here the function will send back received commands like an echo" << Qt::endl;
             out << "    // Customize as needed" << Qt::endl;
             out << "    let valid_cmd = lcsf_protocol_" << protSuffix << "::send_cmd(cmd_name, &cmd_payload);" << Qt::endl;
@@ -885,11 +1278,13 @@ void RustGenerator::generateMain(
         }
 
         file.close();
+        Profiler::addCounter("Bytes written", file.size());
     }
 }
 
 void RustGenerator::generateBridge(
     QString protocolName, QString protocolId, QString protocolVersion, QList<Command *> cmdList, bool isA, QString dirPath) {
+    LCSF_PROFILE_SCOPE("RustGenerator::generateBridge", "emit");
     QString low_prot_name = protocolName.toLower();
     QDir dir(dirPath);
     if (!dir.exists()) {
@@ -914,7 +1309,9 @@ void RustGenerator::generateBridge(
         out << Qt::endl;
         out << "use crate::lcsf_lib::lcsf_validator;" << Qt::endl;
         out << "use crate::lcsf_prot::protocol_" << protSuffix << ";" << Qt::endl;
-        out << "use lazy_static::lazy_static;" << Qt::endl;
+        if (!this->staticDescMode) {
+            out << "use lazy_static::lazy_static;" << Qt::endl;
+        }
         out << "use lcsf_validator::LcsfAttDesc;" << Qt::endl;
         out << "use lcsf_validator::LcsfCmdDesc;" << Qt::endl;
         out << "use lcsf_validator::LcsfDataType;" << Qt::endl;
@@ -926,6 +1323,9 @@ void RustGenerator::generateBridge(
         if (this->is_CString_needed(attInfosList)) {
             out << "use std::ffi::CString;" << Qt::endl;
         }
+        if (this->segmentEncodeMode) {
+            out << "use std::io::IoSlice;" << Qt::endl;
+        }
         out << Qt::endl;
 
         // Import Attribute
@@ -1141,6 +1541,10 @@ void RustGenerator::generateBridge(
         out << "///" << Qt::endl;
         out << "/// valid_cmd: valid command reference" << Qt::endl;
         out << "pub fn receive_cmd(valid_cmd: &LcsfValidCmd) -> (CmdEnum, CmdPayload) {" << Qt::endl;
+        if (this->instrumentMode) {
+            out << "    #[cfg(feature = \"lcsf_stats\")]" << Qt::endl;
+            out << "    let start = std::time::Instant::now();" << Qt::endl;
+        }
         out << "    let cmd_name = cmd_id_to_name(valid_cmd.cmd_id);" << Qt::endl;
         out << "    let cmd_payload = match cmd_name {" << Qt::endl;
         for (Command *command : cmdList) {
@@ -1152,6 +1556,10 @@ void RustGenerator::generateBridge(
             }
         }
         out << "    };" << Qt::endl;
+        if (this->instrumentMode) {
+            out << "    #[cfg(feature = \"lcsf_stats\")]" << Qt::endl;
+            out << "    stats::rx(cmd_name, stats::att_data_size(&valid_cmd.att_arr), start);" << Qt::endl;
+        }
         out << "    (cmd_name, cmd_payload)" << Qt::endl;
         out << "}" << Qt::endl;
         out << Qt::endl;
@@ -1265,6 +1673,10 @@ void RustGenerator::generateBridge(
         out << "///" << Qt::endl;
         out << "/// cmd_payload: protocol payload reference" << Qt::endl;
         out << "pub fn send_cmd(cmd_name: CmdEnum, cmd_payload: &CmdPayload) -> LcsfValidCmd {" << Qt::endl;
+        if (this->instrumentMode) {
+            out << "    #[cfg(feature = \"lcsf_stats\")]" << Qt::endl;
+            out << "    let start = std::time::Instant::now();" << Qt::endl;
+        }
         out << "    let mut send_cmd = LcsfValidCmd {" << Qt::endl;
         out << "        cmd_id: cmd_name_to_id(cmd_name)," << Qt::endl;
         out << "        att_arr: Vec::new()," << Qt::endl;
@@ -1279,10 +1691,186 @@ void RustGenerator::generateBridge(
             }
         }
         out << "    }" << Qt::endl;
+        if (this->instrumentMode) {
+            out << "    #[cfg(feature = \"lcsf_stats\")]" << Qt::endl;
+            out << "    stats::tx(cmd_name, stats::att_data_size(&send_cmd.att_arr), start);" << Qt::endl;
+        }
         out << "    send_cmd" << Qt::endl;
         out << "}" << Qt::endl;
         out << Qt::endl;
 
+        // Segment encoder
+        if (this->segmentEncodeMode) {
+            out << "// *** Segment encoder ***" << Qt::endl;
+            out << Qt::endl;
+            out << "/// Encoded message segment, a range of the header buffer or payload data borrowed in place" << Qt::endl;
+            out << "pub enum LcsfSegment<'a> {" << Qt::endl;
+            out << "    Header(std::ops::Range<usize>)," << Qt::endl;
+            out << "    Data(&'a [u8])," << Qt::endl;
+            out << "}" << Qt::endl;
+            out << Qt::endl;
+            out << "/// Command encoded as a segment list, for vectored writes that don't copy byte arrays and strings"
+                << Qt::endl;
+            out << "pub struct LcsfSegments<'a> {" << Qt::endl;
+            out << "    pub header: Vec<u8>," << Qt::endl;
+            out << "    pub segments: Vec<LcsfSegment<'a>>," << Qt::endl;
+            out << "    is_small: bool," << Qt::endl;
+            out << "    is_overflow: bool," << Qt::endl;
+            out << "    header_start: usize," << Qt::endl;
+            out << "}" << Qt::endl;
+            out << Qt::endl;
+            out << "impl<'a> LcsfSegments<'a> {" << Qt::endl;
+            out << "    fn new(is_small: bool) -> Self {" << Qt::endl;
+            out << "        LcsfSegments {" << Qt::endl;
+            out << "            header: Vec::new()," << Qt::endl;
+            out << "            segments: Vec::new()," << Qt::endl;
+            out << "            is_small," << Qt::endl;
+            out << "            is_overflow: false," << Qt::endl;
+            out << "            header_start: 0," << Qt::endl;
+            out << "        }" << Qt::endl;
+            out << "    }" << Qt::endl;
+            out << Qt::endl;
+            out << "    fn cmplx_flag(&self) -> u16 {" << Qt::endl;
+            out << "        if self.is_small { 0x80 } else { 0x8000 }" << Qt::endl;
+            out << "    }" << Qt::endl;
+            out << Qt::endl;
+            out << "    fn push_field(&mut self, value: u16) {" << Qt::endl;
+            out << "        if self.is_small {" << Qt::endl;
+            out << "            self.is_overflow |= value > u8::MAX as u16;" << Qt::endl;
+            out << "            self.header.push(value as u8);" << Qt::endl;
+            out << "        } else {" << Qt::endl;
+            out << "            self.header.extend_from_slice(&value.to_le_bytes());" << Qt::endl;
+            out << "        }" << Qt::endl;
+            out << "    }" << Qt::endl;
+            out << Qt::endl;
+            out << "    fn push_size(&mut self, size: usize) {" << Qt::endl;
+            out << "        self.is_overflow |= size > u16::MAX as usize;" << Qt::endl;
+            out << "        self.push_field(size as u16);" << Qt::endl;
+            out << "    }" << Qt::endl;
+            out << Qt::endl;
+            out << "    fn push_data(&mut self, data: &[u8]) {" << Qt::endl;
+            out << "        self.push_size(data.len());" << Qt::endl;
+            out << "        self.header.extend_from_slice(data);" << Qt::endl;
+            out << "    }" << Qt::endl;
+            out << Qt::endl;
+            out << "    fn push_ref(&mut self, data: &'a [u8]) {" << Qt::endl;
+            out << "        self.push_size(data.len());" << Qt::endl;
+            out << "        self.close_header();" << Qt::endl;
+            out << "        if !data.is_empty() {" << Qt::endl;
+            out << "            self.segments.push(LcsfSegment::Data(data));" << Qt::endl;
+            out << "        }" << Qt::endl;
+            out << "    }" << Qt::endl;
+            out << Qt::endl;
+            out << "    fn close_header(&mut self) {" << Qt::endl;
+            out << "        if self.header.len() > self.header_start {" << Qt::endl;
+            out << "            self.segments.push(LcsfSegment::Header(self.header_start..self.header.len()));" << Qt::endl;
+            out << "            self.header_start = self.header.len();" << Qt::endl;
+            out << "        }" << Qt::endl;
+            out << "    }" << Qt::endl;
+            out << Qt::endl;
+            out << "    /// Get the segments as io slices, for std::io::Write::write_vectored" << Qt::endl;
+            out << "    pub fn io_slices(&self) -> Vec<IoSlice<'_>> {" << Qt::endl;
+            out << "        self.segments" << Qt::endl;
+            out << "            .iter()" << Qt::endl;
+            out << "            .map(|segment| match segment {" << Qt::endl;
+            out << "                LcsfSegment::Header(range) => IoSlice::new(&self.header[range.clone()])," << Qt::endl;
+            out << "                LcsfSegment::Data(data) => IoSlice::new(data)," << Qt::endl;
+            out << "            })" << Qt::endl;
+            out << "            .collect()" << Qt::endl;
+            out << "    }" << Qt::endl;
+            out << Qt::endl;
+            out << "    /// Get the encoded message size" << Qt::endl;
+            out << "    pub fn size(&self) -> usize {" << Qt::endl;
+            out << "        self.segments" << Qt::endl;
+            out << "            .iter()" << Qt::endl;
+            out << "            .map(|segment| match segment {" << Qt::endl;
+            out << "                LcsfSegment::Header(range) => range.len()," << Qt::endl;
+            out << "                LcsfSegment::Data(data) => data.len()," << Qt::endl;
+            out << "            })" << Qt::endl;
+            out << "            .sum()" << Qt::endl;
+            out << "    }" << Qt::endl;
+            out << "}" << Qt::endl;
+            out << Qt::endl;
+
+            out << "/// Write a command attributes in a segment list" << Qt::endl;
+            out << "///" << Qt::endl;
+            out << "/// cmd_payload: protocol payload reference" << Qt::endl;
+            out << "///" << Qt::endl;
+            out << "/// segs: segment list to fill" << Qt::endl;
+            out << "///" << Qt::endl;
+            out << "/// Returns false if the payload is not the command's" << Qt::endl;
+            for (Command *command : cmdList) {
+                if ((command->getAttArray().size() > 0) && (command->isTransmittable(isA))) {
+                    out << "fn " << command->getName().toLower()
+                        << "_fill_segments<'a>(cmd_payload: &'a CmdPayload, segs: &mut LcsfSegments<'a>) -> bool {"
+                        << Qt::endl;
+                    out << "    if let CmdPayload::" << this->capitalize(command->getName())
+                        << "Payload(payload) = cmd_payload {" << Qt::endl;
+                    out << "        segs.push_field(" << this->getSegAttNbString({}, command->getAttArray()) << ");"
+                        << Qt::endl;
+                    this->fillSegments_Rec(command->getName(), {}, command->getAttArray(), &out, 2);
+                    out << "        true" << Qt::endl;
+                    out << "    } else {" << Qt::endl;
+                    out << "        false" << Qt::endl;
+                    out << "    }" << Qt::endl;
+                    out << "}" << Qt::endl;
+                    out << Qt::endl;
+                }
+            }
+
+            out << "/// Encode a command as a segment list, byte arrays and strings are borrowed from the payload"
+                << Qt::endl;
+            out << "///" << Qt::endl;
+            out << "/// cmd_name: command name to send" << Qt::endl;
+            out << "///" << Qt::endl;
+            out << "/// cmd_payload: protocol payload reference" << Qt::endl;
+            out << "///" << Qt::endl;
+            out << "/// is_small: true for the smallest lcsf representation, with one byte fields" << Qt::endl;
+            out << "///" << Qt::endl;
+            out << "/// Returns None if the command is not sent by this side, the payload is not the command's or a "
+                << "field overflows" << Qt::endl;
+            out << "pub fn send_cmd_segments(cmd_name: CmdEnum, cmd_payload: &CmdPayload, is_small: bool) -> "
+                << "Option<LcsfSegments<'_>> {" << Qt::endl;
+            if (this->instrumentMode) {
+                out << "    #[cfg(feature = \"lcsf_stats\")]" << Qt::endl;
+                out << "    let start = std::time::Instant::now();" << Qt::endl;
+            }
+            out << "    let mut segs = LcsfSegments::new(is_small);" << Qt::endl;
+            out << "    segs.push_field(PROT_ID);" << Qt::endl;
+            out << "    segs.push_field(cmd_name_to_id(cmd_name));" << Qt::endl;
+            out << "    let is_filled = match cmd_name {" << Qt::endl;
+            for (Command *command : cmdList) {
+                if (!command->isTransmittable(isA)) {
+                    out << "        CmdEnum::" << this->capitalize(command->getName()) << " => false," << Qt::endl;
+                } else if (command->getAttArray().size() > 0) {
+                    out << "        CmdEnum::" << this->capitalize(command->getName()) << " => "
+                        << command->getName().toLower() << "_fill_segments(cmd_payload, &mut segs)," << Qt::endl;
+                } else {
+                    out << "        CmdEnum::" << this->capitalize(command->getName()) << " => {" << Qt::endl;
+                    out << "            segs.push_field(0);" << Qt::endl;
+                    out << "            true" << Qt::endl;
+                    out << "        }" << Qt::endl;
+                }
+            }
+            out << "    };" << Qt::endl;
+            out << "    segs.close_header();" << Qt::endl;
+            if (this->instrumentMode) {
+                out << "    #[cfg(feature = \"lcsf_stats\")]" << Qt::endl;
+                out << "    if !is_filled || segs.is_overflow {" << Qt::endl;
+                out << "        stats::fail(cmd_name, stats::FailReason::Encode);" << Qt::endl;
+                out << "    } else {" << Qt::endl;
+                out << "        stats::tx(cmd_name, segs.size() as u64, start);" << Qt::endl;
+                out << "    }" << Qt::endl;
+            }
+            out << "    if !is_filled || segs.is_overflow { None } else { Some(segs) }" << Qt::endl;
+            out << "}" << Qt::endl;
+            out << Qt::endl;
+        }
+
+        if (this->instrumentMode) {
+            this->printStats(cmdList.size(), &out);
+        }
+
         // Protocol id
         out << "// *** Protocol lcsf descriptor ***" << Qt::endl;
         out << Qt::endl;
@@ -1329,34 +1917,296 @@ void RustGenerator::generateBridge(
         }
 
         // Description
-        out << "lazy_static! {" << Qt::endl;
-        out << "    /// Test protocol descriptor" << Qt::endl;
-        out << "    pub static ref PROT_DESC:LcsfProtDesc = LcsfProtDesc {prot_ver: PROT_VER, cmd_desc_arr: vec!["
-            << Qt::endl;
+        // Static slices live in read-only memory and need no initialization, vectors are built on first access
+        QString indent = (this->staticDescMode) ? "" : "    ";
+        QString emptyArr = (this->staticDescMode) ? "&[]" : "Vec::new()";
+        QString arrStart = (this->staticDescMode) ? "&[" : "vec![";
+        if (this->staticDescMode) {
+            out << "/// Test protocol descriptor" << Qt::endl;
+            out << "pub static PROT_DESC: LcsfProtDesc = LcsfProtDesc {prot_ver: PROT_VER, cmd_desc_arr: &[" << Qt::endl;
+        } else {
+            out << "lazy_static! {" << Qt::endl;
+            out << "    /// Test protocol descriptor" << Qt::endl;
+            out << "    pub static ref PROT_DESC:LcsfProtDesc = LcsfProtDesc {prot_ver: PROT_VER, cmd_desc_arr: vec!["
+                << Qt::endl;
+        }
         for (Command *command : cmdList) {
-            out << "        (CMD_ID_" << command->getName().toUpper() << ", LcsfCmdDesc {att_desc_arr: ";
+            out << indent << "    (CMD_ID_" << command->getName().toUpper() << ", LcsfCmdDesc {att_desc_arr: ";
             if (command->getAttArray().size() == 0) {
-                out << "Vec::new()})," << Qt::endl;
+                out << emptyArr << "})," << Qt::endl;
             } else {
-                out << "vec![" << Qt::endl;
+                out << arrStart << Qt::endl;
                 for (Attribute *attribute : command->getAttArray()) {
                     QString desc_str = this->getAttDescString(attribute->getIsOptional(), attribute->getDataType());
-                    out << "            (" << command->getName().toUpper() << "_ATT_ID_" << attribute->getName().toUpper()
-                        << desc_str;
+                    out << indent << "        (" << command->getName().toUpper() << "_ATT_ID_"
+                        << attribute->getName().toUpper() << desc_str;
                     if (attribute->getDataType() == NS_AttDataType::SUB_ATTRIBUTES) {
-                        out << "vec![" << Qt::endl;
-                        this->printAttDesc_Rec(attribute->getName(), attribute->getSubAttArray(), &out, 4);
-                        out << "            ]})," << Qt::endl;
+                        out << arrStart << Qt::endl;
+                        this->printAttDesc_Rec(attribute->getName(), attribute->getSubAttArray(), &out,
+                            (this->staticDescMode) ? 3 : 4);
+                        out << indent << "        ]})," << Qt::endl;
                     } else {
-                        out << "Vec::new()})," << Qt::endl;
+                        out << emptyArr << "})," << Qt::endl;
                     }
                 }
-                out << "        ]})," << Qt::endl;
+                out << indent << "    ]})," << Qt::endl;
             }
         }
-        out << "    ]};" << Qt::endl;
+        out << indent << "]};" << Qt::endl;
+        if (!this->staticDescMode) {
+            out << "}" << Qt::endl;
+        }
+
+        file.close();
+        Profiler::addCounter("Bytes written", file.size());
+    }
+}
+
+void RustGenerator::generateBench(QString protocolName, QList<Command *> cmdList, bool isA, QString dirPath) {
+    LCSF_PROFILE_SCOPE("RustGenerator::generateBench", "emit");
+    QString low_prot_name = protocolName.toLower();
+    QDir dir(dirPath);
+    if (!dir.exists()) {
+        dir.mkpath(".");
+    }
+    QString protSuffix = low_prot_name + "_" + ((isA) ? "a" : "b");
+    QString rxSuffix = low_prot_name + "_" + ((isA) ? "b" : "a");
+    QString rxSide = (isA) ? "B" : "A";
+    QString fileName = dirPath + "/lcsf_bench_" + protSuffix + ".rs";
+    QList<Attribute::T_attInfos> attInfosList = this->getAttInfos(cmdList);
+    QFile file(fileName);
+
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        QTextStream out(&file);
+
+        // Header/Import
+        out << "//! Throughput benchmark (" << ((isA) ? "A" : "B") << ") for protocol: " << this->capitalize(protocolName)
+            << Qt::endl;
+        out << "//!" << Qt::endl;
+        out << "//! This file has been auto-generated by LCSF Generator v" << APP_VERSION << Qt::endl;
+        out << "//! It shouldn't be edited manually" << Qt::endl;
+        out << "//!" << Qt::endl;
+        out << "//! Each command sent by the side is encoded to an LCSF frame by a LcsfCore with random payloads, then"
+            << Qt::endl;
+        out << "//! received by a LcsfCore holding the protocol of side " << rxSide
+            << ", byte rates use the encoded frame sizes." << Qt::endl;
+        out << Qt::endl;
+        out << "use crate::lcsf_lib::lcsf_core;" << Qt::endl;
+        out << "use crate::lcsf_lib::lcsf_transcoder;" << Qt::endl;
+        out << "use crate::lcsf_lib::lcsf_validator;" << Qt::endl;
+        out << "use crate::lcsf_prot::lcsf_protocol_" << protSuffix << ";" << Qt::endl;
+        out << "use crate::lcsf_prot::lcsf_protocol_" << rxSuffix << ";" << Qt::endl;
+        out << "use crate::lcsf_prot::protocol_" << protSuffix << ";" << Qt::endl;
+        out << "use lcsf_core::LcsfCore;" << Qt::endl;
+        out << "use lcsf_transcoder::LcsfModeEnum;" << Qt::endl;
+        out << "use lcsf_validator::LcsfValidCmd;" << Qt::endl;
+        out << "use std::cell::Cell;" << Qt::endl;
+        out << "use std::cell::RefCell;" << Qt::endl;
+        if (this->is_CString_needed(attInfosList)) {
+            out << "use std::ffi::CString;" << Qt::endl;
+        }
+        out << "use std::time::Instant;" << Qt::endl;
+        out << Qt::endl;
+        for (Command *command : cmdList) {
+            if (command->isTransmittable(isA) && (command->getAttArray().size() > 0)) {
+                out << "use protocol_" << protSuffix << "::" << this->capitalize(command->getName()) << "AttPayload;"
+                    << Qt::endl;
+                printInclude_Rec(protSuffix, command->getName(), command->getAttArray(), &out);
+            }
+        }
+        out << "use protocol_" << protSuffix << "::CmdEnum;" << Qt::endl;
+        out << "use protocol_" << protSuffix << "::CmdPayload;" << Qt::endl;
+        out << Qt::endl;
+
+        // Settings
+        out << "/// Round trips per command" << Qt::endl;
+        out << "pub const BENCH_ITERATIONS: u32 = 100000;" << Qt::endl;
+        out << Qt::endl;
+        out << "/// Random payloads built per command, used in turn" << Qt::endl;
+        out << "pub const BENCH_SAMPLES: usize = 16;" << Qt::endl;
+        out << Qt::endl;
+        out << "/// Maximum byte array and string size" << Qt::endl;
+        out << "pub const BENCH_MAX_DATA_SIZE: u32 = 64;" << Qt::endl;
+        out << Qt::endl;
+        out << "/// Random generator seed, the payloads are the same on every run" << Qt::endl;
+        out << "pub const BENCH_SEED: u32 = 1;" << Qt::endl;
+        out << Qt::endl;
+        // Frame and received command storage, the LcsfCore callbacks are plain functions
+        out << "thread_local! {" << Qt::endl;
+        out << "    /// Last frame encoded by the sending core" << Qt::endl;
+        out << "    static BENCH_FRAME: RefCell<Vec<u8>> = RefCell::new(Vec::new());" << Qt::endl;
+        out << "    /// Commands decoded by the receiving core" << Qt::endl;
+        out << "    static BENCH_EXEC_COUNT: Cell<u32> = Cell::new(0);" << Qt::endl;
+        out << "}" << Qt::endl;
+        out << Qt::endl;
+
+        // Random generator
+        out << "/// Xorshift random generator" << Qt::endl;
+        out << "struct BenchRng {" << Qt::endl;
+        out << "    state: u32," << Qt::endl;
+        out << "}" << Qt::endl;
+        out << Qt::endl;
+        out << "#[allow(dead_code)]" << Qt::endl;
+        out << "impl BenchRng {" << Qt::endl;
+        out << "    fn next(&mut self) -> u32 {" << Qt::endl;
+        out << "        self.state ^= self.state << 13;" << Qt::endl;
+        out << "        self.state ^= self.state >> 17;" << Qt::endl;
+        out << "        self.state ^= self.state << 5;" << Qt::endl;
+        out << "        self.state" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "    fn next_bool(&mut self) -> bool {" << Qt::endl;
+        out << "        (self.next() & 1) != 0" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "    fn next_u64(&mut self) -> u64 {" << Qt::endl;
+        out << "        ((self.next() as u64) << 32) | (self.next() as u64)" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "    fn next_f64(&mut self) -> f64 {" << Qt::endl;
+        out << "        (self.next() as f64) / 4294967296.0" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << Qt::endl;
+        out << "    fn bytes(&mut self) -> Vec<u8> {" << Qt::endl;
+        out << "        let size = 1 + (self.next() % BENCH_MAX_DATA_SIZE);" << Qt::endl;
+        out << "        (0..size).map(|_| self.next() as u8).collect()" << Qt::endl;
+        out << "    }" << Qt::endl;
+        if (this->is_CString_needed(attInfosList)) {
+            out << Qt::endl;
+            out << "    fn string(&mut self) -> CString {" << Qt::endl;
+            out << "        let size = self.next() % BENCH_MAX_DATA_SIZE;" << Qt::endl;
+            out << "        let chars: Vec<u8> = (0..size).map(|_| b'a' + (self.next() % 26) as u8).collect();" << Qt::endl;
+            out << "        CString::new(chars).unwrap()" << Qt::endl;
+            out << "    }" << Qt::endl;
+        }
+        out << "}" << Qt::endl;
+        out << Qt::endl;
+
+        // Core callbacks
+        out << "/// Send callback of the sending core, stores the frame" << Qt::endl;
+        out << "fn bench_send(frame: &[u8]) {" << Qt::endl;
+        out << "    BENCH_FRAME.with(|bench_frame| {" << Qt::endl;
+        out << "        let mut bench_frame = bench_frame.borrow_mut();" << Qt::endl;
+        out << "        bench_frame.clear();" << Qt::endl;
+        out << "        bench_frame.extend_from_slice(frame);" << Qt::endl;
+        out << "    });" << Qt::endl;
+        out << "}" << Qt::endl;
+        out << Qt::endl;
+        out << "/// Send callback of the receiving core, nothing is sent back" << Qt::endl;
+        out << "fn bench_discard(_frame: &[u8]) {}" << Qt::endl;
+        out << Qt::endl;
+        out << "/// Protocol callback of the sending core, nothing is received" << Qt::endl;
+        out << "fn bench_discard_cmd(_core: &LcsfCore, _valid_cmd: &LcsfValidCmd) {}" << Qt::endl;
+        out << Qt::endl;
+        out << "/// Protocol callback of the receiving core, decodes the command and counts it" << Qt::endl;
+        out << "fn bench_receive(_core: &LcsfCore, valid_cmd: &LcsfValidCmd) {" << Qt::endl;
+        out << "    std::hint::black_box(lcsf_protocol_" << rxSuffix << "::receive_cmd(valid_cmd));" << Qt::endl;
+        out << "    BENCH_EXEC_COUNT.with(|count| count.set(count.get() + 1));" << Qt::endl;
+        out << "}" << Qt::endl;
+        out << Qt::endl;
+
+        // Payload builders
+        for (Command *command : cmdList) {
+            if (!command->isTransmittable(isA) || (command->getAttArray().size() == 0)) {
+                continue;
+            }
+            out << "fn build_" << command->getName().toLower() << "(rng: &mut BenchRng) -> CmdPayload {" << Qt::endl;
+            out << "    CmdPayload::" << this->capitalize(command->getName()) << "Payload("
+                << this->capitalize(command->getName()) << "AttPayload {" << Qt::endl;
+            printBenchStruct_Rec(command->getName(), command->getAttArray(), &out, 2);
+            out << "    })" << Qt::endl;
+            out << "}" << Qt::endl;
+            out << Qt::endl;
+        }
+
+        // Benchmark loop
+        out << "/// Run the round trips of a command, return messages and bytes per second" << Qt::endl;
+        out << "///" << Qt::endl;
+        out << "/// tx_core: core encoding the commands" << Qt::endl;
+        out << "///" << Qt::endl;
+        out << "/// rx_core: core decoding the frames" << Qt::endl;
+        out << "///" << Qt::endl;
+        out << "/// cmd_name: command to benchmark" << Qt::endl;
+        out << "///" << Qt::endl;
+        out << "/// samples: payloads to cycle through" << Qt::endl;
+        out << "fn bench_cmd(" << Qt::endl;
+        out << "    tx_core: &LcsfCore," << Qt::endl;
+        out << "    rx_core: &mut LcsfCore," << Qt::endl;
+        out << "    cmd_name: CmdEnum," << Qt::endl;
+        out << "    samples: &[CmdPayload]," << Qt::endl;
+        out << ") -> Option<(f64, f64)> {" << Qt::endl;
+        out << "    let mut byte_nb: usize = 0;" << Qt::endl;
+        out << "    BENCH_EXEC_COUNT.with(|count| count.set(0));" << Qt::endl;
+        out << "    let start = Instant::now();" << Qt::endl;
+        out << "    for idx in 0..BENCH_ITERATIONS as usize {" << Qt::endl;
+        out << "        let valid_cmd = lcsf_protocol_" << protSuffix
+            << "::send_cmd(cmd_name, &samples[idx % samples.len()]);" << Qt::endl;
+        out << "        if !tx_core.send_cmd(lcsf_protocol_" << protSuffix << "::PROT_ID, &valid_cmd) {" << Qt::endl;
+        out << "            return None;" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "        let is_received = BENCH_FRAME.with(|frame| {" << Qt::endl;
+        out << "            let frame = frame.borrow();" << Qt::endl;
+        out << "            byte_nb += frame.len();" << Qt::endl;
+        out << "            rx_core.receive_buff(&frame)" << Qt::endl;
+        out << "        });" << Qt::endl;
+        out << "        if !is_received {" << Qt::endl;
+        out << "            return None;" << Qt::endl;
+        out << "        }" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << "    let elapsed = start.elapsed().as_secs_f64();" << Qt::endl;
+        out << "    if BENCH_EXEC_COUNT.with(|count| count.get()) != BENCH_ITERATIONS {" << Qt::endl;
+        out << "        return None;" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << "    if elapsed <= 0.0 {" << Qt::endl;
+        out << "        return Some((0.0, 0.0));" << Qt::endl;
+        out << "    }" << Qt::endl;
+        out << "    Some((BENCH_ITERATIONS as f64 / elapsed, byte_nb as f64 / elapsed))" << Qt::endl;
+        out << "}" << Qt::endl;
+        out << Qt::endl;
+        out << "/// Run the benchmark of every command sent by the side and print the results" << Qt::endl;
+        out << "///" << Qt::endl;
+        out << "/// Returns false if a round trip failed" << Qt::endl;
+        out << "pub fn run() -> bool {" << Qt::endl;
+        out << "    let mut rng = BenchRng { state: BENCH_SEED };" << Qt::endl;
+        out << "    let mut is_ok = true;" << Qt::endl;
+        out << "    let mut tx_core = LcsfCore::new(LcsfModeEnum::Normal, bench_send, false);" << Qt::endl;
+        out << "    let mut rx_core = LcsfCore::new(LcsfModeEnum::Normal, bench_discard, false);" << Qt::endl;
+        out << "    tx_core.add_protocol(" << Qt::endl;
+        out << "        lcsf_protocol_" << protSuffix << "::PROT_ID," << Qt::endl;
+        out << "        &lcsf_protocol_" << protSuffix << "::PROT_DESC," << Qt::endl;
+        out << "        bench_discard_cmd," << Qt::endl;
+        out << "    );" << Qt::endl;
+        out << "    rx_core.add_protocol(" << Qt::endl;
+        out << "        lcsf_protocol_" << rxSuffix << "::PROT_ID," << Qt::endl;
+        out << "        &lcsf_protocol_" << rxSuffix << "::PROT_DESC," << Qt::endl;
+        out << "        bench_receive," << Qt::endl;
+        out << "    );" << Qt::endl;
+        out << "    println!(\"{:<24} {:>16} {:>16}\", \"Command\", \"msg/s\", \"bytes/s\");" << Qt::endl;
+        for (Command *command : cmdList) {
+            if (!command->isTransmittable(isA)) {
+                continue;
+            }
+            out << "    let samples: Vec<CmdPayload> = (0..BENCH_SAMPLES).map(|_| ";
+            if (command->getAttArray().size() > 0) {
+                out << "build_" << command->getName().toLower() << "(&mut rng)";
+            } else {
+                out << "CmdPayload::Empty";
+            }
+            out << ").collect();" << Qt::endl;
+            out << "    match bench_cmd(&tx_core, &mut rx_core, CmdEnum::" << this->capitalize(command->getName())
+                << ", &samples) {" << Qt::endl;
+            out << "        Some((msg_rate, byte_rate)) => println!(\"{:<24} {:>16.0} {:>16.0}\", \""
+                << command->getName() << "\", msg_rate, byte_rate)," << Qt::endl;
+            out << "        None => {" << Qt::endl;
+            out << "            println!(\"{:<24} round trip failed\", \"" << command->getName() << "\");" << Qt::endl;
+            out << "            is_ok = false;" << Qt::endl;
+            out << "        }" << Qt::endl;
+            out << "    }" << Qt::endl;
+        }
+        out << "    is_ok" << Qt::endl;
         out << "}" << Qt::endl;
 
         file.close();
+        Profiler::addCounter("Bytes written", file.size());
     }
 }
@@ -0,0 +1,103 @@
+/**
+ * \file binding_roundtrip.cpp
+ * \brief Round trip through the generated Test C++ binding
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+
+#include "LCSF_Binding_Test.hpp"
+
+using namespace lcsf_test;
+
+static constexpr std::array<uint8_t, 5> Bytes = {0x01, 0x02, 0x03, 0x04, 0x05};
+
+// Checks the received payload against the sent one, byte arrays and strings by content
+static bool isCc2Equal(const Cc2Payload &sent, const Cc2Payload &recv) {
+    return (sent.sa1 == recv.sa1) && (sent.sa2 == recv.sa2) && (sent.sa3 == recv.sa3) &&
+           std::ranges::equal(sent.sa4, recv.sa4) && (sent.sa5 == recv.sa5) && (sent.sa6 == recv.sa6) &&
+           (sent.sa7 == recv.sa7) && (sent.sa8 == recv.sa8) && !recv.sa9.has_value() && (sent.sa10 == recv.sa10) &&
+           (sent.sa11 == recv.sa11) && (sent.sa12 == recv.sa12) && (sent.sa13 == recv.sa13);
+}
+
+static bool isCc6Equal(const Cc6Payload &sent, const Cc6Payload &recv) {
+    return std::ranges::equal(sent.sa4, recv.sa4) && (sent.ca9.sa1 == recv.ca9.sa1) &&
+           (sent.ca9.sa2 == recv.ca9.sa2) && (sent.ca9.sa3 == recv.ca9.sa3) && recv.ca10.has_value() &&
+           (sent.ca10->sa1 == recv.ca10->sa1) && (sent.ca10->ca11.sa1 == recv.ca10->ca11.sa1) &&
+           std::ranges::equal(sent.ca10->ca11.ca12.sa4, recv.ca10->ca11.ca12.sa4);
+}
+
+// Encodes the payload then receives it on the side, returns true if the handler saw the same payload
+template <Side side, typename T_Payload>
+static bool roundTrip(const T_Payload &sent, bool (*pFnIsEqual)(const T_Payload &, const T_Payload &)) {
+    std::array<uint8_t, 256> frame;
+    std::size_t frameSize = encode(sent, std::span<uint8_t>(frame));
+    bool isEqual = false;
+
+    if (frameSize == 0) {
+        return false;
+    }
+    bool isReceived = receive<side>(std::span<const uint8_t>(frame.data(), frameSize), [&](const auto &recv) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(recv)>, T_Payload>) {
+            isEqual = pFnIsEqual(sent, recv);
+        }
+    });
+    return isReceived && isEqual;
+}
+
+int main(void) {
+    int failNb = 0;
+    Cc2Payload cc2 = {};
+    Cc6Payload cc6 = {};
+    std::array<uint8_t, MAX_FRAME_SIZE<Sc1Payload>> sc1Frame;
+
+    cc2.sa1 = 0x12;
+    cc2.sa2 = 0x1234;
+    cc2.sa3 = 0x12345678;
+    cc2.sa4 = Bytes;
+    cc2.sa5 = "loopback";
+    cc2.sa7 = 0x4321;
+    cc2.sa10 = "optional";
+    cc2.sa11 = 0x0123456789abcdef;
+    cc2.sa12 = 1.5f;
+    cc2.sa13 = -2.25;
+    if (!roundTrip<Side::A>(cc2, isCc2Equal)) {
+        printf("CC2 round trip failed\n");
+        failNb++;
+    }
+    cc6.sa4 = std::span<const uint8_t>(Bytes).first(2);
+    cc6.ca9 = {0x34, 0x5678, 0x9abcdef0};
+    cc6.ca10 = Cc6Ca10Payload{0x56, {std::nullopt, {Bytes}}};
+    if (!roundTrip<Side::B>(cc6, isCc6Equal)) {
+        printf("CC6 round trip failed\n");
+        failNb++;
+    }
+    // SC1 is only received by B, A rejects it
+    std::size_t frameSize = encode(Sc1Payload{}, sc1Frame);
+    if ((frameSize != sc1Frame.size()) ||
+        receive<Side::A>(std::span<const uint8_t>(sc1Frame.data(), frameSize), [](const auto &) {}) ||
+        !receive<Side::B>(std::span<const uint8_t>(sc1Frame.data(), frameSize), [](const auto &) {})) {
+        printf("SC1 side dispatch failed\n");
+        failNb++;
+    }
+    printf("Binding round trip: %d failure(s)\n", failNb);
+    return (failNb == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
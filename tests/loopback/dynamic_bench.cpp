@@ -0,0 +1,310 @@
+/**
+ * \file dynamic_bench.cpp
+ * \brief Dynamic codec benchmark against the generated Test bridges, after checking both on the reference frames
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "deschandler.h"
+#include "dynamiccodec.h"
+#include "framecapture.h"
+#include "golden_frames.h"
+
+extern "C" {
+#include "LCSF_Loopback_Test.h"
+}
+
+// Random frames encoded per command and direction, decoded in turn
+#define BENCH_SAMPLES 16
+#define BENCH_MAX_DATA_SIZE 32
+#define BENCH_BUFFER_SIZE 2048
+
+// One direction of the loopback, the generated side that encodes and the one that decodes
+typedef struct {
+    const char *pName;
+    int (*pFnEncode)(uint_fast16_t cmdName, test_cmd_payload_t *pCmdPayload, uint8_t *pBuffer, size_t buffSize);
+    bool (*pFnReceive)(const uint8_t *pBuffer, size_t buffSize);
+} T_BenchLink;
+
+static const T_BenchLink BenchAToB = {"A->B", LCSF_Bridge_TestEncode_A, LCSF_ValidatorReceive_B};
+static const T_BenchLink BenchBToA = {"B->A", LCSF_Bridge_TestEncode_B, LCSF_ValidatorReceive_A};
+
+// Last command executed by a generated side
+static uint_fast16_t BenchRxCmdName;
+static test_cmd_payload_t BenchRxPayload;
+static uint32_t BenchRxCount;
+
+static quint32 BenchRandState = 1;
+
+// Checked frames, saved as a capture for the replay tools, one every millisecond
+static QList<FrameCapture::T_Record> BenchRecords;
+
+static bool benchStore(uint_fast16_t cmdName, test_cmd_payload_t *pCmdPayload) {
+    BenchRxCmdName = cmdName;
+    if (pCmdPayload != NULL) {
+        BenchRxPayload = *pCmdPayload;
+    }
+    BenchRxCount++;
+    return true;
+}
+
+extern "C" bool Test_MainExecute_A(uint_fast16_t cmdName, test_cmd_payload_t *pCmdPayload) {
+    return benchStore(cmdName, pCmdPayload);
+}
+
+extern "C" bool Test_MainExecute_B(uint_fast16_t cmdName, test_cmd_payload_t *pCmdPayload) {
+    return benchStore(cmdName, pCmdPayload);
+}
+
+// Xorshift generator, the frames are the same on every run
+static quint32 benchRand(void) {
+    BenchRandState ^= BenchRandState << 13;
+    BenchRandState ^= BenchRandState >> 17;
+    BenchRandState ^= BenchRandState << 5;
+    return BenchRandState;
+}
+
+static void fillValues_Rec(const DynamicCodec &codec, QVector<DynamicCodec::T_Value> &values) {
+    for (DynamicCodec::T_Value &value : values) {
+        const DynamicCodec::T_Node &node = codec.getNode(value.nodeIdx);
+
+        value.isPresent = !node.isOptional || ((benchRand() & 1) != 0);
+        if (!value.isPresent) {
+            continue;
+        }
+        switch (node.dataType) {
+            case NS_AttDataType::UINT8:
+                value.uintValue = (quint8)benchRand();
+                break;
+            case NS_AttDataType::UINT16:
+                value.uintValue = (quint16)benchRand();
+                break;
+            case NS_AttDataType::UINT32:
+                value.uintValue = benchRand();
+                break;
+            case NS_AttDataType::UINT64:
+                value.uintValue = ((quint64)benchRand() << 32) | benchRand();
+                break;
+            case NS_AttDataType::FLOAT32:
+                value.realValue = (float)benchRand() / 4294967296.0f;
+                break;
+            case NS_AttDataType::FLOAT64:
+                value.realValue = (double)benchRand() / 4294967296.0;
+                break;
+            case NS_AttDataType::STRING:
+                value.data.resize(benchRand() % BENCH_MAX_DATA_SIZE);
+                for (int idx = 0; idx < value.data.size(); idx++) {
+                    value.data[idx] = (char)('a' + (benchRand() % 26));
+                }
+                break;
+            case NS_AttDataType::BYTE_ARRAY:
+                value.data.resize(1 + (benchRand() % BENCH_MAX_DATA_SIZE));
+                for (int idx = 0; idx < value.data.size(); idx++) {
+                    value.data[idx] = (char)benchRand();
+                }
+                break;
+            case NS_AttDataType::SUB_ATTRIBUTES:
+                fillValues_Rec(codec, value.subValues);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+static double getRate(qint64 elapsedNs, int iterations) {
+    return (elapsedNs > 0) ? (iterations * 1e9 / elapsedNs) : 0.0;
+}
+
+/**
+ * \fn static bool benchCommand(const DynamicCodec &codec, Command *pCmd, const T_BenchLink *pLink, int iterations)
+ * \brief Check the dynamic codec and the generated code agree on random frames of a command, then time both
+ *
+ * \param codec compiled dynamic codec
+ * \param pCmd pointer to the command
+ * \param pLink pointer to the generated link
+ * \param iterations number of timed decodes and encodes
+ * \return bool: true if both codecs produced the same frames
+ */
+static bool benchCommand(const DynamicCodec &codec, Command *pCmd, const T_BenchLink *pLink, int iterations) {
+    QVector<QByteArray> frames;
+    QVector<DynamicCodec::T_Message> msgs(BENCH_SAMPLES);
+    QVector<test_cmd_payload_t> payloads(BENCH_SAMPLES);
+    uint_fast16_t cmdName = 0;
+    uint8_t buffer[BENCH_BUFFER_SIZE];
+    QByteArray frame;
+    QElapsedTimer timer;
+    qint64 elapsedNs[4];
+
+    // Frames are built by the dynamic codec, the generated code must decode them and encode them back identically
+    frames.reserve(BENCH_SAMPLES);
+    for (int idx = 0; idx < BENCH_SAMPLES; idx++) {
+        DynamicCodec::T_Message &msg = msgs[idx];
+
+        codec.initMessage(pCmd->getId(), msg);
+        fillValues_Rec(codec, msg.attValues);
+        if (codec.encode(msg, frame) != DynamicCodec::CODEC_OK) {
+            return false;
+        }
+        frames.append(frame);
+        uint32_t rxCount = BenchRxCount;
+        if (!pLink->pFnReceive((const uint8_t *)frames[idx].constData(), frames[idx].size()) ||
+            (BenchRxCount != (rxCount + 1))) {
+            return false;
+        }
+        cmdName = BenchRxCmdName;
+        payloads[idx] = BenchRxPayload;
+        int frameSize = pLink->pFnEncode(cmdName, &(payloads[idx]), buffer, sizeof(buffer));
+        if ((frameSize != frames[idx].size()) || (std::memcmp(buffer, frames[idx].constData(), frameSize) != 0)) {
+            return false;
+        }
+        if ((codec.decode(frames[idx], msg) != DynamicCodec::CODEC_OK) ||
+            (codec.encode(msg, frame) != DynamicCodec::CODEC_OK) || !(frame == frames[idx])) {
+            return false;
+        }
+        BenchRecords.append({(quint64)BenchRecords.size() * 1000, codec.getProtocolId(), frames[idx]});
+    }
+    // Decode
+    timer.start();
+    for (int idx = 0; idx < iterations; idx++) {
+        codec.decode(frames.at(idx % BENCH_SAMPLES), msgs[idx % BENCH_SAMPLES]);
+    }
+    elapsedNs[0] = timer.nsecsElapsed();
+    timer.start();
+    for (int idx = 0; idx < iterations; idx++) {
+        const QByteArray &sample = frames.at(idx % BENCH_SAMPLES);
+        pLink->pFnReceive((const uint8_t *)sample.constData(), sample.size());
+    }
+    elapsedNs[1] = timer.nsecsElapsed();
+    // Encode
+    timer.start();
+    for (int idx = 0; idx < iterations; idx++) {
+        codec.encode(msgs.at(idx % BENCH_SAMPLES), frame);
+    }
+    elapsedNs[2] = timer.nsecsElapsed();
+    timer.start();
+    for (int idx = 0; idx < iterations; idx++) {
+        pLink->pFnEncode(cmdName, &(payloads[idx % BENCH_SAMPLES]), buffer, sizeof(buffer));
+    }
+    elapsedNs[3] = timer.nsecsElapsed();
+    printf("%-24s %-6s %14.0f %14.0f %14.0f %14.0f\n", pCmd->getName().toLatin1().constData(), pLink->pName,
+        getRate(elapsedNs[0], iterations), getRate(elapsedNs[1], iterations), getRate(elapsedNs[2], iterations),
+        getRate(elapsedNs[3], iterations));
+    return true;
+}
+
+/**
+ * \fn static bool checkGolden(const DynamicCodec &codec)
+ * \brief Check the dynamic codec and the generated code decode the reference frames and encode them back identically
+ *
+ * \param codec compiled dynamic codec
+ * \return bool: true if both codecs reproduced every frame
+ */
+static bool checkGolden(const DynamicCodec &codec) {
+    DynamicCodec::T_Message msg;
+    uint8_t buffer[BENCH_BUFFER_SIZE];
+    QByteArray frame;
+    bool isOk = true;
+
+    for (size_t idx = 0; idx < LCSF_GOLDEN_FRAME_NB; idx++) {
+        const lcsf_golden_frame_t *pGolden = &(LcsfGoldenFrames[idx]);
+        const T_BenchLink *pLink = (pGolden->IsAToB) ? &BenchAToB : &BenchBToA;
+        QByteArray golden((const char *)pGolden->pFrame, (int)pGolden->FrameSize);
+        uint32_t rxCount = BenchRxCount;
+        int frameSize = -1;
+
+        if ((codec.decode(golden, msg) != DynamicCodec::CODEC_OK) || (codec.encode(msg, frame) != DynamicCodec::CODEC_OK) ||
+            !(frame == golden)) {
+            printf("%-24s %-6s reference frame rejected by the dynamic codec\n", pGolden->pName, pLink->pName);
+            isOk = false;
+            continue;
+        }
+        if (pLink->pFnReceive(pGolden->pFrame, pGolden->FrameSize) && (BenchRxCount == (rxCount + 1))) {
+            frameSize = pLink->pFnEncode(BenchRxCmdName, &BenchRxPayload, buffer, sizeof(buffer));
+        }
+        if ((frameSize != golden.size()) || (std::memcmp(buffer, pGolden->pFrame, pGolden->FrameSize) != 0)) {
+            printf("%-24s %-6s reference frame rejected by the generated code\n", pGolden->pName, pLink->pName);
+            isOk = false;
+            continue;
+        }
+        BenchRecords.append({(quint64)BenchRecords.size() * 1000, codec.getProtocolId(), golden});
+    }
+    return isOk;
+}
+
+int main(int argc, char *argv[]) {
+    QList<Command *> cmdArray;
+    QString protocolName, protocolId, protocolVersion, protocolDesc;
+    DynamicCodec codec;
+    int iterations = 100000;
+    int ret = EXIT_SUCCESS;
+
+    if (argc < 2) {
+        printf("Usage: %s <description.json> [iterations] [capture]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (argc > 2) {
+        iterations = atoi(argv[2]);
+    }
+    QFile descFile(argv[1]);
+    if (!descFile.open(QIODevice::ReadOnly)) {
+        printf("Couldn't open file: %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    DescHandler::load_desc(descFile, cmdArray, protocolName, protocolId, protocolVersion, protocolDesc);
+    descFile.close();
+    if (!codec.compile(protocolId.toUShort(nullptr, 16), cmdArray)) {
+        printf("Couldn't compile protocol %s\n", protocolName.toLatin1().constData());
+        return EXIT_FAILURE;
+    }
+    if (!LCSF_Bridge_TestInit_A() || !LCSF_Bridge_TestInit_B() || !LCSF_ValidatorAddProtocol_A(0, &LCSF_Test_ProtDesc_A) ||
+        !LCSF_ValidatorAddProtocol_B(0, &LCSF_Test_ProtDesc_B)) {
+        printf("Initialization failed\n");
+        return EXIT_FAILURE;
+    }
+    if (!checkGolden(codec)) {
+        ret = EXIT_FAILURE;
+    }
+    printf("%-24s %-6s %14s %14s %14s %14s\n", "Command", "Link", "dyn dec/s", "gen dec/s", "dyn enc/s", "gen enc/s");
+    for (Command *command : cmdArray) {
+        QList<const T_BenchLink *> links;
+
+        if (command->isTransmittable(true)) {
+            links.append(&BenchAToB);
+        }
+        if (command->isTransmittable(false)) {
+            links.append(&BenchBToA);
+        }
+        for (const T_BenchLink *pLink : links) {
+            if (!benchCommand(codec, command, pLink, iterations)) {
+                printf("%-24s %-6s codecs disagree\n", command->getName().toLatin1().constData(), pLink->pName);
+                ret = EXIT_FAILURE;
+            }
+        }
+    }
+    if ((argc > 3) && !FrameCapture::save(argv[3], BenchRecords)) {
+        printf("Couldn't save capture: %s\n", argv[3]);
+        ret = EXIT_FAILURE;
+    }
+    return ret;
+}
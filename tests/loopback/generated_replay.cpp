@@ -0,0 +1,102 @@
+/**
+ * \file generated_replay.cpp
+ * \brief Capture replay through the generated Test bridges
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#include <QFile>
+#include <QHash>
+#include <cstdio>
+#include <cstdlib>
+
+#include "deschandler.h"
+#include "framecapture.h"
+#include "framereplay.h"
+
+extern "C" {
+#include "LCSF_Loopback_Test.h"
+}
+
+typedef bool (*T_ReceiveFn)(const uint8_t *pBuffer, size_t buffSize);
+
+// Commands executed by the generated sides
+static uint32_t ReplayRxCount;
+
+extern "C" bool Test_MainExecute_A(uint_fast16_t cmdName, test_cmd_payload_t *pCmdPayload) {
+    (void)cmdName;
+    (void)pCmdPayload;
+    ReplayRxCount++;
+    return true;
+}
+
+extern "C" bool Test_MainExecute_B(uint_fast16_t cmdName, test_cmd_payload_t *pCmdPayload) {
+    (void)cmdName;
+    (void)pCmdPayload;
+    ReplayRxCount++;
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    QList<Command *> cmdArray;
+    QString protocolName, protocolId, protocolVersion, protocolDesc;
+    QList<FrameCapture::T_Record> records;
+    QHash<int, T_ReceiveFn> receivers;
+    QString error;
+    int passNb = 1;
+
+    if (argc < 3) {
+        printf("Usage: %s <description.json> <capture> [passes]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (argc > 3) {
+        passNb = atoi(argv[3]);
+    }
+    QFile descFile(argv[1]);
+    if (!descFile.open(QIODevice::ReadOnly)) {
+        printf("Couldn't open file: %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    DescHandler::load_desc(descFile, cmdArray, protocolName, protocolId, protocolVersion, protocolDesc);
+    descFile.close();
+    if (!FrameCapture::load(argv[2], records, error)) {
+        printf("Couldn't load capture: %s, reason: %s\n", argv[2], error.toLatin1().constData());
+        return EXIT_FAILURE;
+    }
+    if (!LCSF_Bridge_TestInit_A() || !LCSF_Bridge_TestInit_B() || !LCSF_ValidatorAddProtocol_A(0, &LCSF_Test_ProtDesc_A) ||
+        !LCSF_ValidatorAddProtocol_B(0, &LCSF_Test_ProtDesc_B)) {
+        printf("Initialization failed\n");
+        return EXIT_FAILURE;
+    }
+    // A frame is received by the side it is sent to, B for the bidirectional commands
+    for (Command *pCmd : cmdArray) {
+        receivers.insert(pCmd->getId(), pCmd->isTransmittable(true) ? LCSF_ValidatorReceive_B : LCSF_ValidatorReceive_A);
+    }
+    auto decodeFn = [&receivers](const uchar *pFrame, int frameSize) {
+        int cmdId = (frameSize >= 4) ? (pFrame[2] | (pFrame[3] << 8)) : -1;
+        T_ReceiveFn pFnReceive = receivers.value(cmdId, nullptr);
+        uint32_t rxCount = ReplayRxCount;
+
+        if ((pFnReceive == nullptr) || !pFnReceive(pFrame, frameSize) || (ReplayRxCount != (rxCount + 1))) {
+            return -1;
+        }
+        return cmdId;
+    };
+    FrameReplay::T_Report report = FrameReplay::run(records, protocolId.toUShort(nullptr, 16), passNb, decodeFn);
+    printf("%s", FrameReplay::formatReport(report, cmdArray).toLatin1().constData());
+    return ((report.total.frameNb > 0) && (report.rejectedNb == 0)) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,153 @@
+/**
+ * \file golden_frames.h
+ * \brief Reference frames of the Test protocol (example/Test.json) checked by the loopback and the dynamic codec
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+
+    The frames are written field by field in the LCSF_C_Stack layout, independently from the generated encoders and
+    the minimal stack: 2 bytes little endian fields (protocol id, command id, attribute number), then each attribute
+    id, with LCSF_CMPLX_FLAG for the complex ones, its data size or sub-attribute number, and its data. Unsigned
+    integers take their minimal size, strings end with their terminator and floats are little endian IEEE 754.
+    Attributes follow the description order, so each frame must be encoded back byte for byte.
+ */
+
+#ifndef GOLDEN_FRAMES_H
+#define GOLDEN_FRAMES_H
+
+// *** Libraries include ***
+// Standard lib
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *** Definitions ***
+// --- Public Types ---
+
+typedef struct _lcsf_golden_frame {
+    const char *pName;
+    bool IsAToB; // Sent by A to B, else by B to A
+    const uint8_t *pFrame;
+    size_t FrameSize;
+} lcsf_golden_frame_t;
+
+// --- Public Constants ---
+
+// Commands without attributes
+static const uint8_t LcsfGoldenSC1[] = {0x55, 0x00, 0x00, 0x00, 0x00, 0x00};
+static const uint8_t LcsfGoldenSC2[] = {0x55, 0x00, 0x01, 0x00, 0x00, 0x00};
+static const uint8_t LcsfGoldenSC3[] = {0x55, 0x00, 0x02, 0x00, 0x00, 0x00};
+
+// Mandatory attributes only, zero on a single byte
+static const uint8_t LcsfGoldenCC1[] = {
+    0x55, 0x00, 0x03, 0x00, 0x08, 0x00,
+    0x00, 0x00, 0x01, 0x00, 0x00,                                                 // SA1 = 0
+    0x01, 0x00, 0x02, 0x00, 0x34, 0x12,                                           // SA2 = 0x1234
+    0x02, 0x00, 0x03, 0x00, 0x89, 0x67, 0x05,                                     // SA3 = 0x56789
+    0x03, 0x00, 0x04, 0x00, 0xDE, 0xAD, 0xBE, 0xEF,                               // SA4
+    0x04, 0x00, 0x05, 0x00, 'l', 'c', 's', 'f', 0x00,                             // SA5 = "lcsf"
+    0x0A, 0x00, 0x08, 0x00, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01,       // SA11 = 0x0102030405060708
+    0x0B, 0x00, 0x04, 0x00, 0x00, 0x00, 0xC0, 0x3F,                               // SA12 = 1.5
+    0x0C, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xC0,       // SA13 = -2.25
+};
+
+// Every optional attribute, wide types holding small values and an empty string
+static const uint8_t LcsfGoldenCC2[] = {
+    0x55, 0x00, 0x04, 0x00, 0x0D, 0x00,
+    0x00, 0x00, 0x01, 0x00, 0xFF,                                                 // SA1 = 0xFF
+    0x01, 0x00, 0x01, 0x00, 0x7F,                                                 // SA2 = 0x7F
+    0x02, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x80,                               // SA3 = 0x80000000
+    0x03, 0x00, 0x01, 0x00, 0x00,                                                 // SA4
+    0x04, 0x00, 0x01, 0x00, 0x00,                                                 // SA5 = ""
+    0x05, 0x00, 0x01, 0x00, 0x2A,                                                 // SA6 = 42
+    0x06, 0x00, 0x02, 0x00, 0x00, 0x01,                                           // SA7 = 0x100
+    0x07, 0x00, 0x04, 0x00, 0xFF, 0xFF, 0xFF, 0xFF,                               // SA8 = 0xFFFFFFFF
+    0x08, 0x00, 0x02, 0x00, 0x00, 0xFF,                                           // SA9
+    0x09, 0x00, 0x03, 0x00, 'A', 'B', 0x00,                                       // SA10 = "AB"
+    0x0A, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,                         // SA11 = 0x100000000
+    0x0B, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00,                               // SA12 = 0.0
+    0x0C, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x3F,       // SA13 = 1.0
+};
+
+// Bidirectional, sent by B, some optional attributes
+static const uint8_t LcsfGoldenCC3[] = {
+    0x55, 0x00, 0x05, 0x00, 0x0A, 0x00,
+    0x00, 0x00, 0x01, 0x00, 0x01,                                                 // SA1 = 1
+    0x01, 0x00, 0x02, 0x00, 0xFF, 0xFF,                                           // SA2 = 0xFFFF
+    0x02, 0x00, 0x01, 0x00, 0x00,                                                 // SA3 = 0
+    0x03, 0x00, 0x03, 0x00, 0x01, 0x02, 0x03,                                     // SA4
+    0x04, 0x00, 0x03, 0x00, 'h', 'i', 0x00,                                       // SA5 = "hi"
+    0x06, 0x00, 0x01, 0x00, 0x10,                                                 // SA7 = 0x10
+    0x09, 0x00, 0x02, 0x00, 'z', 0x00,                                            // SA10 = "z"
+    0x0A, 0x00, 0x08, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,       // SA11 = 0xFFFFFFFFFFFFFFFF
+    0x0B, 0x00, 0x04, 0x00, 0x00, 0x00, 0x80, 0xBF,                               // SA12 = -1.0
+    0x0C, 0x00, 0x08, 0x00, 0x18, 0x2D, 0x44, 0x54, 0xFB, 0x21, 0x09, 0x40,       // SA13 = pi
+};
+
+// Nested complex attributes, optional ones left out at each level
+static const uint8_t LcsfGoldenCC4[] = {
+    0x55, 0x00, 0x06, 0x00, 0x03, 0x00,
+    0x00, 0x00, 0x01, 0x00, 0x05,                                                 // SA1 = 5
+    0x0A, 0x80, 0x02, 0x00,                                                       // CA1, 2 sub-attributes
+    0x00, 0x00, 0x01, 0x00, 0x01,                                                 //   SA1 = 1
+    0x01, 0x00, 0x02, 0x00, 0x03, 0x02,                                           //   SA2 = 0x203
+    0x0B, 0x80, 0x01, 0x00,                                                       // CA2, 1 sub-attribute
+    0x0B, 0x80, 0x02, 0x00,                                                       //   CA3, 2 sub-attributes
+    0x00, 0x00, 0x01, 0x00, 0x09,                                                 //     SA1 = 9
+    0x0A, 0x80, 0x01, 0x00,                                                       //     CA4, 1 sub-attribute
+    0x03, 0x00, 0x03, 0x00, 0xAA, 0xBB, 0xCC,                                     //       SA4
+};
+
+// Optional complex attribute left out
+static const uint8_t LcsfGoldenCC5[] = {
+    0x55, 0x00, 0x07, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x02, 0x00, 0x00, 0x80,                                           // SA2 = 0x8000
+    0x0A, 0x80, 0x03, 0x00,                                                       // CA5, 3 sub-attributes
+    0x00, 0x00, 0x01, 0x00, 0x00,                                                 //   SA1 = 0
+    0x01, 0x00, 0x01, 0x00, 0x01,                                                 //   SA2 = 1
+    0x02, 0x00, 0x04, 0x00, 0x78, 0x56, 0x34, 0x12,                               //   SA3 = 0x12345678
+};
+
+// Bidirectional, sent by A, every complex attribute
+static const uint8_t LcsfGoldenCC6[] = {
+    0x55, 0x00, 0x08, 0x00, 0x03, 0x00,
+    0x03, 0x00, 0x05, 0x00, 0x01, 0x23, 0x45, 0x67, 0x89,                         // SA4
+    0x0A, 0x80, 0x03, 0x00,                                                       // CA9, 3 sub-attributes
+    0x00, 0x00, 0x01, 0x00, 0x80,                                                 //   SA1 = 0x80
+    0x01, 0x00, 0x02, 0x00, 0xCD, 0xAB,                                           //   SA2 = 0xABCD
+    0x02, 0x00, 0x02, 0x00, 0xEF, 0xBE,                                           //   SA3 = 0xBEEF
+    0x0B, 0x80, 0x02, 0x00,                                                       // CA10, 2 sub-attributes
+    0x00, 0x00, 0x01, 0x00, 0x03,                                                 //   SA1 = 3
+    0x0B, 0x80, 0x01, 0x00,                                                       //   CA11, 1 sub-attribute
+    0x0A, 0x80, 0x01, 0x00,                                                       //     CA12, 1 sub-attribute
+    0x03, 0x00, 0x01, 0x00, 0x7E,                                                 //       SA4
+};
+
+static const lcsf_golden_frame_t LcsfGoldenFrames[] = {
+    {"SC1", true, LcsfGoldenSC1, sizeof(LcsfGoldenSC1)},
+    {"SC2", false, LcsfGoldenSC2, sizeof(LcsfGoldenSC2)},
+    {"SC3", true, LcsfGoldenSC3, sizeof(LcsfGoldenSC3)},
+    {"CC1", true, LcsfGoldenCC1, sizeof(LcsfGoldenCC1)},
+    {"CC2", false, LcsfGoldenCC2, sizeof(LcsfGoldenCC2)},
+    {"CC3", false, LcsfGoldenCC3, sizeof(LcsfGoldenCC3)},
+    {"CC4", true, LcsfGoldenCC4, sizeof(LcsfGoldenCC4)},
+    {"CC5", false, LcsfGoldenCC5, sizeof(LcsfGoldenCC5)},
+    {"CC6", true, LcsfGoldenCC6, sizeof(LcsfGoldenCC6)},
+};
+
+#define LCSF_GOLDEN_FRAME_NB (sizeof(LcsfGoldenFrames) / sizeof(LcsfGoldenFrames[0]))
+
+#endif // GOLDEN_FRAMES_H
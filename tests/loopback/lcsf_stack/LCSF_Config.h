@@ -0,0 +1,46 @@
+/**
+ * \file LCSF_Config.h
+ * \brief Configuration of the LCSF reference stack used by the loopback harness
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#ifndef LCSF_CONFIG_H
+#define LCSF_CONFIG_H
+
+// *** Libraries include ***
+// Standard lib
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *** Definitions ***
+// --- Public Constants ---
+
+// Define LCSF_SMALL to use 1 byte frame fields instead of 2
+
+// Number of protocols the validator can handle
+#ifndef LCSF_VALIDATOR_PROTOCOL_NB
+#define LCSF_VALIDATOR_PROTOCOL_NB 1
+#endif
+
+// Number of attributes the validator can decode in a single frame
+#ifndef LCSF_VALIDATOR_RX_ATT_NB
+#define LCSF_VALIDATOR_RX_ATT_NB 64
+#endif
+
+#endif // LCSF_CONFIG_H
@@ -0,0 +1,44 @@
+/**
+ * \file LCSF_Transcoder.h
+ * \brief LCSF frame field definitions, minimal reference stack used by the loopback harness
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#ifndef LCSF_TRANSCODER_H
+#define LCSF_TRANSCODER_H
+
+// *** Libraries include ***
+// Standard lib
+// Custom lib
+#include <LCSF_Config.h>
+#include <lib/LCSF_Validator.h>
+
+// *** Definitions ***
+// --- Public Constants ---
+
+#ifdef LCSF_SMALL
+#define LCSF_FIELD_SIZE 1
+#define LCSF_FIELD_MAX 0xFF
+#define LCSF_CMPLX_FLAG 0x80
+#else
+#define LCSF_FIELD_SIZE 2
+#define LCSF_FIELD_MAX 0xFFFF
+#define LCSF_CMPLX_FLAG 0x8000
+#endif
+
+#endif // LCSF_TRANSCODER_H
@@ -0,0 +1,373 @@
+/**
+ * \file LCSF_Validator.c
+ * \brief LCSF frame validator and encoder, minimal reference stack used by the loopback harness
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+// *** Libraries include ***
+// Standard lib
+#include <string.h>
+// Custom lib
+#include <LCSF_Config.h>
+#include <lib/LCSF_Transcoder.h>
+#include <lib/LCSF_Validator.h>
+#include <lib/Lifo.h>
+
+// *** Definitions ***
+// --- Private Types ---
+
+// Frame cursor, used for reading and writing
+typedef struct _lcsf_validator_cursor {
+    uint8_t *pBuffer;
+    size_t buffSize;
+    size_t idx;
+} lcsf_validator_cursor_t;
+
+// Module information structure
+typedef struct _lcsf_validator_info {
+    const lcsf_validator_protocol_desc_t *pProtArray[LCSF_VALIDATOR_PROTOCOL_NB];
+    lifo_desc_t RxLifo;
+    lcsf_valid_att_t RxAttArray[LCSF_VALIDATOR_RX_ATT_NB];
+} lcsf_validator_info_t;
+
+// --- Private Variables ---
+static lcsf_validator_info_t LcsfValidatorInfo;
+
+// *** End Definitions ***
+
+// *** Private Functions ***
+
+/**
+ * \fn static const lcsf_validator_protocol_desc_t *LCSF_ValidatorGetProtocol(uint_fast16_t protId)
+ * \brief Find a registered protocol from its identifier
+ *
+ * \param protId protocol identifier
+ * \return const lcsf_validator_protocol_desc_t *: pointer to the protocol, NULL if unknown
+ */
+static const lcsf_validator_protocol_desc_t *LCSF_ValidatorGetProtocol(uint_fast16_t protId) {
+    for (uint_fast8_t idx = 0; idx < LCSF_VALIDATOR_PROTOCOL_NB; idx++) {
+        const lcsf_validator_protocol_desc_t *pProt = LcsfValidatorInfo.pProtArray[idx];
+
+        if ((pProt != NULL) && (pProt->ProtId == protId)) {
+            return pProt;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \fn static const lcsf_command_desc_t *LCSF_ValidatorGetCommand(const lcsf_protocol_desc_t *pProtDesc, uint_fast16_t cmdId)
+ * \brief Find a command descriptor from its identifier
+ *
+ * \param pProtDesc pointer to the protocol descriptor
+ * \param cmdId command identifier
+ * \return const lcsf_command_desc_t *: pointer to the command descriptor, NULL if unknown
+ */
+static const lcsf_command_desc_t *LCSF_ValidatorGetCommand(const lcsf_protocol_desc_t *pProtDesc, uint_fast16_t cmdId) {
+    for (uint_fast16_t idx = 0; idx < pProtDesc->CmdNb; idx++) {
+        if (pProtDesc->pCmdDescArray[idx].CmdId == cmdId) {
+            return &(pProtDesc->pCmdDescArray[idx]);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \fn static bool LCSF_ValidatorReadField(lcsf_validator_cursor_t *pCursor, uint_fast16_t *pValue)
+ * \brief Read a little endian frame field
+ *
+ * \param pCursor pointer to the frame cursor
+ * \param pValue pointer to contain the field value
+ * \return bool: true if the field was in the frame
+ */
+static bool LCSF_ValidatorReadField(lcsf_validator_cursor_t *pCursor, uint_fast16_t *pValue) {
+    if ((pCursor->buffSize - pCursor->idx) < LCSF_FIELD_SIZE) {
+        return false;
+    }
+    *pValue = 0;
+    for (uint_fast8_t idx = 0; idx < LCSF_FIELD_SIZE; idx++) {
+        *pValue |= (uint_fast16_t)pCursor->pBuffer[pCursor->idx++] << (8 * idx);
+    }
+    return true;
+}
+
+/**
+ * \fn static bool LCSF_ValidatorWriteField(lcsf_validator_cursor_t *pCursor, uint_fast16_t value)
+ * \brief Write a little endian frame field
+ *
+ * \param pCursor pointer to the frame cursor
+ * \param value field value
+ * \return bool: true if the value fits the field and the buffer
+ */
+static bool LCSF_ValidatorWriteField(lcsf_validator_cursor_t *pCursor, uint_fast16_t value) {
+    if ((value > LCSF_FIELD_MAX) || ((pCursor->buffSize - pCursor->idx) < LCSF_FIELD_SIZE)) {
+        return false;
+    }
+    for (uint_fast8_t idx = 0; idx < LCSF_FIELD_SIZE; idx++) {
+        pCursor->pBuffer[pCursor->idx++] = (uint8_t)(value >> (8 * idx));
+    }
+    return true;
+}
+
+/**
+ * \fn static bool LCSF_ValidatorCheckData(uint_fast8_t dataType, const uint8_t *pData, uint_fast16_t dataSize)
+ * \brief Check the size and content of an attribute data against its type
+ *
+ * \param dataType attribute data type
+ * \param pData pointer to the data
+ * \param dataSize data size
+ * \return bool: true if the data is valid
+ */
+static bool LCSF_ValidatorCheckData(uint_fast8_t dataType, const uint8_t *pData, uint_fast16_t dataSize) {
+    if (dataSize == 0) {
+        return false;
+    }
+    switch (dataType) {
+        case LCSF_UINT8:
+            return dataSize <= sizeof(uint8_t);
+        case LCSF_UINT16:
+            return dataSize <= sizeof(uint16_t);
+        case LCSF_UINT32:
+            return dataSize <= sizeof(uint32_t);
+        case LCSF_UINT64:
+            return dataSize <= sizeof(uint64_t);
+        case LCSF_FLOAT32:
+            return dataSize == sizeof(float);
+        case LCSF_FLOAT64:
+            return dataSize == sizeof(double);
+        case LCSF_STRING:
+            return pData[dataSize - 1] == '\0';
+        case LCSF_BYTE_ARRAY:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * \fn static bool LCSF_ValidatorDecodeAtt(lcsf_validator_cursor_t *pCursor, uint_fast16_t attNb, uint_fast16_t descNb,
+ *  const lcsf_attribute_desc_t *pDescArray, lcsf_valid_att_t **pAttArrayAddr)
+ * \brief Recursively decode an attribute array in descriptor order
+ *
+ * \param pCursor pointer to the frame cursor
+ * \param attNb number of attributes in the frame
+ * \param descNb number of attribute descriptors
+ * \param pDescArray pointer to the attribute descriptors
+ * \param pAttArrayAddr pointer to contain the attribute array
+ * \return bool: true if the attributes are valid
+ */
+static bool LCSF_ValidatorDecodeAtt(lcsf_validator_cursor_t *pCursor, uint_fast16_t attNb, uint_fast16_t descNb,
+    const lcsf_attribute_desc_t *pDescArray, lcsf_valid_att_t **pAttArrayAddr) {
+    if ((attNb > descNb) || !LifoGet(&LcsfValidatorInfo.RxLifo, descNb, (void **)pAttArrayAddr)) {
+        return false;
+    }
+    lcsf_valid_att_t *pAttArray = *pAttArrayAddr;
+
+    for (uint_fast16_t idx = 0; idx < descNb; idx++) {
+        pAttArray[idx].PayloadSize = 0;
+        pAttArray[idx].Payload.pData = NULL;
+    }
+    for (uint_fast16_t attIdx = 0; attIdx < attNb; attIdx++) {
+        uint_fast16_t attId;
+        uint_fast16_t dataSize;
+        uint_fast16_t descIdx = 0;
+
+        if (!LCSF_ValidatorReadField(pCursor, &attId) || !LCSF_ValidatorReadField(pCursor, &dataSize)) {
+            return false;
+        }
+        bool isComplex = (attId & LCSF_CMPLX_FLAG) != 0;
+        attId &= ~LCSF_CMPLX_FLAG;
+        // Find descriptor, reject unknown and duplicate attributes
+        while ((descIdx < descNb) && (pDescArray[descIdx].AttId != attId)) {
+            descIdx++;
+        }
+        if ((descIdx >= descNb) || (pAttArray[descIdx].Payload.pData != NULL)) {
+            return false;
+        }
+        const lcsf_attribute_desc_t *pDesc = &(pDescArray[descIdx]);
+        if (isComplex != (pDesc->DataType == LCSF_SUB_ATTRIBUTES)) {
+            return false;
+        }
+        pAttArray[descIdx].PayloadSize = (uint16_t)dataSize;
+        if (isComplex) {
+            if (!LCSF_ValidatorDecodeAtt(pCursor, dataSize, pDesc->SubAttNb, pDesc->pSubAttDescArray,
+                    &(pAttArray[descIdx].Payload.pSubAttArray))) {
+                return false;
+            }
+        } else {
+            if (((pCursor->buffSize - pCursor->idx) < dataSize) ||
+                !LCSF_ValidatorCheckData(pDesc->DataType, &(pCursor->pBuffer[pCursor->idx]), dataSize)) {
+                return false;
+            }
+            pAttArray[descIdx].Payload.pData = &(pCursor->pBuffer[pCursor->idx]);
+            pCursor->idx += dataSize;
+        }
+    }
+    // Check mandatory attributes
+    for (uint_fast16_t idx = 0; idx < descNb; idx++) {
+        if (!pDescArray[idx].IsOptional && (pAttArray[idx].Payload.pData == NULL)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * \fn static uint_fast16_t LCSF_ValidatorGetAttNb(uint_fast16_t descNb, const lcsf_valid_att_t *pAttArray)
+ * \brief Count the present attributes of an array
+ *
+ * \param descNb number of attribute descriptors
+ * \param pAttArray pointer to the attribute array
+ * \return uint_fast16_t: number of present attributes
+ */
+static uint_fast16_t LCSF_ValidatorGetAttNb(uint_fast16_t descNb, const lcsf_valid_att_t *pAttArray) {
+    uint_fast16_t attNb = 0;
+
+    if (pAttArray == NULL) {
+        return 0;
+    }
+    for (uint_fast16_t idx = 0; idx < descNb; idx++) {
+        if (pAttArray[idx].Payload.pData != NULL) {
+            attNb++;
+        }
+    }
+    return attNb;
+}
+
+/**
+ * \fn static bool LCSF_ValidatorEncodeAtt(lcsf_validator_cursor_t *pCursor, uint_fast16_t descNb,
+ *  const lcsf_attribute_desc_t *pDescArray, const lcsf_valid_att_t *pAttArray)
+ * \brief Recursively encode the present attributes of an array
+ *
+ * \param pCursor pointer to the frame cursor
+ * \param descNb number of attribute descriptors
+ * \param pDescArray pointer to the attribute descriptors
+ * \param pAttArray pointer to the attribute array
+ * \return bool: true if the attributes fit in the frame
+ */
+static bool LCSF_ValidatorEncodeAtt(lcsf_validator_cursor_t *pCursor, uint_fast16_t descNb,
+    const lcsf_attribute_desc_t *pDescArray, const lcsf_valid_att_t *pAttArray) {
+    for (uint_fast16_t idx = 0; idx < descNb; idx++) {
+        const lcsf_attribute_desc_t *pDesc = &(pDescArray[idx]);
+        const lcsf_valid_att_t *pAtt = &(pAttArray[idx]);
+
+        if (pAtt->Payload.pData == NULL) {
+            if (!pDesc->IsOptional) {
+                return false;
+            }
+            continue;
+        }
+        if (pDesc->DataType == LCSF_SUB_ATTRIBUTES) {
+            uint_fast16_t subAttNb = LCSF_ValidatorGetAttNb(pDesc->SubAttNb, pAtt->Payload.pSubAttArray);
+
+            if (!LCSF_ValidatorWriteField(pCursor, pDesc->AttId | LCSF_CMPLX_FLAG) ||
+                !LCSF_ValidatorWriteField(pCursor, subAttNb) ||
+                !LCSF_ValidatorEncodeAtt(pCursor, pDesc->SubAttNb, pDesc->pSubAttDescArray, pAtt->Payload.pSubAttArray)) {
+                return false;
+            }
+        } else {
+            if (!LCSF_ValidatorWriteField(pCursor, pDesc->AttId) || !LCSF_ValidatorWriteField(pCursor, pAtt->PayloadSize) ||
+                ((pCursor->buffSize - pCursor->idx) < pAtt->PayloadSize)) {
+                return false;
+            }
+            memcpy(&(pCursor->pBuffer[pCursor->idx]), pAtt->Payload.pData, pAtt->PayloadSize);
+            pCursor->idx += pAtt->PayloadSize;
+        }
+    }
+    return true;
+}
+
+// *** Public Functions ***
+
+uint16_t GetVLESize(uint64_t value) {
+    uint16_t size = 1;
+
+    while ((value >>= 8) != 0) {
+        size++;
+    }
+    return size;
+}
+
+bool LCSF_ValidatorAddProtocol(uint_fast8_t protIdx, const lcsf_validator_protocol_desc_t *pProtDesc) {
+    if ((protIdx >= LCSF_VALIDATOR_PROTOCOL_NB) || (pProtDesc == NULL) || (pProtDesc->pProtDesc == NULL)) {
+        return false;
+    }
+    LcsfValidatorInfo.pProtArray[protIdx] = pProtDesc;
+    return LifoInit(&LcsfValidatorInfo.RxLifo, LcsfValidatorInfo.RxAttArray, LCSF_VALIDATOR_RX_ATT_NB,
+        sizeof(lcsf_valid_att_t));
+}
+
+bool LCSF_ValidatorReceive(const uint8_t *pBuffer, size_t buffSize) {
+    // Data payloads point into the frame, the bridges read them without writing
+    lcsf_validator_cursor_t cursor = {.pBuffer = (uint8_t *)pBuffer, .buffSize = buffSize, .idx = 0};
+    lcsf_valid_cmd_t validCmd;
+    uint_fast16_t protId;
+    uint_fast16_t cmdId;
+    uint_fast16_t attNb;
+
+    if ((pBuffer == NULL) || !LCSF_ValidatorReadField(&cursor, &protId) || !LCSF_ValidatorReadField(&cursor, &cmdId) ||
+        !LCSF_ValidatorReadField(&cursor, &attNb)) {
+        return false;
+    }
+    const lcsf_validator_protocol_desc_t *pProt = LCSF_ValidatorGetProtocol(protId);
+    if (pProt == NULL) {
+        return false;
+    }
+    const lcsf_command_desc_t *pCmdDesc = LCSF_ValidatorGetCommand(pProt->pProtDesc, cmdId);
+    if (pCmdDesc == NULL) {
+        return false;
+    }
+    LifoFreeAll(&LcsfValidatorInfo.RxLifo);
+    validCmd.CmdId = (uint16_t)cmdId;
+    validCmd.pAttArray = NULL;
+    if ((pCmdDesc->AttNb > 0) &&
+        !LCSF_ValidatorDecodeAtt(&cursor, attNb, pCmdDesc->AttNb, pCmdDesc->pAttDescArray, &(validCmd.pAttArray))) {
+        return false;
+    }
+    // Reject trailing bytes and attributes on commands without any
+    if ((cursor.idx != buffSize) || ((pCmdDesc->AttNb == 0) && (attNb != 0))) {
+        return false;
+    }
+    return pProt->pFnInterpretMsg(&validCmd);
+}
+
+int LCSF_ValidatorEncode(uint_fast16_t protId, lcsf_valid_cmd_t *pValidCmd, uint8_t *pBuffer, size_t buffSize) {
+    lcsf_validator_cursor_t cursor = {.pBuffer = pBuffer, .buffSize = buffSize, .idx = 0};
+
+    if ((pValidCmd == NULL) || (pBuffer == NULL)) {
+        return -1;
+    }
+    const lcsf_validator_protocol_desc_t *pProt = LCSF_ValidatorGetProtocol(protId);
+    if (pProt == NULL) {
+        return -1;
+    }
+    const lcsf_command_desc_t *pCmdDesc = LCSF_ValidatorGetCommand(pProt->pProtDesc, pValidCmd->CmdId);
+    if (pCmdDesc == NULL) {
+        return -1;
+    }
+    uint_fast16_t attNb = LCSF_ValidatorGetAttNb(pCmdDesc->AttNb, pValidCmd->pAttArray);
+    if (!LCSF_ValidatorWriteField(&cursor, protId) || !LCSF_ValidatorWriteField(&cursor, pValidCmd->CmdId) ||
+        !LCSF_ValidatorWriteField(&cursor, attNb)) {
+        return -1;
+    }
+    if ((attNb > 0) &&
+        !LCSF_ValidatorEncodeAtt(&cursor, pCmdDesc->AttNb, pCmdDesc->pAttDescArray, pValidCmd->pAttArray)) {
+        return -1;
+    }
+    return (int)cursor.idx;
+}
@@ -0,0 +1,137 @@
+/**
+ * \file LCSF_Validator.h
+ * \brief LCSF frame validator and encoder, minimal reference stack used by the loopback harness
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#ifndef LCSF_VALIDATOR_H
+#define LCSF_VALIDATOR_H
+
+// *** Libraries include ***
+// Standard lib
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+// Custom lib
+#include <LCSF_Config.h>
+
+// *** Definitions ***
+// --- Public Types ---
+
+// Attribute data types
+enum _lcsf_data_type {
+    LCSF_UINT8,
+    LCSF_UINT16,
+    LCSF_UINT32,
+    LCSF_UINT64,
+    LCSF_FLOAT32,
+    LCSF_FLOAT64,
+    LCSF_BYTE_ARRAY,
+    LCSF_STRING,
+    LCSF_SUB_ATTRIBUTES,
+};
+
+// Attribute descriptor
+typedef struct _lcsf_attribute_desc {
+    bool IsOptional;
+    uint_fast8_t DataType;
+    uint16_t AttId;
+    uint16_t SubAttNb;
+    const struct _lcsf_attribute_desc *pSubAttDescArray;
+} lcsf_attribute_desc_t;
+
+// Command descriptor
+typedef struct _lcsf_command_desc {
+    uint16_t CmdId;
+    uint16_t AttNb;
+    const lcsf_attribute_desc_t *pAttDescArray;
+} lcsf_command_desc_t;
+
+// Protocol descriptor
+typedef struct _lcsf_protocol_desc {
+    uint16_t CmdNb;
+    const lcsf_command_desc_t *pCmdDescArray;
+} lcsf_protocol_desc_t;
+
+// Valid attribute, absent optional attributes have a NULL payload
+typedef struct _lcsf_valid_att {
+    uint16_t PayloadSize;
+    union {
+        void *pData;
+        struct _lcsf_valid_att *pSubAttArray;
+    } Payload;
+} lcsf_valid_att_t;
+
+// Valid command, attributes are in descriptor order
+typedef struct _lcsf_valid_cmd {
+    uint16_t CmdId;
+    lcsf_valid_att_t *pAttArray;
+} lcsf_valid_cmd_t;
+
+// Protocol handled by the validator
+typedef struct _lcsf_validator_protocol_desc {
+    uint16_t ProtId;
+    uint16_t ProtVer;
+    const lcsf_protocol_desc_t *pProtDesc;
+    bool (*pFnInterpretMsg)(lcsf_valid_cmd_t *pValidCmd);
+} lcsf_validator_protocol_desc_t;
+
+// --- Public Function Prototypes ---
+
+/**
+ * \fn uint16_t GetVLESize(uint64_t value)
+ * \brief Get the variable length encoding size of an unsigned value, without upper zero bytes
+ *
+ * \param value value to encode
+ * \return uint16_t: number of bytes, at least 1
+ */
+uint16_t GetVLESize(uint64_t value);
+
+/**
+ * \fn bool LCSF_ValidatorAddProtocol(uint_fast8_t protIdx, const lcsf_validator_protocol_desc_t *pProtDesc)
+ * \brief Register a protocol in the validator
+ *
+ * \param protIdx index of the protocol, less than LCSF_VALIDATOR_PROTOCOL_NB
+ * \param pProtDesc pointer to the protocol descriptor
+ * \return bool: true if operation was a success
+ */
+bool LCSF_ValidatorAddProtocol(uint_fast8_t protIdx, const lcsf_validator_protocol_desc_t *pProtDesc);
+
+/**
+ * \fn bool LCSF_ValidatorReceive(const uint8_t *pBuffer, size_t buffSize)
+ * \brief Validate a frame against its protocol descriptor and pass it to the protocol interpreter
+ *
+ * \param pBuffer pointer to the frame, data payloads point into it
+ * \param buffSize frame size
+ * \return bool: true if the frame was valid and interpreted
+ */
+bool LCSF_ValidatorReceive(const uint8_t *pBuffer, size_t buffSize);
+
+/**
+ * \fn int LCSF_ValidatorEncode(uint_fast16_t protId, lcsf_valid_cmd_t *pValidCmd, uint8_t *pBuffer, size_t buffSize)
+ * \brief Encode a valid command into a frame
+ *
+ * \param protId protocol identifier
+ * \param pValidCmd pointer to the command
+ * \param pBuffer pointer to the frame buffer
+ * \param buffSize frame buffer size
+ * \return int: frame size, -1 if the protocol is unknown or the buffer too small
+ */
+int LCSF_ValidatorEncode(uint_fast16_t protId, lcsf_valid_cmd_t *pValidCmd, uint8_t *pBuffer, size_t buffSize);
+
+#endif // LCSF_VALIDATOR_H
@@ -0,0 +1,51 @@
+/**
+ * \file Lifo.c
+ * \brief Last in first out allocator, reference stack version
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+// *** Libraries include ***
+// Standard lib
+// Custom lib
+#include "Lifo.h"
+
+// *** Public Functions ***
+
+bool LifoInit(lifo_desc_t *pLifo, void *pBuffer, uint_fast16_t elemNb, size_t elemSize) {
+    if ((pLifo == NULL) || (pBuffer == NULL) || (elemSize == 0)) {
+        return false;
+    }
+    pLifo->pBuffer = (uint8_t *)pBuffer;
+    pLifo->elemSize = elemSize;
+    pLifo->elemNb = elemNb;
+    pLifo->usedNb = 0;
+    return true;
+}
+
+bool LifoGet(lifo_desc_t *pLifo, uint_fast16_t elemNb, void **pElemAddr) {
+    if ((pLifo == NULL) || (pElemAddr == NULL) || (elemNb > (pLifo->elemNb - pLifo->usedNb))) {
+        return false;
+    }
+    *pElemAddr = pLifo->pBuffer + (pLifo->usedNb * pLifo->elemSize);
+    pLifo->usedNb += elemNb;
+    return true;
+}
+
+void LifoFreeAll(lifo_desc_t *pLifo) {
+    pLifo->usedNb = 0;
+}
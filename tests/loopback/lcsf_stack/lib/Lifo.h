@@ -0,0 +1,75 @@
+/**
+ * \file Lifo.h
+ * \brief Last in first out allocator, reference stack version
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#ifndef LIFO_H
+#define LIFO_H
+
+// *** Libraries include ***
+// Standard lib
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *** Definitions ***
+// --- Public Types ---
+
+// Lifo descriptor, elements are allocated in blocks and freed all at once
+typedef struct _lifo_desc {
+    uint8_t *pBuffer;
+    size_t elemSize;
+    uint_fast16_t elemNb;
+    uint_fast16_t usedNb;
+} lifo_desc_t;
+
+// --- Public Function Prototypes ---
+
+/**
+ * \fn bool LifoInit(lifo_desc_t *pLifo, void *pBuffer, uint_fast16_t elemNb, size_t elemSize)
+ * \brief Initialize a lifo over a buffer
+ *
+ * \param pLifo pointer to the lifo descriptor
+ * \param pBuffer pointer to the buffer, elemNb * elemSize bytes
+ * \param elemNb number of elements in the buffer
+ * \param elemSize size of an element
+ * \return bool: true if operation was a success
+ */
+bool LifoInit(lifo_desc_t *pLifo, void *pBuffer, uint_fast16_t elemNb, size_t elemSize);
+
+/**
+ * \fn bool LifoGet(lifo_desc_t *pLifo, uint_fast16_t elemNb, void **pElemAddr)
+ * \brief Allocate contiguous elements
+ *
+ * \param pLifo pointer to the lifo descriptor
+ * \param elemNb number of elements to allocate
+ * \param pElemAddr pointer to contain the address of the first element
+ * \return bool: true if operation was a success
+ */
+bool LifoGet(lifo_desc_t *pLifo, uint_fast16_t elemNb, void **pElemAddr);
+
+/**
+ * \fn void LifoFreeAll(lifo_desc_t *pLifo)
+ * \brief Free every element of a lifo
+ *
+ * \param pLifo pointer to the lifo descriptor
+ */
+void LifoFreeAll(lifo_desc_t *pLifo);
+
+#endif // LIFO_H
@@ -42,6 +42,9 @@ TEST(test_generator, gen_A_output) {
     test_generator.generateBridge(protocol_name, cmd_list, true, path);
     test_generator.generateDescription(protocol_name, cmd_list, path);
 
+    // Check descriptors are not shared by default
+    ASSERT_EQ(test_generator.getSharedDescArrayNb(), 0);
+
     // Check Main
     ASSERT_TRUE(openFile(&model_file, MODEL_DIR_PATH, "model_raw_main_a.c"));
     ASSERT_TRUE(openFile(&output_file, outputDir, "Test_Main_a.c"));
@@ -243,4 +246,445 @@ TEST(test_generator, gen_B_output) {
     }
     model_file.close();
     output_file.close();
-}
\ No newline at end of file
+}
+
+TEST(test_generator, footprint) {
+    CodeGenerator test_generator;
+    CodeGenerator::T_Footprint footprint = test_generator.getFootprint(cmd_list);
+
+    // Flat command: padded payload struct and one descriptor per attribute
+    CodeGenerator::T_CmdFootprint cmd_footprint = footprint.cmdFootprints.at(3);
+    ASSERT_EQ(cmd_footprint.cmdName.toStdString(), "CC1");
+    ASSERT_EQ(cmd_footprint.payloadSize, 72);
+    ASSERT_EQ(cmd_footprint.flagsSize, 1);
+    ASSERT_EQ(cmd_footprint.descSize, 13 * CodeGenerator::ATT_DESC_SIZE);
+    ASSERT_EQ(cmd_footprint.nestingDepth, 1);
+
+    // Nested command: sub-attribute structs and descriptors
+    cmd_footprint = footprint.cmdFootprints.at(6);
+    ASSERT_EQ(cmd_footprint.cmdName.toStdString(), "CC4");
+    ASSERT_EQ(cmd_footprint.payloadSize, 28);
+    ASSERT_EQ(cmd_footprint.flagsSize, 4);
+    ASSERT_EQ(cmd_footprint.descSize, 11 * CodeGenerator::ATT_DESC_SIZE);
+    ASSERT_EQ(cmd_footprint.nestingDepth, 4);
+
+    // Totals
+    ASSERT_EQ(footprint.payloadUnionSize, 72);
+    ASSERT_EQ(footprint.descTableSize, 72 * CodeGenerator::ATT_DESC_SIZE);
+    ASSERT_EQ(footprint.lifoSize, Command::getMaxAttNb(cmd_list) * CodeGenerator::VALID_ATT_SIZE);
+    ASSERT_EQ(footprint.maxNestingDepth, 4);
+    ASSERT_EQ(footprint.flashSize, footprint.descTableSize + footprint.cmdTableSize);
+
+    // Shared sub-attribute descriptors are counted once
+    test_generator.setShareDescMode(true);
+    footprint = test_generator.getFootprint(cmd_list);
+    ASSERT_EQ(footprint.descTableSize, 56 * CodeGenerator::ATT_DESC_SIZE);
+}
+
+TEST(test_generator, share_desc_output) {
+    CodeGenerator test_generator;
+    QString path = "gen_out/share_desc/";
+    QFile output_file;
+    QString output_content;
+
+    test_generator.setShareDescMode(true);
+    test_generator.generateDescription(protocol_name, cmd_list, path);
+
+    // Check isomorphic sub-attribute descriptors are shared
+    ASSERT_EQ(test_generator.getSharedDescArrayNb(), 8);
+    ASSERT_EQ(test_generator.getSharedDescEntryNb(), 16);
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Desc_Test.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("// Shared sub-attribute descriptors: 8 arrays merged, 16 entries saved"));
+    EXPECT_TRUE(output_content.contains(", shared with "));
+}
+
+TEST(test_generator, reentrant_output) {
+    CodeGenerator test_generator;
+    CodeExtractor test_extractor;
+    QString path = "gen_out/reentrant/";
+    QFile output_file;
+    QString output_content;
+
+    test_generator.setReentrantMode(true);
+    test_generator.generateMainHeader(protocol_name, cmd_list, test_extractor, path);
+    test_generator.generateMain(protocol_name, cmd_list, test_extractor, true, path);
+    test_generator.generateBridgeHeader(protocol_name, protocol_id, protocol_version, cmd_list, path);
+    test_generator.generateBridge(protocol_name, cmd_list, true, path);
+
+    // Check Main keeps its state in the context
+    ASSERT_TRUE(openFile(&output_file, path, "Test_Main_a.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_FALSE(output_content.contains("static test_info_t TestInfo;"));
+    EXPECT_TRUE(output_content.contains("bool Test_MainInit(test_ctx_t *pCtx, uint8_t *pBuffer, size_t buffSize) {"));
+    EXPECT_TRUE(output_content.contains("LCSF_Bridge_TestEncode(pCtx->pBridgeCtx, "));
+
+    // Check Bridge keeps its state in the context
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Bridge_Test_a.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_FALSE(output_content.contains("LcsfBridgeTestInfo"));
+    EXPECT_FALSE(output_content.contains("static uint8_t LifoData"));
+    EXPECT_TRUE(output_content.contains("return Test_MainExecute(pCtx->pMainCtx, cmdName, pCmdPayload);"));
+    EXPECT_TRUE(output_content.contains("LifoGet(pLifo, "));
+    // Channels receive concurrently through the decoder
+    EXPECT_TRUE(output_content.contains(
+        "bool LCSF_Bridge_TestReceiveFrame(lcsf_bridge_test_ctx_t *pCtx, const uint8_t *pBuffer, size_t buffSize) {"));
+
+    // Check context types
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Bridge_Test.h"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("} lcsf_bridge_test_ctx_t;"));
+    ASSERT_TRUE(openFile(&output_file, path, "Test_Main.h"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("} test_ctx_t;"));
+}
+
+TEST(test_generator, deferred_output) {
+    CodeGenerator test_generator;
+    CodeExtractor test_extractor;
+    QString path = "gen_out/deferred/";
+    QFile output_file;
+    QString output_content;
+    int immediate_ram_size = test_generator.getFootprint(cmd_list).ramSize;
+
+    test_generator.setDeferredMode(true);
+    test_generator.generateMainHeader(protocol_name, cmd_list, test_extractor, path);
+    test_generator.generateMain(protocol_name, cmd_list, test_extractor, true, path);
+    test_generator.generateBridgeHeader(protocol_name, protocol_id, protocol_version, cmd_list, path);
+    test_generator.generateBridge(protocol_name, cmd_list, true, path);
+
+    // Check Main drains the queue
+    ASSERT_TRUE(openFile(&output_file, path, "Test_Main_a.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("uint_fast16_t Test_MainPoll(uint_fast16_t maxCmds) {"));
+    EXPECT_TRUE(output_content.contains("LCSF_Bridge_TestRelease();"));
+
+    // Check Bridge queues instead of executing
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Bridge_Test_a.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_FALSE(output_content.contains("return Test_MainExecute("));
+    EXPECT_TRUE(output_content.contains("atomic_store_explicit(&(LcsfBridgeTestInfo.QueueHead), head + 1"));
+    EXPECT_TRUE(output_content.contains("test_cmd_payload_t *LCSF_Bridge_TestPeek(uint16_t *pCmdName) {"));
+
+    // Check queue slots are sized from the payload union
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Bridge_Test.h"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("#define LCSF_BRIDGE_TEST_QUEUE_SIZE 4"));
+    EXPECT_TRUE(output_content.contains("    test_cmd_payload_t CmdPayload;\n} lcsf_bridge_test_queue_slot_t;"));
+    // 4 slots of 80 bytes and 2 indexes replace the 72 bytes receive payload
+    ASSERT_EQ(test_generator.getFootprint(cmd_list).ramSize, immediate_ram_size + (4 * 80) + 8 - 72);
+}
+
+TEST(test_generator, fast_decoder_output) {
+    CodeGenerator test_generator;
+    CodeExtractor test_extractor;
+    QString path = "gen_out/fast_decoder/";
+    QFile output_file;
+    QString output_content;
+
+    // Benchmark needs the specialised decoder
+    EXPECT_FALSE(test_generator.generateDecoderBench(protocol_name, cmd_list, true, path));
+    test_generator.setFastDecoderMode(true);
+    test_generator.generateMainHeader(protocol_name, cmd_list, test_extractor, path);
+    test_generator.generateMain(protocol_name, cmd_list, test_extractor, true, path);
+    test_generator.generateBridgeHeader(protocol_name, protocol_id, protocol_version, cmd_list, path);
+    test_generator.generateBridge(protocol_name, cmd_list, true, path);
+    test_generator.generateDescription(protocol_name, cmd_list, path);
+    ASSERT_TRUE(test_generator.generateDecoderBench(protocol_name, cmd_list, true, path));
+
+    // Check Bridge decodes frames without the validator
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Bridge_Test_a.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("int LCSF_Bridge_TestDecode(const uint8_t *pBuffer, size_t buffSize, "
+                                        "uint16_t *pCmdName, test_cmd_payload_t *pCmdPayload) {"));
+    EXPECT_TRUE(output_content.contains("case (LCSF_TEST_CA7_ATT_ID_CA8 | LCSF_BRIDGE_TEST_CMPLX_FLAG):"));
+    EXPECT_TRUE(output_content.contains("pCmdPayload->cc5_payload.ca6_payload.ca7_payload.optAttFlagsBitfield |= "
+                                        "TEST_CA7_ATT_SA1_FLAG;"));
+    EXPECT_TRUE(output_content.contains("    return isAttHere[TEST_CA7_ATT_CA8];"));
+    // Only received commands are decoded
+    EXPECT_TRUE(output_content.contains("LCSF_Bridge_TestCC2Decode("));
+    EXPECT_FALSE(output_content.contains("LCSF_Bridge_TestCC1Decode("));
+    EXPECT_TRUE(output_content.contains("return Test_MainExecute(cmdName, pCmdPayload);"));
+
+    // Check benchmark frames
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Bench_Test_a.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("static const uint8_t LCSF_Bench_CC5Frame[] = {"));
+    EXPECT_TRUE(output_content.contains("LCSF_BENCH_FIELD(LCSF_TEST_CA7_ATT_ID_CA8 | LCSF_BENCH_CMPLX_FLAG), "
+                                        "LCSF_BENCH_FIELD(1),"));
+    EXPECT_FALSE(output_content.contains("LCSF_Bench_CC1Frame"));
+}
+
+TEST(test_generator, throughput_bench_output) {
+    CodeGenerator test_generator;
+    QString path = "gen_out/bench/";
+    QFile output_file;
+    QString output_content;
+
+    // Benchmark drives the immediate dispatch only
+    test_generator.setDeferredMode(true);
+    EXPECT_FALSE(test_generator.generateThroughputBench(protocol_name, cmd_list, true, path));
+    test_generator.setDeferredMode(false);
+    ASSERT_TRUE(test_generator.generateThroughputBench(protocol_name, cmd_list, true, path));
+
+    // Check random payloads of the sent commands
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Throughput_Test_a.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("static void LCSF_Bench_BuildCC1(test_cmd_payload_t *pCmdPayload) {"));
+    EXPECT_TRUE(output_content.contains("    pCmdPayload->cc1_payload.sa4Size = LCSF_Bench_RandSize();"));
+    EXPECT_TRUE(output_content.contains("        pCmdPayload->cc1_payload.optAttFlagsBitfield |= TEST_CC1_ATT_SA10_FLAG;\n"
+                                        "        pCmdPayload->cc1_payload.p_sa10 = "
+                                        "LCSF_Bench_RandString(&(pCmdPayload->cc1_payload.sa10Size));"));
+    EXPECT_TRUE(output_content.contains("        pCmdPayload->cc4_payload.ca2_payload.optAttFlagsBitfield |= "
+                                        "TEST_CA2_ATT_SA1_FLAG;"));
+    EXPECT_TRUE(output_content.contains("    {\"SC1\", TEST_CMD_SC1, NULL},"));
+    EXPECT_FALSE(output_content.contains("LCSF_Bench_BuildCC2"));
+
+    // Check round trip is encoded by side A and decoded by side B
+    EXPECT_TRUE(output_content.contains("#include \"LCSF_Loopback_Test.h\""));
+    EXPECT_TRUE(output_content.contains("int frameSize = LCSF_Bridge_TestEncode_A(pCmd->cmdName,"));
+    EXPECT_TRUE(output_content.contains("LCSF_ValidatorReceive_B(LcsfBenchBuffer, (size_t)frameSize);"));
+    EXPECT_TRUE(openFile(&output_file, path, "LCSF_Loopback_Test.h"));
+    output_file.close();
+}
+
+TEST(test_generator, loopback_output) {
+    CodeGenerator test_generator;
+    QString path = "gen_out/loopback/";
+    QFile output_file;
+    QString output_content;
+    Attribute *tx_att = Command::findCmdAddr("CC1", cmd_list)->getAttByName("SA9");
+    Attribute *rx_att = Command::findCmdAddr("CC2", cmd_list)->getAttByName("SA4");
+
+    // Check deferred commands are drained from the receiver queue instead of executed
+    test_generator.setDeferredMode(true);
+    ASSERT_TRUE(test_generator.generateLoopback(protocol_name, cmd_list, path));
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Loopback_Test.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("    while ((pCmdPayload = LCSF_Bridge_TestPeek_B(&cmdName)) != NULL) {\n"
+                                        "        isOk = LCSF_Loopback_Store(pChan, cmdName, pCmdPayload) && isOk;\n"
+                                        "        LCSF_Bridge_TestRelease_B();"));
+    EXPECT_FALSE(output_content.contains("bool Test_MainExecute_A("));
+    test_generator.setDeferredMode(false);
+
+    // Check the fast decoder receives the frames
+    test_generator.setFastDecoderMode(true);
+    ASSERT_TRUE(test_generator.generateLoopback(protocol_name, cmd_list, path));
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Loopback_Test.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("    return LCSF_Bridge_TestReceiveFrame_B(pBuffer, buffSize);"));
+    EXPECT_FALSE(output_content.contains("LCSF_ValidatorReceive_B("));
+    test_generator.setFastDecoderMode(false);
+
+    // Check segments are encoded and gathered into the frame
+    test_generator.setSegmentEncodeMode(true);
+    ASSERT_TRUE(test_generator.generateLoopback(protocol_name, cmd_list, path));
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Loopback_Test.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("    int segNb = LCSF_Bridge_TestEncodeSegments_A(cmdName, pCmdPayload, "
+                                        "pChan->SegHeader, sizeof(pChan->SegHeader),\n"
+                                        "        pChan->Segs, LCSF_BRIDGE_TEST_SEG_NB);"));
+    EXPECT_TRUE(output_content.contains(
+        "        memcpy(&(pBuffer[frameSize]), pChan->Segs[idx].pData, pChan->Segs[idx].Size);"));
+    test_generator.setSegmentEncodeMode(false);
+
+    // Check reentrant channels run in their own thread and receive through their context
+    test_generator.setReentrantMode(true);
+    ASSERT_TRUE(test_generator.generateLoopback(protocol_name, cmd_list, path));
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Loopback_Test.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("#define LCSF_LOOPBACK_CHAN_NB 2"));
+    EXPECT_TRUE(
+        output_content.contains("    return LCSF_Bridge_TestReceiveFrame_A(&(pChan->BridgeCtxA), pBuffer, buffSize);"));
+    EXPECT_TRUE(output_content.contains(
+        "    return LCSF_Loopback_Store((lcsf_loopback_chan_t *)pCtx->pUserData, cmdName, pCmdPayload);"));
+    EXPECT_TRUE(output_content.contains("pthread_create(&(threads[chanIdx]), NULL, LCSF_Loopback_Run, "));
+    test_generator.setReentrantMode(false);
+
+    // Check streamed bodies are sent after their header, fed in chunks and patched into the received payload
+    tx_att->setIsStreamed(true);
+    rx_att->setIsStreamed(true);
+    ASSERT_TRUE(test_generator.generateLoopback(protocol_name, cmd_list, path));
+    tx_att->setIsStreamed(false);
+    rx_att->setIsStreamed(false);
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Loopback_Test.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("            return LCSF_Loopback_EncodeStreamA(cmdName, pCmdPayload, "
+                                        "pCmdPayload->cc1_payload.p_sa9, pBuffer,"));
+    EXPECT_TRUE(output_content.contains(
+        "        if (!LCSF_Bridge_TestStreamReceive_B(&(pChan->RxStreamB), &(pBuffer[idx]), chunkSize)) {"));
+    EXPECT_TRUE(output_content.contains("            if (pChan->RxPayload.cc2_payload.sa4Size != bodySize) {\n"
+                                        "                return false;\n"
+                                        "            }\n"
+                                        "            pChan->RxPayload.cc2_payload.p_sa4 = pChan->Body;"));
+    EXPECT_FALSE(output_content.contains("LCSF_ValidatorReceive_B("));
+    ASSERT_TRUE(test_generator.generateLoopback(protocol_name, cmd_list, path));
+
+    // Check side symbols get suffixed
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Loopback_Test.h"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains(
+        "#define LCSF_Bridge_TestEncode LCSF_LOOPBACK_SYM(LCSF_Bridge_TestEncode, LCSF_LOOPBACK_SIDE)"));
+    EXPECT_TRUE(output_content.contains("#define Test_MainExecute LCSF_LOOPBACK_SYM(Test_MainExecute, LCSF_LOOPBACK_SIDE)"));
+    EXPECT_TRUE(output_content.contains("bool LCSF_ValidatorReceive_B(const uint8_t *pBuffer, size_t buffSize);"));
+
+    // Check every command is sent in each of its directions and compared field by field
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Loopback_Test.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("    return LCSF_ValidatorReceive_B(pBuffer, buffSize);"));
+    EXPECT_TRUE(output_content.contains("    {\"SC1\", TEST_CMD_SC1, &LcsfLoopbackAToB, NULL, NULL},\n"
+                                        "    {\"SC2\", TEST_CMD_SC2, &LcsfLoopbackBToA, NULL, NULL},"));
+    EXPECT_TRUE(output_content.contains(
+        "    {\"CC3\", TEST_CMD_CC3, &LcsfLoopbackAToB, LCSF_Bench_BuildCC3, LCSF_Loopback_CompareCC3},\n"
+        "    {\"CC3\", TEST_CMD_CC3, &LcsfLoopbackBToA, LCSF_Bench_BuildCC3, LCSF_Loopback_CompareCC3},"));
+    EXPECT_TRUE(output_content.contains("static void LCSF_Bench_BuildCC2(test_cmd_payload_t *pCmdPayload) {"));
+    EXPECT_TRUE(output_content.contains("    if ((pSent->cc4_payload.optAttFlagsBitfield & TEST_CC4_ATT_CA2_FLAG) != 0) {\n"
+                                        "        if (pSent->cc4_payload.ca2_payload.optAttFlagsBitfield != "
+                                        "pRecv->cc4_payload.ca2_payload.optAttFlagsBitfield) {"));
+    EXPECT_TRUE(output_content.contains("    if ((pSent->cc1_payload.sa4Size != pRecv->cc1_payload.sa4Size) ||\n"
+                                        "        (memcmp(pSent->cc1_payload.p_sa4, pRecv->cc1_payload.p_sa4, "
+                                        "pSent->cc1_payload.sa4Size) != 0)) {"));
+
+    // Check the reference frames are checked first when a golden header is given
+    EXPECT_TRUE(output_content.contains("#ifdef LCSF_LOOPBACK_GOLDEN\n#include LCSF_LOOPBACK_GOLDEN\n#endif"));
+    EXPECT_TRUE(output_content.contains("    if (!LCSF_Loopback_CheckGolden(&(LcsfLoopbackChans[0]))) {"));
+}
+
+TEST(test_generator, segment_output) {
+    CodeGenerator test_generator;
+    CodeExtractor test_extractor;
+    QString path = "gen_out/segment/";
+    QFile output_file;
+    QString output_content;
+
+    test_generator.setSegmentEncodeMode(true);
+    test_generator.generateBridgeHeader(protocol_name, protocol_id, protocol_version, cmd_list, path);
+    test_generator.generateBridge(protocol_name, cmd_list, true, path);
+
+    // Check Bridge header exposes the segment layout
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Bridge_Test.h"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("} lcsf_bridge_test_segment_t;"));
+    EXPECT_TRUE(output_content.contains("int LCSF_Bridge_TestEncodeSegments(uint_fast16_t cmdName, "
+                                        "const test_cmd_payload_t *pCmdPayload, uint8_t *pHeader, size_t headerSize,"));
+
+    // Check Bridge references byte arrays and strings in place
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Bridge_Test_a.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("LCSF_Bridge_TestCC1EncodeSeg("));
+    EXPECT_FALSE(output_content.contains("LCSF_Bridge_TestCC2EncodeSeg("));
+}
+
+TEST(test_generator, instrument_output) {
+    CodeGenerator test_generator;
+    CodeExtractor test_extractor;
+    QString path = "gen_out/instrument/";
+    QFile output_file;
+    QString output_content;
+    int plain_ram_size = test_generator.getFootprint(cmd_list).ramSize;
+
+    test_generator.setInstrumentMode(true);
+    // 9 commands of 4 counters and 5 totals (56 bytes), 4 failure counters, then the receive and execute last failures
+    ASSERT_EQ(test_generator.getFootprint(cmd_list).ramSize, plain_ram_size + (9 * 56) + 16 + 8);
+    test_generator.generateBridgeHeader(protocol_name, protocol_id, protocol_version, cmd_list, path);
+    test_generator.generateBridge(protocol_name, cmd_list, true, path);
+
+    // Check Bridge header has the removable hooks and the stats struct
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Bridge_Test.h"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("#ifndef LCSF_BRIDGE_TEST_NO_STATS\n#define LCSF_BRIDGE_TEST_STATS\n#endif"));
+    EXPECT_TRUE(output_content.contains("#define LCSF_BRIDGE_TEST_CYCLES() 0u"));
+    EXPECT_TRUE(output_content.contains("    lcsf_bridge_test_cmd_stats_t Cmd[LCSF_TEST_CMD_NB];"));
+    EXPECT_TRUE(
+        output_content.contains("#define LCSF_BRIDGE_TEST_HOOK_HANDLER(pStats, cmdName, isOk, start) ((void)(isOk))"));
+    EXPECT_TRUE(output_content.contains("lcsf_bridge_test_stats_t *LCSF_Bridge_TestGetStats(void);"));
+
+    // Check Bridge records the received and sent commands around the handler and the encoder
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Bridge_Test_a.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("    LCSF_BRIDGE_TEST_HOOK_START(handlerStart);\n"
+                                        "    bool isOk = Test_MainExecute(cmdName, pCmdPayload);\n"
+                                        "    LCSF_BRIDGE_TEST_HOOK_HANDLER(&(LcsfBridgeTestInfo.Stats), cmdName, isOk, "
+                                        "handlerStart);"));
+    EXPECT_TRUE(output_content.contains("    LCSF_BRIDGE_TEST_HOOK_TX(&(LcsfBridgeTestInfo.Stats), cmdName, msgSize, "
+                                        "start);\n    return msgSize;"));
+    EXPECT_TRUE(output_content.contains("LcsfBridgeTestInfo.Stats.LastFailCmdName = LCSF_TEST_CMD_NB;"));
+    EXPECT_TRUE(output_content.contains("LcsfBridgeTestInfo.Stats.RxLastFailCmdName = LCSF_TEST_CMD_NB;"));
+    EXPECT_TRUE(output_content.contains("            pStats->Cmd[cmdName].RxFailCount++;"));
+
+    // Check deferred Main times the handler when draining the queue
+    test_generator.setDeferredMode(true);
+    test_generator.generateMainHeader(protocol_name, cmd_list, test_extractor, path);
+    test_generator.generateMain(protocol_name, cmd_list, test_extractor, true, path);
+    test_generator.generateBridge(protocol_name, cmd_list, true, path);
+    ASSERT_TRUE(openFile(&output_file, path, "Test_Main_a.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("LCSF_BRIDGE_TEST_HOOK_HANDLER(LCSF_Bridge_TestGetStats(), cmdName, isOk, start);"));
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Bridge_Test_a.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("LCSF_BRIDGE_TEST_FAIL_QUEUE_FULL);"));
+    EXPECT_FALSE(output_content.contains("bool isOk = Test_MainExecute("));
+}
+
+TEST(test_generator, stream_output) {
+    CodeGenerator test_generator;
+    QString path = "gen_out/stream/";
+    QFile output_file;
+    QString output_content;
+    Attribute *tx_att = Command::findCmdAddr("CC1", cmd_list)->getAttByName("SA9");
+    Attribute *rx_att = Command::findCmdAddr("CC2", cmd_list)->getAttByName("SA4");
+
+    tx_att->setIsStreamed(true);
+    rx_att->setIsStreamed(true);
+    test_generator.generateBridgeHeader(protocol_name, protocol_id, protocol_version, cmd_list, path);
+    test_generator.generateBridge(protocol_name, cmd_list, true, path);
+    tx_att->setIsStreamed(false);
+    rx_att->setIsStreamed(false);
+
+    // Check Bridge header exposes the stream api
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Bridge_Test.h"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("#define LCSF_BRIDGE_TEST_STREAM_DEPTH 4"));
+    EXPECT_TRUE(output_content.contains("bool LCSF_Bridge_TestStreamReceive(lcsf_bridge_test_rx_stream_t *pStream, "
+                                        "const uint8_t *pData, size_t dataSize);"));
+
+    // Check Bridge writes the streamed attribute last, with its size only
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Bridge_Test_a.c"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("LCSF_Bridge_TestWriteField(pWriter, pCmdPayload->cc1_payload.sa9Size)) {\n"
+                                        "            return false;\n"
+                                        "        }\n"
+                                        "    }\n"
+                                        "    return true;"));
+    EXPECT_TRUE(output_content.contains("pStream->BodyLeft = pCmdPayload->cc1_payload.sa9Size;"));
+    // Only the received streamed attribute body goes to the callback
+    EXPECT_TRUE(output_content.contains("return (attId == LCSF_TEST_CC2_ATT_ID_SA4);"));
+    EXPECT_FALSE(output_content.contains("LCSF_TEST_CC1_ATT_ID_SA9);"));
+    EXPECT_FALSE(output_content.contains("EncodeSegments("));
+}
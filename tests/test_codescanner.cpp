@@ -0,0 +1,196 @@
+/**
+ * \file test_codescanner.cpp
+ * \brief Code scanner unit test
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#include <QRandomGenerator>
+#include <QStringList>
+#include <QTextStream>
+#include <gtest/gtest.h>
+
+#include "codeextractor.h"
+#include "codescanner.h"
+#include "rustextractor.h"
+#include "test_data.h"
+
+// Brace neutral fragments, each entry is a list of consecutive lines
+static const QList<QStringList> c_noise = {
+    {R"(x = "{";)"},
+    {R"(c = '}';)"},
+    {R"(s = "\"{\\";)"},
+    {R"(q = '\'';)"},
+    {R"(b = '\\'; /* } */)"},
+    {R"(// { unbalanced line comment)"},
+    {R"(/* { block)", R"(   comment } } spanning lines */)"},
+    {R"(s = "continued { \)", R"(string }";)"},
+    {R"(// continued comment \)", R"(   { still comment)"},
+    {R"(printf("%s}\n", "{{");)"},
+    {R"(f(); /**/ g(); /* { */ h();)"},
+};
+
+static const QList<QStringList> rust_noise = {
+    {R"(let s = "{";)"},
+    {R"(let c = '}';)"},
+    {R"(let r = r#"}"{"#;)"},
+    {R"(let r = r"{";)"},
+    {R"(let b = b"{";)"},
+    {R"(let bc = b'{';)"},
+    {R"(let br = br##"}"#"##;)"},
+    {R"(let q = '\'';)"},
+    {R"(let u = '\u{7B}';)"},
+    {R"(fn f<'a>(x: &'a str) -> &'a str { x })"},
+    {R"('outer: loop { break 'outer; })"},
+    {R"(/* outer /* { */ } */)"},
+    {R"(/* nested /* {)", R"(   } */ { still comment */)"},
+    {R"(let s = "multi {)", R"(line }";)"},
+    {R"(let r = r#"multi {)", R"(line " } "#;)"},
+    {R"(// { unbalanced line comment)"},
+    {R"(let r#type = 1;)"},
+};
+
+static void check_random_programs(CodeScanner::T_ScannerLanguage language, const QList<QStringList> &noise) {
+    QRandomGenerator rng(1234);
+
+    for (int programIdx = 0; programIdx < 200; programIdx++) {
+        CodeScanner scanner(language);
+        QStringList lines;
+        QList<int> depths;
+        int depth = 0;
+
+        for (int step = 0; step < 100; step++) {
+            int choice = rng.bounded(4);
+            if (choice == 0) {
+                lines.append("if (x) {");
+                depths.append(++depth);
+            } else if ((choice == 1) && (depth > 0)) {
+                lines.append("}");
+                depths.append(--depth);
+            } else {
+                for (const QString &line : noise.at(rng.bounded(noise.size()))) {
+                    lines.append(line);
+                    depths.append(depth);
+                }
+            }
+        }
+        while (depth > 0) {
+            lines.append("}");
+            depths.append(--depth);
+        }
+        for (int lineIdx = 0; lineIdx < lines.size(); lineIdx++) {
+            ASSERT_EQ(scanner.scanLine(lines.at(lineIdx)), depths.at(lineIdx))
+                << "program " << programIdx << ", line " << lineIdx << ": " << lines.at(lineIdx).toStdString();
+        }
+    }
+}
+
+TEST(test_codescanner, c_corpus) {
+    for (const QStringList &fragment : c_noise) {
+        CodeScanner scanner(CodeScanner::LANGUAGE_C);
+        for (const QString &line : fragment) {
+            scanner.scanLine(line);
+        }
+        ASSERT_EQ(scanner.getBracketCounter(), 0) << fragment.join("\n").toStdString();
+        ASSERT_FALSE(scanner.getBlockBegan()) << fragment.join("\n").toStdString();
+        ASSERT_TRUE(scanner.isInCode()) << fragment.join("\n").toStdString();
+    }
+}
+
+TEST(test_codescanner, rust_corpus) {
+    for (const QStringList &fragment : rust_noise) {
+        CodeScanner scanner(CodeScanner::LANGUAGE_RUST);
+        for (const QString &line : fragment) {
+            scanner.scanLine(line);
+        }
+        ASSERT_EQ(scanner.getBracketCounter(), 0) << fragment.join("\n").toStdString();
+        ASSERT_TRUE(scanner.isInCode()) << fragment.join("\n").toStdString();
+    }
+}
+
+TEST(test_codescanner, c_random_programs) {
+    check_random_programs(CodeScanner::LANGUAGE_C, c_noise);
+}
+
+TEST(test_codescanner, rust_random_programs) {
+    check_random_programs(CodeScanner::LANGUAGE_RUST, rust_noise);
+}
+
+TEST(test_codescanner, c_extraction_with_literals) {
+    QString source = R"C(// *** Definitions ***
+// *** Private Functions ***
+
+static void Test_Helper(void) {
+    printf("}\n"); // }
+}
+
+static bool TestExecuteSC1(void) {
+    char open = '{'; /* } */
+    return true;
+}
+
+// *** Public Functions ***
+
+void Test_MainPrint(void) {
+    printf("{");
+}
+)C";
+    QList<Command *> name_list = {new Command("SC1", 0, false, NS_DirectionType::A_TO_B, "")};
+
+    QTextStream stream(&source);
+    CodeExtractor test_extractor;
+    ASSERT_TRUE(test_extractor.extractFromSourceFile(protocol_name, &stream, name_list));
+
+    ASSERT_EQ(test_extractor.getUnknownPrivateFunctions().toStdString(),
+        "static void Test_Helper(void) {\n    printf(\"}\\n\"); // }\n}\n\n");
+    ASSERT_EQ(test_extractor.getCommandFunctions().at(0).toStdString(),
+        "static bool TestExecuteSC1(void) {\n    char open = '{'; /* } */\n    return true;\n}\n\n");
+    ASSERT_EQ(test_extractor.getUnknownPublicFunctions().toStdString(),
+        "void Test_MainPrint(void) {\n    printf(\"{\");\n}\n\n");
+    ASSERT_EQ(test_extractor.getUnknownPublicFunctionsHeaders().toStdString(), "void Test_MainPrint(void);\n\n");
+}
+
+TEST(test_codescanner, rust_extraction_with_literals) {
+    QString source = R"RUST(// --- Custom uses ---
+/// Command enum
+// --- Custom definitions ---
+fn execute_sc2() {
+    let s = "}";
+    let r = r#"}"}"#;
+    let c = '}';
+}
+
+fn execute_sc3() {
+    custom_sc3_body();
+}
+
+fn execute_cmd(cmd_name: CmdEnum, cmd_payload: &CmdPayload) {
+    custom_dispatch_body();
+}
+// --- Custom public functions ---
+)RUST";
+
+    QTextStream stream(&source);
+    RustExtractor test_extractor;
+    ASSERT_TRUE(test_extractor.extractFromSourceFile(protocol_name, &stream, cmd_list));
+
+    QString allCmdFns = test_extractor.getCommandFunctions().join("\n");
+    ASSERT_TRUE(allCmdFns.contains("let c = '}';\n}\n"));
+    ASSERT_TRUE(allCmdFns.contains("custom_sc3_body();"));
+    ASSERT_FALSE(allCmdFns.contains("custom_dispatch_body();"));
+    ASSERT_TRUE(test_extractor.getExecuteCmdFunction().contains("custom_dispatch_body();"));
+}
@@ -127,8 +127,14 @@ TEST(test_command, cmd_att) {
     test_cmd.sortAttArrayById();
     ASSERT_EQ(test_cmd.getAttArray(), att_array);
 
-    // Check getAttByName
+    // Check getAttByName/getAttById
     ASSERT_EQ(test_cmd.getAttByName(test_att2->getName()), test_att2);
+    ASSERT_EQ(test_cmd.getAttById(test_att3->getId()), test_att3);
+
+    // Check lookups follow renames
+    test_att2->setName("renamed_att2");
+    ASSERT_EQ(test_cmd.getAttByName("sub_att2"), nullptr);
+    ASSERT_EQ(test_cmd.getAttByName("renamed_att2"), test_att2);
 
     // Check getTotalAttNb
     ASSERT_EQ(test_cmd.getTotalAttNb(), 5);
@@ -186,6 +192,22 @@ TEST(test_command, cmd_static) {
 
     // Check getMaxAttNb
     ASSERT_EQ(Command::getMaxAttNb(cmd_array), 3);
+
+    // Check getNameIndex/getIdIndex
+    QHash<QString, Command *> name_index = Command::getNameIndex(cmd_array);
+    ASSERT_EQ(name_index.size(), cmd_array.size());
+    ASSERT_EQ(name_index.value(test_cmd5.getName()), &test_cmd5);
+    ASSERT_EQ(name_index.value("unknown"), nullptr);
+    QHash<short, Command *> id_index = Command::getIdIndex(cmd_array);
+    ASSERT_EQ(id_index.value(test_cmd6.getId()), &test_cmd6);
+
+    // Check filterListByNames
+    QStringList unknown_names;
+    QList<Command *> subset_array = {&test_cmd3, &test_cmd5};
+    ASSERT_EQ(Command::filterListByNames(cmd_array, {"cmd5", "cmd3"}, unknown_names), subset_array);
+    ASSERT_TRUE(unknown_names.isEmpty());
+    Command::filterListByNames(cmd_array, {"cmd5", "unknown"}, unknown_names);
+    ASSERT_EQ(unknown_names, QStringList({"unknown"}));
 }
 
 TEST(test_attribute, cmd_comparison) {
@@ -219,4 +241,41 @@ TEST(test_attribute, cmd_comparison) {
     ASSERT_FALSE(Command::compareRefCmdList(cmd_array, cmd_array3, err_val));
     ASSERT_EQ(err_val, 2);
     ASSERT_TRUE(Command::compareRefCmdList(cmd_array, cmd_array, err_val));
+}
+
+TEST(test_command, cmd_struct_hash) {
+    Command test_cmd0("cmd0", 10, true, NS_DirectionType::BIDIRECTIONAL, "Test description");
+    Command test_cmd1("cmd1", 11, false, NS_DirectionType::A_TO_B, "Test description");
+    Command test_cmd2("cmd0", 10, true, NS_DirectionType::BIDIRECTIONAL, "Test description");
+    Command test_cmd3("cmd1", 11, false, NS_DirectionType::A_TO_B, "Test description");
+    Attribute *test_att0 = new Attribute("sub_att0", 10, false, NS_AttDataType::SUB_ATTRIBUTES, "This is a sub-attribute");
+    Attribute *test_att1 = new Attribute("sub_att1", 11, false, NS_AttDataType::UINT8, "This is a sub-attribute");
+    Attribute *test_att2 = new Attribute("sub_att0", 10, false, NS_AttDataType::SUB_ATTRIBUTES, "This is a sub-attribute");
+    Attribute *test_att3 = new Attribute("sub_att1", 11, false, NS_AttDataType::UINT8, "This is a sub-attribute");
+    test_att0->addSubAtt(test_att1);
+    test_cmd0.addAttribute(test_att0);
+    test_att2->addSubAtt(test_att3);
+    test_cmd2.addAttribute(test_att2);
+    QList<Command *> cmd_array = {&test_cmd0, &test_cmd1};
+    QList<Command *> cmd_array2 = {&test_cmd2, &test_cmd3};
+
+    // Equal commands have equal hashes
+    quint64 ref_hash = test_cmd0.getStructHash();
+    ASSERT_EQ(test_cmd2.getStructHash(), ref_hash);
+    ASSERT_TRUE(Command::diffCmdList(cmd_array, cmd_array2).isEmpty());
+
+    // A sub-attribute edit invalidates the command hash
+    test_att3->setIsOptional(true);
+    ASSERT_NE(test_cmd2.getStructHash(), ref_hash);
+    test_cmd3.setDirection(NS_DirectionType::B_TO_A);
+    QStringList diff_paths = Command::diffCmdList(cmd_array, cmd_array2);
+    QStringList ref_paths = {"cmd0/sub_att0/sub_att1", "cmd1"};
+    ASSERT_EQ(diff_paths, ref_paths);
+
+    // Added and removed commands
+    test_cmd3.setName("cmd3");
+    ref_paths = QStringList({"cmd0/sub_att0/sub_att1", "cmd1", "cmd3"});
+    ASSERT_EQ(Command::diffCmdList(cmd_array, cmd_array2), ref_paths);
+    test_cmd0.clearAttArray();
+    test_cmd2.clearAttArray();
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+/**
+ * \file test_cppgenerator.cpp
+ * \brief C++ code generator unit test
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#include <QFile>
+#include <gtest/gtest.h>
+
+#include "cppgenerator.h"
+#include "test_data.h"
+
+TEST(test_cppgen, binding_output) {
+    CppGenerator test_cppgen;
+    QString path = "gen_out/cpp/";
+    QFile output_file;
+    QString output_content;
+
+    test_cppgen.generateBinding(protocol_name, protocol_id, protocol_version, cmd_list, path);
+
+    ASSERT_TRUE(openFile(&output_file, path, "LCSF_Binding_Test.hpp"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+
+    // Check the handler doc lists the payloads received by A
+    EXPECT_TRUE(output_content.contains(" *         void operator()(const lcsf_test::Sc2Payload &payload);\n"
+                                        " *         void operator()(const lcsf_test::Sc3Payload &payload);"));
+    EXPECT_FALSE(output_content.contains("lcsf_test::Sc1Payload &payload"));
+
+    // Check descriptor
+    EXPECT_TRUE(output_content.contains("namespace lcsf_test {"));
+    EXPECT_TRUE(output_content.contains("inline constexpr uint16_t PROT_ID = 0x55;"));
+    EXPECT_TRUE(output_content.contains("enum class CmdId : uint16_t {\n    Sc1 = 0x0,"));
+    EXPECT_TRUE(output_content.contains("    {CC4_ATT_ID_CA1, false, DataType::SubAttributes, CC4_CA1_ATT_DESC, "));
+    EXPECT_TRUE(output_content.contains("    {CmdId::Sc1, {}},\n"));
+
+    // Check payloads are views over the frame
+    EXPECT_TRUE(output_content.contains("struct Cc1Payload {"));
+    EXPECT_TRUE(output_content.contains("    std::span<const uint8_t> sa4;"));
+    EXPECT_TRUE(output_content.contains("    std::optional<std::string_view> sa10;"));
+    EXPECT_TRUE(output_content.contains("    std::optional<Cc4Ca2Payload> ca2;"));
+
+    // Check worst-case sizes and side dispatch
+    EXPECT_TRUE(output_content.contains("inline constexpr std::size_t MAX_FRAME_SIZE =\n"
+                                        "    (2 * FIELD_SIZE) + detail::getMaxAttListSize(T_Payload::ATT_DESC);"));
+    EXPECT_TRUE(output_content.contains("        case CmdId::Sc1:\n            return side == Side::B;"));
+    EXPECT_TRUE(output_content.contains("        case CmdId::Sc3:\n            return true;"));
+    EXPECT_FALSE(output_content.contains("virtual"));
+}
@@ -20,6 +20,9 @@
  */
 
 #include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QTextStream>
 #include <gtest/gtest.h>
 #include <iostream>
@@ -46,6 +49,9 @@ static bool compare_cmd_list(QList<Command *> model_list, QList<Command *> out_l
         } else {
             std::cout << "Commands are different at index: " << std::to_string(err_val) << "\n" << Qt::endl;
         }
+        for (const QString &path : Command::diffCmdList(model_list, out_list)) {
+            std::cout << "Differs: " << path.toStdString() << Qt::endl;
+        }
     }
     return val;
 }
@@ -67,6 +73,22 @@ TEST(test_deschandler, load_desc) {
     ASSERT_TRUE(compare_cmd_list(cmd_list, load_cmd_list));
 }
 
+TEST(test_deschandler, load_subset) {
+    QString filename = outputDir "Test_subset.txt";
+    QFile subset_file(filename);
+    QStringList cmd_names;
+
+    // Write a profile with comments, blank lines and a duplicate
+    ASSERT_TRUE(subset_file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    subset_file.write("# Image subset\nSC1\n\n  CC4 # complex command\nSC1\n");
+    subset_file.close();
+
+    ASSERT_TRUE(subset_file.open(QIODevice::ReadOnly));
+    DescHandler::load_subset(subset_file, cmd_names);
+    subset_file.close();
+    ASSERT_EQ(cmd_names, QStringList({"SC1", "CC4"}));
+}
+
 TEST(test_deschandler, save_desc) {
     QString path = "gen_out/";
     QString filename = path + "Test_desc.json" ;
@@ -88,4 +110,124 @@ TEST(test_deschandler, save_desc) {
     }
     model_file.close();
     output_file.close();
-}
\ No newline at end of file
+}
+
+TEST(test_deschandler, save_desc_compact) {
+    QString filename = QString(outputDir) + "Test_desc_compact.json";
+    QFile model_file, output_file;
+
+    // Generate compact desc
+    ASSERT_TRUE(DescHandler::save_desc(
+        filename, cmd_list, protocol_name, protocol_id, protocol_version, protocol_desc, true));
+
+    // Compact output must match the compact serialization of the model
+    ASSERT_TRUE(openFile(&model_file, MODEL_DIR_PATH, "model_desc.json"));
+    ASSERT_TRUE(openFile(&output_file, outputDir, "Test_desc_compact.json"));
+    QByteArray model_content = QJsonDocument::fromJson(model_file.readAll()).toJson(QJsonDocument::Compact);
+    QByteArray output_content = output_file.readAll();
+    ASSERT_EQ(model_content.toStdString(), output_content.toStdString());
+    model_file.close();
+    output_file.close();
+}
+
+// Previous save_desc implementation, builds the whole QJsonDocument tree before serializing it
+static void saveAttTree_Rec(QJsonArray &attributes, QList<Attribute *> attList) {
+    for (Attribute *attribute : attList) {
+        QJsonObject Attr;
+
+        Attr.insert(QLatin1String("name"), attribute->getName());
+        Attr.insert(QLatin1String("id"), attribute->getId());
+        Attr.insert(QLatin1String("isOptional"), attribute->getIsOptional());
+        Attr.insert(QLatin1String("dataType"), NS_AttDataType::SL_AttDataType.at(attribute->getDataType()));
+        Attr.insert(QLatin1String("desc"), attribute->getDesc());
+        Attr.insert(QLatin1String("size"), attribute->getSubAttArray().size());
+        if (attribute->getDataType() == NS_AttDataType::SUB_ATTRIBUTES) {
+            QJsonArray SubAttr;
+            saveAttTree_Rec(SubAttr, attribute->getSubAttArray());
+            Attr.insert(QLatin1String("subAttr"), SubAttr);
+        }
+        attributes.append(Attr);
+    }
+}
+
+static bool saveDescTree(QString filename, QList<Command *> cmdArray) {
+    QJsonObject DescFile;
+    DescFile.insert(QLatin1String("name"), protocol_name);
+    DescFile.insert(QLatin1String("id"), protocol_id);
+    DescFile.insert(QLatin1String("version"), protocol_version.toInt());
+    DescFile.insert(QLatin1String("desc"), protocol_desc);
+
+    QJsonArray DescCmd;
+    for (Command *Cmd : cmdArray) {
+        QJsonObject jsonCmd;
+        jsonCmd.insert(QLatin1String("parentName"), "NONE");
+        jsonCmd.insert(QLatin1String("name"), Cmd->getName());
+        jsonCmd.insert(QLatin1String("id"), Cmd->getId());
+        jsonCmd.insert(QLatin1String("hasAtt"), Cmd->getHasAtt());
+        jsonCmd.insert(QLatin1String("direction"), Cmd->getDirection());
+        jsonCmd.insert(QLatin1String("description"), Cmd->getDesc());
+        jsonCmd.insert(QLatin1String("size"), Cmd->getAttArray().size());
+        QJsonArray Attr;
+        saveAttTree_Rec(Attr, Cmd->getAttArray());
+        jsonCmd.insert(QLatin1String("attributes"), Attr);
+        DescCmd.append(jsonCmd);
+    }
+    DescFile.insert(QLatin1String("commands"), DescCmd);
+    QFile JsonDescFile(filename);
+
+    if (!JsonDescFile.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    JsonDescFile.write(QJsonDocument(DescFile).toJson());
+    JsonDescFile.close();
+    return true;
+}
+
+// Streams a description large enough to span many write chunks, bounded to keep the suite fast
+TEST(test_deschandler, save_desc_large) {
+    QString filename = QString(outputDir) + "Test_desc_large.json";
+    QString tree_filename = QString(outputDir) + "Test_desc_large_tree.json";
+    QList<Command *> large_list;
+    QList<Command *> reload_list;
+    QString reload_name, reload_id, reload_version, reload_desc;
+
+    for (short cmdIdx = 0; cmdIdx < 200; cmdIdx++) {
+        Command *cmd = new Command(QString("CMD_%1").arg(cmdIdx), cmdIdx, true, NS_DirectionType::BIDIRECTIONAL,
+            QString("Command description %1").arg(cmdIdx));
+        for (short attIdx = 0; attIdx < 50; attIdx++) {
+            cmd->addAttribute(new Attribute(QString("ATT_%1").arg(attIdx), attIdx, (attIdx % 2) == 0,
+                NS_AttDataType::UINT32, QString("Attribute description %1").arg(attIdx)));
+        }
+        large_list.append(cmd);
+    }
+    bool is_stream_ok = DescHandler::save_desc(
+        filename, large_list, protocol_name, protocol_id, protocol_version, protocol_desc);
+    bool is_tree_ok = saveDescTree(tree_filename, large_list);
+
+    // Streamed output matches the tree writer byte for byte and loads back the same commands
+    QFile output_file(filename);
+    QFile tree_file(tree_filename);
+    QByteArray output_content;
+    QByteArray tree_content;
+    if (output_file.open(QIODevice::ReadOnly)) {
+        output_content = output_file.readAll();
+        output_file.seek(0);
+        DescHandler::load_desc(output_file, reload_list, reload_name, reload_id, reload_version, reload_desc);
+        output_file.close();
+    }
+    if (tree_file.open(QIODevice::ReadOnly)) {
+        tree_content = tree_file.readAll();
+        tree_file.close();
+    }
+    EXPECT_TRUE(is_stream_ok);
+    EXPECT_TRUE(is_tree_ok);
+    EXPECT_GT(output_content.size(), 512 * 1024);
+    EXPECT_TRUE(output_content == tree_content);
+    EXPECT_EQ(reload_name, protocol_name);
+    EXPECT_TRUE(compare_cmd_list(large_list, reload_list));
+    for (Command *cmd : large_list + reload_list) {
+        cmd->clearAttArray();
+    }
+    qDeleteAll(reload_list);
+    qDeleteAll(large_list);
+}
@@ -20,6 +20,9 @@
  */
 
 #include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <gtest/gtest.h>
 
 #include "docgenerator.h"
@@ -73,4 +76,91 @@ TEST(test_docgenerator, doc_output) {
     }
     model_file.close();
     output_file.close();
-}
\ No newline at end of file
+}
+
+TEST(test_docgenerator, doc_engine_output) {
+    DocGenerator test_generator;
+    QString path = "gen_out/doc_engine/";
+    QFile model_file, output_file;
+    QStringList model_content, output_content;
+    const QList<QPair<QString, QString>> file_pairs = {
+        {"model_wiki.txt", "LCSF_Test_WikiTables.txt"},
+        {"model_dokuwiki.txt", "LCSF_Test_DokuWikiTables.txt"},
+        {"model_mkdown.md", "LCSF_Test_MkdownTables.md"},
+    };
+
+    // Build the tables once
+    DocGenerator::T_DocModel model = test_generator.buildDocModel(protocol_name, protocol_id, protocol_desc, cmd_list);
+    ASSERT_EQ(model.commands.count(), cmd_list.count());
+    EXPECT_EQ(model.commands.at(0).attRows.count(), 0);
+    EXPECT_EQ(model.commands.at(3).attRows.at(0).id.toStdString(), "0x00");
+    // Sub-attribute tables are sorted by parent name
+    for (int idx = 1; idx < model.subAttTables.count(); idx++) {
+        EXPECT_LT(model.subAttTables.at(idx - 1).parentName, model.subAttTables.at(idx).parentName);
+    }
+
+    // Render all formats from the same model, outputs match the single format generators
+    test_generator.generateDoc(
+        model, {DocGenerator::DOC_WIKI, DocGenerator::DOC_DOKUWIKI, DocGenerator::DOC_MKDOWN}, path);
+    for (const QPair<QString, QString> &file_pair : file_pairs) {
+        ASSERT_TRUE(openFile(&model_file, MODEL_DIR_PATH, file_pair.first));
+        ASSERT_TRUE(openFile(&output_file, path, file_pair.second));
+        model_content = readFileContent(&model_file);
+        output_content = readFileContent(&output_file);
+        EXPECT_EQ(output_content.count(), model_content.count());
+        for (int idx = 0; idx < output_content.count(); idx++) {
+            ASSERT_EQ(model_content.at(idx).toStdString(), output_content.at(idx).toStdString()) << idx;
+        }
+        model_file.close();
+        output_file.close();
+    }
+}
+
+TEST(test_docgenerator, html_output) {
+    DocGenerator test_generator;
+    QString path = "gen_out/doc_html/";
+    QString html_path = path + "LCSF_Test_Html/";
+    QFile output_file;
+    QStringList output_content;
+
+    DocGenerator::T_DocModel model = test_generator.buildDocModel(protocol_name, protocol_id, protocol_desc, cmd_list);
+    test_generator.generateDoc(model, {DocGenerator::DOC_HTML}, path);
+
+    // One page per command, linked from the index
+    ASSERT_TRUE(openFile(&output_file, html_path, "index.html"));
+    QString index_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    for (const DocGenerator::T_DocCmd &doc_cmd : model.commands) {
+        EXPECT_TRUE(index_content.contains("href=\"cmd_" + doc_cmd.name + ".html\"")) << doc_cmd.name.toStdString();
+        EXPECT_TRUE(QFile::exists(html_path + "cmd_" + doc_cmd.name + ".html")) << doc_cmd.name.toStdString();
+    }
+    // Sub-attributes are kept in templates
+    for (const DocGenerator::T_DocCmd &doc_cmd : model.commands) {
+        bool has_sub_att = false;
+        for (const DocGenerator::T_DocRow &doc_row : doc_cmd.attRows) {
+            has_sub_att |= (doc_row.subRows.size() > 0);
+        }
+        ASSERT_TRUE(openFile(&output_file, html_path, "cmd_" + doc_cmd.name + ".html"));
+        QString cmd_content = readFileContent(&output_file).join("\n");
+        output_file.close();
+        EXPECT_EQ(cmd_content.contains("<template>"), has_sub_att) << doc_cmd.name.toStdString();
+    }
+
+    // The search index holds every command and attribute
+    ASSERT_TRUE(openFile(&output_file, html_path, "lcsf_index.js"));
+    output_content = readFileContent(&output_file);
+    output_file.close();
+    ASSERT_EQ(output_content.count(), 1);
+    QString index_line = output_content.at(0);
+    ASSERT_TRUE(index_line.startsWith("var LCSF_INDEX = "));
+    index_line = index_line.mid(QString("var LCSF_INDEX = ").size());
+    index_line.chop(1);
+    QJsonDocument index_doc = QJsonDocument::fromJson(index_line.toUtf8());
+    ASSERT_TRUE(index_doc.isObject());
+    int entry_nb = 0;
+    for (Command *command : cmd_list) {
+        entry_nb += 1 + command->getTotalAttNb();
+    }
+    EXPECT_EQ(index_doc.object().value("pages").toArray().count(), cmd_list.count());
+    EXPECT_EQ(index_doc.object().value("entries").toArray().count(), entry_nb);
+}
@@ -0,0 +1,150 @@
+/**
+ * \file test_dynamiccodec.cpp
+ * \brief Dynamic codec unit test
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#include <gtest/gtest.h>
+
+#include "dynamiccodec.h"
+#include "test_data.h"
+
+// CC4 with its mandatory attributes only: SA1 = 0x12, CA1 {SA1 = 0x34, SA2 = 0x5678}
+static const QByteArray cc4_frame = QByteArray::fromHex("5500" "0600" "0200" "0000010012" "0a800200" "0000010034"
+                                                        "010002007856");
+static const QByteArray cc4_small_frame = QByteArray::fromHex("550602" "000112" "8a02" "000134" "01027856");
+
+static void fillCC4(const DynamicCodec &codec, DynamicCodec::T_Message &msg) {
+    ASSERT_TRUE(codec.initMessage(6, msg));
+    msg.attValues[0].isPresent = true;
+    msg.attValues[0].uintValue = 0x12;
+    msg.attValues[1].isPresent = true;
+    msg.attValues[1].subValues[0].isPresent = true;
+    msg.attValues[1].subValues[0].uintValue = 0x34;
+    msg.attValues[1].subValues[1].isPresent = true;
+    msg.attValues[1].subValues[1].uintValue = 0x5678;
+}
+
+TEST(test_dynamiccodec, compile) {
+    DynamicCodec codec;
+    QList<Command *> dupList = {cmd_list.at(0), cmd_list.at(0)};
+
+    ASSERT_TRUE(codec.compile(protocol_id.toUShort(nullptr, 16), cmd_list));
+    EXPECT_EQ(codec.getCmdName(6).toStdString(), "CC4");
+    EXPECT_TRUE(codec.getCmdName(42).isEmpty());
+
+    // Duplicated command ids are rejected
+    EXPECT_FALSE(codec.compile(0x55, dupList));
+    EXPECT_FALSE(codec.isCompiled());
+}
+
+TEST(test_dynamiccodec, encode_decode) {
+    DynamicCodec codec;
+    DynamicCodec::T_Message msg;
+    DynamicCodec::T_Message decoded;
+    QByteArray frame;
+
+    ASSERT_TRUE(codec.compile(0x55, cmd_list));
+    fillCC4(codec, msg);
+    ASSERT_EQ(codec.encode(msg, frame), DynamicCodec::CODEC_OK);
+    EXPECT_EQ(frame.toHex().toStdString(), cc4_frame.toHex().toStdString());
+
+    // Decoded values are in descriptor order, absent attributes are flagged
+    ASSERT_EQ(codec.decode(frame, decoded), DynamicCodec::CODEC_OK);
+    EXPECT_EQ(decoded.cmdId, 6);
+    ASSERT_EQ(decoded.attValues.size(), 3);
+    EXPECT_EQ(decoded.attValues[1].subValues[1].uintValue, 0x5678u);
+    EXPECT_FALSE(decoded.attValues[1].subValues[2].isPresent);
+    EXPECT_FALSE(decoded.attValues[2].isPresent);
+    EXPECT_EQ(codec.getNode(decoded.attValues[1].nodeIdx).name.toStdString(), "CA1");
+    EXPECT_EQ(codec.formatMessage(decoded).toStdString(), "CC4 (6)\n  SA1: 18\n  CA1\n    SA1: 52\n    SA2: 22136");
+
+    // Strings, byte arrays and reals survive the round trip
+    ASSERT_TRUE(codec.initMessage(3, msg));
+    for (DynamicCodec::T_Value &value : msg.attValues) {
+        value.isPresent = !codec.getNode(value.nodeIdx).isOptional;
+    }
+    msg.attValues[3].data = QByteArray::fromHex("0102fe");
+    msg.attValues[4].data = "lcsf";
+    msg.attValues[10].uintValue = 0x123456789ULL;
+    msg.attValues[11].realValue = 0.5;
+    msg.attValues[12].realValue = -1.25;
+    ASSERT_EQ(codec.encode(msg, frame), DynamicCodec::CODEC_OK);
+    ASSERT_EQ(codec.decode(frame, decoded), DynamicCodec::CODEC_OK);
+    EXPECT_EQ(decoded.attValues[3].data, msg.attValues[3].data);
+    EXPECT_EQ(decoded.attValues[4].data.toStdString(), "lcsf");
+    EXPECT_EQ(decoded.attValues[10].uintValue, 0x123456789ULL);
+    EXPECT_EQ(decoded.attValues[11].realValue, 0.5);
+    EXPECT_EQ(decoded.attValues[12].realValue, -1.25);
+
+    // Values are checked against their type
+    msg.attValues[0].uintValue = 0x100;
+    EXPECT_EQ(codec.encode(msg, frame), DynamicCodec::CODEC_ERR_VALUE);
+    msg.attValues[0].uintValue = 0;
+    msg.attValues[3].data.clear();
+    EXPECT_EQ(codec.encode(msg, frame), DynamicCodec::CODEC_ERR_DATA_SIZE);
+    msg.attValues[3].isPresent = false;
+    EXPECT_EQ(codec.encode(msg, frame), DynamicCodec::CODEC_ERR_MISSING_ATT);
+}
+
+TEST(test_dynamiccodec, small_fields) {
+    DynamicCodec codec;
+    DynamicCodec::T_Message msg;
+    QByteArray frame;
+
+    codec.setSmallFields(true);
+    ASSERT_TRUE(codec.compile(0x55, cmd_list));
+    fillCC4(codec, msg);
+    ASSERT_EQ(codec.encode(msg, frame), DynamicCodec::CODEC_OK);
+    EXPECT_EQ(frame.toHex().toStdString(), cc4_small_frame.toHex().toStdString());
+    EXPECT_EQ(codec.decode(frame, msg), DynamicCodec::CODEC_OK);
+}
+
+TEST(test_dynamiccodec, decode_errors) {
+    DynamicCodec codec;
+    DynamicCodec::T_Message msg;
+    QByteArray frame;
+
+    EXPECT_EQ(codec.decode(cc4_frame, msg), DynamicCodec::CODEC_ERR_NOT_COMPILED);
+    ASSERT_TRUE(codec.compile(0x55, cmd_list));
+    EXPECT_EQ(codec.decode(cc4_frame.left(cc4_frame.size() - 1), msg), DynamicCodec::CODEC_ERR_FRAME_SIZE);
+    EXPECT_EQ(codec.decode(cc4_frame + QByteArray(1, '\0'), msg), DynamicCodec::CODEC_ERR_TRAILING_BYTES);
+
+    frame = cc4_frame;
+    frame[0] = 0x56;
+    EXPECT_EQ(codec.decode(frame, msg), DynamicCodec::CODEC_ERR_PROTOCOL_ID);
+    frame = cc4_frame;
+    frame[2] = 0x2a;
+    EXPECT_EQ(codec.decode(frame, msg), DynamicCodec::CODEC_ERR_UNKNOWN_CMD);
+    // SA1 id becomes an unknown id, then the SA1 of CA1 becomes a second SA2
+    frame = cc4_frame;
+    frame[6] = 0x07;
+    EXPECT_EQ(codec.decode(frame, msg), DynamicCodec::CODEC_ERR_UNKNOWN_ATT);
+    frame = cc4_frame;
+    frame[15] = 0x01;
+    EXPECT_EQ(codec.decode(frame, msg), DynamicCodec::CODEC_ERR_DUPLICATE_ATT);
+    // CA1 without its complex flag
+    frame = cc4_frame;
+    frame[12] = 0x00;
+    EXPECT_EQ(codec.decode(frame, msg), DynamicCodec::CODEC_ERR_ATT_TYPE);
+    // CA1 without its mandatory SA2
+    frame = QByteArray::fromHex("550006000200" "0000010012" "0a800100" "0000010034");
+    EXPECT_EQ(codec.decode(frame, msg), DynamicCodec::CODEC_ERR_MISSING_ATT);
+    EXPECT_EQ(DynamicCodec::getErrorString(DynamicCodec::CODEC_ERR_MISSING_ATT).toStdString(),
+        "missing mandatory attribute");
+}
@@ -86,6 +86,53 @@ TEST(test_extractor, b_extraction) {
     }
 }
 
+// Command functions are matched on their exact name, even when a command name prefixes another one
+// or when a command function calls another one.
+TEST(test_extractor, c_command_name_lookup) {
+    QString source = R"C(// *** Definitions ***
+// *** Private Functions ***
+
+static bool TestExecuteSC10(void) {
+    return TestExecuteSC1();
+}
+
+static bool TestExecuteSC1(void) {
+    return true;
+}
+
+// *** Public Functions ***
+
+bool Test_MainExecute(uint_fast16_t cmdName, test_cmd_payload_t *pCmdPayload) {
+    switch (cmdName) {
+        default:
+            return false;
+    }
+}
+
+void Test_MainAfter(void) {
+    return;
+}
+)C";
+    QList<Command *> name_list = {
+        new Command("SC1", 0, false, NS_DirectionType::A_TO_B, ""),
+        new Command("SC10", 1, false, NS_DirectionType::A_TO_B, ""),
+    };
+
+    QTextStream stream(&source);
+    CodeExtractor test_extractor;
+    ASSERT_TRUE(test_extractor.extractFromSourceFile(protocol_name, &stream, name_list));
+
+    QStringList cmdFcnList = test_extractor.getCommandFunctions();
+    ASSERT_EQ(cmdFcnList.count(), 2);
+    ASSERT_TRUE(cmdFcnList.at(0).startsWith("static bool TestExecuteSC1(void)"));
+    ASSERT_TRUE(cmdFcnList.at(1).startsWith("static bool TestExecuteSC10(void)"));
+    ASSERT_TRUE(test_extractor.getUnknownPrivateFunctions().isEmpty());
+    ASSERT_EQ(test_extractor.getDefaultCommandHandler().toStdString(), "            return false;\n");
+
+    // Functions placed after the main execute function are kept
+    ASSERT_TRUE(test_extractor.getUnknownPublicFunctions().contains("void Test_MainAfter(void) {"));
+}
+
 // Regression: a user helper fn interleaved among the execute_ functions must be preserved (moved
 // into the custom definitions section) instead of aborting extraction and silently dropping it
 // together with every customization that follows it.
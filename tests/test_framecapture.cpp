@@ -0,0 +1,73 @@
+/**
+ * \file test_framecapture.cpp
+ * \brief Frame capture unit test
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#include <QBuffer>
+#include <gtest/gtest.h>
+
+#include "framecapture.h"
+
+static const QList<FrameCapture::T_Record> capture_records = {
+    {1000, 0x55, QByteArray::fromHex("550000000000")},
+    {0x123456789, 0xab, QByteArray::fromHex("ab0001000100")},
+};
+
+// Header, then the first record: timestamp, protocol id, frame size and frame
+static const QByteArray capture_start = QByteArray::fromHex("4c4341500100" "0000" "e803000000000000" "5500" "06000000"
+                                                            "550000000000");
+
+TEST(test_framecapture, write_read) {
+    QBuffer buffer;
+    QList<FrameCapture::T_Record> records;
+    QString error;
+
+    ASSERT_TRUE(buffer.open(QIODevice::WriteOnly));
+    ASSERT_TRUE(FrameCapture::write(&buffer, capture_records));
+    buffer.close();
+    EXPECT_EQ(buffer.data().size(), FrameCapture::HEADER_SIZE + 2 * (FrameCapture::RECORD_HEADER_SIZE + 6));
+    EXPECT_EQ(buffer.data().left(capture_start.size()).toHex().toStdString(), capture_start.toHex().toStdString());
+
+    ASSERT_TRUE(buffer.open(QIODevice::ReadOnly));
+    ASSERT_TRUE(FrameCapture::read(&buffer, records, error));
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_EQ(records.at(1).timestampUs, 0x123456789ULL);
+    EXPECT_EQ(records.at(1).protocolId, 0xab);
+    EXPECT_EQ(records.at(1).frame, capture_records.at(1).frame);
+}
+
+TEST(test_framecapture, invalid_capture) {
+    QByteArray data = capture_start;
+    QList<FrameCapture::T_Record> records;
+    QString error;
+
+    // Wrong magic
+    data[0] = 'X';
+    QBuffer badMagic(&data);
+    ASSERT_TRUE(badMagic.open(QIODevice::ReadOnly));
+    EXPECT_FALSE(FrameCapture::read(&badMagic, records, error));
+    EXPECT_EQ(error.toStdString(), "not a capture file");
+
+    // Frame cut short
+    data = capture_start.left(capture_start.size() - 1);
+    QBuffer truncated(&data);
+    ASSERT_TRUE(truncated.open(QIODevice::ReadOnly));
+    EXPECT_FALSE(FrameCapture::read(&truncated, records, error));
+    EXPECT_EQ(error.toStdString(), "truncated record 0");
+}
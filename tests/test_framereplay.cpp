@@ -0,0 +1,81 @@
+/**
+ * \file test_framereplay.cpp
+ * \brief Capture replay unit test
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#include <gtest/gtest.h>
+
+#include "framereplay.h"
+#include "test_data.h"
+
+// Two SC1 frames, a CC4 frame, a frame of another protocol and a frame the decoder rejects
+static const QList<FrameCapture::T_Record> replay_records = {
+    {2000, 0x55, QByteArray::fromHex("550000000000")},
+    {3000, 0x55, QByteArray::fromHex("550000000000")},
+    {4500, 0x55, QByteArray::fromHex("5500060000")},
+    {5000, 0x12, QByteArray::fromHex("120000000000")},
+    {6000, 0x55, QByteArray::fromHex("55")},
+};
+
+// Command identifier of the frame header, rejects frames too short to hold it
+static int decodeHeader(const uchar *pFrame, int frameSize) {
+    return (frameSize >= 4) ? (pFrame[2] | (pFrame[3] << 8)) : -1;
+}
+
+TEST(test_framereplay, run) {
+    int decodeNb = 0;
+    auto decodeFn = [&decodeNb](const uchar *pFrame, int frameSize) {
+        decodeNb++;
+        return decodeHeader(pFrame, frameSize);
+    };
+    FrameReplay::T_Report report = FrameReplay::run(replay_records, 0x55, 3, decodeFn);
+
+    // Other protocols aren't decoded, throughput and latency passes decode the same frames
+    // Skipped and rejected frames are counted once
+    EXPECT_EQ(decodeNb, 24);
+    EXPECT_EQ(report.recordNb, 5);
+    EXPECT_EQ(report.skippedNb, 1);
+    EXPECT_EQ(report.rejectedNb, 1);
+    EXPECT_EQ(report.spanUs, 4000u);
+    EXPECT_EQ(report.total.frameNb, 9);
+    EXPECT_EQ(report.total.byteNb, 51);
+    ASSERT_EQ(report.cmdStats.size(), 2);
+    EXPECT_EQ(report.cmdStats.at(0).cmdId, 0);
+    EXPECT_EQ(report.cmdStats.at(0).frameNb, 6);
+    EXPECT_EQ(report.cmdStats.at(1).cmdId, 6);
+    EXPECT_EQ(report.cmdStats.at(1).frameNb, 3);
+    EXPECT_LE(report.total.p50Ns, report.total.p90Ns);
+    EXPECT_LE(report.total.p99Ns, report.total.maxNs);
+    EXPECT_GE(report.wallNs, 0);
+    EXPECT_GE(report.timerOverheadNs, 0);
+}
+
+TEST(test_framereplay, report) {
+    FrameReplay::T_Report report = FrameReplay::run(replay_records, 0x55, 1, decodeHeader);
+    QStringList lines = FrameReplay::formatReport(report, cmd_list).split("\n");
+
+    ASSERT_EQ(lines.size(), 8);
+    EXPECT_TRUE(lines.at(0).startsWith("Replayed 5 records over 0.004 s of capture, 1 passes, 1 skipped"));
+    EXPECT_EQ(lines.at(1), QString("Latencies exclude %1 ns of timer overhead").arg(report.timerOverheadNs));
+    EXPECT_TRUE(lines.at(2).startsWith("Command"));
+    EXPECT_TRUE(lines.at(3).startsWith("SC1 "));
+    EXPECT_TRUE(lines.at(4).startsWith("CC4 "));
+    EXPECT_TRUE(lines.at(5).startsWith("Total "));
+    EXPECT_TRUE(lines.at(6).startsWith("Throughput: "));
+}
@@ -0,0 +1,111 @@
+/**
+ * \file test_profiler.cpp
+ * \brief Profiler unit test
+ * \author Jean-Roland Gosse
+
+    This file is part of LCSF Generator.
+
+    LCSF Generator is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LCSF Generator is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this project. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <gtest/gtest.h>
+
+#include "profiler.h"
+
+static void profiledFunction(qint64 allocNb) {
+    LCSF_PROFILE_SCOPE("profiledFunction", "test");
+    for (qint64 idx = 0; idx < allocNb; idx++) {
+        Profiler::recordAllocation(16);
+    }
+}
+
+TEST(test_profiler, disabled) {
+    Profiler::setEnabled(false);
+    Profiler::reset();
+
+    // Nothing is recorded while disabled
+    profiledFunction(3);
+    Profiler::addCounter("Counter", 1);
+    ASSERT_TRUE(Profiler::getEvents().isEmpty());
+    ASSERT_TRUE(Profiler::getCounters().isEmpty());
+}
+
+TEST(test_profiler, scopes) {
+    Profiler::setEnabled(true);
+    Profiler::reset();
+
+    {
+        LCSF_PROFILE_SCOPE("outerScope", "test");
+        profiledFunction(3);
+        profiledFunction(2);
+    }
+    Profiler::addCounter("Counter", 5);
+    Profiler::addCounter("Counter", 7);
+    Profiler::setEnabled(false);
+
+    // Inner scopes end first
+    QList<Profiler::T_ProfileEvent> events = Profiler::getEvents();
+    ASSERT_EQ(events.size(), 3);
+    ASSERT_EQ(events.at(0).name.toStdString(), "profiledFunction");
+    ASSERT_EQ(events.at(0).category.toStdString(), "test");
+    ASSERT_EQ(events.at(0).allocCount, 3);
+    ASSERT_EQ(events.at(0).allocBytes, 48);
+    ASSERT_EQ(events.at(1).allocCount, 2);
+    ASSERT_EQ(events.at(2).name.toStdString(), "outerScope");
+    ASSERT_GE(events.at(2).allocCount, 5);
+
+    // Outer scope encloses the inner ones
+    ASSERT_LE(events.at(2).startUs, events.at(0).startUs);
+    ASSERT_GE(events.at(2).startUs + events.at(2).durationUs, events.at(1).startUs + events.at(1).durationUs);
+
+    // Counters accumulate
+    ASSERT_EQ(Profiler::getCounters().value("Counter"), 12);
+
+    // Report table has one line per scope name plus the header and counters
+    QStringList tableLines = Profiler::getReportTable().split("\n", Qt::SkipEmptyParts);
+    ASSERT_EQ(tableLines.size(), 4);
+    ASSERT_TRUE(tableLines.at(0).startsWith("Scope"));
+    ASSERT_TRUE(tableLines.at(3).startsWith("Counter"));
+}
+
+TEST(test_profiler, chrome_trace) {
+    Profiler::setEnabled(true);
+    Profiler::reset();
+    profiledFunction(1);
+    Profiler::addCounter("Counter", 3);
+    Profiler::setEnabled(false);
+
+    QString traceFilename = "test_profiler_trace.json";
+    ASSERT_TRUE(Profiler::writeChromeTrace(traceFilename));
+
+    QFile traceFile(traceFilename);
+    ASSERT_TRUE(traceFile.open(QIODevice::ReadOnly));
+    QJsonDocument traceDoc = QJsonDocument::fromJson(traceFile.readAll());
+    traceFile.close();
+    traceFile.remove();
+
+    QJsonArray traceEvents = traceDoc.object().value("traceEvents").toArray();
+    ASSERT_EQ(traceEvents.size(), 2);
+    QJsonObject scopeEvent = traceEvents.at(0).toObject();
+    ASSERT_EQ(scopeEvent.value("name").toString().toStdString(), "profiledFunction");
+    ASSERT_EQ(scopeEvent.value("ph").toString().toStdString(), "X");
+    ASSERT_EQ(scopeEvent.value("args").toObject().value("allocs").toInt(), 1);
+    QJsonObject counterEvent = traceEvents.at(1).toObject();
+    ASSERT_EQ(counterEvent.value("ph").toString().toStdString(), "C");
+    ASSERT_EQ(counterEvent.value("args").toObject().value("value").toInt(), 3);
+}
@@ -95,4 +95,135 @@ TEST(test_rustgen, gen_B_output) {
     }
     model_file.close();
     output_file.close();
-}
\ No newline at end of file
+}
+TEST(test_rustgen, segment_output) {
+    RustGenerator test_rustgen;
+    QString path = "gen_out/segment/";
+    QFile output_file;
+    QString output_content;
+
+    test_rustgen.setSegmentEncodeMode(true);
+    test_rustgen.generateBridge(protocol_name, protocol_id, protocol_version, cmd_list, true, path);
+
+    // Check Bridge borrows byte arrays and strings from the payload
+    ASSERT_TRUE(openFile(&output_file, path, "lcsf_protocol_test_a.rs"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("pub fn send_cmd_segments(cmd_name: CmdEnum, cmd_payload: &CmdPayload, "
+                                        "is_small: bool) -> Option<LcsfSegments<'_>> {"));
+    EXPECT_TRUE(output_content.contains("        segs.push_ref(&payload.sa4);"));
+    EXPECT_TRUE(output_content.contains("        segs.push_ref(payload.sa5.as_bytes_with_nul());"));
+    EXPECT_TRUE(output_content.contains("        segs.push_field(CC6_ATT_ID_CA10 | segs.cmplx_flag());"));
+    // Check unsendable commands and mismatched payloads are not encoded
+    EXPECT_TRUE(output_content.contains("        CmdEnum::Cc2 => false,"));
+    EXPECT_TRUE(output_content.contains("        CmdEnum::Sc1 => {\n            segs.push_field(0);\n            true\n"));
+    EXPECT_TRUE(output_content.contains("    } else {\n        false\n    }"));
+    EXPECT_TRUE(output_content.contains("    if !is_filled || segs.is_overflow { None } else { Some(segs) }"));
+}
+
+TEST(test_rustgen, handler_trait_output) {
+    RustGenerator test_rustgen;
+    QString path = "gen_out/trait/";
+    QFile output_file;
+    QString output_content;
+
+    test_rustgen.setHandlerTraitMode(true);
+    test_rustgen.generateMain(protocol_name, cmd_list, true, path);
+
+    // Check Main has a handler trait for the received commands instead of execute functions
+    ASSERT_TRUE(openFile(&output_file, path, "protocol_test_a.rs"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("pub trait Handler {\n    fn sc2(&mut self);\n    fn sc3(&mut self);"));
+    EXPECT_TRUE(output_content.contains("    fn cc2(&mut self, payload: &Cc2AttPayload);"));
+    EXPECT_FALSE(output_content.contains("    fn cc1(&mut self"));
+    EXPECT_TRUE(output_content.contains(
+        "pub fn dispatch<H: Handler>(handler: &mut H, cmd_name: CmdEnum, cmd_payload: &CmdPayload) -> bool {"));
+    EXPECT_TRUE(output_content.contains("        (CmdEnum::Cc2, CmdPayload::Cc2Payload(payload)) => handler.cc2(payload),"));
+    EXPECT_FALSE(output_content.contains("fn execute_"));
+    EXPECT_FALSE(output_content.contains("// --- Custom"));
+    // Check the protocol is registered to the core with a callback monomorphized for the handler
+    EXPECT_TRUE(output_content.contains("pub fn init_core<H: Handler + Default>(core: &mut LcsfCore) {"));
+    EXPECT_TRUE(output_content.contains("        &lcsf_protocol_test_a::PROT_DESC,\n        process_cmd::<H>,"));
+    EXPECT_TRUE(output_content.contains("fn process_cmd<H: Handler + Default>(_core: &LcsfCore, "
+                                        "valid_cmd: &LcsfValidCmd) {\n    receive(&mut H::default(), valid_cmd);"));
+}
+
+TEST(test_rustgen, instrument_output) {
+    RustGenerator test_rustgen;
+    QString path = "gen_out/instrument/";
+    QFile output_file;
+    QString output_content;
+
+    test_rustgen.setInstrumentMode(true);
+    test_rustgen.setHandlerTraitMode(true);
+    test_rustgen.generateMain(protocol_name, cmd_list, true, path);
+    test_rustgen.generateBridge(protocol_name, protocol_id, protocol_version, cmd_list, true, path);
+
+    // Check Bridge has the stats module behind the cargo feature and records the commands
+    ASSERT_TRUE(openFile(&output_file, path, "lcsf_protocol_test_a.rs"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("#[cfg(feature = \"lcsf_stats\")]\npub mod stats {"));
+    EXPECT_TRUE(output_content.contains("    pub const CMD_NB: usize = 9;"));
+    EXPECT_TRUE(output_content.contains("    pub fn handler(cmd_name: CmdEnum, is_ok: bool, start: Instant) {"));
+    EXPECT_TRUE(output_content.contains("    stats::rx(cmd_name, stats::att_data_size(&valid_cmd.att_arr), start);\n"
+                                        "    (cmd_name, cmd_payload)"));
+    EXPECT_TRUE(output_content.contains("    stats::tx(cmd_name, stats::att_data_size(&send_cmd.att_arr), start);\n"
+                                        "    send_cmd"));
+
+    // Check Main times the handler
+    ASSERT_TRUE(openFile(&output_file, path, "protocol_test_a.rs"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("    let is_ok = dispatch(handler, cmd_name, &cmd_payload);\n"
+                                        "    #[cfg(feature = \"lcsf_stats\")]\n"
+                                        "    lcsf_protocol_test_a::stats::handler(cmd_name, is_ok, start);\n"
+                                        "    is_ok"));
+}
+
+TEST(test_rustgen, static_desc_output) {
+    RustGenerator test_rustgen;
+    QString path = "gen_out/static_desc/";
+    QFile output_file;
+    QString output_content;
+
+    test_rustgen.setStaticDescMode(true);
+    test_rustgen.generateBridge(protocol_name, protocol_id, protocol_version, cmd_list, true, path);
+
+    // Check Bridge descriptor is a plain static of slices
+    ASSERT_TRUE(openFile(&output_file, path, "lcsf_protocol_test_a.rs"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains(
+        "pub static PROT_DESC: LcsfProtDesc = LcsfProtDesc {prot_ver: PROT_VER, cmd_desc_arr: &["));
+    EXPECT_TRUE(output_content.contains("    (CMD_ID_CC4, LcsfCmdDesc {att_desc_arr: &[\n"
+                                        "        (CC4_ATT_ID_SA1, LcsfAttDesc { is_optional: false, "
+                                        "data_type: LcsfDataType::Uint8, subatt_desc_arr: &[]}),"));
+    EXPECT_FALSE(output_content.contains("lazy_static"));
+    EXPECT_FALSE(output_content.contains("subatt_desc_arr: Vec::new()"));
+}
+
+TEST(test_rustgen, bench_output) {
+    RustGenerator test_rustgen;
+    QString path = "gen_out/bench/";
+    QFile output_file;
+    QString output_content;
+
+    test_rustgen.generateBench(protocol_name, cmd_list, false, path);
+
+    // Check random payloads of the sent commands and their round trip through side A
+    ASSERT_TRUE(openFile(&output_file, path, "lcsf_bench_test_b.rs"));
+    output_content = readFileContent(&output_file).join("\n");
+    output_file.close();
+    EXPECT_TRUE(output_content.contains("fn build_cc2(rng: &mut BenchRng) -> CmdPayload {\n"
+                                        "    CmdPayload::Cc2Payload(Cc2AttPayload {\n"
+                                        "        sa1: rng.next() as u8,"));
+    EXPECT_TRUE(output_content.contains("        is_sa10_here: rng.next_bool(),\n        sa10: rng.string(),"));
+    EXPECT_TRUE(output_content.contains("        ca6_payload: Cc5AttCa6Payload {"));
+    EXPECT_FALSE(output_content.contains("fn build_cc1("));
+    EXPECT_TRUE(output_content.contains("        if !tx_core.send_cmd(lcsf_protocol_test_b::PROT_ID, &valid_cmd) {"));
+    EXPECT_TRUE(output_content.contains("            rx_core.receive_buff(&frame)"));
+    EXPECT_TRUE(output_content.contains("    std::hint::black_box(lcsf_protocol_test_a::receive_cmd(valid_cmd));"));
+    EXPECT_TRUE(output_content.contains("    match bench_cmd(&tx_core, &mut rx_core, CmdEnum::Sc2, &samples) {"));
+}